@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/satellite-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/traffic-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-batched-rx-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Benchmark for the batched receptions of the satellite channel.
+ *
+ * A user defined scenario with a given number of beams and UTs per beam is
+ * simulated with CBR traffic from every UT user to a GW user, so that the
+ * return link bursts of a beam are received by the satellite receivers of
+ * all the co-channel beams. The heap allocations made during the simulation,
+ * the events and the signal parameter copies of the channels, the simulation
+ * time and the bytes received by the GW user are reported.
+ *
+ * The receptions are started either with one event per receiver or with one
+ * event per batch of receivers with identical delay and context. The received
+ * bytes of the runs with and without batching shall be identical, e.g. compare
+ * the outputs of
+ *
+ *         ./waf --run "sat-batched-rx-benchmark --batchedRx=0"
+ *         ./waf --run "sat-batched-rx-benchmark --batchedRx=1"
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-batched-rx-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-batched-rx-benchmark");
+
+/**
+ * Defines whether the heap allocations are counted
+ */
+static bool g_countAllocations = false;
+
+/**
+ * Number of the counted heap allocations
+ */
+static uint64_t g_allocations = 0;
+
+void*
+operator new (std::size_t size)
+{
+  if (g_countAllocations)
+    {
+      ++g_allocations;
+    }
+
+  void* block = std::malloc (size == 0 ? 1 : size);
+
+  if (block == NULL)
+    {
+      throw std::bad_alloc ();
+    }
+
+  return block;
+}
+
+void
+operator delete (void* block) throw ()
+{
+  std::free (block);
+}
+
+void*
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete[] (void* block) throw ()
+{
+  operator delete (block);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t beams (8);
+  uint32_t utsPerBeam (20);
+  double simLength (10.0);
+  bool batchedRx (true);
+
+  CommandLine cmd;
+  cmd.AddValue ("beams", "Number of beams", beams);
+  cmd.AddValue ("utsPerBeam", "Number of UTs per beam", utsPerBeam);
+  cmd.AddValue ("simLength", "Simulation length in seconds", simLength);
+  cmd.AddValue ("batchedRx", "Start the receptions with identical delay and context by a single event", batchedRx);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::SatChannel::EnableBatchedRx", BooleanValue (batchedRx));
+  Config::SetDefault ("ns3::SatEnvVariables::EnableSimulationOutputOverwrite", BooleanValue (true));
+
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("sat-batched-rx-benchmark", "", true);
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  SatHelper::BeamUserInfoMap_t beamInfos;
+
+  for (uint32_t beamId = 1; beamId <= beams; ++beamId)
+    {
+      beamInfos[beamId] = SatBeamUserInfo (utsPerBeam, 1);
+    }
+
+  helper->CreateUserDefinedScenario (beamInfos);
+
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  NodeContainer utUsers = helper->GetUtUsers ();
+
+  uint16_t port = 9;
+
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (simLength));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("10ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (256));
+
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+  cbrs.Start (Seconds (1.0));
+  cbrs.Stop (Seconds (simLength));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  g_countAllocations = true;
+  Simulator::Stop (Seconds (simLength));
+  Simulator::Run ();
+  g_countAllocations = false;
+  int64_t simulationMs = clock.End ();
+
+  uint64_t scheduledRx = 0;
+  uint64_t rxParamsCopies = 0;
+
+  for (uint32_t i = 0; i < ChannelList::GetNChannels (); ++i)
+    {
+      Ptr<SatChannel> channel = DynamicCast<SatChannel> (ChannelList::GetChannel (i));
+
+      if (channel != NULL)
+        {
+          scheduledRx += channel->GetNScheduledRx ();
+          rxParamsCopies += channel->GetNRxParamsCopies ();
+        }
+    }
+
+  Ptr<PacketSink> sink = DynamicCast<PacketSink> (sinks.Get (0));
+
+  std::cout << std::setw (8) << "beams"
+            << std::setw (8) << "UTs"
+            << std::setw (10) << "batched"
+            << std::setw (14) << "allocations"
+            << std::setw (14) << "receptions"
+            << std::setw (14) << "copies"
+            << std::setw (12) << "sim [ms]"
+            << std::setw (14) << "rx bytes" << std::endl;
+
+  std::cout << std::setw (8) << beams
+            << std::setw (8) << beams * utsPerBeam
+            << std::setw (10) << (batchedRx ? "yes" : "no")
+            << std::setw (14) << g_allocations
+            << std::setw (14) << scheduledRx
+            << std::setw (14) << rxParamsCopies
+            << std::setw (12) << simulationMs
+            << std::setw (14) << sink->GetTotalRx () << std::endl;
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -0,0 +1,397 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-crdsa-sic-engine.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-crdsa-sic-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Benchmark for the CRDSA successive interference cancellation.
+ *
+ * Synthetic CRDSA frames with 1k - 50k bursts are processed with
+ * SatCrdsaSicEngine and with a reference implementation of the previous
+ * frame processing algorithm of SatPhyRxCarrierPerFrame, which rescans
+ * the frame from the first slot after each successfully decoded packet.
+ * The processing time of both is reported and the decoded output
+ * (decoding order, errors and the number of decoding attempts) of the
+ * two is verified to be identical.
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-crdsa-sic-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-crdsa-sic-benchmark");
+
+namespace {
+
+/**
+ * Synthetic CRDSA burst
+ */
+struct Burst
+{
+  uint16_t ownSlotId;
+  std::vector<uint16_t> slotIdsForOtherReplicas;
+  Mac48Address source;
+  uint32_t payloadId;
+  double rxPower;
+  double ifPower;
+  bool processed;
+  bool error;
+};
+
+/**
+ * Decoder shared by both algorithms. The uniform random number is drawn
+ * from a sequence advancing once per decoding attempt like in the carrier,
+ * thus identical outputs require identical decoding sequences.
+ */
+class Decoder
+{
+public:
+  Decoder (std::vector<Burst> &bursts, double noise, double thresholdDb)
+    : m_bursts (bursts),
+      m_noise (noise),
+      m_thresholdDb (thresholdDb),
+      m_state (12345),
+      m_attempts (0)
+  {
+  }
+
+  bool Decode (uint32_t index, uint32_t numOfPacketsForThisSlot)
+  {
+    Burst &b = m_bursts[index];
+    double sinrDb = 10.0 * std::log10 (b.rxPower / (m_noise + b.ifPower));
+    double bler = 1.0 / (1.0 + std::exp (4.0 * (sinrDb - m_thresholdDb)));
+
+    m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    double r = (m_state >> 11) * (1.0 / 9007199254740992.0);
+
+    b.processed = true;
+    b.error = (r < bler);
+    m_attempts++;
+    return !b.error;
+  }
+
+  void Cancel (uint32_t index, uint32_t processedIndex)
+  {
+    m_bursts[index].ifPower -= m_bursts[processedIndex].rxPower;
+    if (std::abs (m_bursts[index].ifPower) < 1e-12)
+      {
+        m_bursts[index].ifPower = 0.0;
+      }
+  }
+
+  uint64_t GetAttempts () const
+  {
+    return m_attempts;
+  }
+
+private:
+  std::vector<Burst> &m_bursts;
+  double m_noise;
+  double m_thresholdDb;
+  uint64_t m_state;
+  uint64_t m_attempts;
+};
+
+/**
+ * Generate a frame with nBursts bursts, each transmitted as nReplicas
+ * replicas into distinct slots.
+ */
+std::vector<Burst>
+GenerateFrame (uint32_t nBursts, uint32_t nSlots, uint32_t nReplicas, uint32_t seed)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (seed);
+
+  std::vector<Burst> bursts;
+  std::vector<double> slotPower (nSlots, 0.0);
+
+  for (uint32_t u = 0; u < nBursts / nReplicas; u++)
+    {
+      std::vector<uint16_t> slots;
+      while (slots.size () < nReplicas)
+        {
+          uint16_t s = rng->GetInteger (0, nSlots - 1);
+          if (std::find (slots.begin (), slots.end (), s) == slots.end ())
+            {
+              slots.push_back (s);
+            }
+        }
+
+      Mac48Address source = Mac48Address::Allocate ();
+
+      for (uint32_t r = 0; r < nReplicas; r++)
+        {
+          Burst b;
+          b.ownSlotId = slots[r];
+          for (uint32_t o = 0; o < nReplicas; o++)
+            {
+              if (o != r)
+                {
+                  b.slotIdsForOtherReplicas.push_back (slots[o]);
+                }
+            }
+          b.source = source;
+          b.payloadId = u;
+          b.rxPower = std::pow (10.0, rng->GetValue (-1.0, 1.0));
+          b.ifPower = 0.0;
+          b.processed = false;
+          b.error = false;
+          slotPower[b.ownSlotId] += b.rxPower;
+          bursts.push_back (b);
+        }
+    }
+
+  /// shuffle the reception order within the frame
+  for (uint32_t i = bursts.size (); i > 1; i--)
+    {
+      std::swap (bursts[i - 1], bursts[rng->GetInteger (0, i - 1)]);
+    }
+
+  for (uint32_t i = 0; i < bursts.size (); i++)
+    {
+      bursts[i].ifPower = slotPower[bursts[i].ownSlotId] - bursts[i].rxPower;
+    }
+
+  return bursts;
+}
+
+/**
+ * Reference implementation of the previous frame processing algorithm.
+ */
+std::vector<uint32_t>
+ProcessFrameLegacy (std::vector<Burst> &bursts, Decoder &decoder)
+{
+  typedef std::map<uint32_t, std::list<uint32_t> > container_t;
+  container_t container;
+
+  for (uint32_t i = 0; i < bursts.size (); i++)
+    {
+      container[bursts[i].ownSlotId].push_back (i);
+    }
+
+  std::vector<uint32_t> results;
+
+  /// eliminate interference and release the slot for re-processing
+  auto eliminate = [&] (container_t::iterator iter, uint32_t processed)
+    {
+      if (iter->second.empty ())
+        {
+          container.erase (iter);
+          return;
+        }
+      for (uint32_t other : iter->second)
+        {
+          bursts[other].processed = false;
+          decoder.Cancel (other, processed);
+        }
+    };
+
+  auto removeReplicas = [&] (uint32_t packet, bool eliminateInterference)
+    {
+      for (uint16_t slot : bursts[packet].slotIdsForOtherReplicas)
+        {
+          container_t::iterator iter = container.find (slot);
+          NS_ABORT_MSG_IF (iter == container.end (), "Replica slot not found");
+          uint32_t removed = 0;
+          bool found = false;
+          for (std::list<uint32_t>::iterator it = iter->second.begin (); it != iter->second.end (); )
+            {
+              if (bursts[*it].source == bursts[packet].source)
+                {
+                  found = true;
+                  removed = *it;
+                  iter->second.erase (it++);
+                }
+              else
+                {
+                  ++it;
+                }
+            }
+          NS_ABORT_MSG_IF (!found, "Replica not found");
+          if (eliminateInterference)
+            {
+              eliminate (iter, removed);
+            }
+        }
+    };
+
+  bool nothingToProcess;
+  do
+    {
+      nothingToProcess = true;
+      uint32_t processed = 0;
+
+      for (container_t::iterator iter = container.begin (); iter != container.end (); iter++)
+        {
+          for (std::list<uint32_t>::iterator it = iter->second.begin (); it != iter->second.end (); it++)
+            {
+              if (!bursts[*it].processed && decoder.Decode (*it, iter->second.size ()))
+                {
+                  nothingToProcess = false;
+                  processed = *it;
+                  iter->second.erase (it);
+                  break;
+                }
+            }
+
+          if (!nothingToProcess)
+            {
+              eliminate (iter, processed);
+              break;
+            }
+        }
+
+      if (!nothingToProcess)
+        {
+          removeReplicas (processed, true);
+          results.push_back (processed);
+        }
+    }
+  while (!nothingToProcess);
+
+  while (!container.empty ())
+    {
+      container_t::iterator iter = container.begin ();
+      if (iter->second.empty ())
+        {
+          container.erase (iter);
+          continue;
+        }
+      uint32_t packet = iter->second.front ();
+      iter->second.pop_front ();
+      removeReplicas (packet, false);
+      results.push_back (packet);
+    }
+
+  return results;
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t minBursts (1000);
+  uint32_t maxBursts (50000);
+  uint32_t replicas (3);
+  double load (0.6);
+  double thresholdDb (0.0);
+  uint32_t maxLegacyBursts (20000);
+
+  CommandLine cmd;
+  cmd.AddValue ("minBursts", "Smallest number of bursts per frame", minBursts);
+  cmd.AddValue ("maxBursts", "Largest number of bursts per frame", maxBursts);
+  cmd.AddValue ("replicas", "Number of replicas per unique payload", replicas);
+  cmd.AddValue ("load", "Unique payloads per slot", load);
+  cmd.AddValue ("thresholdDb", "SINR threshold of the decoder in dB", thresholdDb);
+  cmd.AddValue ("maxLegacyBursts", "Largest frame processed with the reference algorithm", maxLegacyBursts);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (10) << "bursts"
+            << std::setw (10) << "slots"
+            << std::setw (12) << "decoded"
+            << std::setw (12) << "attempts"
+            << std::setw (14) << "engine [ms]"
+            << std::setw (14) << "legacy [ms]"
+            << std::setw (10) << "equal" << std::endl;
+
+  for (uint32_t nBursts = minBursts; nBursts <= maxBursts; nBursts *= 2)
+    {
+      uint32_t nUnique = nBursts / replicas;
+      uint32_t nSlots = std::min<uint32_t> (65535, std::max<uint32_t> (replicas, nUnique / load));
+
+      std::vector<Burst> frame = GenerateFrame (nBursts, nSlots, replicas, nBursts);
+
+      /// SIC engine
+      std::vector<Burst> engineBursts = frame;
+      Decoder engineDecoder (engineBursts, 0.1, thresholdDb);
+      SatCrdsaSicEngine engine;
+      engine.SetDecodeCallback (MakeCallback (&Decoder::Decode, &engineDecoder));
+      engine.SetCancelCallback (MakeCallback (&Decoder::Cancel, &engineDecoder));
+
+      SystemWallClockMs clock;
+      clock.Start ();
+      for (uint32_t i = 0; i < engineBursts.size (); i++)
+        {
+          engine.AddPacket (engineBursts[i].ownSlotId,
+                            engineBursts[i].slotIdsForOtherReplicas,
+                            engineBursts[i].source);
+        }
+      std::vector<uint32_t> engineResults = engine.ProcessFrame ();
+      int64_t engineMs = clock.End ();
+
+      uint32_t decoded = 0;
+      for (uint32_t i = 0; i < engineResults.size (); i++)
+        {
+          decoded += engineBursts[engineResults[i]].error ? 0 : 1;
+        }
+
+      /// reference
+      std::string legacyMs ("-");
+      std::string equal ("-");
+      if (nBursts <= maxLegacyBursts)
+        {
+          std::vector<Burst> legacyBursts = frame;
+          Decoder legacyDecoder (legacyBursts, 0.1, thresholdDb);
+
+          clock.Start ();
+          std::vector<uint32_t> legacyResults = ProcessFrameLegacy (legacyBursts, legacyDecoder);
+          legacyMs = std::to_string (clock.End ());
+
+          bool same = (legacyResults == engineResults)
+            && (legacyDecoder.GetAttempts () == engineDecoder.GetAttempts ());
+          for (uint32_t i = 0; same && i < legacyResults.size (); i++)
+            {
+              same = (legacyBursts[legacyResults[i]].error == engineBursts[engineResults[i]].error);
+            }
+          equal = same ? "yes" : "NO";
+
+          NS_ABORT_MSG_UNLESS (same, "SIC engine output differs from the reference implementation");
+        }
+
+      std::cout << std::setw (10) << nBursts
+                << std::setw (10) << nSlots
+                << std::setw (12) << decoded
+                << std::setw (12) << engine.GetNDecodingAttempts ()
+                << std::setw (14) << engineMs
+                << std::setw (14) << legacyMs
+                << std::setw (10) << equal << std::endl;
+
+      if (nBursts < maxBursts && nBursts * 2 > maxBursts)
+        {
+          nBursts = maxBursts / 2;
+        }
+    }
+
+  return 0;
+}
@@ -188,6 +188,13 @@ main (int argc, char *argv[])
       }
     }
 
+  // Run independent replications in local worker processes, if requested with
+  // --Replications. The parent process only merges the statistics at the end.
+  if (!simulationHelper->ForkReplications ())
+    {
+      return 0;
+    }
+
   // Creating the reference system. Note, currently the satellite module supports
   // only one reference system, which is named as "Scenario72". The string is utilized
   // in mapping the scenario to the needed reference system configuration files. Arbitrary
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-fading-oscillator-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Microbenchmark for the fading oscillator sums of the Loo and Rayleigh
+ * fading models.
+ *
+ * Oscillators with random amplitudes, phases and rotation speeds are summed
+ * at a set of time instants with a reference implementation of the previous
+ * SatFadingOscillator object based summing, and with SatFadingOscillatorBank
+ * in deterministic and vectorized evaluation modes. The throughput of each
+ * method is reported in oscillator evaluations per second. The deterministic
+ * sums are verified to be bit-exactly equal to the reference sums, and the
+ * largest relative deviation of the vectorized sums is reported.
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-fading-oscillator-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-fading-oscillator-benchmark");
+
+namespace {
+
+/**
+ * Reference implementation of the previous oscillator summing, the oscillator
+ * vector is passed by value as before.
+ */
+std::complex<double>
+GetComplexSumReference (std::vector< Ptr<SatFadingOscillator> > oscillators, double timeInSeconds)
+{
+  std::complex<double> complexSum = std::complex<double> (0, 0);
+
+  for (uint32_t i = 0; i < oscillators.size (); i++)
+    {
+      complexSum += oscillators[i]->GetComplexValueAt (timeInSeconds);
+    }
+
+  return complexSum;
+}
+
+/**
+ * Reference implementation of the previous cosine wave oscillator summing.
+ */
+std::complex<double>
+GetCosineWaveSumReference (std::vector< Ptr<SatFadingOscillator> > oscillators, double timeInSeconds)
+{
+  std::complex<double> complexSum = std::complex<double> (0, 0);
+
+  for (uint32_t i = 0; i < oscillators.size (); i++)
+    {
+      complexSum += oscillators[i]->GetCosineWaveValueAt (timeInSeconds);
+    }
+
+  return complexSum;
+}
+
+double
+GetEvaluationsPerSecond (uint64_t evaluations, int64_t ms)
+{
+  return evaluations / (std::max<int64_t> (ms, 1) / 1000.0);
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t minOscillators (4);
+  uint32_t maxOscillators (64);
+  uint32_t samples (100000);
+  double maxDopplerHz (100.0);
+
+  CommandLine cmd;
+  cmd.AddValue ("minOscillators", "Smallest number of oscillators in the bank", minOscillators);
+  cmd.AddValue ("maxOscillators", "Largest number of oscillators in the bank", maxOscillators);
+  cmd.AddValue ("samples", "Number of evaluated time instants per bank", samples);
+  cmd.AddValue ("maxDopplerHz", "Maximum Doppler frequency of the oscillators", maxDopplerHz);
+  cmd.Parse (argc, argv);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  std::cout << std::setw (12) << "oscillators"
+            << std::setw (12) << "type"
+            << std::setw (16) << "reference [/s]"
+            << std::setw (16) << "determ. [/s]"
+            << std::setw (16) << "vector. [/s]"
+            << std::setw (10) << "exact"
+            << std::setw (14) << "max rel.dev" << std::endl;
+
+  for (uint32_t n = minOscillators; n <= maxOscillators; n *= 2)
+    {
+      for (uint32_t cosineWave = 0; cosineWave <= 1; cosineWave++)
+        {
+          std::vector< Ptr<SatFadingOscillator> > oscillators;
+          SatFadingOscillatorBank bank;
+
+          double phi = rng->GetValue (-M_PI, M_PI);
+
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              double omega = 2.0 * M_PI * maxDopplerHz * std::cos (rng->GetValue (0, M_PI));
+
+              if (cosineWave)
+                {
+                  double amplitude = rng->GetValue (0.5, 1.5) / n;
+                  oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+                  bank.AddOscillator (amplitude, phi, omega);
+                }
+              else
+                {
+                  double psi = rng->GetValue (-M_PI, M_PI);
+                  std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (n);
+                  oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+                  bank.AddOscillator (amplitude, phi, omega);
+                }
+            }
+
+          std::vector<double> times (samples);
+          for (uint32_t i = 0; i < samples; ++i)
+            {
+              times[i] = rng->GetValue (0.0, 1000.0);
+            }
+
+          std::vector< std::complex<double> > referenceSums (samples);
+          std::vector< std::complex<double> > deterministicSums (samples);
+          std::vector< std::complex<double> > vectorizedSums (samples);
+
+          SystemWallClockMs clock;
+          clock.Start ();
+          for (uint32_t i = 0; i < samples; ++i)
+            {
+              referenceSums[i] = cosineWave ? GetCosineWaveSumReference (oscillators, times[i])
+                : GetComplexSumReference (oscillators, times[i]);
+            }
+          int64_t referenceMs = clock.End ();
+
+          clock.Start ();
+          for (uint32_t i = 0; i < samples; ++i)
+            {
+              deterministicSums[i] = cosineWave ? bank.GetCosineWaveSum (times[i], SatFadingOscillatorBank::EVALUATION_DETERMINISTIC)
+                : bank.GetComplexSum (times[i], SatFadingOscillatorBank::EVALUATION_DETERMINISTIC);
+            }
+          int64_t deterministicMs = clock.End ();
+
+          clock.Start ();
+          for (uint32_t i = 0; i < samples; ++i)
+            {
+              vectorizedSums[i] = cosineWave ? bank.GetCosineWaveSum (times[i], SatFadingOscillatorBank::EVALUATION_VECTORIZED)
+                : bank.GetComplexSum (times[i], SatFadingOscillatorBank::EVALUATION_VECTORIZED);
+            }
+          int64_t vectorizedMs = clock.End ();
+
+          bool exact = (referenceSums == deterministicSums);
+
+          double maxDeviation = 0.0;
+          for (uint32_t i = 0; i < samples; ++i)
+            {
+              double deviation = std::abs (vectorizedSums[i] - referenceSums[i]) / std::max (std::abs (referenceSums[i]), 1e-3);
+              maxDeviation = std::max (maxDeviation, deviation);
+            }
+
+          uint64_t evaluations = static_cast<uint64_t> (n) * samples;
+
+          std::cout << std::setw (12) << n
+                    << std::setw (12) << (cosineWave ? "cosine" : "complex")
+                    << std::setw (16) << std::setprecision (4) << GetEvaluationsPerSecond (evaluations, referenceMs)
+                    << std::setw (16) << GetEvaluationsPerSecond (evaluations, deterministicMs)
+                    << std::setw (16) << GetEvaluationsPerSecond (evaluations, vectorizedMs)
+                    << std::setw (10) << (exact ? "yes" : "NO")
+                    << std::setw (14) << maxDeviation << std::endl;
+
+          NS_ABORT_MSG_UNLESS (exact, "Deterministic oscillator sums differ from the reference");
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-frame-allocator-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Benchmark for the return link frame allocation of a beam.
+ *
+ * A superframe allocator is created with the default superframe configuration
+ * and random capacity requests (CRA, RBDC and VBDC per RC) of a given number
+ * of UTs are allocated to it for a number of superframes in the same way as
+ * done by the beam scheduler. The allocation time is reported for each
+ * number of UTs per beam together with a checksum of the generated TBTPs
+ * (time slots of the UTs and bytes allocated to the UTs).
+ *
+ * The requests and the random sorting of the allocator are seeded with the
+ * same values in every run, thus the checksums of runs with different
+ * builds of the frame allocator shall be identical.
+ *
+ *         ./waf --run "sat-frame-allocator-benchmark --utsPerBeam=100,500,1000"
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-frame-allocator-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-frame-allocator-benchmark");
+
+namespace {
+
+/**
+ * FNV-1a hash of the TBTPs
+ */
+class TbtpChecksum
+{
+public:
+  TbtpChecksum ()
+    : m_hash (14695981039346656037ULL)
+  {
+  }
+
+  void Add (const void *data, uint32_t size)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *> (data);
+
+    for (uint32_t i = 0; i < size; ++i)
+      {
+        m_hash ^= bytes[i];
+        m_hash *= 1099511628211ULL;
+      }
+  }
+
+  uint64_t Get () const
+  {
+    return m_hash;
+  }
+
+private:
+  uint64_t m_hash;
+};
+
+/**
+ * Sort requests according to C/N0 in the same way as the beam scheduler
+ */
+bool
+CompareCno (const SatFrameAllocator::SatFrameAllocReq *req1, const SatFrameAllocator::SatFrameAllocReq *req2)
+{
+  return (req1->m_cno < req2->m_cno);
+}
+
+void
+AddTbtps (TbtpChecksum &checksum, SatFrameAllocator::TbtpMsgContainer_t &tbtps,
+          SatFrameAllocator::UtAllocInfoContainer_t &utAllocs, const std::vector<Address> &uts)
+{
+  uint32_t tbtpCount = tbtps.size ();
+  checksum.Add (&tbtpCount, sizeof (tbtpCount));
+
+  for (SatFrameAllocator::TbtpMsgContainer_t::iterator tbtp = tbtps.begin (); tbtp != tbtps.end (); ++tbtp)
+    {
+      // UTs are assigned in TBTPs by their index in the beam
+      for (uint32_t ut = 0; ut < uts.size (); ++ut)
+        {
+          SatTbtpMessage::DaTimeSlotInfo slots = (*tbtp)->GetDaTimeslots (ut);
+
+          uint8_t frameId = slots.GetFrameId ();
+          checksum.Add (&frameId, sizeof (frameId));
+
+          for (uint32_t i = 0; i < slots.GetSize (); ++i)
+            {
+              int64_t startTime = slots[i].m_startTime.GetInteger ();
+              uint32_t waveformId = slots[i].m_waveformId;
+              uint16_t carrierId = slots[i].m_carrierId;
+              uint8_t rcIndex = slots[i].m_rcIndex;
+              uint8_t slotType = slots[i].m_slotType;
+
+              checksum.Add (&startTime, sizeof (startTime));
+              checksum.Add (&waveformId, sizeof (waveformId));
+              checksum.Add (&carrierId, sizeof (carrierId));
+              checksum.Add (&rcIndex, sizeof (rcIndex));
+              checksum.Add (&slotType, sizeof (slotType));
+            }
+        }
+    }
+
+  for (SatFrameAllocator::UtAllocInfoContainer_t::const_iterator it = utAllocs.begin (); it != utAllocs.end (); ++it)
+    {
+      for (std::vector<uint32_t>::const_iterator bytes = it->second.first.begin (); bytes != it->second.first.end (); ++bytes)
+        {
+          checksum.Add (&(*bytes), sizeof (*bytes));
+        }
+
+      uint8_t ctrlSlot = it->second.second;
+      checksum.Add (&ctrlSlot, sizeof (ctrlSlot));
+    }
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  std::string utsPerBeam ("50,100,250,500,1000");
+  uint32_t superframes (100);
+  uint32_t rcCount (2);
+  uint32_t maxTbtpSize (1000);
+  uint32_t seed (1);
+
+  CommandLine cmd;
+  cmd.AddValue ("utsPerBeam", "Comma separated list of the numbers of UTs per beam", utsPerBeam);
+  cmd.AddValue ("superframes", "Number of allocated superframes", superframes);
+  cmd.AddValue ("rcCount", "Number of RCs per UT", rcCount);
+  cmd.AddValue ("maxTbtpSize", "Maximum size of a TBTP message in bytes", maxTbtpSize);
+  cmd.AddValue ("seed", "Seed of the requests and the random sorting of the allocator", seed);
+  cmd.Parse (argc, argv);
+
+  std::vector<uint32_t> utCounts;
+  std::istringstream iss (utsPerBeam);
+  std::string token;
+
+  while (std::getline (iss, token, ','))
+    {
+      utCounts.push_back (std::atoi (token.c_str ()));
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("sat-frame-allocator-benchmark", "", true);
+
+  Ptr<SatConf> satConf = CreateObject<SatConf> ();
+  satConf->Initialize ("Scenario72RtnConf.txt", "Scenario72FwdConf.txt", "Scenario72GwPos.txt",
+                       "Scenario72GeoPos.txt", "dvbRcs2Waveforms.txt");
+
+  Ptr<SatSuperframeConf> superframeConf = satConf->GetSuperframeSeq ()->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
+
+  std::cout << std::setw (8) << "UTs"
+            << std::setw (14) << "time [ms]"
+            << std::setw (16) << "per SF [us]"
+            << std::setw (20) << "checksum" << std::endl;
+
+  for (uint32_t i = 0; i < utCounts.size (); ++i)
+    {
+      RngSeedManager::SetSeed (seed);
+      std::srand (seed);
+
+      Ptr<SatSuperframeAllocator> allocator = CreateObject<SatSuperframeAllocator> (superframeConf);
+      uint32_t minCarrierBytes = superframeConf->GetFrameConf (0)->GetCarrierMinPayloadInBytes ();
+
+      Ptr<UniformRandomVariable> bytes = CreateObject<UniformRandomVariable> ();
+      Ptr<UniformRandomVariable> cno = CreateObject<UniformRandomVariable> ();
+      Ptr<UniformRandomVariable> ctrlSlot = CreateObject<UniformRandomVariable> ();
+
+      // UTs in the order of addition to the beam, i.e. by UT index
+      std::vector<Address> uts;
+
+      for (uint32_t ut = 0; ut < utCounts[i]; ++ut)
+        {
+          uts.push_back (Mac48Address::Allocate ());
+        }
+
+      // draw the requests of all superframes before the measurement
+      std::vector<std::vector<SatFrameAllocator::SatFrameAllocReq> > requests (superframes);
+
+      for (uint32_t sf = 0; sf < superframes; ++sf)
+        {
+          for (uint32_t ut = 0; ut < utCounts[i]; ++ut)
+            {
+              SatFrameAllocator::SatFrameAllocReq req (SatFrameAllocator::SatFrameAllocReqItemContainer_t (rcCount, SatFrameAllocator::SatFrameAllocReqItem ()));
+              req.m_address = uts[ut];
+              req.m_utIndex = ut;
+              req.m_cno = SatUtils::DbToLinear (cno->GetValue (65.0, 85.0));
+              req.m_generateCtrlSlot = (ctrlSlot->GetValue () < 0.1);
+
+              for (uint32_t rc = 0; rc < rcCount; ++rc)
+                {
+                  req.m_reqPerRc[rc].m_craBytes = (rc == 0 ? minCarrierBytes / (4 * utCounts[i]) : 0);
+                  req.m_reqPerRc[rc].m_rbdcBytes = bytes->GetInteger (0, minCarrierBytes / 2);
+                  req.m_reqPerRc[rc].m_minRbdcBytes = req.m_reqPerRc[rc].m_rbdcBytes / 4;
+                  req.m_reqPerRc[rc].m_vbdcBytes = bytes->GetInteger (0, minCarrierBytes / 2);
+                }
+
+              requests[sf].push_back (req);
+            }
+        }
+
+      std::vector<SatFrameAllocator::TbtpMsgContainer_t> tbtps (superframes);
+      std::vector<SatFrameAllocator::UtAllocInfoContainer_t> utAllocs (superframes);
+
+      SystemWallClockMs clock;
+      clock.Start ();
+
+      for (uint32_t sf = 0; sf < superframes; ++sf)
+        {
+          SatFrameAllocator::SatFrameAllocContainer_t allocReqs;
+
+          for (std::vector<SatFrameAllocator::SatFrameAllocReq>::iterator it = requests[sf].begin (); it != requests[sf].end (); ++it)
+            {
+              allocReqs.push_back (&(*it));
+            }
+
+          std::stable_sort (allocReqs.begin (), allocReqs.end (), CompareCno);
+
+          allocator->PreAllocateSymbols (allocReqs);
+
+          tbtps[sf].push_back (CreateObject<SatTbtpMessage> (SatConstVariables::SUPERFRAME_SEQUENCE));
+          tbtps[sf].back ()->SetSuperframeCounter (sf);
+
+          allocator->GenerateTimeSlots (tbtps[sf], maxTbtpSize, utAllocs[sf], TracedCallback<uint32_t> (), TracedCallback<uint32_t, uint32_t> (), TracedCallback<uint32_t, double> ());
+        }
+
+      int64_t allocationMs = clock.End ();
+
+      TbtpChecksum checksum;
+
+      for (uint32_t sf = 0; sf < superframes; ++sf)
+        {
+          AddTbtps (checksum, tbtps[sf], utAllocs[sf], uts);
+        }
+
+      std::cout << std::setw (8) << utCounts[i]
+                << std::setw (14) << allocationMs
+                << std::setw (16) << (superframes > 0 ? 1000 * allocationMs / superframes : 0)
+                << std::setw (20) << std::hex << checksum.Get () << std::dec << std::endl;
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-look-up-table-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Microbenchmark for the BLER look-up of SatLookUpTable.
+ *
+ * Synthetic link result tables with uniform and non-uniform Es/No steps
+ * are written into temporary files and loaded with SatLookUpTable. BLER
+ * values for a set of random Es/No values are looked up with the single
+ * value and the batch GetBler methods of SatLookUpTable and with a reference
+ * implementation of the previous linear search. The processing time of each
+ * method is reported and the BLER values are verified to be identical.
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-look-up-table-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-look-up-table-benchmark");
+
+namespace {
+
+/**
+ * Reference implementation of the previous BLER look-up (linear search).
+ */
+double
+GetBlerLinear (const std::vector<double> &esNoDb, const std::vector<double> &blerValues, double esNo)
+{
+  uint32_t n = esNoDb.size ();
+
+  if (esNo < esNoDb[0])
+    {
+      return 1.0;
+    }
+
+  uint32_t i = 1;
+
+  while ((i < n) && (esNo > esNoDb[i]))
+    {
+      i++;
+    }
+
+  if (i >= n)
+    {
+      return 0.0;
+    }
+
+  return SatUtils::Interpolate (esNo, esNoDb[i - 1], esNoDb[i], blerValues[i - 1], blerValues[i]);
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t minEntries (16);
+  uint32_t maxEntries (1024);
+  uint32_t lookups (200000);
+
+  CommandLine cmd;
+  cmd.AddValue ("minEntries", "Smallest number of entries in the table", minEntries);
+  cmd.AddValue ("maxEntries", "Largest number of entries in the table", maxEntries);
+  cmd.AddValue ("lookups", "Number of BLER look-ups per table", lookups);
+  cmd.Parse (argc, argv);
+
+  // Temporary tables are not cached
+  Config::SetDefault ("ns3::SatEnvVariables::EnableBinaryDataCache", BooleanValue (false));
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  std::cout << std::setw (10) << "entries"
+            << std::setw (10) << "grid"
+            << std::setw (14) << "linear [ms]"
+            << std::setw (14) << "lookup [ms]"
+            << std::setw (14) << "batch [ms]"
+            << std::setw (10) << "equal" << std::endl;
+
+  for (uint32_t n = minEntries; n <= maxEntries; n *= 4)
+    {
+      for (int uniform = 1; uniform >= 0; uniform--)
+        {
+          // Es/No from -5 dB upwards, BLER decreasing from 1 to 1e-5
+          std::vector<double> esNoDb;
+          std::vector<double> blerValues;
+          double esNo = -5.0;
+
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              esNoDb.push_back (esNo);
+              blerValues.push_back (std::pow (10.0, -5.0 * i / (n - 1)));
+              esNo += uniform ? 0.05 : rng->GetValue (0.01, 0.1);
+            }
+
+          std::ostringstream path;
+          path << "sat-look-up-table-benchmark-" << n << "-" << uniform << ".txt";
+
+          std::ofstream ofs (path.str ().c_str ());
+          // Written with full precision, thus the parsed table equals the reference
+          ofs << std::setprecision (17);
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              ofs << esNoDb[i] << " " << blerValues[i] << std::endl;
+            }
+          ofs.close ();
+
+          Ptr<SatLookUpTable> table = CreateObject<SatLookUpTable> (path.str ());
+          std::remove (path.str ().c_str ());
+
+          std::vector<double> input (lookups);
+          for (uint32_t i = 0; i < lookups; ++i)
+            {
+              input[i] = rng->GetValue (-6.0, esNo + 1.0);
+            }
+
+          std::vector<double> linearResults (lookups);
+          std::vector<double> lookupResults (lookups);
+          std::vector<double> batchResults;
+
+          SystemWallClockMs clock;
+          clock.Start ();
+          for (uint32_t i = 0; i < lookups; ++i)
+            {
+              linearResults[i] = GetBlerLinear (esNoDb, blerValues, input[i]);
+            }
+          int64_t linearMs = clock.End ();
+
+          clock.Start ();
+          for (uint32_t i = 0; i < lookups; ++i)
+            {
+              lookupResults[i] = table->GetBler (input[i]);
+            }
+          int64_t lookupMs = clock.End ();
+
+          clock.Start ();
+          table->GetBler (input, batchResults);
+          int64_t batchMs = clock.End ();
+
+          bool same = (linearResults == lookupResults) && (linearResults == batchResults);
+
+          std::cout << std::setw (10) << n
+                    << std::setw (10) << (uniform ? "uniform" : "random")
+                    << std::setw (14) << linearMs
+                    << std::setw (14) << lookupMs
+                    << std::setw (14) << batchMs
+                    << std::setw (10) << (same ? "yes" : "NO") << std::endl;
+
+          NS_ABORT_MSG_UNLESS (same, "BLER look-up differs from the linear search");
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-packet-trace-converter.cc
+ * \ingroup satellite
+ *
+ * \brief Converter of binary packet trace files to the text format of the
+ * packet trace log.
+ *
+ * A binary packet trace is written when attribute
+ * ns3::SatPacketTrace::OutputFormat is set to Binary. The converted text file
+ * is identical to the packet trace log written with the text output format.
+ * If the output file name is not given, the extension of the input file name
+ * is replaced with .log.
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-packet-trace-converter --PrintHelp"
+ *
+ *         Example:
+ *         ./waf --run "sat-packet-trace-converter --input=PacketTrace.bin --output=PacketTrace.log"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-packet-trace-converter");
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary packet trace file", input);
+  cmd.AddValue ("output", "Text packet trace file to create", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      std::cout << "Input file not given, see --PrintHelp" << std::endl;
+      return 1;
+    }
+
+  if (output.empty ())
+    {
+      output = input.substr (0, input.rfind ('.')) + ".log";
+    }
+
+  uint64_t entries = SatPacketTrace::ConvertBinaryToText (input, output);
+
+  std::cout << "Converted " << entries << " packet trace entries from " << input << " to " << output << std::endl;
+
+  return 0;
+}
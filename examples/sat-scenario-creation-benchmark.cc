@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/satellite-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-scenario-creation-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Benchmark for the scenario creation time.
+ *
+ * User defined scenarios with an increasing number of beams and a given
+ * number of UTs per beam are created one after another with SatHelper. The
+ * creation time of the helper and the scenario is reported for each scenario
+ * size together with a checksum of the created topology (node ids, UT
+ * positions and MAC addresses of the satellite devices).
+ *
+ * The number of threads used for drawing the UT positions is set with the
+ * scenarioCreationThreads argument. Since the scenarios of a run are created
+ * in the same order, the checksums of the runs with different numbers of
+ * threads shall be identical, e.g. compare the outputs of
+ *
+ *         ./waf --run "sat-scenario-creation-benchmark --scenarioCreationThreads=1"
+ *         ./waf --run "sat-scenario-creation-benchmark --scenarioCreationThreads=8"
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-scenario-creation-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-scenario-creation-benchmark");
+
+namespace {
+
+/**
+ * FNV-1a hash of the topology
+ */
+class TopologyChecksum
+{
+public:
+  TopologyChecksum ()
+    : m_hash (14695981039346656037ULL)
+  {
+  }
+
+  void Add (const void *data, uint32_t size)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *> (data);
+
+    for (uint32_t i = 0; i < size; ++i)
+      {
+        m_hash ^= bytes[i];
+        m_hash *= 1099511628211ULL;
+      }
+  }
+
+  uint64_t Get () const
+  {
+    return m_hash;
+  }
+
+private:
+  uint64_t m_hash;
+};
+
+uint64_t
+GetTopologyChecksum (NodeContainer nodes)
+{
+  TopologyChecksum checksum;
+
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      uint32_t nodeId = (*it)->GetId ();
+      checksum.Add (&nodeId, sizeof (nodeId));
+
+      Vector position = (*it)->GetObject<MobilityModel> ()->GetPosition ();
+      checksum.Add (&position.x, sizeof (position.x));
+      checksum.Add (&position.y, sizeof (position.y));
+      checksum.Add (&position.z, sizeof (position.z));
+
+      for (uint32_t i = 0; i < (*it)->GetNDevices (); ++i)
+        {
+          Ptr<SatNetDevice> device = DynamicCast<SatNetDevice> ((*it)->GetDevice (i));
+
+          if (device)
+            {
+              uint8_t address[6];
+              Mac48Address::ConvertFrom (device->GetAddress ()).CopyTo (address);
+              checksum.Add (address, sizeof (address));
+            }
+        }
+    }
+
+  return checksum.Get ();
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  std::string beamCounts ("1,8,24");
+  uint32_t utsPerBeam (5);
+  uint32_t scenarioCreationThreads (1);
+
+  CommandLine cmd;
+  cmd.AddValue ("beamCounts", "Comma separated list of the numbers of beams of the created scenarios", beamCounts);
+  cmd.AddValue ("utsPerBeam", "Number of UTs per beam", utsPerBeam);
+  cmd.AddValue ("scenarioCreationThreads", "Number of threads used for drawing the UT positions", scenarioCreationThreads);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::SatHelper::ScenarioCreationThreads", UintegerValue (scenarioCreationThreads));
+
+  std::vector<uint32_t> beams;
+  std::istringstream iss (beamCounts);
+  std::string token;
+
+  while (std::getline (iss, token, ','))
+    {
+      beams.push_back (std::atoi (token.c_str ()));
+    }
+
+  std::cout << std::setw (8) << "beams"
+            << std::setw (8) << "UTs"
+            << std::setw (14) << "helper [ms]"
+            << std::setw (16) << "scenario [ms]"
+            << std::setw (20) << "checksum" << std::endl;
+
+  for (uint32_t i = 0; i < beams.size (); ++i)
+    {
+      Singleton<SatIdMapper>::Get ()->Reset ();
+
+      Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+      Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("sat-scenario-creation-benchmark", "", true);
+
+      SystemWallClockMs clock;
+      clock.Start ();
+      Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+      int64_t helperMs = clock.End ();
+
+      SatHelper::BeamUserInfoMap_t beamInfos;
+
+      for (uint32_t beamId = 1; beamId <= beams[i]; ++beamId)
+        {
+          beamInfos[beamId] = SatBeamUserInfo (utsPerBeam, 1);
+        }
+
+      clock.Start ();
+      helper->CreateUserDefinedScenario (beamInfos);
+      int64_t scenarioMs = clock.End ();
+
+      NodeContainer nodes = helper->GetBeamHelper ()->GetUtNodes ();
+      nodes.Add (helper->GetBeamHelper ()->GetGwNodes ());
+
+      std::cout << std::setw (8) << beams[i]
+                << std::setw (8) << beams[i] * utsPerBeam
+                << std::setw (14) << helperMs
+                << std::setw (16) << scenarioMs
+                << std::setw (20) << std::hex << GetTopologyChecksum (nodes) << std::dec << std::endl;
+
+      Singleton<SatEnvVariables>::Get ()->DoDispose ();
+
+      Simulator::Destroy ();
+    }
+
+  return 0;
+}
@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/satellite-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/traffic-module.h"
+
+using namespace ns3;
+
+/**
+ * \file sat-ut-da-tx-benchmark.cc
+ * \ingroup satellite
+ *
+ * \brief Benchmark for the scheduling of the return link DA transmission
+ * opportunities of the UTs.
+ *
+ * A user defined scenario with a given number of beams and UTs per beam is
+ * simulated with CBR traffic from every UT user to a GW user, so that the UTs
+ * are allocated DA time slots in every superframe. The number of events
+ * inserted to the simulator event queue, the maximum number of pending
+ * events, the simulation time and the bytes received by the GW user are
+ * reported.
+ *
+ * The DA Tx opportunities are scheduled either with one event per time slot
+ * or through the DA Tx timeline of the UT MAC, which keeps only the next
+ * opportunity of the UT in the event queue. The received bytes of the runs
+ * with and without the timeline shall be identical, e.g. compare the outputs
+ * of
+ *
+ *         ./waf --run "sat-ut-da-tx-benchmark --daTxTimeline=0"
+ *         ./waf --run "sat-ut-da-tx-benchmark --daTxTimeline=1"
+ *
+ *         To see help for user arguments:
+ *         execute command -> ./waf --run "sat-ut-da-tx-benchmark --PrintHelp"
+ *
+ */
+
+NS_LOG_COMPONENT_DEFINE ("sat-ut-da-tx-benchmark");
+
+namespace ns3 {
+
+/**
+ * Map scheduler, which counts the events inserted to the event queue and
+ * the maximum number of pending events.
+ */
+class SatCountingScheduler : public MapScheduler
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::SatCountingScheduler")
+      .SetParent<MapScheduler> ()
+      .AddConstructor<SatCountingScheduler> ()
+    ;
+    return tid;
+  }
+
+  virtual void Insert (const Event &ev)
+  {
+    MapScheduler::Insert (ev);
+
+    ++m_insertedEvents;
+    ++m_pendingEvents;
+    m_maxPendingEvents = std::max (m_maxPendingEvents, m_pendingEvents);
+  }
+
+  virtual Event RemoveNext (void)
+  {
+    --m_pendingEvents;
+    return MapScheduler::RemoveNext ();
+  }
+
+  virtual void Remove (const Event &ev)
+  {
+    --m_pendingEvents;
+    MapScheduler::Remove (ev);
+  }
+
+  static uint64_t m_insertedEvents;
+  static uint64_t m_pendingEvents;
+  static uint64_t m_maxPendingEvents;
+};
+
+uint64_t SatCountingScheduler::m_insertedEvents = 0;
+uint64_t SatCountingScheduler::m_pendingEvents = 0;
+uint64_t SatCountingScheduler::m_maxPendingEvents = 0;
+
+NS_OBJECT_ENSURE_REGISTERED (SatCountingScheduler);
+
+} // namespace ns3
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t beams (4);
+  uint32_t utsPerBeam (50);
+  double simLength (10.0);
+  bool daTxTimeline (true);
+
+  CommandLine cmd;
+  cmd.AddValue ("beams", "Number of beams", beams);
+  cmd.AddValue ("utsPerBeam", "Number of UTs per beam", utsPerBeam);
+  cmd.AddValue ("simLength", "Simulation length in seconds", simLength);
+  cmd.AddValue ("daTxTimeline", "Schedule the DA Tx opportunities through the DA Tx timeline of the UT MAC", daTxTimeline);
+  cmd.Parse (argc, argv);
+
+  ObjectFactory schedulerFactory;
+  schedulerFactory.SetTypeId ("ns3::SatCountingScheduler");
+  Simulator::SetScheduler (schedulerFactory);
+
+  Config::SetDefault ("ns3::SatUtMac::DaTxTimeline", BooleanValue (daTxTimeline));
+  Config::SetDefault ("ns3::SatEnvVariables::EnableSimulationOutputOverwrite", BooleanValue (true));
+
+  // constant rate assignment for RC index 0 only, so that the UTs get time slots in every superframe
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService0_ConstantAssignmentProvided", BooleanValue (true));
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService0_RbdcAllowed", BooleanValue (false));
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService0_VolumeAllowed", BooleanValue (false));
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService0_ConstantServiceRate", StringValue ("ns3::ConstantRandomVariable[Constant=256]"));
+
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("sat-ut-da-tx-benchmark", "", true);
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  SatHelper::BeamUserInfoMap_t beamInfos;
+
+  for (uint32_t beamId = 1; beamId <= beams; ++beamId)
+    {
+      beamInfos[beamId] = SatBeamUserInfo (utsPerBeam, 1);
+    }
+
+  helper->CreateUserDefinedScenario (beamInfos);
+
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  NodeContainer utUsers = helper->GetUtUsers ();
+
+  uint16_t port = 9;
+
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (simLength));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("10ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (256));
+
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+  cbrs.Start (Seconds (1.0));
+  cbrs.Stop (Seconds (simLength));
+
+  uint64_t setupEvents = SatCountingScheduler::m_insertedEvents;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (simLength));
+  Simulator::Run ();
+  int64_t simulationMs = clock.End ();
+
+  Ptr<PacketSink> sink = DynamicCast<PacketSink> (sinks.Get (0));
+
+  std::cout << std::setw (8) << "beams"
+            << std::setw (8) << "UTs"
+            << std::setw (10) << "timeline"
+            << std::setw (14) << "events"
+            << std::setw (16) << "max pending"
+            << std::setw (12) << "sim [ms]"
+            << std::setw (14) << "rx bytes" << std::endl;
+
+  std::cout << std::setw (8) << beams
+            << std::setw (8) << beams * utsPerBeam
+            << std::setw (10) << (daTxTimeline ? "yes" : "no")
+            << std::setw (14) << SatCountingScheduler::m_insertedEvents - setupEvents
+            << std::setw (16) << SatCountingScheduler::m_maxPendingEvents
+            << std::setw (12) << simulationMs
+            << std::setw (14) << sink->GetTotalRx () << std::endl;
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+
+  Simulator::Destroy ();
+
+  return 0;
+}
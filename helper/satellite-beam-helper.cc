@@ -85,7 +85,8 @@ SatBeamHelper::GetTypeId (void)
                    MakeEnumAccessor (&SatBeamHelper::m_raInterferenceModel),
                    MakeEnumChecker (SatPhyRxCarrierConf::IF_CONSTANT, "Constant",
                                     SatPhyRxCarrierConf::IF_TRACE, "Trace",
-                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket"))
+                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket",
+                                    SatPhyRxCarrierConf::IF_PER_PACKET_BUCKETED, "PerPacketBucketed"))
     .AddAttribute ("RaCollisionModel",
                    "Collision model for random access",
                    EnumValue (SatPhyRxCarrierConf::RA_COLLISION_CHECK_AGAINST_SINR),
@@ -971,6 +972,7 @@ SatBeamHelper::GetChannel (SatEnums::ChannelType_t channelType, uint32_t freqId)
       channel->SetFrequencyConverter (m_carrierFreqConverter);
       channel->SetBandwidthConverter (m_carrierBandwidthConverter);
       channel->SetFrequencyId (freqId);
+      channel->SetAntennaGainPatterns (m_antennaGainPatterns);
 
       Ptr<PropagationDelayModel> pDelay;
       // Signal propagates at the speed of light
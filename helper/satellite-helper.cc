@@ -148,6 +148,12 @@ SatHelper::GetTypeId (void)
                    StringValue ("CreationTraceUt"),
                    MakeStringAccessor (&SatHelper::m_utCreationFileName),
                    MakeStringChecker ())
+    .AddAttribute ("ScenarioCreationThreads",
+                   "Number of threads used for drawing the UT positions of the spot-beams in scenario creation. "
+                   "The created scenario is identical with any number of threads.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&SatHelper::m_scenarioCreationThreads),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("Creation", "Creation traces",
                      MakeTraceSourceAccessor (&SatHelper::m_creationDetailsTrace),
                      "ns3::SatTypedefs::CreationCallback")
@@ -180,7 +186,9 @@ SatHelper::SatHelper ()
     m_utsInBeam (0),
     m_gwUsers (0),
     m_utUsers (0),
-		m_utPositionsByBeam ()
+		m_utPositionsByBeam (),
+    m_scenarioCreationThreads (1),
+    m_precomputedUtPositions ()
 {
   NS_LOG_FUNCTION (this);
 
@@ -486,6 +494,11 @@ SatHelper::DoCreateScenario (BeamUserInfoMap_t& beamInfos, uint32_t gwUsers)
       SetGwMobility (gwNodes);
       internet.Install (gwNodes);
 
+      if (m_scenarioCreationThreads > 1)
+        {
+          PrecomputeUtPositions (beamInfos);
+        }
+
       for ( BeamUserInfoMap_t::iterator info = beamInfos.begin (); info != beamInfos.end (); info++)
         {
           // create UTs of the beam, set mobility to them and install to Internet
@@ -586,6 +599,14 @@ SatHelper::SetUtMobility (NodeContainer uts, uint32_t beamId)
       altRnd->SetAttribute ("Max", DoubleValue (500.0));
       beamAllocator->SetAltitude (altRnd);
 
+      std::map<uint32_t, std::vector<GeoCoordinate> >::iterator positions = m_precomputedUtPositions.find (beamId);
+
+      if (positions != m_precomputedUtPositions.end ())
+        {
+          beamAllocator->SetPrecomputedPositions (positions->second);
+          m_precomputedUtPositions.erase (positions);
+        }
+
       allocator = beamAllocator;
     }
 
@@ -596,6 +617,41 @@ SatHelper::SetUtMobility (NodeContainer uts, uint32_t beamId)
   InstallMobilityObserver (uts);
 }
 
+void
+SatHelper::PrecomputeUtPositions (BeamUserInfoMap_t& beamInfos)
+{
+  NS_LOG_FUNCTION (this);
+
+  // All the UTs are placed by the user defined list positions
+  if ( m_utPositions != NULL )
+    {
+      return;
+    }
+
+  std::map<uint32_t, uint32_t> positionCounts;
+
+  for ( BeamUserInfoMap_t::iterator info = beamInfos.begin (); info != beamInfos.end (); info++)
+    {
+      if (m_utPositionsByBeam.find (info->first) == m_utPositionsByBeam.end ())
+        {
+          positionCounts[info->first] = info->second.GetUtCount ();
+        }
+    }
+
+  // The spot-beam position allocators of the beams are created later, thus
+  // the minimum elevation angle is the default value of the attribute.
+  TypeId::AttributeInformation info;
+  bool found = SatSpotBeamPositionAllocator::GetTypeId ().LookupAttributeByName ("MinElevationAngleInDegForUT", &info);
+  NS_ASSERT (found);
+  double minElevationAngleInDeg = DynamicCast<const DoubleValue> (info.initialValue)->Get ();
+
+  m_precomputedUtPositions = SatSpotBeamPositionAllocator::DrawValidPositions (m_antennaGainPatterns,
+                                                                               m_satConf->GetGeoSatPosition (),
+                                                                               minElevationAngleInDeg,
+                                                                               positionCounts,
+                                                                               m_scenarioCreationThreads);
+}
+
 void
 SatHelper::SetGeoSatMobility (Ptr<Node> node)
 {
@@ -317,6 +317,16 @@ private:
    */
   Ptr<SatListPositionAllocator> m_utPositions;
 
+  /**
+   * Number of threads used for drawing the UT positions of the spot-beams
+   */
+  uint32_t m_scenarioCreationThreads;
+
+  /**
+   * UT positions of the spot-beams drawn in parallel by beam ID
+   */
+  std::map<uint32_t, std::vector<GeoCoordinate> > m_precomputedUtPositions;
+
   /**
    * Enables creation traces to be written in given file
    */
@@ -394,6 +404,14 @@ private:
    */
   void SetUtMobility (NodeContainer uts, uint32_t beamId);
 
+  /**
+   * Draws the UT positions of the spot-beams using the spot-beam position
+   * allocator in parallel, before creating the nodes of the beams.
+   *
+   * \param beamInfos information of beam to create (and beams which are given in map)
+   */
+  void PrecomputeUtPositions (BeamUserInfoMap_t& beamInfos);
+
   /**
    * Install Satellite Mobility Observer to nodes, if observer doesn't exist already in a node
    *
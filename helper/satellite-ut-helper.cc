@@ -77,7 +77,8 @@ SatUtHelper::GetTypeId (void)
                    MakeEnumAccessor (&SatUtHelper::m_daInterferenceModel),
                    MakeEnumChecker (SatPhyRxCarrierConf::IF_CONSTANT, "Constant",
                                     SatPhyRxCarrierConf::IF_TRACE, "Trace",
-                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket"))
+                                    SatPhyRxCarrierConf::IF_PER_PACKET, "PerPacket",
+                                    SatPhyRxCarrierConf::IF_PER_PACKET_BUCKETED, "PerPacketBucketed"))
     .AddAttribute ("FwdLinkErrorModel",
                    "Forward link error model",
                    EnumValue (SatPhyRxCarrierConf::EM_AVI),
@@ -380,10 +381,12 @@ SatUtHelper::Install (Ptr<Node> n, uint32_t beamId, Ptr<SatChannel> fCh, Ptr<Sat
   llc->SetReceiveCallback (MakeCallback (&SatNetDevice::Receive, dev));
 
   // Add UT to NCC
-  uint32_t raChannel = ncc->AddUt (dev->GetAddress (), m_llsConf, beamId);
+  uint32_t assignmentId = 0;
+  uint32_t raChannel = ncc->AddUt (dev->GetAddress (), m_llsConf, beamId, assignmentId);
 
-  // set RA channel given by NCC to MAC
+  // set RA channel and TBTP assignment ID given by NCC to MAC
   mac->SetRaChannel (raChannel);
+  mac->SetAssignmentId (assignmentId);
 
   phy->Initialize ();
 
@@ -20,6 +20,10 @@
  * Modified by: Patrice Raveneau <patrice.raveneau@cnes.fr>
  */
 
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
 #include "simulation-helper.h"
 
 #include <ns3/log.h>
@@ -32,6 +36,8 @@
 #include <ns3/config.h>
 #include <ns3/config-store.h>
 #include <ns3/satellite-env-variables.h>
+#include <ns3/satellite-stats-replication-merger.h>
+#include <ns3/rng-seed-manager.h>
 
 #include <ns3/packet-sink.h>
 #include <ns3/packet-sink-helper.h>
@@ -86,6 +92,8 @@ SimulationHelper::SimulationHelper ()
 	m_randomAccessConfigured (false),
 	m_enableInputFileUtListPositions (false),
 	m_inputFileUtPositionsCheckBeams (true),
+	m_replications (1),
+	m_replicationWorkers (0),
 	m_gwUserId (0),
 	m_progressLoggingEnabled (false),
 	m_progressUpdateInterval (Seconds (0.5))
@@ -109,6 +117,8 @@ SimulationHelper::SimulationHelper (std::string simulationName)
 	m_randomAccessConfigured (false),
 	m_enableInputFileUtListPositions (false),
 	m_inputFileUtPositionsCheckBeams (true),
+	m_replications (1),
+	m_replicationWorkers (0),
 	m_gwUserId (0),
 	m_progressLoggingEnabled (false),
 	m_progressUpdateInterval (Seconds (0.5))
@@ -234,6 +244,8 @@ SimulationHelper::AddDefaultUiArguments (CommandLine &cmd)
 
 	// Create a customizable output path
 	cmd.AddValue ("OutputPath", "Output path for storing the simulation statistics", m_outputPath);
+	cmd.AddValue ("Replications", "Number of independent replications run in local worker processes", m_replications);
+	cmd.AddValue ("ReplicationWorkers", "Maximum number of replications run at the same time (0 = number of cores)", m_replicationWorkers);
 }
 
 void
@@ -961,6 +973,14 @@ SimulationHelper::CreateSatScenario (SatHelper::PreDefinedScenario_t scenario)
 {
   NS_LOG_FUNCTION (this);
 
+  // The replication processes have a single replication, the count is only
+  // left above one when ForkReplications was not called or returned false
+  if (m_replications > 1)
+    {
+      NS_FATAL_ERROR ("SimulationHelper::CreateSatScenario - " << m_replications << " replications are set, " <<
+                      "but this simulation does not run them with ForkReplications");
+    }
+
   std::stringstream ss;
   ss << "Created scenario: " << std::endl;
 
@@ -1302,6 +1322,127 @@ SimulationHelper::GetNextUtCount (uint32_t beamId) const
   return m_utCount.at (0)->GetInteger ();
 }
 
+void
+SimulationHelper::SetReplications (uint32_t replications, uint32_t workers)
+{
+  NS_LOG_FUNCTION (this << replications << workers);
+
+  m_replications = replications;
+  m_replicationWorkers = workers;
+}
+
+bool
+SimulationHelper::ForkReplications ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_replications < 2)
+    {
+      return true;
+    }
+
+  // The replications are written below the output path of the simulation
+  SetupOutputPath ();
+
+  if (!Singleton<SatEnvVariables>::Get ()->IsValidDirectory (m_outputPath))
+    {
+      Singleton<SatEnvVariables>::Get ()->CreateDirectory (m_outputPath);
+    }
+
+  uint32_t workers = m_replicationWorkers;
+
+  if (workers == 0)
+    {
+      long cores = sysconf (_SC_NPROCESSORS_ONLN);
+      workers = (cores > 0 ? cores : 1);
+    }
+
+  uint32_t firstRun = RngSeedManager::GetRun ();
+  uint32_t nextReplication = 0;
+  std::map<pid_t, uint32_t> runningReplications;
+  std::vector<uint32_t> failedRuns;
+  SatStatsReplicationMerger merger (m_outputPath);
+
+  while (nextReplication < m_replications || !runningReplications.empty ())
+    {
+      if (nextReplication < m_replications && runningReplications.size () < workers)
+        {
+          uint32_t run = firstRun + nextReplication++;
+
+          std::stringstream ss;
+          ss << m_outputPath << "/run-" << run << "/";
+          std::string replicationPath = ss.str ();
+
+          if (!Singleton<SatEnvVariables>::Get ()->IsValidDirectory (replicationPath))
+            {
+              Singleton<SatEnvVariables>::Get ()->CreateDirectory (replicationPath);
+            }
+
+          // Buffered output would be written by both processes
+          std::cout.flush ();
+          std::cerr.flush ();
+
+          pid_t pid = fork ();
+
+          if (pid < 0)
+            {
+              NS_FATAL_ERROR ("SimulationHelper::ForkReplications - Unable to fork replication with RngRun " << run);
+            }
+
+          if (pid == 0)
+            {
+              RngSeedManager::SetRun (run);
+              m_outputPath = replicationPath;
+              m_replications = 1;
+              Singleton<SatEnvVariables>::Get ()->SetOutputPath (m_outputPath);
+              return true;
+            }
+
+          NS_LOG_INFO ("Started replication with RngRun " << run << " in process " << pid);
+
+          runningReplications.insert (std::make_pair (pid, run));
+          merger.AddReplication (replicationPath);
+        }
+      else
+        {
+          int status = 0;
+          pid_t pid = waitpid (-1, &status, 0);
+
+          if (pid < 0)
+            {
+              NS_FATAL_ERROR ("SimulationHelper::ForkReplications - Waiting for the replications failed");
+            }
+
+          std::map<pid_t, uint32_t>::iterator it = runningReplications.find (pid);
+
+          if (it != runningReplications.end ())
+            {
+              if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+                {
+                  failedRuns.push_back (it->second);
+                }
+
+              NS_LOG_INFO ("Finished replication with RngRun " << it->second);
+              runningReplications.erase (it);
+            }
+        }
+    }
+
+  if (!failedRuns.empty ())
+    {
+      std::stringstream ss;
+      for (std::vector<uint32_t>::const_iterator it = failedRuns.begin (); it != failedRuns.end (); ++it)
+        {
+          ss << " " << *it;
+        }
+      NS_FATAL_ERROR ("SimulationHelper::ForkReplications - Replications with RngRun" << ss.str () << " failed");
+    }
+
+  merger.Merge ();
+
+  return false;
+}
+
 void SimulationHelper::RunSimulation ()
 {
   NS_LOG_FUNCTION (this);
@@ -331,6 +331,37 @@ public:
    */
   void AddDefaultUiArguments (CommandLine &cmd, std::string &xmlInputFile);
 
+  /**
+   * \brief Set the number of independent replications of the simulation run
+   * with ForkReplications. Also set by the `Replications` and
+   * `ReplicationWorkers` command line arguments. CreateSatScenario fails when
+   * more than one replication is set and ForkReplications is not called
+   * before it.
+   * \param replications Number of replications
+   * \param workers Maximum number of replications run at the same time, zero
+   * for the number of online processor cores
+   */
+  void SetReplications (uint32_t replications, uint32_t workers = 0);
+
+  /**
+   * \brief Fork the replications of the simulation into local worker processes.
+   * Replication i is run with RngRun of the simulation added by i and it writes
+   * its output to the subdirectory run-<RngRun> of the simulation output path.
+   * When all replications have finished, the parent process merges the scalar
+   * and CDF statistics files of the replications into the simulation output
+   * path with SatStatsReplicationMerger.
+   *
+   * This method must be called after the configuration and before
+   * CreateSatScenario. With less than two replications it does nothing.
+   * Note that the RngRun of a random variable is fixed when the variable is
+   * created, thus the random variables created before the fork (e.g. the UT
+   * count random variables given to SetUtCountPerBeam) use the RngRun of the
+   * first replication in all the replications.
+   * \return true in a replication process, which shall continue by creating
+   * and running the simulation, false in the parent process after the merge
+   */
+  bool ForkReplications ();
+
   /**
    * \brief Run the simulation
    */
@@ -572,6 +603,8 @@ private:
   bool                         m_randomAccessConfigured;
   bool                         m_enableInputFileUtListPositions;
   bool                         m_inputFileUtPositionsCheckBeams;
+  uint32_t                     m_replications;
+  uint32_t                     m_replicationWorkers;
   uint32_t                     m_gwUserId;
 
   bool                         m_progressLoggingEnabled;
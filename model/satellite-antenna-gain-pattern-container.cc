@@ -19,10 +19,13 @@
  */
 
 #include <sstream>
+#include <cmath>
+#include <limits>
 #include "ns3/log.h"
 #include "satellite-antenna-gain-pattern-container.h"
 #include "ns3/singleton.h"
 #include "ns3/satellite-env-variables.h"
+#include "satellite-utils.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatAntennaGainPatternContainer");
 
@@ -41,6 +44,7 @@ SatAntennaGainPatternContainer::GetTypeId (void)
 }
 
 SatAntennaGainPatternContainer::SatAntennaGainPatternContainer ()
+  : m_commonGrid (true)
 {
   /**
    * TODO: To change the reference system, these hard coded paths
@@ -67,6 +71,15 @@ SatAntennaGainPatternContainer::SatAntennaGainPatternContainer ()
           NS_FATAL_ERROR (this << " an antenna pattern for beam " << i << " already exists!");
         }
     }
+
+  // When all the antenna patterns use the same grid, the position within the
+  // grid is calculated only once for all the beams.
+  Ptr<SatAntennaGainPattern> firstPattern = m_antennaPatternMap.at (1);
+
+  for (uint32_t i = 2; i <= NUMBER_OF_BEAMS && m_commonGrid; ++i)
+    {
+      m_commonGrid = firstPattern->HasSameGrid (m_antennaPatternMap.at (i));
+    }
 }
 
 Ptr<SatAntennaGainPattern>
@@ -92,9 +105,12 @@ SatAntennaGainPatternContainer::GetBestBeamId (GeoCoordinate coord) const
   double bestGain (-100.0);
   uint32_t bestId (0);
 
+  std::vector<double> gains;
+  GetAntennaGains_lin (coord, gains);
+
   for (uint32_t i = 1; i <= NUMBER_OF_BEAMS; ++i)
     {
-      double gain = m_antennaPatternMap.at (i)->GetAntennaGain_lin (coord);
+      double gain = gains[i - 1];
 
       // The antenna pattern has returned a NAN gain. This means
       // that this position is not valid. Return 0, which is not a valid beam id.
@@ -112,4 +128,165 @@ SatAntennaGainPatternContainer::GetBestBeamId (GeoCoordinate coord) const
   return bestId;
 }
 
+void
+SatAntennaGainPatternContainer::GetAntennaGains_lin (GeoCoordinate coord, std::vector<double> &gains) const
+{
+  NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
+
+  gains.resize (NUMBER_OF_BEAMS);
+
+  SatAntennaGainPattern::GridPosition_t pos;
+
+  if (m_commonGrid)
+    {
+      pos = m_antennaPatternMap.at (1)->GetGridPosition (coord);
+    }
+
+  // The patterns are ordered by beam id, starting from 1
+  for (gpIterator it = m_antennaPatternMap.begin (); it != m_antennaPatternMap.end (); ++it)
+    {
+      if (!m_commonGrid)
+        {
+          pos = it->second->GetGridPosition (coord);
+        }
+
+      // NaN of a non-valid grid point is propagated to the gain
+      gains[it->first - 1] = it->second->GetAntennaGain_lin (pos);
+    }
+}
+
+double
+SatAntennaGainPatternContainer::GetBeamCoupling_lin (uint32_t coverageBeamId, uint32_t interferingBeamId)
+{
+  NS_LOG_FUNCTION (this << coverageBeamId << interferingBeamId);
+
+  if (coverageBeamId == 0 || coverageBeamId > NUMBER_OF_BEAMS
+      || interferingBeamId == 0 || interferingBeamId > NUMBER_OF_BEAMS)
+    {
+      NS_FATAL_ERROR ("SatAntennaGainPatternContainer::GetBeamCoupling_lin - unvalid beam id: " << coverageBeamId << ", " << interferingBeamId);
+    }
+
+  if (m_beamCouplings.empty ())
+    {
+      CalculateBeamCouplings ();
+    }
+
+  return m_beamCouplings[coverageBeamId - 1][interferingBeamId - 1];
+}
+
+void
+SatAntennaGainPatternContainer::CalculateBeamCouplings ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatAntennaGainPattern> firstPattern = m_antennaPatternMap.at (1);
+  uint32_t nLat = firstPattern->GetNLatitudes ();
+  uint32_t nLon = firstPattern->GetNLongitudes ();
+
+  // Antenna gains of all beams in the grid, indexed by (grid point * beams + beam)
+  std::vector<float> gains (nLat * nLon * NUMBER_OF_BEAMS, NAN);
+
+  // Best beam in each grid point, 0 if the grid point is not valid
+  std::vector<uint32_t> bestBeams (nLat * nLon, 0);
+
+  for (uint32_t b = 0; b < NUMBER_OF_BEAMS; ++b)
+    {
+      Ptr<SatAntennaGainPattern> pattern = m_antennaPatternMap.at (b + 1);
+
+      if (pattern->GetNLatitudes () != nLat || pattern->GetNLongitudes () != nLon)
+        {
+          NS_FATAL_ERROR ("SatAntennaGainPatternContainer::CalculateBeamCouplings - antenna pattern grids of the beams differ");
+        }
+
+      for (uint32_t lat = 0; lat < nLat; ++lat)
+        {
+          for (uint32_t lon = 0; lon < nLon; ++lon)
+            {
+              gains[(lat * nLon + lon) * NUMBER_OF_BEAMS + b] = pattern->GetGridAntennaGain_db (lat, lon);
+            }
+        }
+    }
+
+  for (uint32_t point = 0; point < nLat * nLon; ++point)
+    {
+      double bestGain = -std::numeric_limits<double>::infinity ();
+
+      for (uint32_t b = 0; b < NUMBER_OF_BEAMS; ++b)
+        {
+          double gain = gains[point * NUMBER_OF_BEAMS + b];
+
+          if (!std::isnan (gain) && gain > bestGain)
+            {
+              bestGain = gain;
+              bestBeams[point] = b + 1;
+            }
+        }
+    }
+
+  // Couplings in dB, initialized to minus infinity
+  std::vector< std::vector<double> > couplingsDb (NUMBER_OF_BEAMS,
+                                                  std::vector<double> (NUMBER_OF_BEAMS, -std::numeric_limits<double>::infinity ()));
+
+  for (uint32_t lat = 0; lat < nLat; ++lat)
+    {
+      for (uint32_t lon = 0; lon < nLon; ++lon)
+        {
+          uint32_t coverageBeam = bestBeams[lat * nLon + lon];
+
+          if (coverageBeam == 0)
+            {
+              continue;
+            }
+
+          std::vector<double> &row = couplingsDb[coverageBeam - 1];
+
+          // The grid point and its adjacent grid points, since the gain of a position
+          // is interpolated from the surrounding grid points
+          for (uint32_t nLatIndex = (lat > 0 ? lat - 1 : lat); nLatIndex <= lat + 1 && nLatIndex < nLat; ++nLatIndex)
+            {
+              for (uint32_t nLonIndex = (lon > 0 ? lon - 1 : lon); nLonIndex <= lon + 1 && nLonIndex < nLon; ++nLonIndex)
+                {
+                  const float *pointGains = &gains[(nLatIndex * nLon + nLonIndex) * NUMBER_OF_BEAMS];
+                  double coverageGain = pointGains[coverageBeam - 1];
+
+                  if (std::isnan (coverageGain))
+                    {
+                      continue;
+                    }
+
+                  for (uint32_t b = 0; b < NUMBER_OF_BEAMS; ++b)
+                    {
+                      if (!std::isnan (pointGains[b]))
+                        {
+                          row[b] = std::max (row[b], pointGains[b] - coverageGain);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+  m_beamCouplings.assign (NUMBER_OF_BEAMS, std::vector<double> (NUMBER_OF_BEAMS, 0.0));
+
+  for (uint32_t i = 0; i < NUMBER_OF_BEAMS; ++i)
+    {
+      bool hasCoverage = !std::isinf (couplingsDb[i][i]);
+
+      for (uint32_t j = 0; j < NUMBER_OF_BEAMS; ++j)
+        {
+          // A beam without any coverage area is considered to be coupled to all the beams
+          if (!hasCoverage)
+            {
+              m_beamCouplings[i][j] = 1.0;
+            }
+          else if (!std::isinf (couplingsDb[i][j]))
+            {
+              m_beamCouplings[i][j] = SatUtils::DbToLinear (couplingsDb[i][j]);
+            }
+        }
+
+      NS_LOG_INFO ("SatAntennaGainPatternContainer::CalculateBeamCouplings - beam " << i + 1 << " coverage calculated: " << hasCoverage);
+    }
+}
+
 } // namespace ns3
@@ -75,6 +75,29 @@ public:
    */
   uint32_t GetBestBeamId (GeoCoordinate coord) const;
 
+  /**
+   * \brief Calculate the antenna gains of all the beams in a specified
+   * geo coordinate
+   * \param coord Geo coordinate
+   * \param gains Antenna gains in linear format indexed by beam id - 1,
+   * NaN for the beams without a valid antenna gain in the position
+   */
+  void GetAntennaGains_lin (GeoCoordinate coord, std::vector<double> &gains) const;
+
+  /**
+   * \brief Get the coupling between two beams. The coupling is the highest
+   * ratio of the antenna gain of the interfering beam to the antenna gain of
+   * the coverage beam within the coverage area of the coverage beam, i.e. an
+   * upper bound for the power received from (or by) the interfering beam
+   * relative to the co-beam power. The coverage area of a beam consists of
+   * the antenna pattern grid points where the beam is the best beam and their
+   * adjacent grid points. The coupling matrix is calculated at the first call.
+   * \param coverageBeamId Beam identifier of the coverage beam
+   * \param interferingBeamId Beam identifier of the interfering beam
+   * \return Coupling in linear format
+   */
+  double GetBeamCoupling_lin (uint32_t coverageBeamId, uint32_t interferingBeamId);
+
 private:
   /**
    * \brief Definition of number of beams (72-beam reference scenario).
@@ -88,6 +111,23 @@ private:
    */
   std::map< uint32_t, Ptr<SatAntennaGainPattern> > m_antennaPatternMap;
 
+  /**
+   * Flag telling whether all the antenna patterns use the same grid
+   */
+  bool m_commonGrid;
+
+  /**
+   * \brief Calculate the beam coupling matrix from the antenna patterns
+   */
+  void CalculateBeamCouplings ();
+
+  /**
+   * Beam coupling matrix in linear format
+   * - Outer vector is indexed by the coverage beam (beam id - 1)
+   * - Inner vector is indexed by the interfering beam (beam id - 1)
+   */
+  std::vector< std::vector<double> > m_beamCouplings;
+
 };
 
 } // namespace ns3
@@ -19,6 +19,8 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <set>
 #include <stdlib.h>
 #include "ns3/double.h"
 #include "ns3/log.h"
@@ -57,7 +59,12 @@ SatAntennaGainPattern::GetInstanceTypeId (void) const
 
 
 SatAntennaGainPattern::SatAntennaGainPattern ()
-  : m_antennaPattern (),
+  : m_antennaPatternLin (),
+    m_antennaPatternDb (),
+    m_gridDb (0),
+    m_gridLin (0),
+    m_cache (),
+    m_validGridBoxes (),
     m_validPositions (),
     m_minAcceptableAntennaGainInDb (40.0),
     m_uniformRandomVariable (),
@@ -75,7 +82,9 @@ SatAntennaGainPattern::SatAntennaGainPattern ()
 }
 
 SatAntennaGainPattern::SatAntennaGainPattern (std::string filePathName)
-  : m_nanStrings (m_nanStringArray, m_nanStringArray + (sizeof m_nanStringArray / sizeof m_nanStringArray[0]))
+  : m_gridDb (0),
+    m_gridLin (0),
+    m_nanStrings (m_nanStringArray, m_nanStringArray + (sizeof m_nanStringArray / sizeof m_nanStringArray[0]))
 {
   // Attributes are needed already in construction phase:
   // - ConstructSelf call in constructor
@@ -107,6 +116,23 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
         }
     }
 
+  // Use the binary cache of the file, if it is valid
+  Ptr<SatBinaryDataCache> cache = SatBinaryDataCache::Open (filePathName, SatBinaryDataCache::CACHE_ANTENNA_PATTERN);
+
+  if (cache != NULL)
+    {
+      ifs->close ();
+      delete ifs;
+
+      ReadAntennaPatternFromCache (cache);
+      return;
+    }
+
+  // Container for the antenna pattern read from the file
+  // - Outer vector holds gain values for all latitudes
+  // - Inner vector holds gain values for all longitudes for a certain latitude
+  std::vector< std::vector <double> > antennaPattern;
+
   // Row vector containing all the gain values for a certain latitude
   std::vector<double> rowVector;
 
@@ -137,13 +163,6 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
       else
         {
           gainDouble = atof (gainString.c_str ());
-
-          // Add the position to valid positions vector if the gain is
-          // above a specified threshold.
-          if ( gainDouble >= m_minAcceptableAntennaGainInDb )
-            {
-              m_validPositions.push_back (std::make_pair (lat, lon));
-            }
         }
 
       // Collect the valid latitude values
@@ -193,7 +212,7 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
       // - Start from another row
       else
         {
-          m_antennaPattern.push_back (rowVector);
+          antennaPattern.push_back (rowVector);
           rowVector.clear ();
           rowVector.push_back (gainDouble);
         }
@@ -210,11 +229,148 @@ void SatAntennaGainPattern::ReadAntennaPatternFromFile (std::string filePathName
   // happens every time the row changes. I.e. the last row is stored here!
   NS_ASSERT ( rowVector.size () == m_longitudes.size ());
 
-  m_antennaPattern.push_back (rowVector);
+  antennaPattern.push_back (rowVector);
   rowVector.clear ();
 
   ifs->close ();
   delete ifs;
+
+  // Change the gains to linear values, because the interpolation is done in linear domain.
+  uint32_t nLat = antennaPattern.size ();
+  uint32_t nLon = m_longitudes.size ();
+
+  m_antennaPatternDb.resize (nLat * nLon);
+  m_antennaPatternLin.resize (nLat * nLon);
+
+  for (uint32_t i = 0; i < nLat; ++i)
+    {
+      for (uint32_t j = 0; j < nLon; ++j)
+        {
+          double gainDb = antennaPattern[i][j];
+          m_antennaPatternDb[i * nLon + j] = gainDb;
+          m_antennaPatternLin[i * nLon + j] = std::isnan (gainDb) ? NAN : SatUtils::DbToLinear (gainDb);
+        }
+    }
+
+  m_gridDb = &m_antennaPatternDb[0];
+  m_gridLin = &m_antennaPatternLin[0];
+
+  InitializeValidity ();
+  StoreAntennaPatternToCache (filePathName);
+}
+
+
+void SatAntennaGainPattern::ReadAntennaPatternFromCache (Ptr<SatBinaryDataCache> cache)
+{
+  NS_LOG_FUNCTION (this << cache);
+
+  const double *params = cache->GetParams ();
+
+  if (cache->GetNParams () != 8)
+    {
+      NS_FATAL_ERROR ("SatAntennaGainPattern::ReadAntennaPatternFromCache - invalid number of parameters: " << cache->GetNParams ());
+    }
+
+  uint32_t nLat = (uint32_t) params[0];
+  uint32_t nLon = (uint32_t) params[1];
+  m_minLat = params[2];
+  m_minLon = params[3];
+  m_maxLat = params[4];
+  m_maxLon = params[5];
+  m_latInterval = params[6];
+  m_lonInterval = params[7];
+
+  // Values: latitudes, longitudes, gains in dB and gains in linear format
+  if (cache->GetNValues () != (uint64_t) nLat + nLon + 2 * (uint64_t) nLat * nLon)
+    {
+      NS_FATAL_ERROR ("SatAntennaGainPattern::ReadAntennaPatternFromCache - invalid number of values: " << cache->GetNValues ());
+    }
+
+  const double *values = cache->GetValues ();
+  m_latitudes.assign (values, values + nLat);
+  m_longitudes.assign (values + nLat, values + nLat + nLon);
+  m_gridDb = values + nLat + nLon;
+  m_gridLin = m_gridDb + nLat * nLon;
+  m_cache = cache;
+
+  InitializeValidity ();
+}
+
+
+void SatAntennaGainPattern::StoreAntennaPatternToCache (std::string filePathName)
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  std::vector<double> params;
+  params.push_back (m_latitudes.size ());
+  params.push_back (m_longitudes.size ());
+  params.push_back (m_minLat);
+  params.push_back (m_minLon);
+  params.push_back (m_maxLat);
+  params.push_back (m_maxLon);
+  params.push_back (m_latInterval);
+  params.push_back (m_lonInterval);
+
+  std::vector<double> values (m_latitudes.begin (), m_latitudes.end ());
+  values.insert (values.end (), m_longitudes.begin (), m_longitudes.end ());
+  values.insert (values.end (), m_antennaPatternDb.begin (), m_antennaPatternDb.end ());
+  values.insert (values.end (), m_antennaPatternLin.begin (), m_antennaPatternLin.end ());
+
+  SatBinaryDataCache::Store (filePathName, SatBinaryDataCache::CACHE_ANTENNA_PATTERN, params, values);
+}
+
+
+void SatAntennaGainPattern::InitializeValidity ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t nLat = m_latitudes.size ();
+  uint32_t nLon = m_longitudes.size ();
+
+  // Add the positions to valid positions vector if the gain is
+  // above a specified threshold.
+  m_validPositions.clear ();
+
+  for (uint32_t i = 0; i < nLat; ++i)
+    {
+      for (uint32_t j = 0; j < nLon; ++j)
+        {
+          if (m_gridDb[i * nLon + j] >= m_minAcceptableAntennaGainInDb)
+            {
+              m_validPositions.push_back (std::make_pair (m_latitudes[i], m_longitudes[j]));
+            }
+        }
+    }
+
+  // Grid box is valid, if all its four grid points are valid
+  m_validGridBoxes.assign (nLat * nLon, 0);
+
+  for (uint32_t i = 0; i + 1 < nLat; ++i)
+    {
+      for (uint32_t j = 0; j + 1 < nLon; ++j)
+        {
+          m_validGridBoxes[i * nLon + j] = !(std::isnan (m_gridDb[i * nLon + j])
+                                             || std::isnan (m_gridDb[i * nLon + j + 1])
+                                             || std::isnan (m_gridDb[(i + 1) * nLon + j])
+                                             || std::isnan (m_gridDb[(i + 1) * nLon + j + 1]));
+        }
+    }
+
+  // Check the three other corners needed for interpolation at each valid position
+  std::set< std::pair<double, double> > validPositionSet (m_validPositions.begin (), m_validPositions.end ());
+  m_validPositionNeighbours.assign (m_validPositions.size (), 0);
+
+  for (uint32_t i = 0; i < m_validPositions.size (); ++i)
+    {
+      std::pair<double, double> lowerLeftCoord = m_validPositions[i];
+      std::pair<double, double> upperLeft (lowerLeftCoord.first + m_latInterval, lowerLeftCoord.second);
+      std::pair<double, double> upperRight (lowerLeftCoord.first + m_latInterval, lowerLeftCoord.second + m_lonInterval);
+      std::pair<double, double> lowerRight (lowerLeftCoord.first, lowerLeftCoord.second + m_lonInterval);
+
+      m_validPositionNeighbours[i] = (validPositionSet.count (upperLeft)
+                                      && validPositionSet.count (upperRight)
+                                      && validPositionSet.count (lowerRight));
+    }
 }
 
 
@@ -234,27 +390,7 @@ GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
 
       // Test if the three other corners for interpolation are found.
       // If they do not, loop again to find another position.
-
-      std::pair<double, double> testPos;
-
-      // Upper left corner
-      testPos.first = lowerLeftCoord.first + m_latInterval;
-      testPos.second = lowerLeftCoord.second;
-      if (find (m_validPositions.begin (), m_validPositions.end (), testPos) == m_validPositions.end ())
-        {
-          continue;
-        }
-
-      // Upper right corner
-      testPos.second = lowerLeftCoord.second + m_lonInterval;
-      if (find (m_validPositions.begin (), m_validPositions.end (), testPos) == m_validPositions.end ())
-        {
-          continue;
-        }
-
-      // Lower right corner
-      testPos.first = lowerLeftCoord.first;
-      if (find (m_validPositions.begin (), m_validPositions.end (), testPos) == m_validPositions.end ())
+      if (!m_validPositionNeighbours[ind])
         {
           continue;
         }
@@ -272,7 +408,54 @@ GeoCoordinate SatAntennaGainPattern::GetValidRandomPosition () const
 }
 
 
-double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
+uint32_t SatAntennaGainPattern::GetNLatitudes () const
+{
+  return m_latitudes.size ();
+}
+
+
+uint32_t SatAntennaGainPattern::GetNLongitudes () const
+{
+  return m_longitudes.size ();
+}
+
+
+double SatAntennaGainPattern::GetGridAntennaGain_db (uint32_t latIndex, uint32_t lonIndex) const
+{
+  NS_LOG_FUNCTION (this << latIndex << lonIndex);
+
+  if (latIndex >= m_latitudes.size () || lonIndex >= m_longitudes.size ())
+    {
+      NS_FATAL_ERROR ("SatAntennaGainPattern::GetGridAntennaGain_db - grid point out of range: " << latIndex << ", " << lonIndex);
+    }
+
+  return m_gridDb[latIndex * m_longitudes.size () + lonIndex];
+}
+
+
+double SatAntennaGainPattern::GetGridAntennaGain_lin (uint32_t latIndex, uint32_t lonIndex) const
+{
+  NS_LOG_FUNCTION (this << latIndex << lonIndex);
+
+  if (latIndex >= m_latitudes.size () || lonIndex >= m_longitudes.size ())
+    {
+      NS_FATAL_ERROR ("SatAntennaGainPattern::GetGridAntennaGain_lin - grid point out of range: " << latIndex << ", " << lonIndex);
+    }
+
+  return m_gridLin[latIndex * m_longitudes.size () + lonIndex];
+}
+
+
+bool SatAntennaGainPattern::HasSameGrid (Ptr<SatAntennaGainPattern> pattern) const
+{
+  NS_LOG_FUNCTION (this << pattern);
+
+  return m_latitudes == pattern->m_latitudes && m_longitudes == pattern->m_longitudes
+         && m_latInterval == pattern->m_latInterval && m_lonInterval == pattern->m_lonInterval;
+}
+
+
+SatAntennaGainPattern::GridPosition_t SatAntennaGainPattern::GetGridPosition (GeoCoordinate coord) const
 {
   NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
 
@@ -293,16 +476,9 @@ double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
   uint32_t minLatIndex = (uint32_t)(std::floor (std::abs (latitude - m_minLat) / m_latInterval));
   uint32_t minLonIndex = (uint32_t)(std::floor (std::abs (longitude - m_minLon) / m_lonInterval));
 
-  // All the values within the grid box has to be valid! If UT is placed (or
-  // is moving outside) the valid simulation area, the simulation will crash
-  // to a fatal error.
-  if (std::isnan (m_antennaPattern[minLatIndex][minLonIndex])
-      || std::isnan (m_antennaPattern[minLatIndex][minLonIndex + 1])
-      || std::isnan (m_antennaPattern[minLatIndex + 1][minLonIndex])
-      || std::isnan (m_antennaPattern[minLatIndex + 1][minLonIndex + 1]))
-    {
-      NS_FATAL_ERROR (this << ", some value(s) of the interpolated grid point(s) is/are NAN!");
-    }
+  // The maximum latitude and longitude are interpolated in the last grid box
+  minLatIndex = std::min<uint32_t> (minLatIndex, m_latitudes.size () - 2);
+  minLonIndex = std::min<uint32_t> (minLonIndex, m_longitudes.size () - 2);
 
   /**
    * 4-point bilinear interpolation
@@ -310,45 +486,32 @@ double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
    * R(x,y2) = (x2 - x)/(x2 - x1) * Q(x1,y2)) + (x - x1)/(x2 - x1) * Q(x2,y2);
    * R = (y2 - y)/(y2 - y1) * R(x,y1) + (y - y1)/(y2 - y1) * R(x,y2);
    */
+  GridPosition_t pos;
+  pos.m_index = minLatIndex * m_longitudes.size () + minLonIndex;
+  pos.m_lonShare1 = (m_longitudes[minLonIndex + 1] - longitude) / m_lonInterval;
+  pos.m_lonShare2 = (longitude - m_longitudes[minLonIndex]) / m_lonInterval;
+  pos.m_latShare1 = (m_latitudes[minLatIndex + 1] - latitude) / m_latInterval;
+  pos.m_latShare2 = (latitude - m_latitudes[minLatIndex]) / m_latInterval;
+
+  return pos;
+}
 
-  // Longitude direction with latitude minLatIndex
-  double upperLonShare = (m_longitudes[minLonIndex + 1] - longitude) / m_lonInterval;
-  double lowerLonShare = (longitude - m_longitudes[minLonIndex]) / m_lonInterval;
-
-  // Change the gains to linear values , because the interpolation is done in linear domain.
-  double G11 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex][minLonIndex] );
-  double G12 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex][minLonIndex + 1] );
-  double G21 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex + 1][minLonIndex] );
-  double G22 = SatUtils::DbToLinear ( m_antennaPattern[minLatIndex + 1][minLonIndex + 1] );
-
-  // Longitude direction with latitude minLatIndex
-  double valLatLower = upperLonShare * G11 + lowerLonShare * G12;
-
-  // Longitude direction with latitude minLatIndex+1
-  double valLatUpper = upperLonShare * G21 + lowerLonShare * G22;
-
-  // Latitude direction with longitude "longitude"
-  double gain = ((m_latitudes[minLatIndex + 1] - latitude) / m_latInterval) * valLatLower +
-    ((latitude - m_latitudes[minLatIndex]) / m_latInterval) * valLatUpper;
-
-  /*
-  std::cout << "minLonIndex = " << minLonIndex <<
-      ", minLatIndex = " << minLatIndex <<
-      ", m_lonInterval = " << m_lonInterval <<
-      ", m_LatInterval = " << m_latInterval <<
-      ", x1 = " << m_longitudes[minLonIndex] <<
-      ", y1 = " << m_latitudes[minLatIndex] <<
-      ", x2 = " << m_longitudes[minLonIndex+1] <<
-      ", y2 = " << m_latitudes[minLatIndex+1] <<
-      ", G(x1,y1) = " << m_antennaPattern[minLatIndex][minLonIndex] <<
-      ", G(x1,y2) = " << m_antennaPattern[minLatIndex+1][minLonIndex] <<
-      ", G(x2,y1) = " << m_antennaPattern[minLatIndex][minLonIndex+1] <<
-      ", G(x2,y2) = " << m_antennaPattern[minLatIndex+1][minLonIndex+1] <<
-      ", x = " << longitude <<
-      ", y = " << latitude <<
-      ", interpolated gain: " << gain << std::endl;
-   */
-  return gain;
+
+double SatAntennaGainPattern::GetAntennaGain_lin (GeoCoordinate coord) const
+{
+  NS_LOG_FUNCTION (this << coord.GetLatitude () << coord.GetLongitude ());
+
+  GridPosition_t pos = GetGridPosition (coord);
+
+  // All the values within the grid box has to be valid! If UT is placed (or
+  // is moving outside) the valid simulation area, the simulation will crash
+  // to a fatal error.
+  if (!m_validGridBoxes[pos.m_index])
+    {
+      NS_FATAL_ERROR (this << ", some value(s) of the interpolated grid point(s) is/are NAN!");
+    }
+
+  return GetAntennaGain_lin (pos);
 }
 
 
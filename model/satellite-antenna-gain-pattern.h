@@ -26,6 +26,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/object.h"
 #include "geo-coordinate.h"
+#include "ns3/satellite-binary-data-cache.h"
 
 namespace ns3 {
 
@@ -43,11 +44,29 @@ namespace ns3 {
  * as an attribute. This approach is selected to speed up the random UT positioning.
  *
  * Antenna gain value for a given longitude and latitude position is calculated by
- * using 4-point bilinear interpolation.
+ * using 4-point bilinear interpolation. The gain values are converted into linear
+ * format and stored into a contiguous row-major grid in initialization phase.
+ * The grid is stored into a binary cache of the antenna pattern file (see
+ * SatBinaryDataCache), which is used instead of the antenna pattern file when
+ * valid.
  */
 class SatAntennaGainPattern : public Object
 {
 public:
+  /**
+   * \brief Position within the antenna gain pattern grid, i.e. the index
+   * of the lower left grid point of the interpolated grid box and the
+   * interpolation weights of the grid points.
+   */
+  typedef struct
+  {
+    uint32_t m_index;
+    double m_lonShare1;
+    double m_lonShare2;
+    double m_latShare1;
+    double m_latShare2;
+  } GridPosition_t;
+
 
   /**
    * \brief Get the type ID
@@ -81,12 +100,70 @@ public:
    */
   double GetAntennaGain_lin (GeoCoordinate coord) const;
 
+  /**
+   * \brief Calculate the position of a {latitude, longitude} point within the
+   * antenna gain pattern grid.
+   * \param coord Geo coordinate
+   * \return Position within the grid
+   */
+  GridPosition_t GetGridPosition (GeoCoordinate coord) const;
+
+  /**
+   * \brief Calculate the antenna gain value for a position within the grid.
+   * The validity of the grid box is not checked, NaN is returned if some
+   * grid point(s) of the box is/are not valid.
+   * \param pos Position within the grid
+   * \return The gain value in linear format
+   */
+  inline double GetAntennaGain_lin (const GridPosition_t &pos) const
+  {
+    const double *g = m_gridLin + pos.m_index;
+    double valLatLower = pos.m_lonShare1 * g[0] + pos.m_lonShare2 * g[1];
+    double valLatUpper = pos.m_lonShare1 * g[m_longitudes.size ()] + pos.m_lonShare2 * g[m_longitudes.size () + 1];
+    return pos.m_latShare1 * valLatLower + pos.m_latShare2 * valLatUpper;
+  }
+
+  /**
+   * \brief Check whether another antenna gain pattern uses the same grid
+   * \param pattern Antenna gain pattern
+   * \return true if the grids are the same
+   */
+  bool HasSameGrid (Ptr<SatAntennaGainPattern> pattern) const;
+
   /**
    * \brief Get a valid random position under this spot-beam coverage.
    * \return A valid random GeoCoordinate
    */
   GeoCoordinate GetValidRandomPosition () const;
 
+  /**
+   * \brief Get the number of latitudes in the antenna gain pattern grid
+   * \return Number of latitudes
+   */
+  uint32_t GetNLatitudes () const;
+
+  /**
+   * \brief Get the number of longitudes in the antenna gain pattern grid
+   * \return Number of longitudes
+   */
+  uint32_t GetNLongitudes () const;
+
+  /**
+   * \brief Get the antenna gain value of a grid point of the antenna gain pattern
+   * \param latIndex Latitude index of the grid point
+   * \param lonIndex Longitude index of the grid point
+   * \return The gain value in dB, NaN if the grid point is not valid
+   */
+  double GetGridAntennaGain_db (uint32_t latIndex, uint32_t lonIndex) const;
+
+  /**
+   * \brief Get the antenna gain value of a grid point of the antenna gain pattern
+   * \param latIndex Latitude index of the grid point
+   * \param lonIndex Longitude index of the grid point
+   * \return The gain value in linear format, NaN if the grid point is not valid
+   */
+  double GetGridAntennaGain_lin (uint32_t latIndex, uint32_t lonIndex) const;
+
 private:
   /**
    * \brief Read the antenna gain pattern from a file
@@ -95,11 +172,56 @@ private:
   void ReadAntennaPatternFromFile (std::string filePathName);
 
   /**
-   * Container for the antenna pattern from one spot-beam
-   * - Outer vector holds gain values for all latitudes
-   * - Inner vector holds gain values for all longitudes for a certain latitude
+   * \brief Read the antenna gain pattern from a binary cache
+   * \param cache Binary cache of the antenna pattern file
    */
-  std::vector< std::vector <double> > m_antennaPattern;
+  void ReadAntennaPatternFromCache (Ptr<SatBinaryDataCache> cache);
+
+  /**
+   * \brief Store the antenna gain pattern into a binary cache
+   * \param filePathName Path and file name of the antenna pattern file
+   */
+  void StoreAntennaPatternToCache (std::string filePathName);
+
+  /**
+   * \brief Initialize the valid grid boxes and the valid positions from
+   * the antenna gain pattern grids
+   */
+  void InitializeValidity ();
+
+  /**
+   * Container for the antenna pattern from one spot-beam in linear format.
+   * Row-major grid, i.e. gain value for latitude index i and longitude index j
+   * is at index i * number of longitudes + j. NaN for the non-valid grid points.
+   */
+  std::vector<double> m_antennaPatternLin;
+
+  /**
+   * Container for the antenna pattern from one spot-beam in dB, same
+   * structure as in m_antennaPatternLin.
+   */
+  std::vector<double> m_antennaPatternDb;
+
+  /**
+   * Antenna pattern in dB, either m_antennaPatternDb or the binary cache
+   */
+  const double *m_gridDb;
+
+  /**
+   * Antenna pattern in linear format, either m_antennaPatternLin or the binary cache
+   */
+  const double *m_gridLin;
+
+  /**
+   * Binary cache holding the antenna pattern, if in use
+   */
+  Ptr<SatBinaryDataCache> m_cache;
+
+  /**
+   * Validity of the grid boxes indexed by the lower left grid point of the box.
+   * Grid box is valid, if all its four grid points are valid.
+   */
+  std::vector<uint8_t> m_validGridBoxes;
 
   /**
    * Container for valid positions
@@ -108,6 +230,12 @@ private:
    */
   std::vector< std::pair<double, double> > m_validPositions;
 
+  /**
+   * Flags of the valid positions, whose upper left, upper right and lower
+   * right neighbour positions are valid as well, indexed as m_validPositions.
+   */
+  std::vector<uint8_t> m_validPositionNeighbours;
+
   /**
    * Minimum acceptable antenna gain for a serving spot-beam. Used
    * for beam selection.
@@ -17,6 +17,7 @@
  *
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
+#include "ns3/enum.h"
 #include "satellite-base-fader.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatBaseFader");
@@ -29,11 +30,18 @@ TypeId
 SatBaseFader::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatBaseFader")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("OscillatorEvaluation",
+                   "Evaluation mode of the fading oscillators. Deterministic mode gives bit-exactly the same fading as the oscillator objects.",
+                   EnumValue (SatFadingOscillatorBank::EVALUATION_DETERMINISTIC),
+                   MakeEnumAccessor (&SatBaseFader::m_oscillatorEvaluationMode),
+                   MakeEnumChecker (SatFadingOscillatorBank::EVALUATION_DETERMINISTIC, "Deterministic",
+                                    SatFadingOscillatorBank::EVALUATION_VECTORIZED, "Vectorized"));
   return tid;
 }
 
 SatBaseFader::SatBaseFader ()
+  : m_oscillatorEvaluationMode (SatFadingOscillatorBank::EVALUATION_DETERMINISTIC)
 {
   NS_LOG_FUNCTION (this);
 }
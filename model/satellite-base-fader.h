@@ -24,6 +24,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "satellite-fading-oscillator-bank.h"
 
 namespace ns3 {
 
@@ -74,7 +75,21 @@ public:
    */
   virtual void UpdateParameters (uint32_t newSet, uint32_t newState) = 0;
 
+protected:
+  /**
+   * \brief Get the evaluation mode of the fading oscillators
+   * \return evaluation mode
+   */
+  inline SatFadingOscillatorBank::EvaluationMode_t GetOscillatorEvaluationMode () const
+  {
+    return m_oscillatorEvaluationMode;
+  }
+
 private:
+  /**
+   * \brief Evaluation mode of the fading oscillators
+   */
+  SatFadingOscillatorBank::EvaluationMode_t m_oscillatorEvaluationMode;
 };
 
 } // namespace ns3
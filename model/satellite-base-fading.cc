@@ -17,6 +17,7 @@
  *
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
+#include "ns3/boolean.h"
 #include "satellite-base-fading.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatBaseFading");
@@ -29,11 +30,26 @@ TypeId
 SatBaseFading::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatBaseFading")
-    .SetParent<Object> ();
+    .SetParent<Object> ()
+    .AddAttribute ("EnableCoherenceCache",
+                   "Reuse the fading value of a MAC address and channel type within a coherence interval.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatBaseFading::m_enableCoherenceCache),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CoherenceInterval",
+                   "Coherence interval of the cached fading values.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&SatBaseFading::m_coherenceInterval),
+                   MakeTimeChecker (Seconds (0)));
   return tid;
 }
 
 SatBaseFading::SatBaseFading ()
+  : m_enableCoherenceCache (false),
+    m_coherenceInterval (Seconds (0)),
+    m_coherenceCache (),
+    m_coherenceCacheHits (0),
+    m_coherenceCacheMisses (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -43,12 +59,58 @@ SatBaseFading::~SatBaseFading ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+SatBaseFading::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_enableCoherenceCache)
+    {
+      NS_LOG_INFO ("SatBaseFading::DoDispose - coherence cache hits: " << m_coherenceCacheHits <<
+                   ", misses: " << m_coherenceCacheMisses <<
+                   ", entries: " << m_coherenceCache.size ());
+    }
+
+  m_coherenceCache.clear ();
+
+  Object::DoDispose ();
+}
+
 double
 SatBaseFading::GetFading (Address macAddress, SatEnums::ChannelType_t channelType)
 {
   NS_LOG_FUNCTION (this);
 
-  return DoGetFading (macAddress,channelType);
+  if (!m_enableCoherenceCache)
+    {
+      return DoGetFading (macAddress,channelType);
+    }
+
+  // simulation time quantized to the coherence interval
+  int64_t interval = Now ().GetTimeStep ();
+
+  if (m_coherenceInterval.IsStrictlyPositive ())
+    {
+      interval /= m_coherenceInterval.GetTimeStep ();
+    }
+
+  std::pair<CoherenceCache_t::iterator, bool> result =
+    m_coherenceCache.insert (std::make_pair (std::make_pair (macAddress, channelType), CoherenceCacheEntry_t ()));
+
+  CoherenceCacheEntry_t& entry = result.first->second;
+
+  if (!result.second && entry.m_interval == interval)
+    {
+      m_coherenceCacheHits++;
+      return entry.m_fadingValue;
+    }
+
+  m_coherenceCacheMisses++;
+
+  entry.m_interval = interval;
+  entry.m_fadingValue = DoGetFading (macAddress,channelType);
+
+  return entry.m_fadingValue;
 }
 
 } // namespace ns3
@@ -20,7 +20,10 @@
 #ifndef SATELLITE_BASE_FADING_H
 #define SATELLITE_BASE_FADING_H
 
+#include <map>
+#include <utility>
 #include "ns3/object.h"
+#include "ns3/nstime.h"
 #include "ns3/uinteger.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -68,13 +71,34 @@ public:
   static TypeId GetTypeId (void);
 
   /**
-   * \brief Function for getting the fading value.
+   * \brief Function for getting the fading value. If the coherence cache
+   * is enabled, the fading value is calculated once per MAC address and
+   * channel type within a coherence interval.
    * \param macAddress
    * \param channelType channel type
    * \return fading value
    */
   double GetFading (Address macAddress, SatEnums::ChannelType_t channelType);
 
+  /**
+   * \brief Get the number of fading values served from the coherence cache
+   * \return number of cache hits
+   */
+  inline uint64_t GetNCoherenceCacheHits () const
+  {
+    return m_coherenceCacheHits;
+  }
+
+  /**
+   * \brief Get the number of fading values calculated with the coherence
+   * cache enabled
+   * \return number of cache misses
+   */
+  inline uint64_t GetNCoherenceCacheMisses () const
+  {
+    return m_coherenceCacheMisses;
+  }
+
   /**
    * \brief Function for getting the fading value. This is an abstract method,
    * thus it is implemented in the inherited fading classes.
@@ -84,7 +108,53 @@ public:
    */
   virtual double DoGetFading (Address macAddress, SatEnums::ChannelType_t channelType) = 0;
 
+protected:
+  /**
+   * \brief Do needed dispose actions. The coherence cache hits and misses
+   * are logged, if the coherence cache is enabled.
+   */
+  virtual void DoDispose ();
+
 private:
+  /**
+   * \brief Cached fading value and the coherence interval it was calculated in
+   */
+  typedef struct
+  {
+    int64_t m_interval;
+    double m_fadingValue;
+  } CoherenceCacheEntry_t;
+
+  /**
+   * \brief Define type for the coherence cache keyed by MAC address and channel type
+   */
+  typedef std::map<std::pair<Address, SatEnums::ChannelType_t>, CoherenceCacheEntry_t> CoherenceCache_t;
+
+  /**
+   * \brief Is the coherence cache enabled
+   */
+  bool m_enableCoherenceCache;
+
+  /**
+   * \brief Coherence interval of the cached fading values. With zero
+   * interval only the fading values calculated at the same time are reused.
+   */
+  Time m_coherenceInterval;
+
+  /**
+   * \brief Latest fading value of each MAC address and channel type
+   */
+  CoherenceCache_t m_coherenceCache;
+
+  /**
+   * \brief Number of coherence cache hits
+   */
+  uint64_t m_coherenceCacheHits;
+
+  /**
+   * \brief Number of coherence cache misses
+   */
+  uint64_t m_coherenceCacheMisses;
 };
 
 } // namespace ns3
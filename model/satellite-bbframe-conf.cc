@@ -20,6 +20,8 @@
 
 
 #include <iostream>
+#include <algorithm>
+#include <functional>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -147,7 +149,8 @@ SatBbFrameConf::SatBbFrameConf ()
     m_waveforms (),
     m_bbFrameUsageMode (NORMAL_FRAMES),
     m_mostRobustShortFrameModcod (SatEnums::SAT_NONVALID_MODCOD),
-    m_mostRobustNormalFrameModcod (SatEnums::SAT_NONVALID_MODCOD)
+    m_mostRobustNormalFrameModcod (SatEnums::SAT_NONVALID_MODCOD),
+    m_cnoRequirementTables ()
 {
   NS_LOG_FUNCTION (this);
   NS_FATAL_ERROR ("Default constructor not supported!!!");
@@ -171,7 +174,8 @@ SatBbFrameConf::SatBbFrameConf (double symbolRate)
     m_waveforms (),
     m_bbFrameUsageMode (NORMAL_FRAMES),
     m_mostRobustShortFrameModcod (SatEnums::SAT_NONVALID_MODCOD),
-    m_mostRobustNormalFrameModcod (SatEnums::SAT_NONVALID_MODCOD)
+    m_mostRobustNormalFrameModcod (SatEnums::SAT_NONVALID_MODCOD),
+    m_cnoRequirementTables ()
 {
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
@@ -289,7 +293,8 @@ SatBbFrameConf::GetTypeId (void)
     .AddAttribute ( "AcmEnabled",
                     "Enable ACM",
                     BooleanValue (false),
-                    MakeBooleanAccessor (&SatBbFrameConf::m_acmEnabled),
+                    MakeBooleanAccessor (&SatBbFrameConf::SetAcmEnabled,
+                                         &SatBbFrameConf::IsAcmEnabled),
                     MakeBooleanChecker ())
     .AddAttribute ( "DefaultModCod",
                     "Default MODCOD",
@@ -379,6 +384,54 @@ SatBbFrameConf::InitializeCNoRequirements ( Ptr<SatLinkResultsDvbS2> linkResults
       */
       it->second->SetCNoRequirement (SatUtils::DbToLinear (esnoRequirementDb) * m_symbolRate);
     }
+
+  m_cnoRequirementTables.clear ();
+}
+
+void
+SatBbFrameConf::SetAcmEnabled (bool enabled)
+{
+  NS_LOG_FUNCTION (this << enabled);
+
+  m_acmEnabled = enabled;
+  m_cnoRequirementTables.clear ();
+}
+
+const SatBbFrameConf::CNoRequirementTable_t&
+SatBbFrameConf::GetCNoRequirementTable (SatEnums::SatBbFrameType_t frameType) const
+{
+  NS_LOG_FUNCTION (this << frameType);
+
+  std::pair<std::map<SatEnums::SatBbFrameType_t, CNoRequirementTable_t>::iterator, bool> result =
+    m_cnoRequirementTables.insert (std::make_pair (frameType, CNoRequirementTable_t ()));
+
+  CNoRequirementTable_t& table = result.first->second;
+
+  if (result.second)
+    {
+      // Walk the waveforms in the same order as the linear search and keep
+      // only the MODCODs with requirement lower than any preceding MODCOD
+      double lowestReq = std::numeric_limits<double>::infinity ();
+
+      for ( waveformMap_t::const_reverse_iterator rit = m_waveforms.rbegin ();
+            rit != m_waveforms.rend ();
+            ++rit )
+        {
+          if (rit->second->GetBbFrameType () == frameType)
+            {
+              double cnoReq = rit->second->GetCNoRequirement ();
+
+              if (cnoReq < lowestReq)
+                {
+                  lowestReq = cnoReq;
+                  table.m_cnoRequirements.push_back (cnoReq);
+                  table.m_modcods.push_back (rit->second->GetModcod ());
+                }
+            }
+        }
+    }
+
+  return table;
 }
 
 void
@@ -495,21 +548,20 @@ SatBbFrameConf::GetBestModcod (double cNo, SatEnums::SatBbFrameType_t frameType)
       return m_defaultModCod;
     }
 
-  // Return the waveform with best spectral efficiency
-  for ( waveformMap_t::const_reverse_iterator rit = m_waveforms.rbegin ();
-        rit != m_waveforms.rend ();
-        ++rit )
+  // Return the waveform with best spectral efficiency, i.e. the first
+  // MODCOD in the table with requirement not exceeding the C/No
+  const CNoRequirementTable_t& table = GetCNoRequirementTable (frameType);
+
+  std::vector<double>::const_iterator it = std::lower_bound (table.m_cnoRequirements.begin (),
+                                                             table.m_cnoRequirements.end (),
+                                                             cNo,
+                                                             std::greater<double> ());
+
+  if (it != table.m_cnoRequirements.end () && *it <= cNo)
     {
-      if (rit->second->GetBbFrameType () == frameType)
-        {
-          double cnoReq = rit->second->GetCNoRequirement ();
-          // The first waveform over the threshold
-          if (cnoReq <= cNo)
-            {
-              return rit->second->GetModcod ();
-            }
-        }
+      return table.m_modcods[it - table.m_cnoRequirements.begin ()];
     }
+
   return m_defaultModCod;
 }
 
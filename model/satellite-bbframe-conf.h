@@ -22,6 +22,7 @@
 #define SATELLITE_BBFRAME_CONF_H
 
 #include <map>
+#include <vector>
 #include <ns3/ptr.h>
 #include <ns3/object.h>
 #include <ns3/simple-ref-count.h>
@@ -257,6 +258,22 @@ public:
    */
   SatEnums::SatModcod_t GetBestModcod (double cNo, SatEnums::SatBbFrameType_t frameType) const;
 
+  /**
+   * \brief Check if ACM is enabled.
+   * \return Is ACM enabled
+   */
+  inline bool IsAcmEnabled () const
+  {
+    return m_acmEnabled;
+  }
+
+  /**
+   * \brief Enable or disable ACM. The precomputed C/No requirement tables
+   * are invalidated.
+   * \param enabled Is ACM enabled
+   */
+  void SetAcmEnabled (bool enabled);
+
   /**
    * Get the default MODCOD
    * \return SatModcod_t The default MODCOD
@@ -276,6 +293,26 @@ public:
   void DumpWaveforms () const;
 
 private:
+  /**
+   * \brief C/No requirement table of one BB frame type. Only the MODCODs
+   * which can be selected as the best MODCOD are included, in the same
+   * (descending) order as in the waveform map, thus the requirements are
+   * strictly descending.
+   */
+  typedef struct
+  {
+    std::vector<double> m_cnoRequirements;
+    std::vector<SatEnums::SatModcod_t> m_modcods;
+  } CNoRequirementTable_t;
+
+  /**
+   * \brief Get the C/No requirement table of a BB frame type. The table is
+   * created if it does not exist yet.
+   * \param frameType BB frame type
+   * \return C/No requirement table
+   */
+  const CNoRequirementTable_t& GetCNoRequirementTable (SatEnums::SatBbFrameType_t frameType) const;
+
   /**
    * \brief Calculate the BBrame higher layer payload in bits.
    * \param modcod Used MODCOD in the BBFrame
@@ -383,6 +420,12 @@ private:
    * The most robust MODCOD for long frame.
    */
   SatEnums::SatModcod_t m_mostRobustNormalFrameModcod;
+
+  /**
+   * Precomputed C/No requirement tables used in the MODCOD selection. The
+   * tables are cleared when the C/No requirements or the ACM flag change.
+   */
+  mutable std::map<SatEnums::SatBbFrameType_t, CNoRequirementTable_t> m_cnoRequirementTables;
 };
 
 } // namespace ns3
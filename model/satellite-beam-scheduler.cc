@@ -243,6 +243,7 @@ SatBeamScheduler::SatBeamScheduler ()
     m_superframeSeq (0),
     m_superFrameCounter (0),
     m_txCallback (0),
+    m_requestedKbpsSum (0),
     m_cnoEstimatorMode (SatCnoEstimator::LAST),
     m_maxBbFrameSize (0),
     m_controlSlotsEnabled (false)
@@ -260,6 +261,7 @@ SatBeamScheduler::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_txCallback.Nullify ();
+  m_scheduleCallback.Nullify ();
   Object::DoDispose ();
 }
 
@@ -333,7 +335,7 @@ SatBeamScheduler::Initialize (uint32_t beamId, SatBeamScheduler::SendCtrlMsgCall
 }
 
 uint32_t
-SatBeamScheduler::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf)
+SatBeamScheduler::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t& assignmentId)
 {
   NS_LOG_FUNCTION (this << utId);
 
@@ -364,6 +366,11 @@ SatBeamScheduler::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf)
       allocReq.m_cno = NAN;
       allocReq.m_address = utId;
 
+      // UTs are indexed densely in the order they are added to the scheduler,
+      // the index is used also as the assignment ID of the UT in TBTPs
+      allocReq.m_utIndex = m_utRequestInfos.size ();
+      assignmentId = allocReq.m_utIndex;
+
       m_utRequestInfos.push_back (std::make_pair (utId, allocReq));
     }
   else
@@ -427,22 +434,112 @@ SatBeamScheduler::CreateCnoEstimator ()
   return estimator;
 }
 
+void
+SatBeamScheduler::SetScheduleCallback (SatBeamScheduler::ScheduleCallback cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+
+  m_scheduleCallback = cb;
+}
+
+void
+SatBeamScheduler::UseAllocationRandomVariable ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // UTs, carriers and RCs are shuffled with a random variable of the beam instead of the
+  // random generator of the standard library shared by all the beams, so that the
+  // allocation of the beam does not depend on whether the beams are scheduled concurrently
+  m_allocationRandom = CreateObject<UniformRandomVariable> ();
+  m_superframeAllocator->SetRandomVariable (m_allocationRandom);
+}
+
+int64_t
+SatBeamScheduler::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+
+  m_raChRandomIndex->SetStream (stream);
+
+  if (m_allocationRandom)
+    {
+      m_allocationRandom->SetStream (stream + 1);
+    }
+
+  return 2;
+}
+
 void
 SatBeamScheduler::Schedule ()
 {
   NS_LOG_FUNCTION (this);
 
-  uint32_t requestedKbpsSum (0);
-  uint32_t offeredKbpsSum (0);
+  if ( m_scheduleCallback.IsNull () )
+    {
+      PrepareScheduling ();
+      AllocateResources ();
+      CompleteScheduling ();
+    }
+  else
+    {
+      m_scheduleCallback (this);
+    }
+
+  // re-schedule next TBTP sending (call of this function)
+  Simulator::Schedule ( m_superframeSeq->GetDuration (SatConstVariables::SUPERFRAME_SEQUENCE), &SatBeamScheduler::Schedule, this);
+}
+
+void
+SatBeamScheduler::PrepareScheduling ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_requestedKbpsSum = 0;
+  m_allocReqs.clear ();
+
+  // the waveform configuration is shared by the beams, so its tables are built here
+  // in the simulator thread instead of during the allocation
+  m_superframeAllocator->PrepareWaveformSelection ();
 
   // check that there is UTs to schedule
   if ( m_utInfos.size () > 0 )
     {
-      requestedKbpsSum = UpdateDamaEntriesWithReqs ();
+      m_requestedKbpsSum = UpdateDamaEntriesWithReqs ();
 
-      DoPreResourceAllocation ();
+      // sort UT requests according to C/N0 of the UTs
+      m_utRequestInfos.sort (CnoCompare (m_utInfos));
+
+      for (UtReqInfoContainer_t::iterator it = m_utRequestInfos.begin (); it != m_utRequestInfos.end (); it++)
+        {
+          m_allocReqs.push_back (&(it->second));
+        }
+    }
+}
+
+void
+SatBeamScheduler::AllocateResources ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if ( m_utInfos.size () > 0 )
+    {
+      // request capacity for UTs from frame allocator
+      m_superframeAllocator->PreAllocateSymbols (m_allocReqs);
 
       // generate time slots
+      m_superframeAllocator->ComputeTimeSlots ();
+    }
+}
+
+void
+SatBeamScheduler::CompleteScheduling ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t offeredKbpsSum (0);
+
+  if ( m_utInfos.size () > 0 )
+    {
       Ptr<SatTbtpMessage> firstTbtp = CreateObject<SatTbtpMessage> (SatConstVariables::SUPERFRAME_SEQUENCE);
       firstTbtp->SetSuperframeCounter (m_superFrameCounter++);
 
@@ -455,7 +552,7 @@ SatBeamScheduler::Schedule ()
       SatFrameAllocator::UtAllocInfoContainer_t utAllocs;
 
       // Add DA slots to TBTP(s)
-      m_superframeAllocator->GenerateTimeSlots (tbtps, m_maxBbFrameSize, utAllocs, m_waveformTrace, m_frameUtLoadTrace, m_frameLoadTrace);
+      m_superframeAllocator->WriteTimeSlots (tbtps, m_maxBbFrameSize, utAllocs, m_waveformTrace, m_frameUtLoadTrace, m_frameLoadTrace);
 
       // update VBDC counter of the UT/RCs
       offeredKbpsSum += UpdateDamaEntriesWithAllocs (utAllocs);
@@ -474,15 +571,12 @@ SatBeamScheduler::Schedule ()
       NS_LOG_INFO ("TBTP sent at: " << Simulator::Now ().GetSeconds ());
     }
 
-  uint32_t usableCapacity = std::min (offeredKbpsSum, requestedKbpsSum);
-  uint32_t unmetCapacity = requestedKbpsSum - usableCapacity;
-  uint32_t exceedingCapacity = (uint32_t)(std::max (((double)(offeredKbpsSum) - requestedKbpsSum), 0.0) + 0.5);
+  uint32_t usableCapacity = std::min (offeredKbpsSum, m_requestedKbpsSum);
+  uint32_t unmetCapacity = m_requestedKbpsSum - usableCapacity;
+  uint32_t exceedingCapacity = (uint32_t)(std::max (((double)(offeredKbpsSum) - m_requestedKbpsSum), 0.0) + 0.5);
   m_usableCapacityTrace (usableCapacity);
   m_unmetCapacityTrace (unmetCapacity);
   m_exceedingCapacityTrace (exceedingCapacity);
-
-  // re-schedule next TBTP sending (call of this function)
-  Simulator::Schedule ( m_superframeSeq->GetDuration (SatConstVariables::SUPERFRAME_SEQUENCE), &SatBeamScheduler::Schedule, this);
 }
 
 void
@@ -606,27 +700,6 @@ SatBeamScheduler::UpdateDamaEntriesWithReqs ()
   return requestedCraRbdcKbps;
 }
 
-void SatBeamScheduler::DoPreResourceAllocation ()
-{
-  NS_LOG_FUNCTION (this);
-
-  if ( m_utInfos.size () > 0 )
-    {
-      // sort UT requests according to C/N0 of the UTs
-      m_utRequestInfos.sort (CnoCompare (m_utInfos));
-
-      SatFrameAllocator::SatFrameAllocContainer_t allocReqs;
-
-      for (UtReqInfoContainer_t::iterator it = m_utRequestInfos.begin (); it != m_utRequestInfos.end (); it++)
-        {
-          allocReqs.push_back (&(it->second));
-        }
-
-      // request capacity for UTs from frame allocator
-      m_superframeAllocator->PreAllocateSymbols (allocReqs);
-    }
-}
-
 uint32_t
 SatBeamScheduler::UpdateDamaEntriesWithAllocs (SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer)
 {
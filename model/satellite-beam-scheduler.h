@@ -62,6 +62,15 @@ class SatDamaEntry;
  *
  *    One scheduler per spot-beam is created and utilized.
  *
+ *    The scheduling is done in three phases: PrepareScheduling, AllocateResources and
+ *    CompleteScheduling. By default the beam scheduler runs the phases by itself. When
+ *    the scheduling callback is set by SetScheduleCallback, the NCC runs the phases of all
+ *    the beams due at the same time instead, and the resource allocation phases of the
+ *    beams can be run concurrently. By default UTs, carriers and RCs are shuffled with
+ *    the random generator of the standard library. After UseAllocationRandomVariable
+ *    they are shuffled with a random variable of the beam instead, so the allocations
+ *    do not depend on the number of the scheduling threads.
+ *
  */
 class SatBeamScheduler : public Object
 {
@@ -101,6 +110,11 @@ public:
    */
   typedef Callback<void, uint32_t, Ptr<SatTbtpMessage> > TbtpAddCallback;
 
+  /**
+   * \param scheduler Beam scheduler, which scheduling is due
+   */
+  typedef Callback<void, Ptr<SatBeamScheduler> > ScheduleCallback;
+
   /**
    * \param beamId ID of the beam which for callback is set
    * \param cb callback to invoke whenever a TBTP is ready for sending and must
@@ -115,9 +129,55 @@ public:
    *
    * \param utId ID (mac address) of the UT to be added
    * \param llsConf Lower layer service configuration for the UT.
+   * \param assignmentId Variable to store the TBTP assignment ID of the added UT
    * \return Index of the RA channel allocated to added UT
    */
-  uint32_t AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf);
+  uint32_t AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t& assignmentId);
+
+  /**
+   * Set callback to invoke, when the scheduling of the beam is due. The callback
+   * is responsible to run the scheduling phases PrepareScheduling, AllocateResources
+   * and CompleteScheduling.
+   *
+   * \param cb callback to invoke, when the scheduling is due
+   */
+  void SetScheduleCallback (SatBeamScheduler::ScheduleCallback cb);
+
+  /**
+   * Shuffle UTs, carriers and RCs in the resource allocation with a random variable
+   * of the beam instead of the random generator of the standard library shared by
+   * all the beams. Required, when the resource allocations of the beams are run
+   * concurrently. Shall be called after Initialize.
+   */
+  void UseAllocationRandomVariable ();
+
+  /**
+   * Assign fixed random variable streams to the random variables of the beam
+   * scheduler. Shall be called after Initialize.
+   *
+   * \param stream First stream index to use
+   * \return Number of stream indices assigned
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * Update DAMA entries with received requests and prepare the allocation
+   * requests of the UTs (first phase of the scheduling).
+   */
+  void PrepareScheduling ();
+
+  /**
+   * Allocate resources of the superframe to the UTs according to the prepared
+   * requests (second phase of the scheduling). The method neither creates objects
+   * nor calls the simulator, so it can be called in other than the simulator thread.
+   */
+  void AllocateResources ();
+
+  /**
+   * Generate and send TBTPs of the allocated resources and update DAMA entries
+   * with the allocations (last phase of the scheduling).
+   */
+  void CompleteScheduling ();
 
   /**
    * Update UT C/N0 info with the latest value.
@@ -380,11 +440,33 @@ private:
    */
   UtReqInfoContainer_t  m_utRequestInfos;
 
+  /**
+   * Allocation requests of the UTs prepared for the current scheduling.
+   */
+  SatFrameAllocator::SatFrameAllocContainer_t  m_allocReqs;
+
+  /**
+   * Sum of the CRA and RBDC rates requested for the current scheduling.
+   */
+  uint32_t  m_requestedKbpsSum;
+
+  /**
+   * Callback to invoke, when the scheduling is due, NULL when the beam scheduler
+   * runs the scheduling by itself.
+   */
+  SatBeamScheduler::ScheduleCallback  m_scheduleCallback;
+
   /**
    * Random variable stream to select RA channel for a UT.
    */
   Ptr<RandomVariableStream> m_raChRandomIndex;
 
+  /**
+   * Random variable stream to shuffle UTs, carriers and RCs in the resource allocation,
+   * NULL if the random generator of the standard library is used.
+   */
+  Ptr<UniformRandomVariable> m_allocationRandom;
+
   /**
    * Mode used for C/N0 estimator.
    */
@@ -486,11 +568,6 @@ private:
    */
   uint32_t UpdateDamaEntriesWithAllocs (SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer);
 
-  /**
-   * Do pre-allocation of the symbols per UT/RC, before time slot generation.
-   */
-  void DoPreResourceAllocation ();
-
   /**
    * Add RA channel information to TBTP(s).
    * \param tbtpContainer Reference to container including TBTPs already and to be added.
@@ -34,6 +34,7 @@
 #include "satellite-mac-tag.h"
 #include "ns3/singleton.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "satellite-rx-power-output-trace-container.h"
 #include "satellite-rx-power-input-trace-container.h"
 #include "satellite-fading-output-trace-container.h"
@@ -63,9 +64,30 @@ SatChannel::SatChannel ()
      * configurations. If using input Rx trace, there is no need to enable e.g. Markov
      * fading, nor antenna patterns.
      */
+    m_rxPowerTraceAddress (),
+    m_rxPowerTrace (),
     m_enableRxPowerOutputTrace (false),
     m_enableFadingOutputTrace (false),
-    m_enableExternalFadingInputTrace (false)
+    m_enableExternalFadingInputTrace (false),
+    m_enableSpatialCulling (false),
+    m_spatialCullingThresholdDb (-40.0),
+    m_enableCulledRxPower (false),
+    m_antennaGainPatterns (),
+    m_enableBatchedRx (false),
+    m_rxBatchDelay (),
+    m_rxBatchContext (0),
+    m_rxBatchReceivers (),
+    m_enableLinkBudgetCache (false),
+    m_linkBudgets (),
+    m_linkBudgetMobilities (),
+    m_linkBudgetCacheHits (0),
+    m_linkBudgetCacheMisses (0),
+    m_scheduledRxCount (0),
+    m_scheduledRxEventCount (0),
+    m_rxParamsCopyCount (0),
+    m_culledRxCount (0),
+    m_culledRxPower_W (0.0),
+    m_culledRxTrace ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -79,8 +101,46 @@ void
 SatChannel::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+
+  if (m_enableSpatialCulling)
+    {
+      NS_LOG_INFO ("SatChannel::DoDispose - channel: " << SatEnums::GetChannelTypeName (m_channelType) <<
+                   ", scheduled receptions: " << m_scheduledRxCount <<
+                   ", culled receptions: " << m_culledRxCount <<
+                   ", culled Rx power: " << m_culledRxPower_W << " W" <<
+                   (m_enableCulledRxPower ? "" : " (not calculated)"));
+    }
+
+  if (m_enableBatchedRx)
+    {
+      NS_LOG_INFO ("SatChannel::DoDispose - channel: " << SatEnums::GetChannelTypeName (m_channelType) <<
+                   ", scheduled receptions: " << m_scheduledRxCount <<
+                   ", scheduled reception events: " << m_scheduledRxEventCount <<
+                   ", signal parameter copies: " << m_rxParamsCopyCount);
+    }
+
+  if (m_enableLinkBudgetCache)
+    {
+      NS_LOG_INFO ("SatChannel::DoDispose - channel: " << SatEnums::GetChannelTypeName (m_channelType) <<
+                   ", link budget cache hits: " << m_linkBudgetCacheHits <<
+                   ", misses: " << m_linkBudgetCacheMisses <<
+                   ", entries: " << m_linkBudgets.size () <<
+                   ", memory: " << GetLinkBudgetCacheMemory () << " bytes");
+    }
+
+  for (std::map<const MobilityModel*, Ptr<SatMobilityModel> >::iterator it = m_linkBudgetMobilities.begin ();
+       it != m_linkBudgetMobilities.end ();
+       ++it)
+    {
+      it->second->TraceDisconnectWithoutContext ("SatCourseChange", MakeCallback (&SatChannel::LinkBudgetMobilityChanged, this));
+    }
+
+  m_linkBudgetMobilities.clear ();
+  m_linkBudgets.clear ();
+  m_rxPowerTrace = 0;
   m_phyRxContainer.clear ();
   m_propagationDelay = 0;
+  m_antennaGainPatterns = 0;
   Channel::DoDispose ();
 }
 
@@ -118,6 +178,35 @@ SatChannel::GetTypeId (void)
                    MakeEnumChecker (SatChannel::ONLY_DEST_NODE, "OnlyDestNode",
                                     SatChannel::ONLY_DEST_BEAM, "OnlyDestBeam",
                                     SatChannel::ALL_BEAMS, "AllBeams"))
+    .AddAttribute ( "EnableBatchedRx",
+                    "Start the consecutive receptions of a transmission with identical propagation delay and node context by a single event.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableBatchedRx),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "EnableSpatialCulling",
+                    "Enable culling of the user link receivers in beams weakly coupled to the transmitting beam (AllBeams forwarding mode).",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableSpatialCulling),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "SpatialCullingThresholdDb",
+                    "Beam coupling relative to the co-beam level below which the receivers are culled.",
+                    DoubleValue (-40.0),
+                    MakeDoubleAccessor (&SatChannel::m_spatialCullingThresholdDb),
+                    MakeDoubleChecker<double> (-200.0, 0.0))
+    .AddAttribute ( "EnableCulledRxPower",
+                    "Calculate the Rx powers of the culled receptions for the CulledRx trace source and the culled Rx power counter.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableCulledRxPower),
+                    MakeBooleanChecker ())
+    .AddAttribute ( "EnableLinkBudgetCache",
+                    "Cache the antenna gains and free space loss of the transmitter and receiver pairs.",
+                    BooleanValue (false),
+                    MakeBooleanAccessor (&SatChannel::m_enableLinkBudgetCache),
+                    MakeBooleanChecker ())
+    .AddTraceSource ("CulledRx",
+                     "A reception culled by the spatial culling with its Rx power without fading, traced only with EnableCulledRxPower enabled",
+                     MakeTraceSourceAccessor (&SatChannel::m_culledRxTrace),
+                     "ns3::SatChannel::CulledRxCallback")
   ;
   return tid;
 }
@@ -181,8 +270,8 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
                   case SatEnums::RETURN_FEEDER_CH:
                     {
                       // Go through the packets and check their destination address by peeking the MAC tag
-                      SatSignalParameters::PacketsInBurst_t::const_iterator it = txParams->m_packetsInBurst.begin ();
-                      for (; it != txParams->m_packetsInBurst.end (); ++it )
+                      SatSignalParameters::PacketsInBurst_t::const_iterator it = txParams->GetPackets ().begin ();
+                      for (; it != txParams->GetPackets ().end (); ++it )
                         {
                           SatMacTag macTag;
                           bool mSuccess = (*it)->PeekPacketTag (macTag);
@@ -242,11 +331,43 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
     */
     case SatChannel::ALL_BEAMS:
       {
-        for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
-             rxPhyIterator != m_phyRxContainer.end ();
-             ++rxPhyIterator)
+        if (m_enableSpatialCulling)
           {
-            ScheduleRx (txParams, *rxPhyIterator);
+            double threshold = SatUtils::DbToLinear (m_spatialCullingThresholdDb);
+
+            for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
+                 rxPhyIterator != m_phyRxContainer.end ();
+                 ++rxPhyIterator)
+              {
+                double coupling = GetBeamCoupling (txParams, *rxPhyIterator);
+
+                // The interference caused to the receiver is negligible
+                if (coupling < threshold)
+                  {
+                    m_culledRxCount++;
+
+                    // The link budget of the culled reception is calculated only when requested
+                    if (m_enableCulledRxPower)
+                      {
+                        double rxPower_W = CalculateCulledRxPower (txParams, *rxPhyIterator);
+
+                        m_culledRxPower_W += rxPower_W;
+                        m_culledRxTrace (txParams->m_beamId, (*rxPhyIterator)->GetBeamId (), rxPower_W);
+                      }
+                    continue;
+                  }
+
+                ScheduleRx (txParams, *rxPhyIterator);
+              }
+          }
+        else
+          {
+            for (PhyRxContainer::const_iterator rxPhyIterator = m_phyRxContainer.begin ();
+                 rxPhyIterator != m_phyRxContainer.end ();
+                 ++rxPhyIterator)
+              {
+                ScheduleRx (txParams, *rxPhyIterator);
+              }
           }
         break;
       }
@@ -256,6 +377,11 @@ SatChannel::StartTx (Ptr<SatSignalParameters> txParams)
         break;
       }
     }
+
+  if (m_enableBatchedRx)
+    {
+      ScheduleRxBatch (txParams);
+    }
 }
 
 void
@@ -268,9 +394,6 @@ SatChannel::ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> receive
   Ptr<MobilityModel> senderMobility = txParams->m_phyTx->GetMobility ();
   Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
 
-  NS_LOG_INFO ("copying signal parameters " << txParams);
-  Ptr<SatSignalParameters> rxParams = txParams->Copy ();
-
   if (m_propagationDelay)
     {
       delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
@@ -322,7 +445,151 @@ SatChannel::ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> receive
 
   Ptr<NetDevice> netDev = receiver->GetDevice ();
   uint32_t dstNodeId =  netDev->GetNode ()->GetId ();
+
+  m_scheduledRxCount++;
+
+  if (m_enableBatchedRx)
+    {
+      // Only the consecutive receivers are batched, so that the receptions
+      // start in the same order as with one event per receiver
+      if (!m_rxBatchReceivers.empty () && (delay != m_rxBatchDelay || dstNodeId != m_rxBatchContext))
+        {
+          ScheduleRxBatch (txParams);
+        }
+
+      m_rxBatchDelay = delay;
+      m_rxBatchContext = dstNodeId;
+      m_rxBatchReceivers.push_back (receiver);
+      return;
+    }
+
+  NS_LOG_INFO ("copying signal parameters " << txParams);
+  Ptr<SatSignalParameters> rxParams = txParams->Copy ();
+  m_rxParamsCopyCount++;
+
   Simulator::ScheduleWithContext (dstNodeId, delay, &SatChannel::StartRx, this, rxParams, receiver);
+  m_scheduledRxEventCount++;
+}
+
+void
+SatChannel::ScheduleRxBatch (Ptr<SatSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams << m_rxBatchReceivers.size ());
+
+  if (m_rxBatchReceivers.empty ())
+    {
+      return;
+    }
+
+  NS_LOG_INFO ("copying signal parameters " << txParams << " for " << m_rxBatchReceivers.size () << " receivers");
+  Ptr<SatSignalParameters> rxParams = txParams->Copy ();
+  m_rxParamsCopyCount++;
+
+  if (m_rxBatchReceivers.size () == 1)
+    {
+      Simulator::ScheduleWithContext (m_rxBatchContext, m_rxBatchDelay, &SatChannel::StartRx, this, rxParams, m_rxBatchReceivers.front ());
+    }
+  else
+    {
+      Simulator::ScheduleWithContext (m_rxBatchContext, m_rxBatchDelay, &SatChannel::StartRxBatch, this, rxParams, m_rxBatchReceivers);
+    }
+
+  m_scheduledRxEventCount++;
+  m_rxBatchReceivers.clear ();
+}
+
+void
+SatChannel::StartRxBatch (Ptr<SatSignalParameters> rxParams, std::vector<Ptr<SatPhyRx> > receivers)
+{
+  NS_LOG_FUNCTION (this << rxParams << receivers.size ());
+
+  Ptr<SatSignalParameters> params;
+
+  for (uint32_t i = 0; i < receivers.size (); ++i)
+    {
+      if (i + 1 == receivers.size ())
+        {
+          // The last receiver takes the scheduled parameters
+          params = rxParams;
+        }
+      else if (params == NULL || params->GetReferenceCount () > 1)
+        {
+          // The receivers modify the parameters, but only the intended receivers
+          // store them, thus a new copy is needed only when the previous receiver
+          // kept its copy
+          params = rxParams->Copy ();
+          m_rxParamsCopyCount++;
+        }
+      else
+        {
+          // The previous receiver released its copy, thus it is restored and reused
+          params->CopyFrom (*rxParams);
+        }
+
+      StartRx (params, receivers[i]);
+    }
+}
+
+double
+SatChannel::GetBeamCoupling (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx)
+{
+  NS_LOG_FUNCTION (this << txParams << phyRx);
+
+  if (m_antennaGainPatterns == NULL)
+    {
+      NS_FATAL_ERROR ("SatChannel::GetBeamCoupling - antenna gain patterns not set!");
+    }
+
+  switch (m_channelType)
+    {
+    // Transmitter (UT) is located in the coverage of the transmitting beam
+    case SatEnums::RETURN_USER_CH:
+      {
+        return m_antennaGainPatterns->GetBeamCoupling_lin (txParams->m_beamId, phyRx->GetBeamId ());
+      }
+    // Receiver (UT) is located in the coverage of the receiving beam
+    case SatEnums::FORWARD_USER_CH:
+      {
+        return m_antennaGainPatterns->GetBeamCoupling_lin (phyRx->GetBeamId (), txParams->m_beamId);
+      }
+    // Feeder links are not culled
+    case SatEnums::FORWARD_FEEDER_CH:
+    case SatEnums::RETURN_FEEDER_CH:
+      {
+        return 1.0;
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatChannel::GetBeamCoupling - Invalid channel type");
+        break;
+      }
+    }
+
+  return 1.0;
+}
+
+double
+SatChannel::CalculateCulledRxPower (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx)
+{
+  NS_LOG_FUNCTION (this << txParams << phyRx);
+
+  double frequency_hz = m_carrierFreqConverter (m_channelType, m_freqId, txParams->m_carrierId);
+
+  LinkBudget_t linkBudget;
+
+  if (m_enableLinkBudgetCache)
+    {
+      linkBudget = GetCachedLinkBudget (txParams->m_phyTx, phyRx, frequency_hz);
+    }
+  else
+    {
+      m_linkBudgetCacheMisses++;
+      linkBudget = CalculateLinkBudget (txParams->m_phyTx, phyRx, frequency_hz);
+    }
+
+  // The fading is not evaluated for the culled receptions
+  double rxPower_W = (txParams->m_txPower_W * linkBudget.m_txAntennaGain_W) / linkBudget.m_freeSpaceLoss;
+  return rxPower_W * linkBudget.m_rxAntennaGain_W / phyRx->GetLosses ();
 }
 
 void
@@ -411,21 +678,20 @@ SatChannel::DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
   // Get the bandwidth of the currently used carrier
   double carrierBandwidthHz = m_carrierBandwidthConverter (m_channelType, rxParams->m_carrierId, SatEnums::EFFECTIVE_BANDWIDTH );
 
+  Address address;
+
   switch (m_channelType)
     {
     case SatEnums::RETURN_FEEDER_CH:
     case SatEnums::FORWARD_USER_CH:
       {
-        // Calculate the Rx power from Rx power density
-        rxParams->m_rxPower_W = carrierBandwidthHz * Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerDensity (std::make_pair (phyRx->GetDevice ()->GetAddress (), m_channelType));
-
+        address = phyRx->GetDevice ()->GetAddress ();
         break;
       }
     case SatEnums::FORWARD_FEEDER_CH:
     case SatEnums::RETURN_USER_CH:
       {
-        // Calculate the Rx power from Rx power density
-        rxParams->m_rxPower_W = carrierBandwidthHz * Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerDensity (std::make_pair (GetSourceAddress (rxParams), m_channelType));
+        address = GetSourceAddress (rxParams);
         break;
       }
     default:
@@ -435,6 +701,15 @@ SatChannel::DoRxPowerInputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx
       }
     }
 
+  if (m_rxPowerTrace == NULL || address != m_rxPowerTraceAddress)
+    {
+      m_rxPowerTrace = Singleton<SatRxPowerInputTraceContainer>::Get ()->GetRxPowerTrace (std::make_pair (address, m_channelType));
+      m_rxPowerTraceAddress = address;
+    }
+
+  // Calculate the Rx power from Rx power density
+  rxParams->m_rxPower_W = carrierBandwidthHz * m_rxPowerTrace->ProceedToNextClosestTimeSample (SatBaseTraceContainer::RX_POWER_TRACE_DEFAULT_RX_POWER_DENSITY_INDEX);
+
   NS_LOG_INFO ("SatChannel::DoRxPowerOutputTrace - carrier bw: " << carrierBandwidthHz <<
                 ", rxPower: " << SatUtils::LinearToDb (rxParams->m_rxPower_W) <<
                 ", carrierId: " << rxParams->m_carrierId <<
@@ -483,30 +758,20 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
 {
   NS_LOG_FUNCTION (this << rxParams << phyRx);
 
-  Ptr<MobilityModel> txMobility = rxParams->m_phyTx->GetMobility ();
-  Ptr<MobilityModel> rxMobility = phyRx->GetMobility ();
-
-  double txAntennaGain_W = 0.0;
-  double rxAntennaGain_W = 0.0;
   double markovFading = 0.0;
   double extFading = 1.0;
 
-  // use always UT's or GW's position when getting antenna gain
   switch (m_channelType)
     {
     case SatEnums::RETURN_FEEDER_CH:
     case SatEnums::FORWARD_USER_CH:
       {
-        txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (rxMobility);
-        rxAntennaGain_W = phyRx->GetAntennaGain (rxMobility);
         markovFading = phyRx->GetFadingValue (phyRx->GetDevice ()->GetAddress (), m_channelType);
         break;
       }
     case SatEnums::RETURN_USER_CH:
     case SatEnums::FORWARD_FEEDER_CH:
       {
-        txAntennaGain_W = rxParams->m_phyTx->GetAntennaGain (txMobility);
-        rxAntennaGain_W = phyRx->GetAntennaGain (txMobility);
         markovFading = rxParams->m_phyTx->GetFadingValue (GetSourceAddress (rxParams), m_channelType);
         break;
       }
@@ -538,9 +803,143 @@ SatChannel::DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyR
       DoFadingOutputTrace (rxParams, phyRx, markovFading);
     }
 
-  // get (calculate) free space loss and RX power and set it to RX params
-  double rxPower_W = (rxParams->m_txPower_W * txAntennaGain_W) / m_freeSpaceLoss->GetFsl (txMobility, rxMobility, rxParams->m_carrierFreq_hz);
-  rxParams->m_rxPower_W = rxPower_W * rxAntennaGain_W / phyRx->GetLosses () * markovFading / extFading;
+  LinkBudget_t linkBudget;
+
+  if (m_enableLinkBudgetCache)
+    {
+      linkBudget = GetCachedLinkBudget (rxParams->m_phyTx, phyRx, rxParams->m_carrierFreq_hz);
+    }
+  else
+    {
+      m_linkBudgetCacheMisses++;
+      linkBudget = CalculateLinkBudget (rxParams->m_phyTx, phyRx, rxParams->m_carrierFreq_hz);
+    }
+
+  // calculate RX power and set it to RX params
+  double rxPower_W = (rxParams->m_txPower_W * linkBudget.m_txAntennaGain_W) / linkBudget.m_freeSpaceLoss;
+  rxParams->m_rxPower_W = rxPower_W * linkBudget.m_rxAntennaGain_W / phyRx->GetLosses () * markovFading / extFading;
+}
+
+SatChannel::LinkBudget_t
+SatChannel::CalculateLinkBudget (Ptr<SatPhyTx> phyTx, Ptr<SatPhyRx> phyRx, double frequency_hz)
+{
+  NS_LOG_FUNCTION (this << phyTx << phyRx << frequency_hz);
+
+  Ptr<MobilityModel> txMobility = phyTx->GetMobility ();
+  Ptr<MobilityModel> rxMobility = phyRx->GetMobility ();
+
+  LinkBudget_t linkBudget;
+  linkBudget.m_txMobility = PeekPointer (txMobility);
+  linkBudget.m_rxMobility = PeekPointer (rxMobility);
+
+  // use always UT's or GW's position when getting antenna gain
+  switch (m_channelType)
+    {
+    case SatEnums::RETURN_FEEDER_CH:
+    case SatEnums::FORWARD_USER_CH:
+      {
+        linkBudget.m_txAntennaGain_W = phyTx->GetAntennaGain (rxMobility);
+        linkBudget.m_rxAntennaGain_W = phyRx->GetAntennaGain (rxMobility);
+        break;
+      }
+    case SatEnums::RETURN_USER_CH:
+    case SatEnums::FORWARD_FEEDER_CH:
+      {
+        linkBudget.m_txAntennaGain_W = phyTx->GetAntennaGain (txMobility);
+        linkBudget.m_rxAntennaGain_W = phyRx->GetAntennaGain (txMobility);
+        break;
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatChannel::CalculateLinkBudget - Invalid channel type");
+        break;
+      }
+    }
+
+  linkBudget.m_freeSpaceLoss = m_freeSpaceLoss->GetFsl (txMobility, rxMobility, frequency_hz);
+
+  return linkBudget;
+}
+
+SatChannel::LinkBudget_t
+SatChannel::GetCachedLinkBudget (Ptr<SatPhyTx> phyTx, Ptr<SatPhyRx> phyRx, double frequency_hz)
+{
+  NS_LOG_FUNCTION (this << phyTx << phyRx << frequency_hz);
+
+  LinkBudgetKey_t key = std::make_pair (std::make_pair (PeekPointer (phyTx), PeekPointer (phyRx)),
+                                        frequency_hz);
+
+  std::map<LinkBudgetKey_t, LinkBudget_t>::const_iterator it = m_linkBudgets.find (key);
+
+  if (it != m_linkBudgets.end ())
+    {
+      m_linkBudgetCacheHits++;
+      return it->second;
+    }
+
+  m_linkBudgetCacheMisses++;
+
+  LinkBudget_t linkBudget = CalculateLinkBudget (phyTx, phyRx, frequency_hz);
+
+  /**
+   * The link budget may be cached only if the course changes of both the
+   * transmitter and the receiver are observed. Otherwise the calculated link
+   * budget is used only for this reception.
+   */
+  if (!ObserveLinkBudgetMobility (phyTx->GetMobility ())
+      || !ObserveLinkBudgetMobility (phyRx->GetMobility ()))
+    {
+      return linkBudget;
+    }
+
+  m_linkBudgets.insert (std::make_pair (key, linkBudget));
+
+  return linkBudget;
+}
+
+bool
+SatChannel::ObserveLinkBudgetMobility (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+
+  if (m_linkBudgetMobilities.find (PeekPointer (mobility)) != m_linkBudgetMobilities.end ())
+    {
+      return true;
+    }
+
+  Ptr<SatMobilityModel> satMobility = DynamicCast<SatMobilityModel> (mobility);
+
+  if (!satMobility)
+    {
+      return false;
+    }
+
+  satMobility->TraceConnectWithoutContext ("SatCourseChange", MakeCallback (&SatChannel::LinkBudgetMobilityChanged, this));
+  m_linkBudgetMobilities.insert (std::make_pair (PeekPointer (mobility), satMobility));
+
+  return true;
+}
+
+void
+SatChannel::LinkBudgetMobilityChanged (Ptr<const SatMobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+
+  const MobilityModel* changed = PeekPointer (mobility);
+
+  std::map<LinkBudgetKey_t, LinkBudget_t>::iterator it = m_linkBudgets.begin ();
+
+  while (it != m_linkBudgets.end ())
+    {
+      if (it->second.m_txMobility == changed || it->second.m_rxMobility == changed)
+        {
+          m_linkBudgets.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
 }
 
 double
@@ -600,7 +999,7 @@ SatChannel::GetSourceAddress (Ptr<SatSignalParameters> rxParams)
 
   SatMacTag tag;
 
-  SatSignalParameters::PacketsInBurst_t::const_iterator i = rxParams->m_packetsInBurst.begin ();
+  SatSignalParameters::PacketsInBurst_t::const_iterator i = rxParams->GetPackets ().begin ();
 
   if (*i == NULL)
     {
@@ -679,6 +1078,64 @@ SatChannel::SetFreeSpaceLoss (Ptr<SatFreeSpaceLoss> loss)
   m_freeSpaceLoss = loss;
 }
 
+void
+SatChannel::SetAntennaGainPatterns (Ptr<SatAntennaGainPatternContainer> antennaPatterns)
+{
+  NS_LOG_FUNCTION (this << antennaPatterns);
+  m_antennaGainPatterns = antennaPatterns;
+}
+
+uint64_t
+SatChannel::GetNScheduledRx () const
+{
+  return m_scheduledRxCount;
+}
+
+uint64_t
+SatChannel::GetNRxParamsCopies () const
+{
+  return m_rxParamsCopyCount;
+}
+
+uint64_t
+SatChannel::GetNCulledRx () const
+{
+  return m_culledRxCount;
+}
+
+double
+SatChannel::GetCulledRxPower () const
+{
+  return m_culledRxPower_W;
+}
+
+uint64_t
+SatChannel::GetNLinkBudgetCacheHits () const
+{
+  return m_linkBudgetCacheHits;
+}
+
+uint64_t
+SatChannel::GetNLinkBudgetCacheMisses () const
+{
+  return m_linkBudgetCacheMisses;
+}
+
+std::size_t
+SatChannel::GetLinkBudgetCacheSize () const
+{
+  return m_linkBudgets.size ();
+}
+
+std::size_t
+SatChannel::GetLinkBudgetCacheMemory () const
+{
+  // Node of the map: key and value, parent, left and right child pointers and color
+  std::size_t nodeSize = sizeof (std::pair<const LinkBudgetKey_t, LinkBudget_t>) + 4 * sizeof (void*);
+
+  return sizeof (m_linkBudgets) + m_linkBudgets.size () * nodeSize;
+}
+
 std::size_t
 SatChannel::GetNDevices (void) const
 {
@@ -22,6 +22,8 @@
 #ifndef SATELLITE_CHANNEL_H
 #define SATELLITE_CHANNEL_H
 
+#include <map>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/channel.h"
@@ -33,6 +35,9 @@
 #include "satellite-phy-rx-carrier-conf.h"
 #include "satellite-enums.h"
 #include "satellite-typedefs.h"
+#include "satellite-antenna-gain-pattern-container.h"
+#include "satellite-mobility-model.h"
+#include "ns3/satellite-input-fstream-time-double-container.h"
 
 namespace ns3 {
 
@@ -56,6 +61,21 @@ namespace ns3 {
  *   and fading (Markov/Loo)
  * - Handle the fading input/output trace functionality
  *
+ * In ALL_BEAMS forwarding mode, the user link receivers of the beams which are
+ * coupled to the transmitting beam below a threshold may optionally be culled,
+ * i.e. the transmission is not passed to them at all. The beam couplings are
+ * calculated from the antenna gain patterns.
+ *
+ * Optionally the link budget of a transmitter and receiver pair at a carrier
+ * frequency (antenna gains and free space loss) is cached, thus only the
+ * fading is evaluated per reception. The cached link budgets are invalidated
+ * when the position of the transmitter or the receiver changes.
+ *
+ * Optionally the receptions of a transmission are batched, i.e. the consecutive
+ * receivers with identical propagation delay and node context are started by a
+ * single scheduled event. Only consecutive receivers are batched, thus the
+ * receptions start in the same order as with one event per receiver.
+ *
  */
 
 class SatChannel : public Channel
@@ -154,6 +174,66 @@ public:
    */
   virtual void SetFreeSpaceLoss (Ptr<SatFreeSpaceLoss> delay);
 
+  /**
+   * \brief Set the antenna gain patterns used for spatial culling of the receivers
+   * \param antennaPatterns Antenna gain pattern container
+   */
+  virtual void SetAntennaGainPatterns (Ptr<SatAntennaGainPatternContainer> antennaPatterns);
+
+  /**
+   * \return Number of receptions scheduled by the channel
+   */
+  uint64_t GetNScheduledRx () const;
+
+  /**
+   * \return Number of signal parameter copies made for the receptions
+   */
+  uint64_t GetNRxParamsCopies () const;
+
+  /**
+   * \return Number of receptions skipped by the spatial culling
+   */
+  uint64_t GetNCulledRx () const;
+
+  /**
+   * \brief Get the sum of the Rx powers of the culled receptions, i.e. the
+   * skipped interference power. The fading is not included. The powers are
+   * calculated only with EnableCulledRxPower attribute enabled.
+   * \return Skipped interference power in Watts
+   */
+  double GetCulledRxPower () const;
+
+  /**
+   * \brief Callback signature for `CulledRx` trace source.
+   * \param txBeamId ID of the transmitting beam
+   * \param rxBeamId ID of the beam of the culled receiver
+   * \param rxPower_W Rx power of the culled reception without fading in Watts
+   */
+  typedef void (* CulledRxCallback)(uint32_t txBeamId, uint32_t rxBeamId, double rxPower_W);
+
+  /**
+   * \return Number of receptions using a cached link budget
+   */
+  uint64_t GetNLinkBudgetCacheHits () const;
+
+  /**
+   * \return Number of receptions calculating the link budget, i.e. all the
+   * receptions when the link budget cache is disabled
+   */
+  uint64_t GetNLinkBudgetCacheMisses () const;
+
+  /**
+   * \return Number of cached link budgets
+   */
+  std::size_t GetLinkBudgetCacheSize () const;
+
+  /**
+   * \brief Get the approximate memory footprint of the link budget cache
+   * including the overhead of the container nodes
+   * \return Memory footprint in bytes
+   */
+  std::size_t GetLinkBudgetCacheMemory () const;
+
   /**
    * \brief Used by attached SatPhyTx instances to transmit signals to the channel
    * \param params the parameters of the signals being transmitted
@@ -234,6 +314,17 @@ private:
    */
   SatEnums::RxPowerCalculationMode_t m_rxPowerCalculationMode;
 
+  /**
+   * \brief Address of the Rx power input trace in use
+   */
+  Address m_rxPowerTraceAddress;
+
+  /**
+   * \brief Rx power input trace of the latest address, used as a cursor to
+   * the trace samples
+   */
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_rxPowerTrace;
+
   /**
    * \brief Defines whether Rx power output tracing is in use or not
    */
@@ -249,6 +340,119 @@ private:
    */
   bool m_enableExternalFadingInputTrace;
 
+  /**
+   * \brief Defines whether the spatial culling of the receivers is in use or not
+   */
+  bool m_enableSpatialCulling;
+
+  /**
+   * \brief Beam coupling threshold in dB below which the receivers are culled
+   */
+  double m_spatialCullingThresholdDb;
+
+  /**
+   * \brief Defines whether the Rx powers of the culled receptions are calculated
+   */
+  bool m_enableCulledRxPower;
+
+  /**
+   * \brief Antenna gain patterns used for the spatial culling
+   */
+  Ptr<SatAntennaGainPatternContainer> m_antennaGainPatterns;
+
+  /**
+   * \brief Defines whether the receptions with identical delay and context are batched
+   */
+  bool m_enableBatchedRx;
+
+  /**
+   * \brief Propagation delay of the pending reception batch
+   */
+  Time m_rxBatchDelay;
+
+  /**
+   * \brief Node context of the pending reception batch
+   */
+  uint32_t m_rxBatchContext;
+
+  /**
+   * \brief Receivers of the pending reception batch of the current transmission
+   */
+  std::vector<Ptr<SatPhyRx> > m_rxBatchReceivers;
+
+  /**
+   * \brief Defines whether the link budgets are cached or not
+   */
+  bool m_enableLinkBudgetCache;
+
+  /**
+   * \brief Key of a cached link budget: transmitter, receiver and carrier frequency
+   */
+  typedef std::pair<std::pair<const SatPhyTx*, const SatPhyRx*>, double> LinkBudgetKey_t;
+
+  /**
+   * \brief Link budget of a transmitter and receiver pair excluding the
+   * transmit power, receiver losses and fading
+   */
+  typedef struct
+  {
+    double m_txAntennaGain_W;
+    double m_rxAntennaGain_W;
+    double m_freeSpaceLoss;
+    const MobilityModel* m_txMobility;
+    const MobilityModel* m_rxMobility;
+  } LinkBudget_t;
+
+  /**
+   * \brief Cached link budgets
+   */
+  std::map<LinkBudgetKey_t, LinkBudget_t> m_linkBudgets;
+
+  /**
+   * \brief Mobility models whose course changes are observed by the link budget cache
+   */
+  std::map<const MobilityModel*, Ptr<SatMobilityModel> > m_linkBudgetMobilities;
+
+  /**
+   * \brief Number of receptions using a cached link budget
+   */
+  uint64_t m_linkBudgetCacheHits;
+
+  /**
+   * \brief Number of receptions calculating the link budget
+   */
+  uint64_t m_linkBudgetCacheMisses;
+
+  /**
+   * \brief Number of scheduled receptions
+   */
+  uint64_t m_scheduledRxCount;
+
+  /**
+   * \brief Number of events scheduled for the receptions
+   */
+  uint64_t m_scheduledRxEventCount;
+
+  /**
+   * \brief Number of signal parameter copies made for the receptions
+   */
+  uint64_t m_rxParamsCopyCount;
+
+  /**
+   * \brief Number of culled receptions
+   */
+  uint64_t m_culledRxCount;
+
+  /**
+   * \brief Sum of the Rx powers of the culled receptions in Watts
+   */
+  double m_culledRxPower_W;
+
+  /**
+   * \brief Trace source fired for every culled reception
+   */
+  TracedCallback<uint32_t, uint32_t, double> m_culledRxTrace;
+
   /**
    * Dispose SatChannel.
    */
@@ -261,6 +465,40 @@ private:
    */
   void ScheduleRx (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx);
 
+  /**
+   * \brief Used internally to schedule the pending reception batch of a transmission.
+   * \param txParams Parameters of the signal being transmitted
+   */
+  void ScheduleRxBatch (Ptr<SatSignalParameters> txParams);
+
+  /**
+   * \brief Used internally to start the packet reception at a batch of receivers.
+   * The receivers modify the signal parameters, but only the intended receivers
+   * store them. Thus, a copy of the parameters is restored and reused as long as
+   * the receivers release it, and a new copy is made only after a receiver has
+   * stored the previous one. The last receiver takes the scheduled parameters.
+   *
+   * \param rxParams Parameters of the signal being received
+   * \param receivers The receiver SatPhyRx entities
+   */
+  void StartRxBatch (Ptr<SatSignalParameters> rxParams, std::vector<Ptr<SatPhyRx> > receivers);
+
+  /**
+   * \brief Get the coupling between the transmitting beam and the receiver beam
+   * \param txParams Parameters of the signal being transmitted
+   * \param phyRx The receiver SatPhyRx entity
+   * \return Beam coupling in linear format
+   */
+  double GetBeamCoupling (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx);
+
+  /**
+   * \brief Get the Rx power of a culled reception without fading
+   * \param txParams Parameters of the signal being transmitted
+   * \param phyRx The culled receiver SatPhyRx entity
+   * \return Rx power in Watts
+   */
+  double CalculateCulledRxPower (Ptr<SatSignalParameters> txParams, Ptr<SatPhyRx> phyRx);
+
   /**
    * \brief Used internally to start the packet reception of at the phyRx.
    *
@@ -277,7 +515,12 @@ private:
   void DoRxPowerOutputTrace (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
 
   /**
-   * \brief Function for Rx power input trace
+   * \brief Function for Rx power input trace. The trace is looked up only
+   * when its address changes from the previous reception. The address is
+   * the source on the forward feeder and return user channels, thus the
+   * trace is looked up once per transmission. The address is the receiver
+   * on the forward user and return feeder channels, thus the trace is
+   * looked up per reception on the forward user channel with several UTs.
    * \param rxParams Rx parameters
    * \param phyRx The receiver SatPhyRx entity
    */
@@ -298,6 +541,39 @@ private:
    */
   void DoRxPowerCalculation (Ptr<SatSignalParameters> rxParams, Ptr<SatPhyRx> phyRx);
 
+  /**
+   * \brief Function for calculating the link budget of a reception
+   * \param phyTx The transmitter SatPhyTx entity
+   * \param phyRx The receiver SatPhyRx entity
+   * \param frequency_hz Carrier frequency of the reception
+   * \return link budget
+   */
+  LinkBudget_t CalculateLinkBudget (Ptr<SatPhyTx> phyTx, Ptr<SatPhyRx> phyRx, double frequency_hz);
+
+  /**
+   * \brief Function for getting the link budget of a reception from the cache.
+   * The link budget is calculated and cached, if it is not found from the cache.
+   * \param phyTx The transmitter SatPhyTx entity
+   * \param phyRx The receiver SatPhyRx entity
+   * \param frequency_hz Carrier frequency of the reception
+   * \return link budget
+   */
+  LinkBudget_t GetCachedLinkBudget (Ptr<SatPhyTx> phyTx, Ptr<SatPhyRx> phyRx, double frequency_hz);
+
+  /**
+   * \brief Start observing the course changes of a mobility model for the link budget cache
+   * \param mobility Mobility model
+   * \return true if the course changes of the mobility model are observed
+   */
+  bool ObserveLinkBudgetMobility (Ptr<MobilityModel> mobility);
+
+  /**
+   * \brief Callback for the course change of an observed mobility model, removes the
+   * cached link budgets of the mobility model
+   * \param mobility Mobility model
+   */
+  void LinkBudgetMobilityChanged (Ptr<const SatMobilityModel> mobility);
+
   /**
    * \brief Function for getting the external source fading value
    * \param rxParams Rx parameters
@@ -119,6 +119,18 @@ SatCompositeSinrOutputTraceContainer::AddNode (key_t key)
           NS_FATAL_ERROR ("SatCompositeSinrOutputTraceContainer::AddNode failed");
         }
 
+      // The figure output is enabled before any rows are added, so that the
+      // figure is created from the rows before they are flushed to the file
+      if (m_enableFigureOutput)
+        {
+          result.first->second->EnableFigureOutput ("Composite SINR",
+                                                    "Time (s)",
+                                                    "SINR (dB)",
+                                                    "set key top right",
+                                                    SatOutputFileStreamDoubleContainer::DECIBEL,
+                                                    Gnuplot2dDataset::LINES_POINTS);
+        }
+
       NS_LOG_INFO ("SatCompositeSinrOutputTraceContainer::AddNode: Added node with MAC " << key.first << " channel type " << key.second);
 
       return result.first->second;
@@ -149,21 +161,16 @@ SatCompositeSinrOutputTraceContainer::WriteToFile ()
 
   for (iter = m_container.begin (); iter != m_container.end (); iter++)
     {
-      if (m_enableFigureOutput)
+      if (!m_enableFigureOutput)
         {
-          iter->second->EnableFigureOutput ("Composite SINR",
-                                            "Time (s)",
-                                            "SINR (dB)",
-                                            "set key top right",
-                                            SatOutputFileStreamDoubleContainer::DECIBEL,
-                                            Gnuplot2dDataset::LINES_POINTS);
+          iter->second->DisableFigureOutput ();
         }
       iter->second->WriteContainerToFile ();
     }
 }
 
 void
-SatCompositeSinrOutputTraceContainer::AddToContainer (key_t key, std::vector<double> newItem)
+SatCompositeSinrOutputTraceContainer::AddToContainer (key_t key, const std::vector<double>& newItem)
 {
   NS_LOG_FUNCTION (this);
 
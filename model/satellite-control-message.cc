@@ -164,6 +164,7 @@ SatTbtpMessage::~SatTbtpMessage ()
 
   m_frameIds.clear ();
   m_daTimeSlots.clear ();
+  m_daAssignments.clear ();
 }
 
 TypeId
@@ -189,49 +190,54 @@ SatTbtpMessage::GetInstanceTypeId (void) const
   return GetTypeId ();
 }
 
-const SatTbtpMessage::DaTimeSlotInfoItem_t&
-SatTbtpMessage::GetDaTimeslots (Address utId)
+SatTbtpMessage::DaTimeSlotInfo
+SatTbtpMessage::GetDaTimeslots (uint32_t assignmentId) const
 {
-  NS_LOG_FUNCTION (this << utId);
+  NS_LOG_FUNCTION (this << assignmentId);
 
-  DaTimeSlotMap_t::const_iterator it = m_daTimeSlots.find (utId);
-
-  if ( it != m_daTimeSlots.end () )
+  if ( assignmentId < m_daAssignments.size () && m_daAssignments[assignmentId].m_slotCount > 0 )
     {
-      return it->second;
+      const DaAssignment_t& assignment = m_daAssignments[assignmentId];
+      return DaTimeSlotInfo (assignment.m_frameId, &m_daTimeSlots[assignment.m_firstSlot], assignment.m_slotCount);
     }
 
-  return m_emptyDaSlotContainer;
+  return DaTimeSlotInfo ();
 }
 
 void
-SatTbtpMessage::SetDaTimeslot (Mac48Address utId, uint8_t frameId, Ptr<SatTimeSlotConf> conf)
+SatTbtpMessage::SetDaTimeslot (uint32_t assignmentId, uint8_t frameId, const Ptr<SatTimeSlotConf>& conf, uint8_t rcIndex)
 {
-  NS_LOG_FUNCTION (this << utId << frameId << conf);
-
-  // find container for the UT from map
-  DaTimeSlotMap_t::iterator it = m_daTimeSlots.find (utId);
+  NS_LOG_FUNCTION (this << assignmentId << (uint32_t) frameId << conf << (uint32_t) rcIndex);
 
-  // If not found, add new UT container to map,
-  // otherwise use container found from map
-  if ( it == m_daTimeSlots.end () )
+  // add assignments up to the given assignment ID, if not yet added
+  if ( assignmentId >= m_daAssignments.size () )
     {
-      std::pair<DaTimeSlotMap_t::iterator, bool> result = m_daTimeSlots.insert (std::make_pair (utId, DaTimeSlotInfoItem_t ()));
+      DaAssignment_t emptyAssignment = { 0, 0, 0 };
+      m_daAssignments.resize (assignmentId + 1, emptyAssignment);
+    }
 
-      if ( result.second )
-        {
-          it = result.first;
-        }
-      else
-        {
-          // container creation for UT has failed, so we need to crash
-          NS_FATAL_ERROR ("Cannot insert slot to container!!!");
-        }
+  DaAssignment_t& assignment = m_daAssignments[assignmentId];
+
+  if ( assignment.m_slotCount == 0 )
+    {
+      assignment.m_firstSlot = m_daTimeSlots.size ();
+      assignment.m_frameId = frameId;
+    }
+  else if ( (assignment.m_firstSlot + assignment.m_slotCount) != m_daTimeSlots.size () || assignment.m_frameId != frameId )
+    {
+      NS_FATAL_ERROR ("Time slots of assignment ID " << assignmentId << " not set consecutively within one frame!!!");
     }
 
-  // store time slot info to user specific container
-  it->second.first = frameId;
-  it->second.second.push_back ( conf  );
+  // store time slot info to the time slot container
+  DaTimeSlot_t timeSlot;
+  timeSlot.m_startTime = conf->GetStartTime ();
+  timeSlot.m_waveformId = conf->GetWaveFormId ();
+  timeSlot.m_carrierId = conf->GetCarrierId ();
+  timeSlot.m_rcIndex = rcIndex;
+  timeSlot.m_slotType = conf->GetSlotType ();
+
+  m_daTimeSlots.push_back (timeSlot);
+  assignment.m_slotCount++;
 
   // store frame ID to keep track of the used frames count
   m_frameIds.insert (frameId);
@@ -340,10 +346,7 @@ uint32_t SatTbtpMessage::GetSizeInBytes () const
   uint32_t assignmentIdSizeInBytes = GetTimeSlotInfoSizeInBytes ();
 
   // add size of DA time slots
-  for (DaTimeSlotMap_t::const_iterator it = m_daTimeSlots.begin (); it != m_daTimeSlots.end (); it++ )
-    {
-      sizeInBytes += (it->second.second.size () * assignmentIdSizeInBytes);
-    }
+  sizeInBytes += (m_daTimeSlots.size () * assignmentIdSizeInBytes);
 
   // add size of RA time slots
   for (RaChannelMap_t::const_iterator it = m_raChannels.begin (); it != m_raChannels.end (); it++ )
@@ -361,14 +364,15 @@ void SatTbtpMessage::Dump () const
   ", superframe sequence id: " << m_superframeSeqId <<
   ", assignment format: " << m_assignmentFormat << std::endl;
 
-  for (DaTimeSlotMap_t::const_iterator mit = m_daTimeSlots.begin ();
-       mit != m_daTimeSlots.end ();
-       ++mit)
+  for (uint32_t i = 0; i < m_daAssignments.size (); ++i)
     {
-      std::cout << "UT: " << mit->first << ": ";
-      std::cout << "Frame ID: " << mit->second.first << ": ";
-      std::cout << mit->second.second.size () << " ";
-      std::cout << std::endl;
+      if ( m_daAssignments[i].m_slotCount > 0 )
+        {
+          std::cout << "Assignment ID: " << i << ": ";
+          std::cout << "Frame ID: " << (uint32_t) m_daAssignments[i].m_frameId << ": ";
+          std::cout << m_daAssignments[i].m_slotCount << " ";
+          std::cout << std::endl;
+        }
     }
 
 }
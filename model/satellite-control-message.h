@@ -194,17 +194,96 @@ class SatTbtpMessage : public SatControlMessage
 {
 public:
   /**
-   * Container for time slot configurations in time slot map item DaTimeSlotMapItem_t.
+   * DA time slot of the TBTP. The time slot is stored by value, so that it
+   * is independent of the time slot configurations of the frame.
    */
-  typedef std::vector< Ptr<SatTimeSlotConf> >  DaTimeSlotConfContainer_t;
+  typedef struct
+  {
+    Time                                m_startTime;
+    uint32_t                            m_waveformId;
+    uint16_t                            m_carrierId;
+    uint8_t                             m_rcIndex;
+    SatTimeSlotConf::SatTimeSlotType_t  m_slotType;
+  } DaTimeSlot_t;
 
   /**
-   * Item for DA time slot information.
-   *
-   * Stored information is pair, which member first holds frame id
-   * of the time slots and member second holds container of time slot configurations.
+   * Non-owning view to the DA time slots of one UT in the TBTP. The view is
+   * valid as long as the TBTP message exists and no time slots are added to it.
    */
-  typedef std::pair<uint8_t, DaTimeSlotConfContainer_t>  DaTimeSlotInfoItem_t;
+  class DaTimeSlotInfo
+  {
+public:
+    /**
+     * Construct an empty view.
+     */
+    DaTimeSlotInfo ()
+      : m_frameId (0),
+        m_slots (0),
+        m_slotCount (0)
+    {
+    }
+
+    /**
+     * Construct a view.
+     *
+     * \param frameId Frame ID of the time slots
+     * \param slots Pointer to the first time slot
+     * \param slotCount Number of the time slots
+     */
+    DaTimeSlotInfo (uint8_t frameId, const DaTimeSlot_t* slots, uint32_t slotCount)
+      : m_frameId (frameId),
+        m_slots (slots),
+        m_slotCount (slotCount)
+    {
+    }
+
+    /**
+     * Get frame ID of the time slots.
+     *
+     * \return Frame ID
+     */
+    inline uint8_t GetFrameId () const
+    {
+      return m_frameId;
+    }
+
+    /**
+     * Get number of the time slots.
+     *
+     * \return Number of the time slots
+     */
+    inline uint32_t GetSize () const
+    {
+      return m_slotCount;
+    }
+
+    /**
+     * Check if there are no time slots.
+     *
+     * \return true if there are no time slots
+     */
+    inline bool IsEmpty () const
+    {
+      return (m_slotCount == 0);
+    }
+
+    /**
+     * Get a time slot.
+     *
+     * \param index Index of the time slot in the view
+     * \return The time slot
+     */
+    inline const DaTimeSlot_t& operator[] (uint32_t index) const
+    {
+      NS_ASSERT (index < m_slotCount);
+      return m_slots[index];
+    }
+
+private:
+    uint8_t             m_frameId;
+    const DaTimeSlot_t* m_slots;
+    uint32_t            m_slotCount;
+  };
 
   /**
    * Container for RA channel information
@@ -319,19 +398,21 @@ public:
   /**
    * Get the information of the DA time slots.
    *
-   * \param utId  id of the UT which time slot information is requested
-   * \return vector containing DA time slot info
+   * \param assignmentId assignment ID of the UT which time slot information is requested
+   * \return view to the DA time slots of the UT, empty if there are no time slots
    */
-  const DaTimeSlotInfoItem_t& GetDaTimeslots (Address utId);
+  DaTimeSlotInfo GetDaTimeslots (uint32_t assignmentId) const;
 
   /**
-   * Set a DA time slot information
+   * Set a DA time slot information. The time slots of a UT shall be set
+   * consecutively and within one frame.
    *
-   * \param utId id of the UT which time slot information is set
+   * \param assignmentId assignment ID of the UT which time slot information is set
    * \param frameId Frame ID of the time slot
-   * \param conf Pointer to time slot configuration
+   * \param conf Time slot configuration
+   * \param rcIndex RC index of the time slot
    */
-  void SetDaTimeslot (Mac48Address utId, uint8_t frameId, Ptr<SatTimeSlotConf> conf);
+  void SetDaTimeslot (uint32_t assignmentId, uint8_t frameId, const Ptr<SatTimeSlotConf>& conf, uint8_t rcIndex);
 
   /**
    * Get the information of the RA channels.
@@ -370,19 +451,32 @@ public:
 
 private:
   typedef std::map <uint8_t, uint16_t >  RaChannelMap_t;
-  typedef std::map<Address, DaTimeSlotInfoItem_t > DaTimeSlotMap_t;
 
-  DaTimeSlotMap_t   m_daTimeSlots;
+  /**
+   * Assignment of the DA time slots of one UT, a range in the time slot container.
+   */
+  typedef struct
+  {
+    uint32_t  m_firstSlot;
+    uint32_t  m_slotCount;
+    uint8_t   m_frameId;
+  } DaAssignment_t;
+
+  /**
+   * DA time slots of all the UTs in the order they are set.
+   */
+  std::vector<DaTimeSlot_t>    m_daTimeSlots;
+
+  /**
+   * DA assignments indexed by assignment ID.
+   */
+  std::vector<DaAssignment_t>  m_daAssignments;
+
   RaChannelMap_t    m_raChannels;
   uint32_t          m_superframeCounter;
   uint8_t           m_superframeSeqId;
   uint8_t           m_assignmentFormat;
   std::set<uint8_t> m_frameIds;
-
-  /**
-   * Empty DA slot container to be returned if there are not DA time slots
-   */
-  const DaTimeSlotInfoItem_t m_emptyDaSlotContainer;
 };
 
 /**
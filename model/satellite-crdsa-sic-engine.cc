@@ -0,0 +1,336 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+
+#include "satellite-crdsa-sic-engine.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatCrdsaSicEngine");
+
+namespace ns3 {
+
+SatCrdsaSicEngine::SatCrdsaSicEngine ()
+  : m_decodingAttempts (0),
+    m_cancellations (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_replicaOffsets.push_back (0);
+}
+
+SatCrdsaSicEngine::~SatCrdsaSicEngine ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatCrdsaSicEngine::SetDecodeCallback (SatCrdsaSicEngine::DecodeCallback cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+  m_decodeCallback = cb;
+}
+
+void
+SatCrdsaSicEngine::SetCancelCallback (SatCrdsaSicEngine::CancelCallback cb)
+{
+  NS_LOG_FUNCTION (this << &cb);
+  m_cancelCallback = cb;
+}
+
+uint32_t
+SatCrdsaSicEngine::AddPacket (uint16_t ownSlotId,
+                              const std::vector<uint16_t> &slotIdsForOtherReplicas,
+                              Mac48Address sourceAddress)
+{
+  NS_LOG_FUNCTION (this << ownSlotId << sourceAddress);
+
+  uint32_t index = m_ownSlotIds.size ();
+
+  m_ownSlotIds.push_back (ownSlotId);
+  m_sourceAddresses.push_back (sourceAddress);
+
+  m_replicaSlotIds.insert (m_replicaSlotIds.end (), slotIdsForOtherReplicas.begin (), slotIdsForOtherReplicas.end ());
+  m_replicaOffsets.push_back (m_replicaSlotIds.size ());
+
+  /// the slot set of the packet (own slot and replica slots) in ascending order
+  std::vector<uint16_t>::iterator first = m_sortedSlotIds.insert (m_sortedSlotIds.end (), ownSlotId);
+  std::size_t firstPos = first - m_sortedSlotIds.begin ();
+  m_sortedSlotIds.insert (m_sortedSlotIds.end (), slotIdsForOtherReplicas.begin (), slotIdsForOtherReplicas.end ());
+  std::sort (m_sortedSlotIds.begin () + firstPos, m_sortedSlotIds.end ());
+
+  m_alive.push_back (1);
+  m_processed.push_back (0);
+  m_queued.push_back (0);
+
+  return index;
+}
+
+void
+SatCrdsaSicEngine::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_ownSlotIds.clear ();
+  m_sourceAddresses.clear ();
+  m_replicaOffsets.clear ();
+  m_replicaOffsets.push_back (0);
+  m_replicaSlotIds.clear ();
+  m_sortedSlotIds.clear ();
+  m_alive.clear ();
+  m_processed.clear ();
+  m_queued.clear ();
+  m_slotOffsets.clear ();
+  m_slotPackets.clear ();
+  m_slotPacketCount.clear ();
+
+  while (!m_worklist.empty ())
+    {
+      m_worklist.pop ();
+    }
+}
+
+void
+SatCrdsaSicEngine::BuildSlotIndex ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t nSlots = 0;
+
+  for (uint32_t i = 0; i < m_ownSlotIds.size (); i++)
+    {
+      nSlots = std::max (nSlots, m_ownSlotIds[i] + 1u);
+    }
+
+  m_slotPacketCount.assign (nSlots, 0);
+  m_slotOffsets.assign (nSlots + 1, 0);
+
+  for (uint32_t i = 0; i < m_ownSlotIds.size (); i++)
+    {
+      m_slotPacketCount[m_ownSlotIds[i]]++;
+    }
+
+  for (uint32_t s = 0; s < nSlots; s++)
+    {
+      m_slotOffsets[s + 1] = m_slotOffsets[s] + m_slotPacketCount[s];
+    }
+
+  /// counting sort keeps the arrival order of the packets within a slot
+  std::vector<uint32_t> fill (m_slotOffsets.begin (), m_slotOffsets.end () - 1);
+  m_slotPackets.resize (m_ownSlotIds.size ());
+
+  for (uint32_t i = 0; i < m_ownSlotIds.size (); i++)
+    {
+      m_slotPackets[fill[m_ownSlotIds[i]]++] = i;
+    }
+}
+
+void
+SatCrdsaSicEngine::Enqueue (uint32_t index)
+{
+  if (!m_queued[index])
+    {
+      m_queued[index] = 1;
+      m_worklist.push ((static_cast<uint64_t> (m_ownSlotIds[index]) << 32) | index);
+    }
+}
+
+void
+SatCrdsaSicEngine::Remove (uint32_t index)
+{
+  NS_ASSERT (m_alive[index]);
+
+  m_alive[index] = 0;
+  m_slotPacketCount[m_ownSlotIds[index]]--;
+}
+
+bool
+SatCrdsaSicEngine::HaveSameSlotIds (uint32_t index1, uint32_t index2) const
+{
+  uint32_t size1 = m_replicaOffsets[index1 + 1] - m_replicaOffsets[index1];
+  uint32_t size2 = m_replicaOffsets[index2 + 1] - m_replicaOffsets[index2];
+
+  /// sanity check
+  if (size1 != size2)
+    {
+      NS_FATAL_ERROR ("SatCrdsaSicEngine::HaveSameSlotIds - The amount of replicas does not match");
+    }
+
+  std::vector<uint16_t>::const_iterator first1 = m_sortedSlotIds.begin () + m_replicaOffsets[index1] + index1;
+  std::vector<uint16_t>::const_iterator first2 = m_sortedSlotIds.begin () + m_replicaOffsets[index2] + index2;
+
+  return std::equal (first1, first1 + size1 + 1, first2);
+}
+
+uint32_t
+SatCrdsaSicEngine::RemoveReplicas (uint32_t index, uint16_t slotId)
+{
+  NS_LOG_FUNCTION (this << index << slotId);
+
+  bool replicaFound = false;
+  uint32_t removed = 0;
+
+  if (slotId < m_slotPacketCount.size ())
+    {
+      for (uint32_t k = m_slotOffsets[slotId]; k < m_slotOffsets[slotId + 1]; k++)
+        {
+          uint32_t other = m_slotPackets[k];
+
+          /// check for the same UT & same slots
+          if (m_alive[other] && m_sourceAddresses[other] == m_sourceAddresses[index])
+            {
+              /// the replica slot is common to both packets, thus the slots
+              /// of the packets are either identical or partially overlapping
+              if (!HaveSameSlotIds (index, other))
+                {
+                  NS_FATAL_ERROR ("SatCrdsaSicEngine::RemoveReplicas - Partially overlapping CRDSA slots");
+                }
+
+              replicaFound = true;
+              removed = other;
+              Remove (other);
+            }
+        }
+    }
+
+  if (!replicaFound)
+    {
+      NS_FATAL_ERROR ("SatCrdsaSicEngine::RemoveReplicas - Replica not found");
+    }
+
+  return removed;
+}
+
+void
+SatCrdsaSicEngine::ReleaseSlot (uint16_t slotId, uint32_t interferer)
+{
+  NS_LOG_FUNCTION (this << slotId << interferer);
+
+  if (m_slotPacketCount[slotId] == 0)
+    {
+      NS_LOG_INFO ("SatCrdsaSicEngine::ReleaseSlot - No other packets in slot " << slotId);
+      return;
+    }
+
+  for (uint32_t k = m_slotOffsets[slotId]; k < m_slotOffsets[slotId + 1]; k++)
+    {
+      uint32_t other = m_slotPackets[k];
+
+      if (m_alive[other])
+        {
+          /// release packets in this slot for re-processing
+          m_processed[other] = 0;
+          m_cancelCallback (other, interferer);
+          m_cancellations++;
+          Enqueue (other);
+        }
+    }
+}
+
+std::vector<uint32_t>
+SatCrdsaSicEngine::ProcessFrame ()
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT (!m_decodeCallback.IsNull ());
+  NS_ASSERT (!m_cancelCallback.IsNull ());
+
+  std::vector<uint32_t> processedPackets;
+  processedPackets.reserve (m_ownSlotIds.size ());
+
+  m_decodingAttempts = 0;
+  m_cancellations = 0;
+
+  BuildSlotIndex ();
+
+  for (uint32_t i = 0; i < m_ownSlotIds.size (); i++)
+    {
+      Enqueue (i);
+    }
+
+  NS_LOG_INFO ("SatCrdsaSicEngine::ProcessFrame - Packets to process: " << m_ownSlotIds.size ());
+
+  /// the worklist always yields the first unprocessed packet in (slot, arrival)
+  /// order, which is the packet a full rescan of the frame would find next
+  while (!m_worklist.empty ())
+    {
+      uint32_t index = static_cast<uint32_t> (m_worklist.top () & 0xFFFFFFFF);
+      m_worklist.pop ();
+      m_queued[index] = 0;
+
+      if (!m_alive[index] || m_processed[index])
+        {
+          continue;
+        }
+
+      uint16_t slotId = m_ownSlotIds[index];
+
+      m_processed[index] = 1;
+      m_decodingAttempts++;
+
+      if (!m_decodeCallback (index, m_slotPacketCount[slotId]))
+        {
+          continue;
+        }
+
+      NS_LOG_INFO ("SatCrdsaSicEngine::ProcessFrame - Packet " << index << " in slot " << slotId << " successfully received");
+
+      Remove (index);
+      processedPackets.push_back (index);
+
+      /// eliminate the interference caused by this packet to other packets in this slot
+      ReleaseSlot (slotId, index);
+
+      /// find and remove replicas of the received packet
+      for (uint32_t r = m_replicaOffsets[index]; r < m_replicaOffsets[index + 1]; r++)
+        {
+          uint32_t replica = RemoveReplicas (index, m_replicaSlotIds[r]);
+          ReleaseSlot (m_replicaSlotIds[r], replica);
+        }
+    }
+
+  NS_LOG_INFO ("SatCrdsaSicEngine::ProcessFrame - All successfully received packets processed, decoding attempts: " << m_decodingAttempts);
+
+  /// the rest of the packets are unsuccessfully received packets
+  for (uint32_t k = 0; k < m_slotPackets.size (); k++)
+    {
+      uint32_t index = m_slotPackets[k];
+
+      if (m_alive[index])
+        {
+          if (!m_processed[index])
+            {
+              NS_FATAL_ERROR ("SatCrdsaSicEngine::ProcessFrame - All packets should have been processed by now");
+            }
+
+          Remove (index);
+          processedPackets.push_back (index);
+
+          for (uint32_t r = m_replicaOffsets[index]; r < m_replicaOffsets[index + 1]; r++)
+            {
+              RemoveReplicas (index, m_replicaSlotIds[r]);
+            }
+        }
+    }
+
+  return processedPackets;
+}
+
+} // namespace ns3
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SATELLITE_CRDSA_SIC_ENGINE_H
+#define SATELLITE_CRDSA_SIC_ENGINE_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+
+#include <ns3/callback.h>
+#include <ns3/mac48-address.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Successive interference cancellation (SIC) engine for a CRDSA frame.
+ *
+ * The engine operates on packet indices only; the actual decoding and the
+ * interference subtraction are delegated to the owner through callbacks.
+ * Packets are stored in flat slot-indexed arrays and the packets waiting for
+ * a (re-)decoding attempt are kept in a worklist ordered by (slot ID, arrival
+ * order). When a packet is decoded, only the packets in its own slot and in
+ * the slots of its replicas are released back to the worklist.
+ *
+ * The decoding order is identical to a full rescan of the frame from the
+ * first slot after each successful decoding, i.e. the decoding attempts and
+ * the output order do not depend on the data structure used.
+ */
+class SatCrdsaSicEngine
+{
+public:
+  /**
+   * \brief Callback for decoding a packet.
+   * - Index of the packet
+   * - Number of packets currently in the slot of the packet
+   * Returns true if the packet was successfully decoded.
+   */
+  typedef Callback<bool, uint32_t, uint32_t> DecodeCallback;
+
+  /**
+   * \brief Callback for removing the interference of a decoded packet.
+   * - Index of the packet from which the interference is removed
+   * - Index of the decoded (or replica of the decoded) packet
+   */
+  typedef Callback<void, uint32_t, uint32_t> CancelCallback;
+
+  /**
+   * Constructor.
+   */
+  SatCrdsaSicEngine ();
+
+  /**
+   * Destructor.
+   */
+  ~SatCrdsaSicEngine ();
+
+  /**
+   * \brief Set the callback used to decode a packet
+   * \param cb Decode callback
+   */
+  void SetDecodeCallback (DecodeCallback cb);
+
+  /**
+   * \brief Set the callback used to eliminate the interference of a decoded packet
+   * \param cb Cancel callback
+   */
+  void SetCancelCallback (CancelCallback cb);
+
+  /**
+   * \brief Add a received packet to the frame. Packets are indexed in the order
+   * they are added.
+   * \param ownSlotId Slot ID of the packet
+   * \param slotIdsForOtherReplicas Slot IDs of the replicas of the packet
+   * \param sourceAddress Address of the sender
+   * \return Index of the added packet
+   */
+  uint32_t AddPacket (uint16_t ownSlotId,
+                      const std::vector<uint16_t> &slotIdsForOtherReplicas,
+                      Mac48Address sourceAddress);
+
+  /**
+   * \brief Get the number of packets added to the frame
+   * \return Number of packets
+   */
+  inline uint32_t GetNPackets () const
+  {
+    return m_ownSlotIds.size ();
+  }
+
+  /**
+   * \brief Process the frame. Every packet index is returned once; the
+   * successfully decoded packets first in decoding order, followed by the
+   * unsuccessfully received unique packets in slot order. The replicas of
+   * the returned packets are not returned.
+   * \return Indices of the unique packets in the frame
+   */
+  std::vector<uint32_t> ProcessFrame ();
+
+  /**
+   * \brief Remove all the packets of the frame
+   */
+  void Clear ();
+
+  /**
+   * \brief Get the number of decoding attempts of the last processed frame
+   * \return Number of decoding attempts
+   */
+  inline uint64_t GetNDecodingAttempts () const
+  {
+    return m_decodingAttempts;
+  }
+
+  /**
+   * \brief Get the number of interference cancellations of the last processed frame
+   * \return Number of interference cancellations
+   */
+  inline uint64_t GetNCancellations () const
+  {
+    return m_cancellations;
+  }
+
+private:
+  typedef std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t> > worklist_t;
+
+  /**
+   * \brief Build the slot-indexed packet storage
+   */
+  void BuildSlotIndex ();
+
+  /**
+   * \brief Add a packet to the worklist
+   * \param index Packet index
+   */
+  void Enqueue (uint32_t index);
+
+  /**
+   * \brief Remove a packet from its slot
+   * \param index Packet index
+   */
+  void Remove (uint32_t index);
+
+  /**
+   * \brief Remove the replicas of a packet from a slot
+   * \param index Packet index
+   * \param slotId Slot ID of the replica
+   * \return Index of the (last) removed replica
+   */
+  uint32_t RemoveReplicas (uint32_t index, uint16_t slotId);
+
+  /**
+   * \brief Release the packets in a slot for re-decoding after eliminating
+   * the interference caused by a decoded packet
+   * \param slotId Slot ID
+   * \param interferer Index of the decoded packet in the slot
+   */
+  void ReleaseSlot (uint16_t slotId, uint32_t interferer);
+
+  /**
+   * \brief Check whether two packets of the same sender have identical slots
+   * \param index1 Packet index
+   * \param index2 Packet index
+   * \return Have the packets identical slots
+   */
+  bool HaveSameSlotIds (uint32_t index1, uint32_t index2) const;
+
+  DecodeCallback m_decodeCallback;
+  CancelCallback m_cancelCallback;
+
+  /**
+   * Per packet data
+   */
+  std::vector<uint16_t> m_ownSlotIds;
+  std::vector<Mac48Address> m_sourceAddresses;
+  std::vector<uint32_t> m_replicaOffsets;
+  std::vector<uint16_t> m_replicaSlotIds;
+  std::vector<uint16_t> m_sortedSlotIds;
+  std::vector<uint8_t> m_alive;
+  std::vector<uint8_t> m_processed;
+  std::vector<uint8_t> m_queued;
+
+  /**
+   * Slot-indexed packet storage, packets of slot s are in
+   * m_slotPackets [m_slotOffsets[s], m_slotOffsets[s + 1]) in arrival order.
+   */
+  std::vector<uint32_t> m_slotOffsets;
+  std::vector<uint32_t> m_slotPackets;
+  std::vector<uint32_t> m_slotPacketCount;
+
+  worklist_t m_worklist;
+
+  uint64_t m_decodingAttempts;
+  uint64_t m_cancellations;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_CRDSA_SIC_ENGINE_H */
@@ -70,7 +70,15 @@ SatFadingExternalInputTraceContainer::GetTypeId (void)
                    "Maximum distance allowed to fading source in position based mode [m].",
                    DoubleValue (5000),
                    MakeDoubleAccessor (&SatFadingExternalInputTraceContainer::m_maxDistanceToFading),
-                   MakeDoubleChecker<double> ());
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("FadingStorage",
+                   "Storage type of the linear fading values of the traces. Half precision floats halve "
+                   "the memory of the fading values with relative accuracy of 4.9e-4 between -42.1 dB and 48.2 dB, "
+                   "the fading values outside the range are clamped to it.",
+                   EnumValue (SatFadingExternalInputTrace::ST_FLOAT),
+                   MakeEnumAccessor (&SatFadingExternalInputTraceContainer::m_fadingStorage),
+                   MakeEnumChecker (SatFadingExternalInputTrace::ST_FLOAT, "Float",
+                                    SatFadingExternalInputTrace::ST_HALF_FLOAT, "HalfFloat"));
   return tid;
 }
 
@@ -82,7 +90,8 @@ TypeId SatFadingExternalInputTraceContainer::GetInstanceTypeId (void) const
 SatFadingExternalInputTraceContainer::SatFadingExternalInputTraceContainer ()
   : m_utInputMode (LIST_MODE),
     m_indexFilesLoaded (false),
-    m_maxDistanceToFading (0)
+    m_maxDistanceToFading (0),
+    m_fadingStorage (SatFadingExternalInputTrace::ST_FLOAT)
 {
   NS_LOG_FUNCTION (this);
 
@@ -385,8 +394,9 @@ SatFadingExternalInputTraceContainer::CreateFadingTrace (SatFadingExternalInputT
 
   if ( it == m_loadedTraces.end ())
     {
-      // create if not found
-      trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName);
+      // create if not found, the trace is shared by all the nodes using the same file
+      trace = Create<SatFadingExternalInputTrace> (fileType, m_dataPath + fileName, m_fadingStorage);
+      m_loadedTraces.insert (std::make_pair (fileName, trace));
     }
   else
     {
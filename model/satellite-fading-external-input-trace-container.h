@@ -175,6 +175,9 @@ private:
   /// Maximum distance allowed to the external fading trace source
   double m_maxDistanceToFading;
 
+  /// Storage type of the linear fading values of the traces
+  SatFadingExternalInputTrace::StorageType_e m_fadingStorage;
+
   /**
    * Initialize index files
    */
@@ -20,6 +20,7 @@
 
 #include <fstream>
 #include <algorithm>
+#include <cstring>
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "satellite-fading-external-input-trace.h"
@@ -29,18 +30,31 @@ NS_LOG_COMPONENT_DEFINE ("SatFadingExternalInputTrace");
 
 namespace ns3 {
 
+const float SatFadingExternalInputTrace::MIN_HALF_FADING = 6.103515625e-05f;
+const float SatFadingExternalInputTrace::MAX_HALF_FADING = 65504.0f;
+
 
 SatFadingExternalInputTrace::SatFadingExternalInputTrace ()
   : m_traceFileType (),
+    m_storageType (),
     m_startTime (),
-    m_timeInterval ()
+    m_timeInterval (),
+    m_nSamples (),
+    m_times (),
+    m_fadingFloat (),
+    m_fadingHalf ()
 {
   NS_FATAL_ERROR ("SatFadingExternalInputTrace::SatFadingExternalInputTrace - Constructor not in use");
 }
 
-SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type, std::string fileName)
-  : m_startTime (-1.0),
-    m_timeInterval (-1.0)
+SatFadingExternalInputTrace::SatFadingExternalInputTrace (TraceFileType_e type, std::string fileName, StorageType_e storageType)
+  : m_storageType (storageType),
+    m_startTime (-1.0),
+    m_timeInterval (-1.0),
+    m_nSamples (0),
+    m_times (NULL),
+    m_fadingFloat (NULL),
+    m_fadingHalf (NULL)
 {
   NS_LOG_FUNCTION (this);
 
@@ -75,6 +89,16 @@ void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
         }
     }
 
+  // Use the binary cache of the file, if it is valid
+  Ptr<SatBinaryDataCache> cache = SatBinaryDataCache::Open (filePathName, SatBinaryDataCache::CACHE_FADING_TRACE);
+
+  if (cache != NULL && ReadTraceFromCache (cache))
+    {
+      ifs->close ();
+      delete ifs;
+      return;
+    }
+
   // Currently supports two or three column formats
   uint32_t columns = (m_traceFileType == FT_TWO_COLUMN) ? 2 : 3;
 
@@ -99,7 +123,22 @@ void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
         {
           NS_ASSERT (values.size () == columns);
 
-          m_traceVector.push_back (values);
+          // Fading is stored in linear format
+          float fading = SatUtils::DbToLinear (values[FADING_INDEX]);
+
+          m_timeVector.push_back (values[TIME_INDEX]);
+
+          if (m_storageType == ST_FLOAT)
+            {
+              m_fadingFloatVector.push_back (fading);
+            }
+          else
+            {
+              // The subnormal half precision values lose accuracy, thus deep fades are clamped
+              fading = std::min (std::max (fading, MIN_HALF_FADING), MAX_HALF_FADING);
+              m_fadingHalfVector.push_back (FloatToHalf (fading));
+            }
+
           values.clear ();
 
           // Calculate the sampling interval
@@ -111,13 +150,102 @@ void SatFadingExternalInputTrace::ReadTrace (std::string filePathName)
     }
   ifs->close ();
   delete ifs;
+
+  m_nSamples = m_timeVector.size ();
+  m_times = m_timeVector.empty () ? NULL : &m_timeVector[0];
+  m_fadingFloat = m_fadingFloatVector.empty () ? NULL : &m_fadingFloatVector[0];
+  m_fadingHalf = m_fadingHalfVector.empty () ? NULL : &m_fadingHalfVector[0];
+
+  StoreTraceToCache (filePathName);
+}
+
+bool
+SatFadingExternalInputTrace::ReadTraceFromCache (Ptr<SatBinaryDataCache> cache)
+{
+  NS_LOG_FUNCTION (this << cache);
+
+  // Parameters: file type, storage type, start time, time interval, number of samples,
+  // smallest stored fading value
+  const double *params = cache->GetParams ();
+
+  if (cache->GetNParams () != 6
+      || params[0] != m_traceFileType
+      || params[1] != m_storageType
+      || params[5] != ((m_storageType == ST_FLOAT) ? 0.0 : MIN_HALF_FADING))
+    {
+      return false;
+    }
+
+  uint32_t nSamples = (uint32_t) params[4];
+  uint64_t fadingSize = (m_storageType == ST_FLOAT) ? sizeof (float) : sizeof (uint16_t);
+
+  // Data: time samples followed by the linear fading values
+  if (cache->GetDataSize () < nSamples * (sizeof (float) + fadingSize))
+    {
+      NS_LOG_WARN ("Invalid data size " << cache->GetDataSize () << " in binary cache");
+      return false;
+    }
+
+  m_startTime = params[2];
+  m_timeInterval = params[3];
+  m_nSamples = nSamples;
+
+  const char *data = static_cast<const char *> (cache->GetData ());
+  m_times = reinterpret_cast<const float *> (data);
+
+  if (m_storageType == ST_FLOAT)
+    {
+      m_fadingFloat = reinterpret_cast<const float *> (data + nSamples * sizeof (float));
+    }
+  else
+    {
+      m_fadingHalf = reinterpret_cast<const uint16_t *> (data + nSamples * sizeof (float));
+    }
+
+  m_cache = cache;
+
+  return true;
+}
+
+void
+SatFadingExternalInputTrace::StoreTraceToCache (std::string filePathName) const
+{
+  NS_LOG_FUNCTION (this << filePathName);
+
+  std::vector<double> params;
+  params.push_back (m_traceFileType);
+  params.push_back (m_storageType);
+  params.push_back (m_startTime);
+  params.push_back (m_timeInterval);
+  params.push_back (m_nSamples);
+  params.push_back ((m_storageType == ST_FLOAT) ? 0.0 : MIN_HALF_FADING);
+
+  std::vector<char> data (m_timeVector.size () * sizeof (float));
+
+  if (!m_timeVector.empty ())
+    {
+      std::memcpy (&data[0], &m_timeVector[0], m_timeVector.size () * sizeof (float));
+    }
+
+  if (m_storageType == ST_FLOAT)
+    {
+      const char *fading = reinterpret_cast<const char *> (m_fadingFloat);
+      data.insert (data.end (), fading, fading + m_nSamples * sizeof (float));
+    }
+  else
+    {
+      const char *fading = reinterpret_cast<const char *> (m_fadingHalf);
+      data.insert (data.end (), fading, fading + m_nSamples * sizeof (uint16_t));
+    }
+
+  SatBinaryDataCache::Store (filePathName, SatBinaryDataCache::CACHE_FADING_TRACE, params, data.empty () ? NULL : &data[0], data.size ());
 }
 
 double
 SatFadingExternalInputTrace::GetFading () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (m_nSamples > 0);
 
   float simTime = Simulator::Now ().GetSeconds ();
 
@@ -129,31 +257,22 @@ SatFadingExternalInputTrace::GetFading () const
   // Calculate the index to the time sample just before current time
   uint32_t lowerIndex = (uint32_t)(std::floor (std::abs (simTime - m_startTime) / m_timeInterval));
 
-  if (lowerIndex >= m_traceVector.size ())
+  if (lowerIndex + 1 >= m_nSamples)
     {
-      NS_LOG_ERROR (this << " calculated index exceeds trace file size!");
+      NS_FATAL_ERROR ("SatFadingExternalInputTrace::GetFading - calculated index " << lowerIndex << " exceeds trace file size " << m_nSamples);
     }
 
-  float lowerKey = m_traceVector.at (lowerIndex).at (TIME_INDEX);
-  float upperKey = m_traceVector.at (lowerIndex + 1).at (TIME_INDEX);
+  float lowerKey = m_times[lowerIndex];
+  float upperKey = m_times[lowerIndex + 1];
 
   // Interpolation in linear domain
-  float lowerVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex).at (FADING_INDEX));
-  float upperVal = SatUtils::DbToLinear (m_traceVector.at (lowerIndex + 1).at (FADING_INDEX));
+  float lowerVal = GetLinearFading (lowerIndex);
+  float upperVal = GetLinearFading (lowerIndex + 1);
 
   // y = y0 + (y1 - y0) * (x - x0) / (x1 - x0)
   double fading = lowerVal + (upperVal - lowerVal)
     * (simTime - lowerKey) / (upperKey - lowerKey);
 
-  /*
-  std::cout << "Now: " << simTime <<
-      ", interpolated fading: " << fading_dB <<
-      ", interpolated fading: " << SatUtils::DbToLinear (fading_dB) <<
-      ", Lower time: " << lowerKey <<
-      ", Upper time: " << upperKey <<
-      ", Lower fading: " << lowerVal <<
-      ", Upper fading: " << upperVal << std::endl;
-  */
   return fading;
 }
 
@@ -161,17 +280,16 @@ bool
 SatFadingExternalInputTrace::TestFadingTrace () const
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (!m_traceVector.empty ());
+  NS_ASSERT (m_nSamples > 0);
 
-  std::vector<std::vector<float> >::const_iterator cit;
   float prevTime (-1.0);
   float currTime (-1.0);
 
-  for (cit = m_traceVector.begin (); cit != m_traceVector.end (); ++cit)
+  for (uint32_t i = 0; i < m_nSamples; ++i)
     {
       if (prevTime > 0)
         {
-          currTime = cit->at (TIME_INDEX);
+          currTime = m_times[i];
           double diff = std::abs ( std::abs (currTime - prevTime) - m_timeInterval);
 
           // Test that the the time samples are from constant interval and
@@ -181,11 +299,109 @@ SatFadingExternalInputTrace::TestFadingTrace () const
               return false;
             }
         }
-      prevTime = cit->at (TIME_INDEX);
+      prevTime = m_times[i];
     }
 
   // Succeeded
   return true;
 }
 
+uint16_t
+SatFadingExternalInputTrace::FloatToHalf (float value)
+{
+  uint32_t x;
+  std::memcpy (&x, &value, sizeof (x));
+
+  uint32_t sign = (x >> 16) & 0x8000;
+  uint32_t exponent = (x >> 23) & 0xff;
+  uint32_t mantissa = x & 0x7fffff;
+
+  // Infinity and NaN
+  if (exponent == 0xff)
+    {
+      return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+    }
+
+  int32_t halfExponent = static_cast<int32_t> (exponent) - 127 + 15;
+
+  // Overflow to infinity
+  if (halfExponent >= 31)
+    {
+      return sign | 0x7c00;
+    }
+
+  // Subnormal half precision values
+  if (halfExponent <= 0)
+    {
+      if (halfExponent < -10)
+        {
+          return sign;
+        }
+
+      mantissa |= 0x800000;
+      uint32_t shift = 14 - halfExponent;
+      uint32_t half = mantissa >> shift;
+      uint32_t remainder = mantissa & ((1u << shift) - 1);
+      uint32_t halfway = 1u << (shift - 1);
+
+      if (remainder > halfway || (remainder == halfway && (half & 1)))
+        {
+          half++;
+        }
+      return sign | half;
+    }
+
+  // Round to nearest even, a carry to the exponent is correct
+  uint32_t half = sign | (halfExponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+      half++;
+    }
+  return half;
+}
+
+float
+SatFadingExternalInputTrace::HalfToFloat (uint16_t half)
+{
+  uint32_t sign = (half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  uint32_t x;
+
+  if (exponent == 0)
+    {
+      if (mantissa == 0)
+        {
+          x = sign;
+        }
+      else
+        {
+          // Normalize the subnormal value
+          int32_t shift = -1;
+          do
+            {
+              shift++;
+              mantissa <<= 1;
+            }
+          while ((mantissa & 0x400) == 0);
+
+          x = sign | ((127 - 15 - shift) << 23) | ((mantissa & 0x3ff) << 13);
+        }
+    }
+  else if (exponent == 31)
+    {
+      x = sign | 0x7f800000 | (mantissa << 13);
+    }
+  else
+    {
+      x = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+  float value;
+  std::memcpy (&value, &x, sizeof (value));
+  return value;
+}
+
 } // namespace ns3
@@ -22,7 +22,10 @@
 #define SATELLITE_FADING_EXTERNAL_INPUT_TRACE_H
 
 #include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/satellite-binary-data-cache.h"
 
 namespace ns3 {
 
@@ -31,6 +34,16 @@ namespace ns3 {
  * \brief The class for satellite fading external input trace. The class reads
  * fading trace input samples from a file and provides the current fading value
  * for this specific fading file.
+ *
+ * The time samples and the fading values converted to linear format are
+ * stored in flat arrays. The fading values are stored either as single
+ * precision floats, which gives exactly the same fading as the values in dB,
+ * or as half precision floats. The half precision values have relative accuracy
+ * of 4.9e-4 between MIN_HALF_FADING and MAX_HALF_FADING (-42.1 dB ... 48.2 dB),
+ * and the fading values outside the range are clamped to it. If the binary data
+ * cache is enabled (see SatEnvVariables), the packed arrays are stored into
+ * the cache of the trace file and memory-mapped on later loads, so that the
+ * processes using the same trace file share the memory.
  */
 class SatFadingExternalInputTrace : public SimpleRefCount <SatFadingExternalInputTrace>
 {
@@ -41,6 +54,12 @@ public:
     FT_THREE_COLUMN
   };
 
+  enum StorageType_e
+  {
+    ST_FLOAT,
+    ST_HALF_FLOAT
+  };
+
   /**
    * Default constructor.
    */
@@ -50,8 +69,9 @@ public:
    * Constructor with initialization parameters.
    * \param type 
    * \param filePathName 
+   * \param storageType Storage type of the linear fading values
    */
-  SatFadingExternalInputTrace (TraceFileType_e type, std::string filePathName);
+  SatFadingExternalInputTrace (TraceFileType_e type, std::string filePathName, StorageType_e storageType);
 
   /**
    * Destructor for SatFadingExternalInputTrace
@@ -71,6 +91,32 @@ public:
    */
   bool TestFadingTrace () const;
 
+  /**
+   * Convert a single precision float to half precision float (round to
+   * nearest even)
+   * \param value Single precision value
+   * \return Half precision value
+   */
+  static uint16_t FloatToHalf (float value);
+
+  /**
+   * Convert a half precision float to single precision float
+   * \param half Half precision value
+   * \return Single precision value
+   */
+  static float HalfToFloat (uint16_t half);
+
+  /**
+   * Smallest linear fading value stored with full accuracy as half precision
+   * float, i.e. the smallest normal half precision value (about -42.1 dB)
+   */
+  static const float MIN_HALF_FADING;
+
+  /**
+   * Largest linear fading value stored as half precision float (about 48.2 dB)
+   */
+  static const float MAX_HALF_FADING;
+
 private:
   /**
    * Read the fading trace from a binary file
@@ -78,6 +124,29 @@ private:
    */
   void ReadTrace (std::string filePathName);
 
+  /**
+   * Use the packed trace arrays from the binary data cache
+   * \param cache Binary data cache of the trace file
+   * \return true if the cache contains the trace in the requested storage type
+   */
+  bool ReadTraceFromCache (Ptr<SatBinaryDataCache> cache);
+
+  /**
+   * Store the packed trace arrays into the binary data cache
+   * \param filePathName Path and file name of the fading file
+   */
+  void StoreTraceToCache (std::string filePathName) const;
+
+  /**
+   * Get the linear fading value of a sample
+   * \param index Index of the sample
+   * \return fading value in linear format
+   */
+  inline float GetLinearFading (uint32_t index) const
+  {
+    return (m_storageType == ST_FLOAT) ? m_fadingFloat[index] : HalfToFloat (m_fadingHalf[index]);
+  }
+
   /**
    * There may be different fading file types.
    * - FT_TWO_COLUMN
@@ -90,6 +159,11 @@ private:
    */
   TraceFileType_e m_traceFileType;
 
+  /**
+   * Storage type of the linear fading values
+   */
+  StorageType_e m_storageType;
+
   /**
    * Constant indices used in the fading container
    */
@@ -107,9 +181,36 @@ private:
   float m_timeInterval;
 
   /**
-   * Container for the fading trace.
+   * Number of time samples in the trace
+   */
+  uint32_t m_nSamples;
+
+  /**
+   * Time samples, points either to m_timeVector or to the binary data cache
+   */
+  const float* m_times;
+
+  /**
+   * Linear fading values in single precision, if storage type is ST_FLOAT
+   */
+  const float* m_fadingFloat;
+
+  /**
+   * Linear fading values in half precision, if storage type is ST_HALF_FLOAT
+   */
+  const uint16_t* m_fadingHalf;
+
+  /**
+   * Memory-mapped binary data cache holding the arrays, if in use
+   */
+  Ptr<SatBinaryDataCache> m_cache;
+
+  /**
+   * Arrays of the trace, when the binary data cache is not in use
    */
-  std::vector<std::vector<float> > m_traceVector;
+  std::vector<float> m_timeVector;
+  std::vector<float> m_fadingFloatVector;
+  std::vector<uint16_t> m_fadingHalfVector;
 };
 
 } // namespace ns3
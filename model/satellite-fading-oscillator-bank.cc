@@ -0,0 +1,482 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+
+#include "satellite-fading-oscillator-bank.h"
+
+#if defined (__AVX__)
+#include <immintrin.h>
+#define SAT_OSCILLATOR_SIMD_WIDTH 4
+#elif defined (__SSE2__)
+#include <emmintrin.h>
+#define SAT_OSCILLATOR_SIMD_WIDTH 2
+#endif
+
+NS_LOG_COMPONENT_DEFINE ("SatFadingOscillatorBank");
+
+namespace ns3 {
+
+/**
+ * Constants of the sine/cosine kernel. The argument is reduced into
+ * [-pi/4, pi/4] with a three part pi/2 (Cody-Waite), and the sine and
+ * cosine of the reduced argument are evaluated with the fdlibm kernel
+ * polynomials. The reduction is exact for arguments up to MAX_ARGUMENT,
+ * larger arguments are evaluated with std::sin and std::cos.
+ */
+static const double TWO_OVER_PI = 6.36619772367581382433e-01;
+static const double PIO2_1 = 1.57079632673412561417e+00;
+static const double PIO2_2 = 6.07710050630396597660e-11;
+static const double PIO2_3 = 2.02226624879595063154e-21;
+static const double MAX_ARGUMENT = 1.0e6;
+static const double ROUND_SHIFTER = 6755399441055744.0;
+
+static const double S1 = -1.66666666666666324348e-01;
+static const double S2 = 8.33333333332248946124e-03;
+static const double S3 = -1.98412698298579493134e-04;
+static const double S4 = 2.75573137070700676789e-06;
+static const double S5 = -2.50507602534068634195e-08;
+static const double S6 = 1.58969099521155010221e-10;
+
+static const double C1 = 4.16666666666666019037e-02;
+static const double C2 = -1.38888888888741095749e-03;
+static const double C3 = 2.48015872894767294178e-05;
+static const double C4 = -2.75573143513906633035e-07;
+static const double C5 = 2.08757232129817482790e-09;
+static const double C6 = -1.13596475577881948265e-11;
+
+/**
+ * Taylor coefficients 1/k! of the exponential function, the series is
+ * used for arguments within [-1, 1] only (cosine of the phase).
+ */
+static const uint32_t EXP_TERMS = 19;
+static const double EXP_COEFFICIENTS[EXP_TERMS] =
+{
+  1.0, 1.0, 0.5, 0.16666666666666666, 0.041666666666666664,
+  0.008333333333333333, 0.001388888888888889, 0.0001984126984126984,
+  2.48015873015873e-05, 2.7557319223985893e-06, 2.755731922398589e-07,
+  2.505210838544172e-08, 2.08767569878681e-09, 1.6059043836821613e-10,
+  1.1470745597729725e-11, 7.647163731819816e-13, 4.779477332387385e-14,
+  2.8114572543455206e-15, 1.5619206968586225e-16
+};
+
+static inline double
+RoundToInteger (double x)
+{
+  return (x + ROUND_SHIFTER) - ROUND_SHIFTER;
+}
+
+/**
+ * \brief Scalar version of the sine/cosine kernel
+ * \param x argument
+ * \param s sine of the argument
+ * \param c cosine of the argument
+ */
+static inline void
+SinCos (double x, double &s, double &c)
+{
+  if (std::fabs (x) > MAX_ARGUMENT)
+    {
+      s = std::sin (x);
+      c = std::cos (x);
+      return;
+    }
+
+  double q = RoundToInteger (x * TWO_OVER_PI);
+  double r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+  double z = r * r;
+
+  double sr = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+  double cr = (1.0 - 0.5 * z) + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+
+  // quadrant of the argument, 0 ... 3
+  double quadrant = q - 4.0 * RoundToInteger (q * 0.25 - 0.375);
+
+  bool swap = (quadrant == 1.0 || quadrant == 3.0);
+  s = swap ? cr : sr;
+  c = swap ? sr : cr;
+
+  if (quadrant >= 2.0)
+    {
+      s = -s;
+    }
+  if (quadrant == 1.0 || quadrant == 2.0)
+    {
+      c = -c;
+    }
+}
+
+/**
+ * \brief Scalar version of the exponential kernel
+ * \param x argument within [-1, 1]
+ * \return exponential of the argument
+ */
+static inline double
+ExpUnit (double x)
+{
+  double e = EXP_COEFFICIENTS[EXP_TERMS - 1];
+  for (int32_t k = EXP_TERMS - 2; k >= 0; k--)
+    {
+      e = e * x + EXP_COEFFICIENTS[k];
+    }
+  return e;
+}
+
+#ifdef SAT_OSCILLATOR_SIMD_WIDTH
+
+#if defined (__AVX__)
+
+typedef __m256d SatVector_t;
+
+static inline SatVector_t VecSet (double v) { return _mm256_set1_pd (v); }
+static inline SatVector_t VecLoad (const double *p) { return _mm256_loadu_pd (p); }
+static inline void VecStore (double *p, SatVector_t a) { _mm256_storeu_pd (p, a); }
+static inline SatVector_t VecAdd (SatVector_t a, SatVector_t b) { return _mm256_add_pd (a, b); }
+static inline SatVector_t VecSub (SatVector_t a, SatVector_t b) { return _mm256_sub_pd (a, b); }
+static inline SatVector_t VecMul (SatVector_t a, SatVector_t b) { return _mm256_mul_pd (a, b); }
+static inline SatVector_t VecAnd (SatVector_t a, SatVector_t b) { return _mm256_and_pd (a, b); }
+static inline SatVector_t VecAndNot (SatVector_t a, SatVector_t b) { return _mm256_andnot_pd (a, b); }
+static inline SatVector_t VecOr (SatVector_t a, SatVector_t b) { return _mm256_or_pd (a, b); }
+static inline SatVector_t VecXor (SatVector_t a, SatVector_t b) { return _mm256_xor_pd (a, b); }
+static inline SatVector_t VecCmpEq (SatVector_t a, SatVector_t b) { return _mm256_cmp_pd (a, b, _CMP_EQ_OQ); }
+static inline SatVector_t VecCmpGe (SatVector_t a, SatVector_t b) { return _mm256_cmp_pd (a, b, _CMP_GE_OQ); }
+static inline SatVector_t VecCmpGt (SatVector_t a, SatVector_t b) { return _mm256_cmp_pd (a, b, _CMP_GT_OQ); }
+static inline int VecMoveMask (SatVector_t a) { return _mm256_movemask_pd (a); }
+
+#else
+
+typedef __m128d SatVector_t;
+
+static inline SatVector_t VecSet (double v) { return _mm_set1_pd (v); }
+static inline SatVector_t VecLoad (const double *p) { return _mm_loadu_pd (p); }
+static inline void VecStore (double *p, SatVector_t a) { _mm_storeu_pd (p, a); }
+static inline SatVector_t VecAdd (SatVector_t a, SatVector_t b) { return _mm_add_pd (a, b); }
+static inline SatVector_t VecSub (SatVector_t a, SatVector_t b) { return _mm_sub_pd (a, b); }
+static inline SatVector_t VecMul (SatVector_t a, SatVector_t b) { return _mm_mul_pd (a, b); }
+static inline SatVector_t VecAnd (SatVector_t a, SatVector_t b) { return _mm_and_pd (a, b); }
+static inline SatVector_t VecAndNot (SatVector_t a, SatVector_t b) { return _mm_andnot_pd (a, b); }
+static inline SatVector_t VecOr (SatVector_t a, SatVector_t b) { return _mm_or_pd (a, b); }
+static inline SatVector_t VecXor (SatVector_t a, SatVector_t b) { return _mm_xor_pd (a, b); }
+static inline SatVector_t VecCmpEq (SatVector_t a, SatVector_t b) { return _mm_cmpeq_pd (a, b); }
+static inline SatVector_t VecCmpGe (SatVector_t a, SatVector_t b) { return _mm_cmpge_pd (a, b); }
+static inline SatVector_t VecCmpGt (SatVector_t a, SatVector_t b) { return _mm_cmpgt_pd (a, b); }
+static inline int VecMoveMask (SatVector_t a) { return _mm_movemask_pd (a); }
+
+#endif
+
+static inline SatVector_t
+VecSelect (SatVector_t mask, SatVector_t a, SatVector_t b)
+{
+  return VecOr (VecAnd (mask, a), VecAndNot (mask, b));
+}
+
+static inline SatVector_t
+VecRoundToInteger (SatVector_t x)
+{
+  SatVector_t shifter = VecSet (ROUND_SHIFTER);
+  return VecSub (VecAdd (x, shifter), shifter);
+}
+
+static inline SatVector_t
+VecPolynomial6 (SatVector_t z, double k1, double k2, double k3, double k4, double k5, double k6)
+{
+  SatVector_t p = VecSet (k6);
+  p = VecAdd (VecMul (z, p), VecSet (k5));
+  p = VecAdd (VecMul (z, p), VecSet (k4));
+  p = VecAdd (VecMul (z, p), VecSet (k3));
+  p = VecAdd (VecMul (z, p), VecSet (k2));
+  return VecAdd (VecMul (z, p), VecSet (k1));
+}
+
+/**
+ * \brief Vector version of the sine/cosine kernel, each lane gives the same
+ * result as the scalar version
+ * \param x arguments
+ * \param s sines of the arguments
+ * \param c cosines of the arguments
+ */
+static inline void
+VecSinCos (SatVector_t x, SatVector_t &s, SatVector_t &c)
+{
+  SatVector_t signMask = VecSet (-0.0);
+
+  SatVector_t q = VecRoundToInteger (VecMul (x, VecSet (TWO_OVER_PI)));
+  SatVector_t r = VecSub (x, VecMul (q, VecSet (PIO2_1)));
+  r = VecSub (r, VecMul (q, VecSet (PIO2_2)));
+  r = VecSub (r, VecMul (q, VecSet (PIO2_3)));
+  SatVector_t z = VecMul (r, r);
+
+  SatVector_t sr = VecAdd (r, VecMul (VecMul (r, z), VecPolynomial6 (z, S1, S2, S3, S4, S5, S6)));
+  SatVector_t cr = VecAdd (VecSub (VecSet (1.0), VecMul (VecSet (0.5), z)),
+                           VecMul (VecMul (z, z), VecPolynomial6 (z, C1, C2, C3, C4, C5, C6)));
+
+  SatVector_t quadrant = VecSub (q, VecMul (VecSet (4.0), VecRoundToInteger (VecSub (VecMul (q, VecSet (0.25)), VecSet (0.375)))));
+
+  SatVector_t isOne = VecCmpEq (quadrant, VecSet (1.0));
+  SatVector_t isTwo = VecCmpEq (quadrant, VecSet (2.0));
+  SatVector_t isThree = VecCmpEq (quadrant, VecSet (3.0));
+
+  SatVector_t swap = VecOr (isOne, isThree);
+  s = VecXor (VecSelect (swap, cr, sr), VecAnd (VecCmpGe (quadrant, VecSet (2.0)), signMask));
+  c = VecXor (VecSelect (swap, sr, cr), VecAnd (VecOr (isOne, isTwo), signMask));
+
+  // arguments beyond the exact reduction are evaluated lane by lane
+  if (VecMoveMask (VecCmpGt (VecAndNot (signMask, x), VecSet (MAX_ARGUMENT))) != 0)
+    {
+      double xs[SAT_OSCILLATOR_SIMD_WIDTH];
+      double ss[SAT_OSCILLATOR_SIMD_WIDTH];
+      double cs[SAT_OSCILLATOR_SIMD_WIDTH];
+
+      VecStore (xs, x);
+      for (uint32_t k = 0; k < SAT_OSCILLATOR_SIMD_WIDTH; k++)
+        {
+          SinCos (xs[k], ss[k], cs[k]);
+        }
+      s = VecLoad (ss);
+      c = VecLoad (cs);
+    }
+}
+
+/**
+ * \brief Vector version of the exponential kernel
+ * \param x arguments within [-1, 1]
+ * \return exponentials of the arguments
+ */
+static inline SatVector_t
+VecExpUnit (SatVector_t x)
+{
+  SatVector_t e = VecSet (EXP_COEFFICIENTS[EXP_TERMS - 1]);
+  for (int32_t k = EXP_TERMS - 2; k >= 0; k--)
+    {
+      e = VecAdd (VecMul (e, x), VecSet (EXP_COEFFICIENTS[k]));
+    }
+  return e;
+}
+
+static inline double
+VecHorizontalSum (SatVector_t a)
+{
+  double values[SAT_OSCILLATOR_SIMD_WIDTH];
+  VecStore (values, a);
+
+  double sum = 0.0;
+  for (uint32_t k = 0; k < SAT_OSCILLATOR_SIMD_WIDTH; k++)
+    {
+      sum += values[k];
+    }
+  return sum;
+}
+
+#endif
+
+SatFadingOscillatorBank::SatFadingOscillatorBank ()
+  : m_amplitudeRe (),
+    m_amplitudeIm (),
+    m_omega (),
+    m_phase ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SatFadingOscillatorBank::AddOscillator (std::complex<double> amplitude, double initialPhase, double omega)
+{
+  NS_LOG_FUNCTION (this << amplitude << initialPhase << omega);
+
+  m_amplitudeRe.push_back (amplitude.real ());
+  m_amplitudeIm.push_back (amplitude.imag ());
+  m_omega.push_back (omega);
+  m_phase.push_back (initialPhase);
+}
+
+void
+SatFadingOscillatorBank::AddOscillator (double amplitude, double initialPhase, double omega)
+{
+  NS_LOG_FUNCTION (this << amplitude << initialPhase << omega);
+
+  m_amplitudeRe.push_back (amplitude);
+  m_amplitudeIm.push_back (0.0);
+  m_omega.push_back (omega);
+  m_phase.push_back (initialPhase);
+}
+
+void
+SatFadingOscillatorBank::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_amplitudeRe.clear ();
+  m_amplitudeIm.clear ();
+  m_omega.clear ();
+  m_phase.clear ();
+}
+
+std::complex<double>
+SatFadingOscillatorBank::GetComplexSum (double timeInSeconds, EvaluationMode_t mode) const
+{
+  NS_LOG_FUNCTION (this << timeInSeconds << mode);
+
+  uint32_t n = m_omega.size ();
+
+  switch (mode)
+    {
+    case EVALUATION_DETERMINISTIC:
+      {
+        // same operations in the same order as with SatFadingOscillator::GetComplexValueAt
+        std::complex<double> complexSum = std::complex<double> (0, 0);
+
+        for (uint32_t i = 0; i < n; i++)
+          {
+            complexSum += std::complex<double> (m_amplitudeRe[i], m_amplitudeIm[i]) * std::cos (timeInSeconds * m_omega[i] + m_phase[i]);
+          }
+
+        return complexSum;
+      }
+    case EVALUATION_VECTORIZED:
+      {
+        double sumRe = 0.0;
+        double sumIm = 0.0;
+        uint32_t i = 0;
+
+#ifdef SAT_OSCILLATOR_SIMD_WIDTH
+        SatVector_t t = VecSet (timeInSeconds);
+        SatVector_t accRe = VecSet (0.0);
+        SatVector_t accIm = VecSet (0.0);
+
+        for (; i + SAT_OSCILLATOR_SIMD_WIDTH <= n; i += SAT_OSCILLATOR_SIMD_WIDTH)
+          {
+            SatVector_t s;
+            SatVector_t c;
+            VecSinCos (VecAdd (VecMul (t, VecLoad (&m_omega[i])), VecLoad (&m_phase[i])), s, c);
+
+            accRe = VecAdd (accRe, VecMul (VecLoad (&m_amplitudeRe[i]), c));
+            accIm = VecAdd (accIm, VecMul (VecLoad (&m_amplitudeIm[i]), c));
+          }
+
+        sumRe = VecHorizontalSum (accRe);
+        sumIm = VecHorizontalSum (accIm);
+#endif
+
+        for (; i < n; i++)
+          {
+            double s;
+            double c;
+            SinCos (timeInSeconds * m_omega[i] + m_phase[i], s, c);
+
+            sumRe += m_amplitudeRe[i] * c;
+            sumIm += m_amplitudeIm[i] * c;
+          }
+
+        return std::complex<double> (sumRe, sumIm);
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatFadingOscillatorBank::GetComplexSum - Invalid evaluation mode");
+        break;
+      }
+    }
+
+  return std::complex<double> (0, 0);
+}
+
+std::complex<double>
+SatFadingOscillatorBank::GetCosineWaveSum (double timeInSeconds, EvaluationMode_t mode) const
+{
+  NS_LOG_FUNCTION (this << timeInSeconds << mode);
+
+  uint32_t n = m_omega.size ();
+
+  switch (mode)
+    {
+    case EVALUATION_DETERMINISTIC:
+      {
+        // same operations in the same order as with SatFadingOscillator::GetCosineWaveValueAt
+        std::complex<double> complexSum = std::complex<double> (0, 0);
+
+        for (uint32_t i = 0; i < n; i++)
+          {
+            std::complex<double> complexPhase ( std::cos (timeInSeconds * m_omega[i] + m_phase[i]), std::sin (timeInSeconds * m_omega[i] + m_phase[i]) );
+            complexSum += m_amplitudeRe[i] * std::exp (complexPhase);
+          }
+
+        return complexSum;
+      }
+    case EVALUATION_VECTORIZED:
+      {
+        // exp (c + j s) = exp (c) * (cos (s) + j sin (s))
+        double sumRe = 0.0;
+        double sumIm = 0.0;
+        uint32_t i = 0;
+
+#ifdef SAT_OSCILLATOR_SIMD_WIDTH
+        SatVector_t t = VecSet (timeInSeconds);
+        SatVector_t accRe = VecSet (0.0);
+        SatVector_t accIm = VecSet (0.0);
+
+        for (; i + SAT_OSCILLATOR_SIMD_WIDTH <= n; i += SAT_OSCILLATOR_SIMD_WIDTH)
+          {
+            SatVector_t s;
+            SatVector_t c;
+            VecSinCos (VecAdd (VecMul (t, VecLoad (&m_omega[i])), VecLoad (&m_phase[i])), s, c);
+
+            SatVector_t ss;
+            SatVector_t cs;
+            VecSinCos (s, ss, cs);
+
+            SatVector_t magnitude = VecMul (VecLoad (&m_amplitudeRe[i]), VecExpUnit (c));
+
+            accRe = VecAdd (accRe, VecMul (magnitude, cs));
+            accIm = VecAdd (accIm, VecMul (magnitude, ss));
+          }
+
+        sumRe = VecHorizontalSum (accRe);
+        sumIm = VecHorizontalSum (accIm);
+#endif
+
+        for (; i < n; i++)
+          {
+            double s;
+            double c;
+            SinCos (timeInSeconds * m_omega[i] + m_phase[i], s, c);
+
+            double ss;
+            double cs;
+            SinCos (s, ss, cs);
+
+            double magnitude = m_amplitudeRe[i] * ExpUnit (c);
+
+            sumRe += magnitude * cs;
+            sumIm += magnitude * ss;
+          }
+
+        return std::complex<double> (sumRe, sumIm);
+      }
+    default:
+      {
+        NS_FATAL_ERROR ("SatFadingOscillatorBank::GetCosineWaveSum - Invalid evaluation mode");
+        break;
+      }
+    }
+
+  return std::complex<double> (0, 0);
+}
+
+} // namespace ns3
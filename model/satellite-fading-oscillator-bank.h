@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SATELLITE_FADING_OSCILLATOR_BANK_H
+#define SATELLITE_FADING_OSCILLATOR_BANK_H
+
+#include <complex>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Bank of fading oscillators stored as structure of arrays (amplitude
+ * real and imaginary parts, rotation speed and initial phase). The bank
+ * evaluates the sum of the oscillators at a given time either with the
+ * reference evaluation, which gives bit-exactly the same result as summing
+ * the values of SatFadingOscillator objects in order, or with a vectorized
+ * sine/cosine kernel (AVX or SSE2 if enabled at compile time, scalar
+ * otherwise). The vectorized evaluation differs from the reference within
+ * the floating point accuracy.
+ */
+class SatFadingOscillatorBank
+{
+public:
+  /**
+   * \brief Evaluation mode of the oscillator sums
+   */
+  typedef enum
+  {
+    EVALUATION_DETERMINISTIC,//!< Reference evaluation, bit-exact with SatFadingOscillator
+    EVALUATION_VECTORIZED    //!< Vectorized sine/cosine kernel
+  } EvaluationMode_t;
+
+  /**
+   * \brief Constructor
+   */
+  SatFadingOscillatorBank ();
+
+  /**
+   * \brief Add an oscillator with complex amplitude
+   * \param amplitude complex amplitude
+   * \param initialPhase initial phase
+   * \param omega rotation speed
+   */
+  void AddOscillator (std::complex<double> amplitude, double initialPhase, double omega);
+
+  /**
+   * \brief Add an oscillator with real amplitude (cosine wave oscillator)
+   * \param amplitude amplitude
+   * \param initialPhase initial phase
+   * \param omega rotation speed
+   */
+  void AddOscillator (double amplitude, double initialPhase, double omega);
+
+  /**
+   * \brief Remove all the oscillators
+   */
+  void Clear ();
+
+  /**
+   * \brief Get the number of oscillators
+   * \return number of oscillators
+   */
+  inline uint32_t GetNOscillators () const
+  {
+    return m_omega.size ();
+  }
+
+  /**
+   * \brief Sum of the complex values of the oscillators at time t, i.e.
+   * sum of amplitude * cos (omega * t + phase).
+   * \param timeInSeconds time in seconds
+   * \param mode evaluation mode
+   * \return complex sum
+   */
+  std::complex<double> GetComplexSum (double timeInSeconds, EvaluationMode_t mode) const;
+
+  /**
+   * \brief Sum of the cosine wave values of the oscillators at time t, i.e.
+   * sum of amplitude * exp (cos (omega * t + phase) + j sin (omega * t + phase)).
+   * Only the real part of the amplitudes is used.
+   * \param timeInSeconds time in seconds
+   * \param mode evaluation mode
+   * \return complex sum
+   */
+  std::complex<double> GetCosineWaveSum (double timeInSeconds, EvaluationMode_t mode) const;
+
+private:
+  /**
+   * \brief Real part of the amplitudes
+   */
+  std::vector<double> m_amplitudeRe;
+
+  /**
+   * \brief Imaginary part of the amplitudes
+   */
+  std::vector<double> m_amplitudeIm;
+
+  /**
+   * \brief Rotation speeds
+   */
+  std::vector<double> m_omega;
+
+  /**
+   * \brief Initial phases
+   */
+  std::vector<double> m_phase;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_FADING_OSCILLATOR_BANK_H */
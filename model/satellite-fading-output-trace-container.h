@@ -78,7 +78,7 @@ public:
    * \param key key
    * \param newItem vector of values
    */
-  void AddToContainer (key_t key, std::vector<double> newItem);
+  void AddToContainer (key_t key, const std::vector<double>& newItem);
 
   /**
    * Function for enabling / disabling figure output
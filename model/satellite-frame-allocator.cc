@@ -54,7 +54,7 @@ SatFrameAllocator::SatFrameAllocInfo::SatFrameAllocInfo (uint8_t countOfRcs)
   m_allocInfoPerRc = SatFrameAllocInfoItemContainer_t (countOfRcs, SatFrameAllocInfoItem ());
 }
 
-SatFrameAllocator::SatFrameAllocInfo::SatFrameAllocInfo (SatFrameAllocReqItemContainer_t &req, Ptr<SatWaveform> trcWaveForm,
+SatFrameAllocator::SatFrameAllocInfo::SatFrameAllocInfo (SatFrameAllocReqItemContainer_t &req, const Ptr<SatWaveform>& trcWaveForm,
                                                          bool ctrlSlotPresent, double ctrlSlotLength)
   : m_ctrlSlotPresent (ctrlSlotPresent),
     m_craSymbols (0.0),
@@ -125,33 +125,33 @@ SatFrameAllocator::SatFrameAllocInfo::GetTotalSymbols ()
   return (m_craSymbols + m_rbdcSymbols + m_vbdcSymbols);
 }
 
-SatFrameAllocator::CcReqCompare::CcReqCompare (const UtAllocContainer_t& utAllocContainer, CcReqCompare::CcReqType_t ccReqType)
-  : m_utAllocContainer (utAllocContainer),
+SatFrameAllocator::CcReqCompare::CcReqCompare (const UtAllocInfoTable_t& utRequests, CcReqCompare::CcReqType_t ccReqType)
+  : m_utRequests (utRequests),
     m_ccReqType (ccReqType)
 {
 
 }
 
 bool
-SatFrameAllocator::CcReqCompare::operator() (RcAllocItem_t rcAlloc1, RcAllocItem_t rcAlloc2)
+SatFrameAllocator::CcReqCompare::operator() (const RcAllocItem_t& rcAlloc1, const RcAllocItem_t& rcAlloc2) const
 {
   bool result = false;
 
   switch (m_ccReqType)
     {
     case CC_TYPE_MIN_RBDC:
-      result = ( m_utAllocContainer.at (rcAlloc1.first).m_request.m_allocInfoPerRc[rcAlloc1.second].m_minRbdcSymbols <
-                 m_utAllocContainer.at (rcAlloc2.first).m_request.m_allocInfoPerRc[rcAlloc2.second].m_minRbdcSymbols );
+      result = ( m_utRequests[rcAlloc1.first].m_allocInfoPerRc[rcAlloc1.second].m_minRbdcSymbols <
+                 m_utRequests[rcAlloc2.first].m_allocInfoPerRc[rcAlloc2.second].m_minRbdcSymbols );
       break;
 
     case CC_TYPE_RBDC:
-      result = ( m_utAllocContainer.at (rcAlloc1.first).m_request.m_allocInfoPerRc[rcAlloc1.second].m_rbdcSymbols <
-                 m_utAllocContainer.at (rcAlloc2.first).m_request.m_allocInfoPerRc[rcAlloc2.second].m_rbdcSymbols );
+      result = ( m_utRequests[rcAlloc1.first].m_allocInfoPerRc[rcAlloc1.second].m_rbdcSymbols <
+                 m_utRequests[rcAlloc2.first].m_allocInfoPerRc[rcAlloc2.second].m_rbdcSymbols );
       break;
 
     case CC_TYPE_VBDC:
-      result = ( m_utAllocContainer.at (rcAlloc1.first).m_request.m_allocInfoPerRc[rcAlloc1.second].m_vbdcSymbols <
-                 m_utAllocContainer.at (rcAlloc2.first).m_request.m_allocInfoPerRc[rcAlloc2.second].m_vbdcSymbols );
+      result = ( m_utRequests[rcAlloc1.first].m_allocInfoPerRc[rcAlloc1.second].m_vbdcSymbols <
+                 m_utRequests[rcAlloc2.first].m_allocInfoPerRc[rcAlloc2.second].m_vbdcSymbols );
       break;
 
     default:
@@ -162,6 +162,30 @@ SatFrameAllocator::CcReqCompare::operator() (RcAllocItem_t rcAlloc1, RcAllocItem
   return result;
 }
 
+SatFrameAllocator::UtAddressCompare::UtAddressCompare (const std::vector<Address>& utAddresses)
+  : m_utAddresses (utAddresses)
+{
+
+}
+
+bool
+SatFrameAllocator::UtAddressCompare::operator() (uint32_t ut1, uint32_t ut2) const
+{
+  return ( m_utAddresses[ut1] < m_utAddresses[ut2] );
+}
+
+SatFrameAllocator::RandomIndex::RandomIndex (UniformRandomVariable* random)
+  : m_random (random)
+{
+
+}
+
+std::ptrdiff_t
+SatFrameAllocator::RandomIndex::operator() (std::ptrdiff_t n)
+{
+  return m_random->GetInteger (0, n - 1);
+}
+
 // SatFrameAllocator
 
 SatFrameAllocator::SatFrameAllocator ()
@@ -173,6 +197,7 @@ SatFrameAllocator::SatFrameAllocator ()
     m_preAllocatedRdbcSymbols (0.0),
     m_preAllocatedVdbcSymbols (0.0),
     m_maxSymbolsPerCarrier (0),
+    m_symbolRateInBauds (0.0),
     m_configType (SatSuperframeConf::CONFIG_TYPE_0),
     m_frameId (0)
 {
@@ -191,6 +216,7 @@ SatFrameAllocator::SatFrameAllocator (Ptr<SatFrameConf> frameConf, uint8_t frame
   m_waveformConf = m_frameConf->GetWaveformConf ();
   m_maxSymbolsPerCarrier = frameConf->GetCarrierMaxSymbols ();
   m_totalSymbolsInFrame = m_maxSymbolsPerCarrier * m_frameConf->GetCarrierCount ();
+  m_symbolRateInBauds = m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ();
 
   switch ( m_configType )
     {
@@ -247,9 +273,24 @@ SatFrameAllocator::SatFrameAllocator (Ptr<SatFrameConf> frameConf, uint8_t frame
       break;
     }
 
+  PrepareWaveformSelection ();
+
   Reset ();
 }
 
+void
+SatFrameAllocator::PrepareWaveformSelection ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (SatWaveformConf::BurstLengthContainer_t::const_iterator it = m_burstLenghts.begin (); it != m_burstLenghts.end (); it++)
+    {
+      m_waveformConf->PrepareCNoThresholdTable (m_symbolRateInBauds, *it);
+    }
+
+  m_waveformConf->PrepareCNoThresholdTable (m_symbolRateInBauds, SatWaveformConf::SHORT_BURST_LENGTH);
+}
+
 void
 SatFrameAllocator::Reset ()
 {
@@ -261,8 +302,20 @@ SatFrameAllocator::Reset ()
   m_preAllocatedRdbcSymbols = 0;
   m_preAllocatedVdbcSymbols = 0;
 
-  m_utAllocs.clear ();
+  // clear only the entries of the UTs allocated to the frame
+  for (std::vector<uint32_t>::const_iterator it = m_utIndices.begin (); it != m_utIndices.end (); it++)
+    {
+      m_utLocalIndices[*it] = 0;
+    }
+
+  m_utAddresses.clear ();
+  m_utIndices.clear ();
+  m_utCnos.clear ();
+  m_utRequests.clear ();
+  m_utAllocations.clear ();
   m_rcAllocs.clear ();
+  m_slotUts.clear ();
+  m_timeSlots.clear ();
 
   m_allocationDenied = false;
 }
@@ -315,11 +368,11 @@ SatFrameAllocator::GetBestWaveform (double cno, uint32_t & waveFormId) const
       break;
 
     case SatSuperframeConf::CONFIG_TYPE_1:
-      cnoSupported = m_waveformConf->GetBestWaveformId ( cno, m_frameConf->GetBtuConf ()->GetSymbolRateInBauds (), waveFormId, m_waveformConf->GetDefaultBurstLength ());
+      cnoSupported = m_waveformConf->GetBestWaveformId ( cno, m_symbolRateInBauds, waveFormId, m_waveformConf->GetDefaultBurstLength ());
       break;
 
     case SatSuperframeConf::CONFIG_TYPE_2:
-      cnoSupported = m_waveformConf->GetBestWaveformId ( cno, m_frameConf->GetBtuConf ()->GetSymbolRateInBauds (), waveFormId, SatWaveformConf::SHORT_BURST_LENGTH);
+      cnoSupported = m_waveformConf->GetBestWaveformId ( cno, m_symbolRateInBauds, waveFormId, SatWaveformConf::SHORT_BURST_LENGTH);
       break;
 
     default:
@@ -446,7 +499,7 @@ SatFrameAllocator::Allocate (CcLevel_t ccLevel, SatFrameAllocReq * allocReq, uin
       if ( allocated )
         {
           // update request according to carrier limit and store allocation request
-          UpdateAndStoreAllocReq (allocReq->m_address, allocReq->m_cno, reqInSymbols);
+          UpdateAndStoreAllocReq (allocReq->m_address, allocReq->m_utIndex, allocReq->m_cno, reqInSymbols);
         }
     }
 
@@ -480,18 +533,20 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
 {
   NS_LOG_FUNCTION (this);
 
-  // variable to watch limit for maximum allowed time slot
-  uint32_t timeslotCount = 0;
+  ComputeTimeSlots (rcBasedAllocationEnabled);
+  WriteTimeSlots (tbtpContainer, maxSizeInBytes, utAllocContainer, waveformTrace, utLoadTrace, loadTrace);
+}
 
-  if (tbtpContainer.empty ())
-    {
-      NS_FATAL_ERROR ("TBTP container must contain at least one message.");
-    }
+void
+SatFrameAllocator::ComputeTimeSlots (bool rcBasedAllocationEnabled)
+{
+  NS_LOG_FUNCTION (this << rcBasedAllocationEnabled);
 
-  Ptr<SatTbtpMessage> tbtpToFill = tbtpContainer.back ();
+  m_slotUts.clear ();
+  m_timeSlots.clear ();
 
   // sort UTs
-  std::vector<Address> uts = SortUts ();
+  std::vector<uint32_t> uts = SortUts ();
 
   // sort available carriers in the frame
   std::vector<uint16_t> carriers = SortCarriers ();
@@ -500,91 +555,60 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
 
   std::vector<uint16_t>::const_iterator currentCarrier = carriers.begin ();
   int64_t carrierSymbolsToUse = m_maxSymbolsPerCarrier;
-  uint32_t utCount = 0;
-  uint32_t symbolsAllocated = 0;
 
-  for (std::vector<Address>::iterator it = uts.begin (); (it != uts.end ()) && (currentCarrier != carriers.end ()); it++ )
+  for (std::vector<uint32_t>::const_iterator it = uts.begin (); (it != uts.end ()) && (currentCarrier != carriers.end ()); it++ )
     {
-      // check before the first slot addition that frame info fit in TBTP in addition to time slot
-      if ( (tbtpToFill->GetSizeInBytes () + tbtpToFill->GetTimeSlotInfoSizeInBytes () + tbtpToFill->GetFrameInfoSize ()) > maxSizeInBytes )
-        {
-          tbtpToFill = CreateNewTbtp (tbtpContainer);
-        }
+      const SatFrameAllocInfo& request = m_utRequests[*it];
+      SatFrameAllocInfo& allocation = m_utAllocations[*it];
+      double cno = m_utCnos[*it];
+
+      m_slotUts.push_back (std::make_pair (*it, m_timeSlots.size ()));
 
       // sort RCs in UT using random method.
       std::vector<uint32_t> rcIndices = SortUtRcs (*it);
       std::vector<uint32_t>::const_iterator currentRcIndex = rcIndices.begin ();
 
-      int64_t rcSymbolsLeft = m_utAllocs[*it].m_allocation.m_allocInfoPerRc[*currentRcIndex].GetTotalSymbols ();
+      int64_t rcSymbolsLeft = allocation.m_allocInfoPerRc[*currentRcIndex].GetTotalSymbols ();
 
       // generate slots here
 
-      int64_t utSymbolsLeft = m_utAllocs[*it].m_allocation.GetTotalSymbols ();
+      int64_t utSymbolsLeft = allocation.GetTotalSymbols ();
       int64_t utSymbolsToUse = m_maxSymbolsPerCarrier;
 
-      bool waveformIdTraced = false;
-
       while ( utSymbolsLeft > 0 )
         {
-          Ptr<SatTimeSlotConf> timeSlot = NULL;
+          TimeSlotItem_t timeSlot;
+          bool created = false;
 
           // try to first create Control slot if present in request and is not already created
           // otherwise create TRC slot
-          if ( (currentRcIndex == rcIndices.begin ()) && m_utAllocs[*it].m_request.m_ctrlSlotPresent
-               && (m_utAllocs[*it].m_allocation.m_ctrlSlotPresent == false ))
+          if ( (currentRcIndex == rcIndices.begin ()) && request.m_ctrlSlotPresent
+               && (allocation.m_ctrlSlotPresent == false ))
             {
-              timeSlot = CreateCtrlTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, rcBasedAllocationEnabled );
+              created = CreateCtrlTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, rcBasedAllocationEnabled, timeSlot);
 
               // if control slot creation fails try to allocate TRC slot,
               // this i because control and TRC slot may use different waveforms (different amount of symbols)
-              if ( timeSlot )
+              if ( created )
                 {
-                  m_utAllocs[*it].m_allocation.m_ctrlSlotPresent = true;
+                  allocation.m_ctrlSlotPresent = true;
                 }
               else
                 {
-                  timeSlot = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, m_utAllocs[*it].m_cno, rcBasedAllocationEnabled );
+                  created = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, cno, rcBasedAllocationEnabled, timeSlot);
                 }
             }
           else
             {
-              timeSlot = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, m_utAllocs[*it].m_cno, rcBasedAllocationEnabled );
+              created = CreateTimeSlot (*currentCarrier, utSymbolsToUse, carrierSymbolsToUse, utSymbolsLeft, rcSymbolsLeft, cno, rcBasedAllocationEnabled, timeSlot);
             }
 
-          // if creation succeeded, add slot to TBTP and update allocation info container
-          if ( timeSlot )
+          // if creation succeeded, store slot to be added to TBTP
+          if ( created )
             {
-              // trace first used wave form per UT
-              if ( !waveformIdTraced )
-                {
-                  waveformIdTraced = true;
-                  waveformTrace (timeSlot->GetWaveFormId ());
-                  utCount++;
-                }
-
-              if ( (tbtpToFill->GetSizeInBytes () + tbtpToFill->GetTimeSlotInfoSizeInBytes () ) > maxSizeInBytes )
-                {
-                  tbtpToFill = CreateNewTbtp (tbtpContainer);
-                }
-
-              timeSlot->SetRcIndex (*currentRcIndex);
-
-              if (timeslotCount > SatFrameConf::m_maxTimeSlotCount)
-                {
-                  //NS_FATAL_ERROR ("Maximum limit for time slots in a frame reached. Check frame configuration!!!");
-                }
-
-              tbtpToFill->SetDaTimeslot (Mac48Address::ConvertFrom (*it), m_frameId, timeSlot);
-              timeslotCount++;
-
-              // store needed information to UT allocation container
-              Ptr<SatWaveform> waveform = m_waveformConf->GetWaveform (timeSlot->GetWaveFormId ());
-
-              UtAllocInfoContainer_t::iterator utAlloc = GetUtAllocItem (utAllocContainer, *it);
-              utAlloc->second.first.at (*currentRcIndex) += waveform->GetPayloadInBytes ();
-              utAlloc->second.second |= m_utAllocs[*it].m_allocation.m_ctrlSlotPresent;
-
-              symbolsAllocated += waveform->GetBurstLengthInSymbols ();
+              timeSlot.m_rcIndex = *currentRcIndex;
+              timeSlot.m_ctrlSlotPresent = allocation.m_ctrlSlotPresent;
+              m_timeSlots.push_back (timeSlot);
             }
 
           // select new carrier to use
@@ -612,7 +636,7 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
                 }
               else
                 {
-                  rcSymbolsLeft = m_utAllocs[*it].m_allocation.m_allocInfoPerRc[*currentRcIndex].GetTotalSymbols ();
+                  rcSymbolsLeft = allocation.m_allocInfoPerRc[*currentRcIndex].GetTotalSymbols ();
 
                 }
             }
@@ -624,7 +648,73 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
             }
         }
 
-      m_utAllocs[*it].m_allocation.m_ctrlSlotPresent = false;
+      allocation.m_ctrlSlotPresent = false;
+    }
+}
+
+void
+SatFrameAllocator::WriteTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
+                                   const TracedCallback<uint32_t>& waveformTrace, const TracedCallback<uint32_t, uint32_t>& utLoadTrace,
+                                   const TracedCallback<uint32_t, double>& loadTrace)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (tbtpContainer.empty ())
+    {
+      NS_FATAL_ERROR ("TBTP container must contain at least one message.");
+    }
+
+  Ptr<SatTbtpMessage> tbtpToFill = tbtpContainer.back ();
+
+  uint32_t utCount = 0;
+  uint32_t symbolsAllocated = 0;
+
+  for (uint32_t i = 0; i < m_slotUts.size (); i++)
+    {
+      uint32_t ut = m_slotUts[i].first;
+      uint32_t firstSlot = m_slotUts[i].second;
+      uint32_t lastSlot = ( (i + 1) < m_slotUts.size () ) ? m_slotUts[i + 1].second : m_timeSlots.size ();
+      UtAllocInfoContainer_t::iterator utAlloc = utAllocContainer.end ();
+
+      // check before the first slot addition that frame info fit in TBTP in addition to time slot
+      if ( (tbtpToFill->GetSizeInBytes () + tbtpToFill->GetTimeSlotInfoSizeInBytes () + tbtpToFill->GetFrameInfoSize ()) > maxSizeInBytes )
+        {
+          tbtpToFill = CreateNewTbtp (tbtpContainer);
+        }
+
+      for (uint32_t j = firstSlot; j < lastSlot; j++)
+        {
+          const TimeSlotItem_t& slot = m_timeSlots[j];
+          Ptr<SatTimeSlotConf> timeSlot = CreateTimeSlotConf (slot);
+
+          // trace first used wave form per UT
+          if ( j == firstSlot )
+            {
+              waveformTrace (timeSlot->GetWaveFormId ());
+              utCount++;
+            }
+
+          if ( (tbtpToFill->GetSizeInBytes () + tbtpToFill->GetTimeSlotInfoSizeInBytes () ) > maxSizeInBytes )
+            {
+              tbtpToFill = CreateNewTbtp (tbtpContainer);
+            }
+
+          // UTs are assigned in TBTP by their beam level index
+          tbtpToFill->SetDaTimeslot (m_utIndices[ut], m_frameId, timeSlot, slot.m_rcIndex);
+
+          // store needed information to UT allocation container
+          const Ptr<SatWaveform>& waveform = m_waveformConf->GetWaveform (timeSlot->GetWaveFormId ());
+
+          if ( utAlloc == utAllocContainer.end () )
+            {
+              utAlloc = GetUtAllocItem (utAllocContainer, ut);
+            }
+
+          utAlloc->second.first.at (slot.m_rcIndex) += waveform->GetPayloadInBytes ();
+          utAlloc->second.second |= slot.m_ctrlSlotPresent;
+
+          symbolsAllocated += waveform->GetBurstLengthInSymbols ();
+        }
     }
 
   // trace out frame UT load
@@ -634,6 +724,14 @@ SatFrameAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbt
   loadTrace ((uint32_t) m_frameId, symbolsAllocated / m_totalSymbolsInFrame );
 }
 
+void
+SatFrameAllocator::SetRandomVariable (Ptr<UniformRandomVariable> random)
+{
+  NS_LOG_FUNCTION (this << random);
+
+  m_random = random;
+}
+
 void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
 {
   NS_LOG_FUNCTION (this);
@@ -652,23 +750,23 @@ void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
           m_preAllocatedVdbcSymbols += vbdcSymbolsLeft;
 
           // sort RCs according to VBDC requests
-          CcReqCompare vbdcCompare = CcReqCompare (m_utAllocs, CcReqCompare::CC_TYPE_VBDC);
-          m_rcAllocs.sort (vbdcCompare);
+          CcReqCompare vbdcCompare = CcReqCompare (m_utRequests, CcReqCompare::CC_TYPE_VBDC);
+          std::stable_sort (m_rcAllocs.begin (), m_rcAllocs.end (), vbdcCompare);
 
           uint32_t rcAllocsLeft = m_rcAllocs.size ();
 
           // do share by adding a share to all RC/VBDC allocations
-          for (RcAllocContainer_t::iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (vbdcSymbolsLeft > 0); it++)
+          for (RcAllocContainer_t::const_iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (vbdcSymbolsLeft > 0); it++)
             {
-              double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocs.at (it->first).m_allocation.GetTotalSymbols ());
+              double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocations[it->first].GetTotalSymbols ());
               double symbolsToAdd = std::min<double> (freeUtSymbols, (vbdcSymbolsLeft / rcAllocsLeft));
 
               // only share symbols to RCs requested RBDC or VBDC
-              if ( ( m_utAllocs.at (it->first).m_request.m_allocInfoPerRc[it->second].m_rbdcSymbols > 0 )
-                   || ( m_utAllocs.at (it->first).m_request.m_allocInfoPerRc[it->second].m_vbdcSymbols > 0 ) )
+              if ( ( m_utRequests[it->first].m_allocInfoPerRc[it->second].m_rbdcSymbols > 0 )
+                   || ( m_utRequests[it->first].m_allocInfoPerRc[it->second].m_vbdcSymbols > 0 ) )
                 {
-                  m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_vbdcSymbols += symbolsToAdd;
-                  m_utAllocs.at (it->first).m_allocation.m_vbdcSymbols += symbolsToAdd;
+                  m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_vbdcSymbols += symbolsToAdd;
+                  m_utAllocations[it->first].m_vbdcSymbols += symbolsToAdd;
                   vbdcSymbolsLeft -= symbolsToAdd;
                 }
 
@@ -685,24 +783,24 @@ void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
       m_preAllocatedVdbcSymbols = vbdcSymbolsLeft;
 
       // sort RCs according to VBDC requests
-      CcReqCompare vbdcCompare = CcReqCompare (m_utAllocs, CcReqCompare::CC_TYPE_VBDC);
-      m_rcAllocs.sort (vbdcCompare);
+      CcReqCompare vbdcCompare = CcReqCompare (m_utRequests, CcReqCompare::CC_TYPE_VBDC);
+      std::stable_sort (m_rcAllocs.begin (), m_rcAllocs.end (), vbdcCompare);
 
       AcceptRequests (CC_LEVEL_CRA_RBDC);
 
       uint32_t rcAllocsLeft = m_rcAllocs.size ();
 
       // do share by setting a share to all RC/VBDC allocations
-      for (RcAllocContainer_t::iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (vbdcSymbolsLeft > 0); it++)
+      for (RcAllocContainer_t::const_iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (vbdcSymbolsLeft > 0); it++)
         {
-          double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocs.at (it->first).m_allocation.GetTotalSymbols ());
+          double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocations[it->first].GetTotalSymbols ());
           double symbolsToAdd = std::min<double> (freeUtSymbols, (vbdcSymbolsLeft / rcAllocsLeft));
 
           // only share symbols to RCs requested VBDC
-          if ( m_utAllocs.at (it->first).m_request.m_allocInfoPerRc[it->second].m_vbdcSymbols > 0 )
+          if ( m_utRequests[it->first].m_allocInfoPerRc[it->second].m_vbdcSymbols > 0 )
             {
-              m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_vbdcSymbols = symbolsToAdd;
-              m_utAllocs.at (it->first).m_allocation.m_vbdcSymbols += symbolsToAdd;
+              m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_vbdcSymbols = symbolsToAdd;
+              m_utAllocations[it->first].m_vbdcSymbols += symbolsToAdd;
               vbdcSymbolsLeft -= symbolsToAdd;
             }
 
@@ -720,24 +818,24 @@ void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
       m_preAllocatedRdbcSymbols = rbdcSymbolsLeft;
 
       // sort RCs according to RBDC requests
-      CcReqCompare rbdcCompare = CcReqCompare (m_utAllocs, CcReqCompare::CC_TYPE_RBDC);
-      m_rcAllocs.sort (rbdcCompare);
+      CcReqCompare rbdcCompare = CcReqCompare (m_utRequests, CcReqCompare::CC_TYPE_RBDC);
+      std::stable_sort (m_rcAllocs.begin (), m_rcAllocs.end (), rbdcCompare);
 
       AcceptRequests (CC_LEVEL_CRA_MIN_RBDC);
 
       uint32_t rcAllocsLeft = m_rcAllocs.size ();
 
       // do share by setting a share to all RC/RBDC allocations
-      for (RcAllocContainer_t::iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (rbdcSymbolsLeft > 0); it++)
+      for (RcAllocContainer_t::const_iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (rbdcSymbolsLeft > 0); it++)
         {
-          double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocs.at (it->first).m_allocation.GetTotalSymbols ());
+          double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocations[it->first].GetTotalSymbols ());
           double symbolsToAdd = std::min<double> (freeUtSymbols, (rbdcSymbolsLeft / rcAllocsLeft));
 
           // only share symbols to RCs requested RBDC
-          if ( m_utAllocs.at (it->first).m_request.m_allocInfoPerRc[it->second].m_rbdcSymbols > 0 )
+          if ( m_utRequests[it->first].m_allocInfoPerRc[it->second].m_rbdcSymbols > 0 )
             {
-              m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_rbdcSymbols = symbolsToAdd + m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_minRbdcSymbols;
-              m_utAllocs.at (it->first).m_allocation.m_rbdcSymbols += symbolsToAdd + m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_minRbdcSymbols;
+              m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_rbdcSymbols = symbolsToAdd + m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_minRbdcSymbols;
+              m_utAllocations[it->first].m_rbdcSymbols += symbolsToAdd + m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_minRbdcSymbols;
               rbdcSymbolsLeft -= symbolsToAdd;
             }
 
@@ -756,27 +854,27 @@ void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
       m_preAllocatedMinRdbcSymbols = minRbdcSymbolsLeft;
 
       // sort RCs according to RBDC requests
-      CcReqCompare minRbdcCompare = CcReqCompare (m_utAllocs, CcReqCompare::CC_TYPE_MIN_RBDC);
-      m_rcAllocs.sort (minRbdcCompare);
+      CcReqCompare minRbdcCompare = CcReqCompare (m_utRequests, CcReqCompare::CC_TYPE_MIN_RBDC);
+      std::stable_sort (m_rcAllocs.begin (), m_rcAllocs.end (), minRbdcCompare);
 
       AcceptRequests (CC_LEVEL_CRA);
 
       uint32_t rcAllocsLeft = m_rcAllocs.size ();
 
       // do share by setting a share to all RC/Minimum RBDC and RC/RBDC allocations
-      for (RcAllocContainer_t::iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (minRbdcSymbolsLeft > 0); it++)
+      for (RcAllocContainer_t::const_iterator it = m_rcAllocs.begin (); it != m_rcAllocs.end () && (minRbdcSymbolsLeft > 0); it++)
         {
-          double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocs.at (it->first).m_allocation.GetTotalSymbols ());
+          double freeUtSymbols = std::max<double> (0.0, m_maxSymbolsPerCarrier - m_utAllocations[it->first].GetTotalSymbols ());
           double symbolsToAdd = std::min<double> (freeUtSymbols, (minRbdcSymbolsLeft / rcAllocsLeft));
 
           // only share symbols to RCs requested RBDC
-          if ( m_utAllocs.at (it->first).m_request.m_allocInfoPerRc[it->second].m_rbdcSymbols > 0 )
+          if ( m_utRequests[it->first].m_allocInfoPerRc[it->second].m_rbdcSymbols > 0 )
             {
-              m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_minRbdcSymbols = symbolsToAdd;
-              m_utAllocs.at (it->first).m_allocation.m_minRbdcSymbols += symbolsToAdd;
+              m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_minRbdcSymbols = symbolsToAdd;
+              m_utAllocations[it->first].m_minRbdcSymbols += symbolsToAdd;
 
-              m_utAllocs.at (it->first).m_allocation.m_allocInfoPerRc[it->second].m_rbdcSymbols = symbolsToAdd;
-              m_utAllocs.at (it->first).m_allocation.m_rbdcSymbols += symbolsToAdd;
+              m_utAllocations[it->first].m_allocInfoPerRc[it->second].m_rbdcSymbols = symbolsToAdd;
+              m_utAllocations[it->first].m_rbdcSymbols += symbolsToAdd;
 
               minRbdcSymbolsLeft -= symbolsToAdd;
             }
@@ -790,13 +888,14 @@ void SatFrameAllocator::ShareSymbols (bool fcaEnabled)
     }
 }
 
-Ptr<SatTimeSlotConf>
+bool
 SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse,
-                                   int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled)
+                                   int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled,
+                                   TimeSlotItem_t& timeSlot)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<SatTimeSlotConf> timeSlotConf = NULL;
+  bool created = false;
   int64_t symbolsToUse = std::min<int64_t> (carrierSymbolsToUse, utSymbolsToUse);
   uint32_t waveformId = 0;
   int64_t timeSlotSymbols = 0;
@@ -827,18 +926,9 @@ SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse,
       switch (m_configType)
         {
         case SatSuperframeConf::CONFIG_TYPE_0:
-          {
-            uint16_t index = (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / timeSlotSymbols;
-            timeSlotConf = m_frameConf->GetTimeSlotConf (carrierId, index);
-          }
-          break;
-
         case SatSuperframeConf::CONFIG_TYPE_1:
         case SatSuperframeConf::CONFIG_TYPE_2:
-          {
-            Time startTime = Seconds ( (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
-            timeSlotConf = Create<SatTimeSlotConf> (startTime, waveformId, carrierId, SatTimeSlotConf::SLOT_TYPE_TRC);
-          }
+          created = true;
           break;
 
         case SatSuperframeConf::CONFIG_TYPE_3:
@@ -847,8 +937,14 @@ SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse,
           break;
         }
 
-      if (timeSlotConf)
+      if (created)
         {
+          timeSlot.m_carrierId = carrierId;
+          timeSlot.m_waveformId = waveformId;
+          timeSlot.m_carrierSymbolsToUse = carrierSymbolsToUse;
+          timeSlot.m_slotSymbols = timeSlotSymbols;
+          timeSlot.m_ctrlSlot = false;
+
           carrierSymbolsToUse -= timeSlotSymbols;
           utSymbolsToUse -= timeSlotSymbols;
 
@@ -865,24 +961,29 @@ SatFrameAllocator::CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse,
         }
     }
 
-  return timeSlotConf;
+  return created;
 }
 
-Ptr<SatTimeSlotConf>
+bool
 SatFrameAllocator::CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse,
-                                       int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled)
+                                       int64_t& utSymbolsLeft, int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled,
+                                       TimeSlotItem_t& timeSlot)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<SatTimeSlotConf> timeSlotConf = NULL;
+  bool created = false;
   int64_t symbolsToUse = std::min<int64_t> (carrierSymbolsToUse, utSymbolsToUse);
 
   int64_t timeSlotSymbols = m_mostRobustWaveform->GetBurstLengthInSymbols ();
 
   if ( timeSlotSymbols <= symbolsToUse )
     {
-      Time startTime = Seconds ( (m_maxSymbolsPerCarrier - carrierSymbolsToUse) / m_frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
-      timeSlotConf = Create<SatTimeSlotConf> (startTime, m_mostRobustWaveform->GetWaveformId (), carrierId, SatTimeSlotConf::SLOT_TYPE_C);
+      timeSlot.m_carrierId = carrierId;
+      timeSlot.m_waveformId = m_mostRobustWaveform->GetWaveformId ();
+      timeSlot.m_carrierSymbolsToUse = carrierSymbolsToUse;
+      timeSlot.m_slotSymbols = timeSlotSymbols;
+      timeSlot.m_ctrlSlot = true;
+      created = true;
 
       carrierSymbolsToUse -= timeSlotSymbols;
       utSymbolsToUse -= timeSlotSymbols;
@@ -899,6 +1000,32 @@ SatFrameAllocator::CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToU
       rcSymbolsLeft -= timeSlotSymbols;
     }
 
+  return created;
+}
+
+Ptr<SatTimeSlotConf>
+SatFrameAllocator::CreateTimeSlotConf (const TimeSlotItem_t& timeSlot) const
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatTimeSlotConf> timeSlotConf = NULL;
+
+  if ( timeSlot.m_ctrlSlot )
+    {
+      Time startTime = Seconds ( (m_maxSymbolsPerCarrier - timeSlot.m_carrierSymbolsToUse) / m_symbolRateInBauds);
+      timeSlotConf = Create<SatTimeSlotConf> (startTime, timeSlot.m_waveformId, timeSlot.m_carrierId, SatTimeSlotConf::SLOT_TYPE_C);
+    }
+  else if ( m_configType == SatSuperframeConf::CONFIG_TYPE_0 )
+    {
+      uint16_t index = (m_maxSymbolsPerCarrier - timeSlot.m_carrierSymbolsToUse) / timeSlot.m_slotSymbols;
+      timeSlotConf = m_frameConf->GetTimeSlotConf (timeSlot.m_carrierId, index);
+    }
+  else
+    {
+      Time startTime = Seconds ( (m_maxSymbolsPerCarrier - timeSlot.m_carrierSymbolsToUse) / m_symbolRateInBauds);
+      timeSlotConf = Create<SatTimeSlotConf> (startTime, timeSlot.m_waveformId, timeSlot.m_carrierId, SatTimeSlotConf::SLOT_TYPE_TRC);
+    }
+
   return timeSlotConf;
 }
 
@@ -920,7 +1047,7 @@ SatFrameAllocator::GetOptimalBurtsLengthInSymbols (int64_t symbolsToUse, int64_t
         }
       else
         {
-          bool waveformFound = m_waveformConf->GetBestWaveformId (cno, m_frameConf->GetBtuConf ()->GetSymbolRateInBauds (), selectedWaveformId, *it );
+          bool waveformFound = m_waveformConf->GetBestWaveformId (cno, m_symbolRateInBauds, selectedWaveformId, *it );
 
           if ( waveformFound )
             {
@@ -954,37 +1081,40 @@ SatFrameAllocator::AcceptRequests (CcLevel_t ccLevel)
 {
   NS_LOG_FUNCTION (this);
 
-  for ( UtAllocContainer_t::iterator it = m_utAllocs.begin (); it != m_utAllocs.end (); it++ )
+  for ( uint32_t ut = 0; ut < m_utRequests.size (); ut++ )
     {
+      const SatFrameAllocInfo& request = m_utRequests[ut];
+      SatFrameAllocInfo& allocation = m_utAllocations[ut];
+
       // accept first UT level total requests by updating allocation counters
       switch (ccLevel)
         {
         case CC_LEVEL_CRA:
-          it->second.m_allocation.m_craSymbols = it->second.m_request.m_craSymbols;
-          it->second.m_allocation.m_minRbdcSymbols = 0.0;
-          it->second.m_allocation.m_rbdcSymbols = 0.0;
-          it->second.m_allocation.m_vbdcSymbols = 0.0;
+          allocation.m_craSymbols = request.m_craSymbols;
+          allocation.m_minRbdcSymbols = 0.0;
+          allocation.m_rbdcSymbols = 0.0;
+          allocation.m_vbdcSymbols = 0.0;
           break;
 
         case CC_LEVEL_CRA_MIN_RBDC:
-          it->second.m_allocation.m_craSymbols = it->second.m_request.m_craSymbols;
-          it->second.m_allocation.m_minRbdcSymbols = it->second.m_request.m_minRbdcSymbols;
-          it->second.m_allocation.m_rbdcSymbols = 0.0;
-          it->second.m_allocation.m_vbdcSymbols = 0.0;
+          allocation.m_craSymbols = request.m_craSymbols;
+          allocation.m_minRbdcSymbols = request.m_minRbdcSymbols;
+          allocation.m_rbdcSymbols = 0.0;
+          allocation.m_vbdcSymbols = 0.0;
           break;
 
         case CC_LEVEL_CRA_RBDC:
-          it->second.m_allocation.m_craSymbols = it->second.m_request.m_craSymbols;
-          it->second.m_allocation.m_minRbdcSymbols = it->second.m_request.m_minRbdcSymbols;
-          it->second.m_allocation.m_rbdcSymbols = it->second.m_request.m_rbdcSymbols;
-          it->second.m_allocation.m_vbdcSymbols = 0.0;
+          allocation.m_craSymbols = request.m_craSymbols;
+          allocation.m_minRbdcSymbols = request.m_minRbdcSymbols;
+          allocation.m_rbdcSymbols = request.m_rbdcSymbols;
+          allocation.m_vbdcSymbols = 0.0;
           break;
 
         case CC_LEVEL_CRA_RBDC_VBDC:
-          it->second.m_allocation.m_craSymbols = it->second.m_request.m_craSymbols;
-          it->second.m_allocation.m_minRbdcSymbols = it->second.m_request.m_minRbdcSymbols;
-          it->second.m_allocation.m_rbdcSymbols = it->second.m_request.m_rbdcSymbols;
-          it->second.m_allocation.m_vbdcSymbols = it->second.m_request.m_vbdcSymbols;
+          allocation.m_craSymbols = request.m_craSymbols;
+          allocation.m_minRbdcSymbols = request.m_minRbdcSymbols;
+          allocation.m_rbdcSymbols = request.m_rbdcSymbols;
+          allocation.m_vbdcSymbols = request.m_vbdcSymbols;
           break;
 
         default:
@@ -993,36 +1123,36 @@ SatFrameAllocator::AcceptRequests (CcLevel_t ccLevel)
         }
 
       // accept first RC specific requests by updating allocation counters
-      for ( uint32_t i = 0; i < it->second.m_request.m_allocInfoPerRc.size (); i++ )
+      for ( uint32_t i = 0; i < request.m_allocInfoPerRc.size (); i++ )
         {
           switch (ccLevel)
             {
             case CC_LEVEL_CRA:
-              it->second.m_allocation.m_allocInfoPerRc[i].m_craSymbols = it->second.m_request.m_allocInfoPerRc[i].m_craSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = 0.0;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_rbdcSymbols = 0.0;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_vbdcSymbols = 0.0;
+              allocation.m_allocInfoPerRc[i].m_craSymbols = request.m_allocInfoPerRc[i].m_craSymbols;
+              allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = 0.0;
+              allocation.m_allocInfoPerRc[i].m_rbdcSymbols = 0.0;
+              allocation.m_allocInfoPerRc[i].m_vbdcSymbols = 0.0;
               break;
 
             case CC_LEVEL_CRA_MIN_RBDC:
-              it->second.m_allocation.m_allocInfoPerRc[i].m_craSymbols = it->second.m_request.m_allocInfoPerRc[i].m_craSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = it->second.m_request.m_allocInfoPerRc[i].m_minRbdcSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_rbdcSymbols = 0.0;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_vbdcSymbols = 0.0;
+              allocation.m_allocInfoPerRc[i].m_craSymbols = request.m_allocInfoPerRc[i].m_craSymbols;
+              allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = request.m_allocInfoPerRc[i].m_minRbdcSymbols;
+              allocation.m_allocInfoPerRc[i].m_rbdcSymbols = 0.0;
+              allocation.m_allocInfoPerRc[i].m_vbdcSymbols = 0.0;
               break;
 
             case CC_LEVEL_CRA_RBDC:
-              it->second.m_allocation.m_allocInfoPerRc[i].m_craSymbols = it->second.m_request.m_allocInfoPerRc[i].m_craSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = it->second.m_request.m_allocInfoPerRc[i].m_minRbdcSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_rbdcSymbols = it->second.m_request.m_allocInfoPerRc[i].m_rbdcSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_vbdcSymbols = 0.0;
+              allocation.m_allocInfoPerRc[i].m_craSymbols = request.m_allocInfoPerRc[i].m_craSymbols;
+              allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = request.m_allocInfoPerRc[i].m_minRbdcSymbols;
+              allocation.m_allocInfoPerRc[i].m_rbdcSymbols = request.m_allocInfoPerRc[i].m_rbdcSymbols;
+              allocation.m_allocInfoPerRc[i].m_vbdcSymbols = 0.0;
               break;
 
             case CC_LEVEL_CRA_RBDC_VBDC:
-              it->second.m_allocation.m_allocInfoPerRc[i].m_craSymbols = it->second.m_request.m_allocInfoPerRc[i].m_craSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = it->second.m_request.m_allocInfoPerRc[i].m_minRbdcSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_rbdcSymbols = it->second.m_request.m_allocInfoPerRc[i].m_rbdcSymbols;
-              it->second.m_allocation.m_allocInfoPerRc[i].m_vbdcSymbols = it->second.m_request.m_allocInfoPerRc[i].m_vbdcSymbols;
+              allocation.m_allocInfoPerRc[i].m_craSymbols = request.m_allocInfoPerRc[i].m_craSymbols;
+              allocation.m_allocInfoPerRc[i].m_minRbdcSymbols = request.m_allocInfoPerRc[i].m_minRbdcSymbols;
+              allocation.m_allocInfoPerRc[i].m_rbdcSymbols = request.m_allocInfoPerRc[i].m_rbdcSymbols;
+              allocation.m_allocInfoPerRc[i].m_vbdcSymbols = request.m_allocInfoPerRc[i].m_vbdcSymbols;
               break;
 
             default:
@@ -1034,7 +1164,7 @@ SatFrameAllocator::AcceptRequests (CcLevel_t ccLevel)
 }
 
 void
-SatFrameAllocator::UpdateAndStoreAllocReq (Address address, double cno, SatFrameAllocInfo &req)
+SatFrameAllocator::UpdateAndStoreAllocReq (Address address, uint32_t utIndex, double cno, SatFrameAllocInfo &req)
 {
   NS_LOG_FUNCTION (this);
 
@@ -1093,35 +1223,65 @@ SatFrameAllocator::UpdateAndStoreAllocReq (Address address, double cno, SatFrame
       req.m_vbdcSymbols = vbdcSymbolsLeft;
     }
 
-  // add request and empty allocation info container
-  UtAllocItem_t utAlloc;
-  utAlloc.m_request = req;
-  utAlloc.m_allocation = SatFrameAllocInfo (req.m_allocInfoPerRc.size ());
-  utAlloc.m_cno = cno;
+  // add request and empty allocation info container, if UT is not yet allocated to the frame
+  if ( utIndex >= m_utLocalIndices.size () )
+    {
+      m_utLocalIndices.resize (utIndex + 1, 0);
+    }
+
+  if ( m_utLocalIndices[utIndex] == 0 )
+    {
+      m_utAddresses.push_back (address);
+      m_utIndices.push_back (utIndex);
+      m_utCnos.push_back (cno);
+      m_utRequests.push_back (req);
+      m_utAllocations.push_back (SatFrameAllocInfo (req.m_allocInfoPerRc.size ()));
+
+      m_utLocalIndices[utIndex] = m_utAddresses.size ();
+    }
+
+  uint32_t ut = m_utLocalIndices[utIndex] - 1;
 
   for (uint8_t i = 0; i < req.m_allocInfoPerRc.size (); i++)
     {
-      RcAllocItem_t rcAlloc = std::make_pair (address, i);
-      m_rcAllocs.push_back (rcAlloc);
+      m_rcAllocs.push_back (std::make_pair (ut, i));
     }
+}
 
-  m_utAllocs.insert (std::make_pair (address, utAlloc));
+template <class T>
+void
+SatFrameAllocator::Shuffle (T first, T last)
+{
+  if ( m_random )
+    {
+      RandomIndex randomIndex (PeekPointer (m_random));
+      std::random_shuffle (first, last, randomIndex);
+    }
+  else
+    {
+      std::random_shuffle (first, last);
+    }
 }
 
-std::vector<Address>
+std::vector<uint32_t>
 SatFrameAllocator::SortUts ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::vector<Address> uts;
+  std::vector<uint32_t> uts;
+  uts.reserve (m_utAddresses.size ());
 
-  for (UtAllocContainer_t::const_iterator it = m_utAllocs.begin (); it != m_utAllocs.end (); it++)
+  for (uint32_t i = 0; i < m_utAddresses.size (); i++)
     {
-      uts.push_back (it->first);
+      uts.push_back (i);
     }
 
+  // UTs are shuffled starting from the address order to keep the
+  // order independent of the order in which UTs were allocated
+  std::sort (uts.begin (), uts.end (), UtAddressCompare (m_utAddresses));
+
   // sort UTs using random method.
-  std::random_shuffle (uts.begin (), uts.end ());
+  Shuffle (uts.begin (), uts.end ());
 
   return uts;
 }
@@ -1139,18 +1299,18 @@ SatFrameAllocator::SortCarriers ()
     }
 
   // sort available carriers using random methods.
-  std::random_shuffle (carriers.begin (), carriers.end ());
+  Shuffle (carriers.begin (), carriers.end ());
 
   return carriers;
 }
 
 std::vector<uint32_t>
-SatFrameAllocator::SortUtRcs (Address ut)
+SatFrameAllocator::SortUtRcs (uint32_t ut)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << ut);
   std::vector<uint32_t> rcIndices;
 
-  for (uint32_t i = 0; i < m_utAllocs[ut].m_allocation.m_allocInfoPerRc.size (); i++)
+  for (uint32_t i = 0; i < m_utAllocations[ut].m_allocInfoPerRc.size (); i++)
     {
       rcIndices.push_back (i);
     }
@@ -1160,7 +1320,7 @@ SatFrameAllocator::SortUtRcs (Address ut)
   if ( rcIndices.size () > 2)
     {
       // sort RCs in UT using random method.
-      std::random_shuffle (rcIndices.begin () + 1, rcIndices.end ());
+      Shuffle (rcIndices.begin () + 1, rcIndices.end ());
     }
 
   return rcIndices;
@@ -1168,19 +1328,19 @@ SatFrameAllocator::SortUtRcs (Address ut)
 
 
 SatFrameAllocator::UtAllocInfoContainer_t::iterator
-SatFrameAllocator::GetUtAllocItem (UtAllocInfoContainer_t& allocContainer, Address ut)
+SatFrameAllocator::GetUtAllocItem (UtAllocInfoContainer_t& allocContainer, uint32_t ut)
 {
-  NS_LOG_FUNCTION (this);
-  UtAllocInfoContainer_t::iterator utAlloc = allocContainer.find (ut);
+  NS_LOG_FUNCTION (this << ut);
+  UtAllocInfoContainer_t::iterator utAlloc = allocContainer.find (m_utAddresses[ut]);
 
   if ( utAlloc == allocContainer.end () )
     {
       UtAllocInfoItem_t rcAllocs;
 
       rcAllocs.second = false;
-      rcAllocs.first = std::vector<uint32_t> (m_utAllocs[ut].m_allocation.m_allocInfoPerRc.size (), 0);
+      rcAllocs.first = std::vector<uint32_t> (m_utAllocations[ut].m_allocInfoPerRc.size (), 0);
 
-      std::pair<UtAllocInfoContainer_t::iterator, bool> result = allocContainer.insert (std::make_pair (ut, rcAllocs ));
+      std::pair<UtAllocInfoContainer_t::iterator, bool> result = allocContainer.insert (std::make_pair (m_utAddresses[ut], rcAllocs ));
 
       if ( result.second )
         {
@@ -24,6 +24,7 @@
 #include "ns3/simple-ref-count.h"
 #include "ns3/address.h"
 #include "ns3/traced-callback.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/satellite-frame-conf.h"
 #include "satellite-control-message.h"
 
@@ -45,6 +46,12 @@ namespace ns3 {
  * calling method GenerateTimeSlots. GenerateTimeSlots method can be called as several time, if same preallocation
  * is wanted to use.
  *
+ * GenerateTimeSlots consists of two steps, which can also be called separately. ComputeTimeSlots
+ * does the actual allocation without creating any objects or calling the simulator, and
+ * WriteTimeSlots adds the computed time slots to TBTP(s) and fires the traces. Thus the time
+ * slots of the frame allocators of different beams can be computed concurrently, provided that
+ * the allocators use random variables of their own (see SetRandomVariable).
+ *
  * NOTE! Calling of PreAllocation or Allocate methods has no effect when PreAllocation
  * is once called until Reset method is called.
  *
@@ -103,6 +110,10 @@ public:
   /**
    * SatFrameAllocReq is used to define frame allocation parameters when
    * requesting allocation from SatFrameAllocator (calling method AllocateSymbols).
+   *
+   * m_utIndex is a dense index of the UT within the beam, assigned by the
+   * beam scheduler when the UT is added to it. Frame allocator uses the index
+   * to look up the UT without searching by its address.
    */
   class SatFrameAllocReq
   {
@@ -110,10 +121,12 @@ public:
     bool                              m_generateCtrlSlot;
     double                            m_cno;
     Address                           m_address;
+    uint32_t                          m_utIndex;
     SatFrameAllocReqItemContainer_t   m_reqPerRc;
 
     SatFrameAllocReq () : m_generateCtrlSlot (false),
-                          m_cno (NAN)
+                          m_cno (NAN),
+                          m_utIndex (0)
     {
     }
 
@@ -124,6 +137,7 @@ public:
      */
     SatFrameAllocReq (SatFrameAllocReqItemContainer_t req) : m_generateCtrlSlot (false),
                                                              m_cno (NAN),
+                                                             m_utIndex (0),
                                                              m_reqPerRc (req)
     {
     }
@@ -231,6 +245,44 @@ public:
   void GenerateTimeSlots ( SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
                            bool rcBasedAllocationEnabled, TracedCallback<uint32_t> waveformTrace, TracedCallback<uint32_t, uint32_t> utLoadTrace, TracedCallback<uint32_t, double> loadTrace);
 
+  /**
+   * Compute time slots for UT/RCs based on preallocation. The computed time slots
+   * are added to TBTP(s) by calling WriteTimeSlots.
+   *
+   * \param rcBasedAllocationEnabled If time slot generated per RC
+   */
+  void ComputeTimeSlots (bool rcBasedAllocationEnabled);
+
+  /**
+   * Add time slots computed by ComputeTimeSlots to TBTP(s).
+   *
+   * \param tbtpContainer TBTP message container to add/fill TBTPs.
+   * \param maxSizeInBytes Maximum size for a TBTP message.
+   * \param utAllocContainer Reference to UT allocation container to fill in info of the allocation
+   * \param waveformTrace Wave form trace callback
+   * \param utLoadTrace UT load per the frame trace callback
+   * \param loadTrace Load per the frame trace callback
+   */
+  void WriteTimeSlots ( SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, UtAllocInfoContainer_t& utAllocContainer,
+                        const TracedCallback<uint32_t>& waveformTrace, const TracedCallback<uint32_t, uint32_t>& utLoadTrace,
+                        const TracedCallback<uint32_t, double>& loadTrace);
+
+  /**
+   * Set random variable used to shuffle UTs, carriers and RCs in time slot generation.
+   * By default the shuffling uses the random generator of the standard library.
+   *
+   * \param random Random variable to use for shuffling
+   */
+  void SetRandomVariable (Ptr<UniformRandomVariable> random);
+
+  /**
+   * \brief Prepare the C/N0 threshold tables of the waveform configuration used by
+   * the allocator. The waveform configuration is shared by the allocators of all the
+   * beams, so the tables shall be prepared in the simulator thread before the time
+   * slots of the beams are computed concurrently.
+   */
+  void PrepareWaveformSelection ();
+
 
 private:
   /**
@@ -307,7 +359,7 @@ public:
      * \param waveForm  Waveform to use in allocation for TRC slots.
      * \param ctrlSlotLength Slot length in symbols for control slots.
      */
-    SatFrameAllocInfo (SatFrameAllocReqItemContainer_t &req, Ptr<SatWaveform> trcWaveForm, bool ctrlSlotPresent, double ctrlSlotLength);
+    SatFrameAllocInfo (SatFrameAllocReqItemContainer_t &req, const Ptr<SatWaveform>& trcWaveForm, bool ctrlSlotPresent, double ctrlSlotLength);
 
     /**
      * Update total count of SatFrameAllocInfo from RCs.
@@ -324,31 +376,22 @@ public:
   };
 
   /**
-   * Allocation information for a UT.
+   * Container for UT allocation information items (requests or allocations),
+   * indexed by the local index of the UT in the frame.
    */
-  typedef struct
-  {
-    double              m_cno;
-    SatFrameAllocInfo   m_request;
-    SatFrameAllocInfo   m_allocation;
-  } UtAllocItem_t;
+  typedef std::vector<SatFrameAllocInfo> UtAllocInfoTable_t;
 
   /**
    * Pair used as RC allocation item.
    *
-   * first = UT address, second = RC index
-   */
-  typedef std::pair<Address, uint8_t> RcAllocItem_t;
-
-  /**
-   * Map container for UT allocation items.
+   * first = local index of the UT in the frame, second = RC index
    */
-  typedef std::map<Address, UtAllocItem_t> UtAllocContainer_t;
+  typedef std::pair<uint32_t, uint8_t> RcAllocItem_t;
 
   /**
    * Container for RC allocation items.
    */
-  typedef std::list<RcAllocItem_t> RcAllocContainer_t;
+  typedef std::vector<RcAllocItem_t> RcAllocContainer_t;
 
   /**
    *  CcReqCompare class for CC type comparisons.
@@ -369,10 +412,10 @@ public:
     /**
      * Construct CcReqCompare.
      *
-     * \param utAllocContainer Reference to UT allocation container.
+     * \param utRequests Reference to UT request table.
      * \param ccReqType Type used for comparisons.
      */
-    CcReqCompare (const UtAllocContainer_t& utAllocContainer, CcReqCompare::CcReqType_t ccReqType);
+    CcReqCompare (const UtAllocInfoTable_t& utRequests, CcReqCompare::CcReqType_t ccReqType);
 
     /**
      * Comparison operator to compare two RC allocations.
@@ -381,13 +424,13 @@ public:
      * \param rcAlloc2
      * \return false if first RC allocation is smaller than second.
      */
-    bool operator() (RcAllocItem_t rcAlloc1, RcAllocItem_t rcAlloc2);
+    bool operator() (const RcAllocItem_t& rcAlloc1, const RcAllocItem_t& rcAlloc2) const;
 
 private:
     /**
-     * Reference to UT allocation container
+     * Reference to UT request table
      */
-    const UtAllocContainer_t& m_utAllocContainer;
+    const UtAllocInfoTable_t& m_utRequests;
 
     /**
      * Type used for comparisons.
@@ -395,6 +438,83 @@ private:
     CcReqType_t m_ccReqType;
   };
 
+  /**
+   *  UtAddressCompare class for sorting local UT indices by the UT addresses.
+   */
+  class UtAddressCompare
+  {
+public:
+    /**
+     * Construct UtAddressCompare.
+     *
+     * \param utAddresses Reference to UT address table.
+     */
+    UtAddressCompare (const std::vector<Address>& utAddresses);
+
+    /**
+     * Comparison operator to compare the addresses of two UTs.
+     *
+     * \param ut1 Local index of the first UT
+     * \param ut2 Local index of the second UT
+     * \return true if the address of the first UT is smaller than the second.
+     */
+    bool operator() (uint32_t ut1, uint32_t ut2) const;
+
+private:
+    /**
+     * Reference to UT address table
+     */
+    const std::vector<Address>& m_utAddresses;
+  };
+
+  /**
+   * \brief Random number generator for std::random_shuffle to draw from a random variable
+   */
+  class RandomIndex
+  {
+public:
+    /**
+     * Construct RandomIndex.
+     *
+     * \param random Random variable to draw from
+     */
+    RandomIndex (UniformRandomVariable* random);
+
+    /**
+     * Draw a random index.
+     *
+     * \param n Number of the indices
+     * \return Random index between 0 and n - 1
+     */
+    std::ptrdiff_t operator() (std::ptrdiff_t n);
+
+private:
+    /**
+     * Random variable to draw from
+     */
+    UniformRandomVariable* m_random;
+  };
+
+  /**
+   * Time slot computed by ComputeTimeSlots.
+   */
+  typedef struct
+  {
+    uint16_t  m_carrierId;
+    uint32_t  m_rcIndex;
+    uint32_t  m_waveformId;
+    int64_t   m_carrierSymbolsToUse;  // Symbols left in the carrier before the slot
+    int64_t   m_slotSymbols;
+    bool      m_ctrlSlot;
+    bool      m_ctrlSlotPresent;      // Control slot allocated for the UT, when the slot is generated
+  } TimeSlotItem_t;
+
+  /**
+   * Pair of the local index of a UT and the index of its first time slot
+   * in the time slot container.
+   */
+  typedef std::pair<uint32_t, uint32_t> SlotUtItem_t;
+
   bool m_allocationDenied;
 
   // total symbols in frame.
@@ -418,6 +538,9 @@ private:
   // maximum symbols available in frame
   double  m_maxSymbolsPerCarrier;
 
+  // symbol rate of the carriers in frame
+  double  m_symbolRateInBauds;
+
   // configuration type of the frame
   SatSuperframeConf::ConfigType_t  m_configType;
 
@@ -433,8 +556,26 @@ private:
   // Frame configuration
   Ptr<SatFrameConf>   m_frameConf;
 
-  // UT allocation container
-  UtAllocContainer_t  m_utAllocs;
+  // UT allocation tables, indexed by the local index of the UT in the frame.
+  // UTs get local indices in the order they are allocated to the frame.
+
+  // Addresses of the UTs
+  std::vector<Address>  m_utAddresses;
+
+  // Beam level UT indices of the UTs
+  std::vector<uint32_t>  m_utIndices;
+
+  // Estimated C/N0 of the UTs
+  std::vector<double>  m_utCnos;
+
+  // Requests of the UTs
+  UtAllocInfoTable_t  m_utRequests;
+
+  // Allocations of the UTs
+  UtAllocInfoTable_t  m_utAllocations;
+
+  // Local index + 1 of the UT by beam level UT index, 0 if the UT is not allocated to the frame
+  std::vector<uint32_t>  m_utLocalIndices;
 
   // RC allocation container
   RcAllocContainer_t  m_rcAllocs;
@@ -442,6 +583,15 @@ private:
   // The most robust waveform
   Ptr<SatWaveform>  m_mostRobustWaveform;
 
+  // UTs handled in time slot generation in the handling order
+  std::vector<SlotUtItem_t>  m_slotUts;
+
+  // Time slots computed for the UTs
+  std::vector<TimeSlotItem_t>  m_timeSlots;
+
+  // Random variable used to shuffle UTs, carriers and RCs, NULL to use the standard library
+  Ptr<UniformRandomVariable>  m_random;
+
   /**
    * Share symbols between all UTs and RCs allocated to the frame.
    *
@@ -470,10 +620,11 @@ private:
    * \param rcSymbolsLeft Symbols left for RC
    * \param cno Estimated C/N0 of the UT.
    * \param rcBasedAllocationEnabled If time slot generated per RC
-   * \return Create time slot configuration
+   * \param timeSlot Variable to store the created time slot
+   * \return true if time slot created, false otherwise
    */
-  Ptr<SatTimeSlotConf> CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
-                                       int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled);
+  bool CreateTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
+                       int64_t& rcSymbolsLeft, double cno, bool rcBasedAllocationEnabled, TimeSlotItem_t& timeSlot);
 
   /**
    * Create control time slot.
@@ -484,18 +635,28 @@ private:
    * \param utSymbolsLeft Symbols left for the UT
    * \param rcSymbolsLeft Symbols left for RC
    * \param rcBasedAllocationEnabled If time slot generated per RC
-   * \return Create time slot configuration
+   * \param timeSlot Variable to store the created time slot
+   * \return true if time slot created, false otherwise
    */
-  Ptr<SatTimeSlotConf> CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
-                                           int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled);
+  bool CreateCtrlTimeSlot (uint16_t carrierId, int64_t& utSymbolsToUse, int64_t& carrierSymbolsToUse, int64_t& utSymbolsLeft,
+                           int64_t& rcSymbolsLeft, bool rcBasedAllocationEnabled, TimeSlotItem_t& timeSlot);
+
+  /**
+   * Create time slot configuration for a computed time slot according to configuration type.
+   *
+   * \param timeSlot Computed time slot
+   * \return Time slot configuration
+   */
+  Ptr<SatTimeSlotConf> CreateTimeSlotConf (const TimeSlotItem_t& timeSlot) const;
 
   /**
    * Update RC/CC requested according to carrier limit
    * \param address Address of the UT which allocation is associated.
+   * \param utIndex Beam level index of the UT which allocation is associated.
    * \param cno C/N0 value estimated for the UT.
    * \param req Allocation request to update
    */
-  void UpdateAndStoreAllocReq (Address address, double cno, SatFrameAllocInfo &req);
+  void UpdateAndStoreAllocReq (Address address, uint32_t utIndex, double cno, SatFrameAllocInfo &req);
 
   /**
    * Accept UT/RC requests of the frame according to given CC level.
@@ -507,9 +668,9 @@ private:
   /**
    * Sort UTs allocated to this frame.
    *
-   * \return Addressed of the UTs in sorted order.
+   * \return Local indices of the UTs in sorted order.
    */
-  std::vector<Address> SortUts ();
+  std::vector<uint32_t> SortUts ();
 
   /**
    * Sort carriers belonging to this frame.
@@ -521,20 +682,29 @@ private:
   /**
    * Sort RCs in given UT.
    *
-   * \param ut Address of the UT which RCs is needed to sort
+   * \param ut Local index of the UT which RCs is needed to sort
    * \return Indices of the UT RC indices in sorted order.
    */
-  std::vector<uint32_t> SortUtRcs (Address ut);
+  std::vector<uint32_t> SortUtRcs (uint32_t ut);
+
+  /**
+   * Shuffle given range with the random variable of the allocator, if set.
+   *
+   * \param first Iterator to the first element of the range
+   * \param last Iterator past the last element of the range
+   */
+  template <class T>
+  void Shuffle (T first, T last);
 
   /**
    *  Get UT allocation item from given container. If UT not available in the
    *  container new UT specific item is added to container.
    *
    * \param allocContainer Container to check
-   * \param ut Address of the UT
+   * \param ut Local index of the UT
    * \return Iterator to UT specific allocation item
    */
-  SatFrameAllocator::UtAllocInfoContainer_t::iterator GetUtAllocItem (UtAllocInfoContainer_t& allocContainer, Address ut);
+  SatFrameAllocator::UtAllocInfoContainer_t::iterator GetUtAllocItem (UtAllocInfoContainer_t& allocContainer, uint32_t ut);
 
   /**
    *  Creates new TBTP to given container with information of the
@@ -139,6 +139,16 @@ SatFrameConf::SatFrameConf ( double bandwidthHz, Time targetDuration, Ptr<SatBtu
   uint32_t defWaveFormId = m_waveformConf->GetDefaultWaveformId ();
   Ptr<SatWaveform> defWaveform = m_waveformConf->GetWaveform (defWaveFormId);
 
+  // resolve the waveforms and their burst durations once for the users of the frame
+  m_waveforms.resize (m_waveformConf->GetMaxWfId () + 1);
+  m_burstDurations.resize (m_waveformConf->GetMaxWfId () + 1);
+
+  for (uint32_t wfId = m_waveformConf->GetMinWfId (); wfId <= m_waveformConf->GetMaxWfId (); wfId++)
+    {
+      m_waveforms[wfId] = m_waveformConf->GetWaveform (wfId);
+      m_burstDurations[wfId] = m_waveforms[wfId]->GetBurstDuration (m_btuConf->GetSymbolRateInBauds ());
+    }
+
   // calculate slot details based on given parameters and default waveform
   Time timeSlotDuration = defWaveform->GetBurstDuration (m_btuConf->GetSymbolRateInBauds ());
   uint32_t carrierSlotCount = targetDuration.GetSeconds () / timeSlotDuration.GetSeconds ();
@@ -443,6 +453,7 @@ SatSuperframeConf::AddFrameConf (Ptr<SatFrameConf> conf)
     }
 
   m_frames.push_back (conf);
+  m_frameFirstCarrierIds.push_back (m_carrierCount);
   m_carrierCount += conf->GetCarrierCount ();
 }
 
@@ -467,19 +478,12 @@ SatSuperframeConf::GetCarrierId ( uint8_t frameId, uint16_t frameCarrierId ) con
 {
   NS_LOG_FUNCTION (this);
 
-  uint32_t carrierId = frameCarrierId;
-
-  for (uint8_t i = 0; i < frameId; i++)
+  if ( frameId >= m_frameFirstCarrierIds.size ())
     {
-      if ( i >= m_frames.size ())
-        {
-          NS_FATAL_ERROR ("Carrier ID out of range.");
-        }
-
-      carrierId += m_frames[i]->GetCarrierCount ();
+      NS_FATAL_ERROR ("Carrier ID out of range.");
     }
 
-  return carrierId;
+  return m_frameFirstCarrierIds[frameId] + frameCarrierId;
 }
 
 double
@@ -691,6 +695,7 @@ SatSuperframeConf::Configure (double allocatedBandwidthHz, Time targetDuration,
       {
         m_raChannels.clear ();
         m_frames.clear ();
+        m_frameFirstCarrierIds.clear ();
         m_carrierCount = 0;
 
         if ( m_configType == CONFIG_TYPE_0)
@@ -389,6 +389,32 @@ public:
     return m_waveformConf;
   }
 
+  /**
+   * Get a waveform by waveform id. The waveforms are resolved once when the
+   * frame configuration is created.
+   *
+   * \param waveformId Id of the waveform
+   * 
+eturn The waveform
+   */
+  inline const Ptr<SatWaveform>& GetWaveform (uint32_t waveformId) const
+  {
+    return m_waveforms.at (waveformId);
+  }
+
+  /**
+   * Get the burst duration of a waveform with the symbol rate of this frame.
+   * The durations are calculated once when the frame configuration is created.
+   *
+   * \param waveformId Id of the waveform
+   * 
+eturn Burst duration of the waveform
+   */
+  inline Time GetBurstDuration (uint32_t waveformId) const
+  {
+    return m_burstDurations.at (waveformId);
+  }
+
 private:
   typedef std::map<uint16_t, SatTimeSlotConfContainer_t > SatTimeSlotConfMap_t; // key = carrier ID
 
@@ -403,6 +429,10 @@ private:
   uint32_t              m_minPayloadPerCarrierInBytes;
   SatTimeSlotConfMap_t  m_timeSlotConfMap;
 
+  // Waveforms and their burst durations with the symbol rate of the frame, indexed by waveform id
+  std::vector<Ptr<SatWaveform> >  m_waveforms;
+  std::vector<Time>               m_burstDurations;
+
   /**
    * Add time slot.
    *
@@ -707,6 +737,9 @@ private:
   std::vector<RaChannelInfo_t>  m_raChannels;
   uint32_t                      m_carrierCount;
 
+  // Super frame specific id of the first carrier of the frames, indexed by frame id
+  std::vector<uint32_t>         m_frameFirstCarrierIds;
+
   /**
    * Get frame id where given global carrier ID belongs to.
    *
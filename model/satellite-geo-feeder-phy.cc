@@ -188,14 +188,14 @@ SatGeoFeederPhy::SendPduWithParams (Ptr<SatSignalParameters> txParams )
   NS_LOG_INFO (this << " sending a packet with carrierId: " << txParams->m_carrierId << " duration: " << txParams->m_duration);
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 SatEnums::LD_RETURN,
-                 SatUtils::GetPacketInfo (txParams->m_packetsInBurst));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_SENT,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_PHY,
+                                       SatEnums::LD_RETURN,
+                                       txParams->GetPackets ()));
 
   // copy as sender own PhyTx object (at satellite) to ensure right distance calculation
   // and antenna gain getting at receiver (UT or GW)
@@ -228,16 +228,18 @@ SatGeoFeederPhy::Receive (Ptr<SatSignalParameters> rxParams, bool /*phyError*/)
   NS_LOG_FUNCTION (this << rxParams);
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 SatEnums::LD_FORWARD,
-                 SatUtils::GetPacketInfo (rxParams->m_packetsInBurst));
-
-  m_rxCallback ( rxParams->m_packetsInBurst, rxParams);
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_RECV,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_PHY,
+                                       SatEnums::LD_FORWARD,
+                                       rxParams->GetPackets ()));
+
+  // The packets are shared with the other receivers of the burst, thus
+  // they are detached before passing them up
+  m_rxCallback ( rxParams->GetWritablePackets (), rxParams);
 }
 
 double
@@ -84,14 +84,14 @@ SatGwLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t flow
           SatEnums::SatLinkDir_t ld = SatEnums::LD_FORWARD;
 
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_LLC,
-                         ld,
-                         SatUtils::GetPacketInfo (packet));
+          m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                               SatEnums::PACKET_SENT,
+                                               m_nodeInfo->GetNodeType (),
+                                               m_nodeInfo->GetNodeId (),
+                                               m_nodeInfo->GetMacAddress (),
+                                               SatEnums::LL_LLC,
+                                               ld,
+                                               packet));
         }
     }
   else
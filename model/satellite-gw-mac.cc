@@ -125,14 +125,14 @@ SatGwMac::Receive (SatPhy::PacketContainer_t packets, Ptr<SatSignalParameters> /
   NS_LOG_FUNCTION (this);
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_MAC,
-                 SatEnums::LD_RETURN,
-                 SatUtils::GetPacketInfo (packets));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_RECV,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_MAC,
+                                       SatEnums::LD_RETURN,
+                                       packets));
 
   // Invoke the `Rx` and `RxDelay` trace sources.
   RxTraces (packets);
@@ -205,14 +205,14 @@ SatGwMac::StartTransmission (uint32_t carrierId)
           m_bbFrameTxTrace (bbFrame->GetFrameType ());
 
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_MAC,
-                         SatEnums::LD_FORWARD,
-                         SatUtils::GetPacketInfo (bbFrame->GetPayload ()));
+          m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                               SatEnums::PACKET_SENT,
+                                               m_nodeInfo->GetNodeType (),
+                                               m_nodeInfo->GetNodeId (),
+                                               m_nodeInfo->GetMacAddress (),
+                                               SatEnums::LL_MAC,
+                                               SatEnums::LD_FORWARD,
+                                               bbFrame->GetPayload ()));
 
           SatSignalParameters::txInfo_s txInfo;
           txInfo.packetType = SatEnums::PACKET_TYPE_DEDICATED_ACCESS;
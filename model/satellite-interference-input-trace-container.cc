@@ -142,7 +142,22 @@ SatInterferenceInputTraceContainer::GetInterferenceDensity (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
+  return FindNode (key)->ProceedToNextClosestTimeSample (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
+}
+
+Ptr<SatInputFileStreamTimeDoubleContainer>
+SatInterferenceInputTraceContainer::GetInterferenceTrace (key_t key)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatInputFileStreamTimeDoubleContainer> trace = FindNode (key);
+
+  if (trace == NULL)
+    {
+      NS_FATAL_ERROR ("SatInterferenceInputTraceContainer::GetInterferenceTrace - No trace for MAC " << key.first);
+    }
+
+  return trace;
 }
 
 } // namespace ns3
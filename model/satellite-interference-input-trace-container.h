@@ -80,6 +80,16 @@ public:
    */
   double GetInterferenceDensity (key_t key);
 
+  /**
+   * \brief Function for getting the interference trace matching the key.
+   * The trace keeps the position of the last returned time sample, thus it
+   * may be stored and used as a cursor instead of looking up the key on
+   * each interference calculation.
+   * \param key key
+   * \return interference trace
+   */
+  Ptr<SatInputFileStreamTimeDoubleContainer> GetInterferenceTrace (key_t key);
+
   /**
    * \brief Function for resetting the variables
    */
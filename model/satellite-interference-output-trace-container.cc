@@ -119,6 +119,18 @@ SatInterferenceOutputTraceContainer::AddNode (key_t key)
           NS_FATAL_ERROR ("SatInterferenceOutputTraceContainer::AddNode failed");
         }
 
+      // The figure output is enabled before any rows are added, so that the
+      // figure is created from the rows before they are flushed to the file
+      if (m_enableFigureOutput)
+        {
+          result.first->second->EnableFigureOutput ("Interference density",
+                                                    "Time (s)",
+                                                    "Interference (W / Hz)",
+                                                    "set key top right",
+                                                    SatOutputFileStreamDoubleContainer::RAW,
+                                                    Gnuplot2dDataset::LINES_POINTS);
+        }
+
       NS_LOG_INFO ("SatInterferenceOutputTraceContainer::AddNode: Added node with MAC " << key.first << " channel type " << key.second);
 
       return result.first->second;
@@ -149,21 +161,16 @@ SatInterferenceOutputTraceContainer::WriteToFile ()
 
   for (iter = m_container.begin (); iter != m_container.end (); iter++)
     {
-      if (m_enableFigureOutput)
+      if (!m_enableFigureOutput)
         {
-          iter->second->EnableFigureOutput ("Interference density",
-                                            "Time (s)",
-                                            "Interference (W / Hz)",
-                                            "set key top right",
-                                            SatOutputFileStreamDoubleContainer::RAW,
-                                            Gnuplot2dDataset::LINES_POINTS);
+          iter->second->DisableFigureOutput ();
         }
       iter->second->WriteContainerToFile ();
     }
 }
 
 void
-SatInterferenceOutputTraceContainer::AddToContainer (key_t key, std::vector<double> newItem)
+SatInterferenceOutputTraceContainer::AddToContainer (key_t key, const std::vector<double>& newItem)
 {
   NS_LOG_FUNCTION (this);
 
@@ -112,6 +112,19 @@ SatLinkResultsDvbRcs2::GetBler (uint32_t waveformId, double ebNoDb) const
   return m_table.at (waveformId)->GetBler (ebNoDb);
 }
 
+void
+SatLinkResultsDvbRcs2::GetBler (uint32_t waveformId, const std::vector<double> &ebNoDb, std::vector<double> &bler) const
+{
+  NS_LOG_FUNCTION (this << waveformId << ebNoDb.size ());
+
+  if (!m_isInitialized)
+    {
+      NS_FATAL_ERROR ("Error retrieving link results, call Initialize first");
+    }
+
+  m_table.at (waveformId)->GetBler (ebNoDb, bler);
+}
+
 double
 SatLinkResultsDvbRcs2::GetEbNoDb (uint32_t waveformId, double blerTarget) const
 {
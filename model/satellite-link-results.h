@@ -137,6 +137,18 @@ public:
    */
   double GetBler (uint32_t waveformId, double ebNoDb) const;
 
+  /**
+   * \brief Get BLER values from link results for a set of Eb/No values.
+   *
+   * \param waveformId (which determines burst length and MODCOD)
+   * \param ebNoDb the received Eb/No values in dB
+   * \param bler BLER values corresponding to the Eb/No values
+   *
+   * Must be run after SatLinkResults::Initialize is called.
+   *
+   */
+  void GetBler (uint32_t waveformId, const std::vector<double> &ebNoDb, std::vector<double> &bler) const;
+
   /**
    * \brief Get a Eb/No requirement for a given BLER target from link results.
    *
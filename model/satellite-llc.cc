@@ -136,14 +136,14 @@ SatLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_ENQUE,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_LLC,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_ENQUE,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_LLC,
+                                       ld,
+                                       packet));
 
   return true;
 }
@@ -157,14 +157,14 @@ SatLlc::Receive (Ptr<Packet> packet, Mac48Address source, Mac48Address dest)
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_FORWARD : SatEnums::LD_RETURN;
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_LLC,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_RECV,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_LLC,
+                                       ld,
+                                       packet));
 
   // Receive packet with a decapsulator instance which is handling the
   // packets for this specific id
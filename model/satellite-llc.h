@@ -29,6 +29,7 @@
 #include <ns3/simple-ref-count.h>
 #include <ns3/mac48-address.h>
 #include <ns3/satellite-base-encapsulator.h>
+#include <ns3/satellite-packet-trace-record.h>
 
 namespace ns3 {
 
@@ -339,15 +340,7 @@ protected:
   /**
    * Trace callback used for packet tracing:
    */
-  TracedCallback<Time,
-                 SatEnums::SatPacketEvent_t,
-                 SatEnums::SatNodeType_t,
-                 uint32_t,
-                 Mac48Address,
-                 SatEnums::SatLogLevel_t,
-                 SatEnums::SatLinkDir_t,
-                 std::string
-                 > m_packetTrace;
+  TracedCallback<const SatPacketTraceRecord &> m_packetTrace;
 
   /**
    * Node info containing node related information, such as
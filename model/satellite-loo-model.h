@@ -22,7 +22,7 @@
 
 #include "ns3/vector.h"
 #include "satellite-base-fader.h"
-#include "satellite-fading-oscillator.h"
+#include "satellite-fading-oscillator-bank.h"
 #include "satellite-loo-conf.h"
 #include "ns3/random-variable-stream.h"
 
@@ -131,12 +131,12 @@ private:
   /**
    * \brief Direct signal oscillators
    */
-  std::vector< std::vector< Ptr<SatFadingOscillator> > > m_directSignalOscillators;
+  std::vector<SatFadingOscillatorBank> m_directSignalOscillators;
 
   /**
    * \brief Multipath oscillators
    */
-  std::vector< std::vector< Ptr<SatFadingOscillator> > > m_multipathOscillators;
+  std::vector<SatFadingOscillatorBank> m_multipathOscillators;
 
   /**
    * \brief Function for constructing direct signal oscillators
@@ -150,19 +150,19 @@ private:
 
   /**
    * \brief Function for calculating cosine wave oscillator complex sum
-   * \param oscillator oscillator
+   * \param oscillators oscillator bank
    * \param timeInSeconds current time in seconds
    * \return sum
    */
-  std::complex<double> GetOscillatorCosineWaveSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
+  std::complex<double> GetOscillatorCosineWaveSum (const SatFadingOscillatorBank& oscillators, double timeInSeconds) const;
 
   /**
    * \brief Function for calculating oscillator complex sum
-   * \param oscillator oscillator
+   * \param oscillators oscillator bank
    * \param timeInSeconds current time in seconds
    * \return sum
    */
-  std::complex<double> GetOscillatorComplexSum (std::vector< Ptr<SatFadingOscillator> > oscillator, double timeInSeconds);
+  std::complex<double> GetOscillatorComplexSum (const SatFadingOscillatorBank& oscillators, double timeInSeconds) const;
 
   /**
    * \brief Function for setting the state
@@ -20,11 +20,14 @@
  */
 
 #include <cmath>
+#include <algorithm>
+#include <functional>
 
 #include "ns3/log.h"
 #include "ns3/fatal-error.h"
 #include "satellite-look-up-table.h"
 #include "satellite-utils.h"
+#include "ns3/satellite-binary-data-cache.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatLookUpTable");
 
@@ -34,9 +37,17 @@ NS_OBJECT_ENSURE_REGISTERED (SatLookUpTable);
 
 
 SatLookUpTable::SatLookUpTable (std::string linkResultPath)
+  : m_esNoDbValues (0),
+    m_blerValues (0),
+    m_nValues (0),
+    m_cache (),
+    m_ifs (0),
+    m_uniformGrid (false),
+    m_esNoStepDb (0.0)
 {
   NS_LOG_FUNCTION (this << linkResultPath);
   Load (linkResultPath);
+  DetectUniformGrid ();
 }
 
 
@@ -53,6 +64,10 @@ SatLookUpTable::DoDispose ()
 
   m_esNoDb.clear ();
   m_bler.clear ();
+  m_esNoDbValues = 0;
+  m_blerValues = 0;
+  m_nValues = 0;
+  m_cache = 0;
 
   if (m_ifs != 0)
     {
@@ -80,32 +95,54 @@ SatLookUpTable::GetTypeId ()
 
 
 
+uint32_t
+SatLookUpTable::FindEsNoIndex (double esNoDb) const
+{
+  uint32_t n = m_nValues;
+  uint32_t i;
+
+  if (m_uniformGrid)
+    {
+      // Index calculated from the Es/No value is corrected against the actual
+      // Es/No values, thus the result is the same as with a search.
+      double pos = std::ceil ((esNoDb - m_esNoDbValues[0]) / m_esNoStepDb);
+      i = (pos >= 1.0) ? ((pos < n) ? (uint32_t) pos : n) : 1;
+
+      while (i > 1 && esNoDb <= m_esNoDbValues[i - 1])
+        {
+          i--;
+        }
+
+      while (i < n && esNoDb > m_esNoDbValues[i])
+        {
+          i++;
+        }
+    }
+  else
+    {
+      i = std::lower_bound (m_esNoDbValues + 1, m_esNoDbValues + m_nValues, esNoDb) - m_esNoDbValues;
+    }
+
+  return i;
+}
+
 double
 SatLookUpTable::GetBler (double esNoDb) const
 {
   NS_LOG_FUNCTION (this << esNoDb);
 
-  uint16_t n = m_esNoDb.size ();
+  uint32_t n = m_nValues;
 
   NS_ASSERT (n > 0);
-  NS_ASSERT (m_bler.size () == n);
 
-  if (esNoDb < m_esNoDb[0])
+  if (esNoDb < m_esNoDbValues[0])
     {
       // edge case: very low SINR, return maximum BLER (100% error rate)
       NS_LOG_INFO (this << " Very low SINR -> BLER = 1.0");
       return 1.0;
     }
 
-  uint16_t i = 1;
-
-  while ((i < n) && (esNoDb > m_esNoDb[i]))
-    {
-      i++;
-    }
-
-  NS_LOG_DEBUG (this << " i=" << i << " esno[i]=" << m_esNoDb[i]
-                     << " bler[i]=" << m_bler[i]);
+  uint32_t i = FindEsNoIndex (esNoDb);
 
   if (i >= n)
     {
@@ -113,17 +150,20 @@ SatLookUpTable::GetBler (double esNoDb) const
       NS_LOG_INFO (this << " Very high SINR -> BLER = 0.0");
       return 0.0;
     }
-  else // sinrDb <= m_esNoDb[i]
+  else // sinrDb <= m_esNoDbValues[i]
     {
+      NS_LOG_DEBUG (this << " i=" << i << " esno[i]=" << m_esNoDbValues[i]
+                         << " bler[i]=" << m_blerValues[i]);
+
       // normal case
       NS_ASSERT (i > 0);
       NS_ASSERT (i < n);
 
       double esno = esNoDb;
-      double esno0 = m_esNoDb[i - 1];
-      double esno1 = m_esNoDb[i];
-      double bler = SatUtils::Interpolate (esno, esno0, esno1, m_bler[i - 1], m_bler[i]);
-      NS_LOG_INFO (this << " Interpolate: " << esno << " to BLER = " << bler << "(sinr0: " << esno0 << ", sinr1: " << esno1 << ", bler0: " << m_bler[i - 1] << ", bler1: " << m_bler[i] << ")");
+      double esno0 = m_esNoDbValues[i - 1];
+      double esno1 = m_esNoDbValues[i];
+      double bler = SatUtils::Interpolate (esno, esno0, esno1, m_blerValues[i - 1], m_blerValues[i]);
+      NS_LOG_INFO (this << " Interpolate: " << esno << " to BLER = " << bler << "(sinr0: " << esno0 << ", sinr1: " << esno1 << ", bler0: " << m_blerValues[i - 1] << ", bler1: " << m_blerValues[i] << ")");
 
       return bler;
     }
@@ -131,40 +171,77 @@ SatLookUpTable::GetBler (double esNoDb) const
 } // end of double SatLookUpTable::GetBler (double sinrDb) const
 
 
+void
+SatLookUpTable::GetBler (const std::vector<double> &esNoDb, std::vector<double> &bler) const
+{
+  NS_LOG_FUNCTION (this << esNoDb.size ());
+
+  uint32_t n = m_nValues;
+
+  NS_ASSERT (n > 0);
+
+  bler.resize (esNoDb.size ());
+
+  for (uint32_t k = 0; k < esNoDb.size (); ++k)
+    {
+      if (esNoDb[k] < m_esNoDbValues[0])
+        {
+          bler[k] = 1.0;
+          continue;
+        }
+
+      uint32_t i = FindEsNoIndex (esNoDb[k]);
+
+      if (i >= n)
+        {
+          bler[k] = 0.0;
+        }
+      else
+        {
+          bler[k] = SatUtils::Interpolate (esNoDb[k], m_esNoDbValues[i - 1], m_esNoDbValues[i], m_blerValues[i - 1], m_blerValues[i]);
+        }
+    }
+}
+
+
 double
 SatLookUpTable::GetEsNoDb (double blerTarget) const
 {
   NS_LOG_FUNCTION (this << blerTarget);
 
-  uint16_t n = m_bler.size ();
+  uint32_t n = m_nValues;
 
   NS_ASSERT (n > 0);
-  NS_ASSERT (m_esNoDb.size () == n);
 
   // If the requested BLER is smaller than the smallest BLER entry
   // in the look-up-table
-  if (blerTarget < m_bler[n - 1])
+  if (blerTarget < m_blerValues[n - 1])
     {
-      return m_esNoDb[n - 1];
+      return m_esNoDbValues[n - 1];
     }
 
   // The requested BLER is higher than the highest BLER entry
   // in the look-up-table
-  if (blerTarget > m_bler[1])
+  if (blerTarget > m_blerValues[1])
     {
       NS_FATAL_ERROR ("The BLER target is set to be too high!");
     }
 
   double sinr = 0.0;
-  // Go through the list from end to beginning
-  for (uint32_t i = 0; i < n; ++i)
+
+  // Find the first entry with BLER equal to or smaller than the BLER target,
+  // BLER values are in non-increasing order
+  uint32_t i = std::lower_bound (m_blerValues, m_blerValues + m_nValues, blerTarget, std::greater<double> ()) - m_blerValues;
+
+  if (i == 0)
     {
-      if (blerTarget >= m_bler[i])
-        {
-          sinr = SatUtils::Interpolate (blerTarget, m_bler[i - 1], m_bler[i], m_esNoDb[i - 1], m_esNoDb[i]);
-          NS_LOG_INFO (this << " Interpolate: " << blerTarget << " to SINR = " << sinr << "(bler0: " << m_bler[i - 1] << ", bler1: " << m_bler[i] << ", sinr0: " << m_esNoDb[i - 1] << ", sinr1: " << m_esNoDb[i] << ")");
-          return sinr;
-        }
+      return m_esNoDbValues[0];
+    }
+
+  if (i < n)
+    {
+      sinr = SatUtils::Interpolate (blerTarget, m_blerValues[i - 1], m_blerValues[i], m_esNoDbValues[i - 1], m_esNoDbValues[i]);
+      NS_LOG_INFO (this << " Interpolate: " << blerTarget << " to SINR = " << sinr << "(bler0: " << m_blerValues[i - 1] << ", bler1: " << m_blerValues[i] << ", sinr0: " << m_esNoDbValues[i - 1] << ", sinr1: " << m_esNoDbValues[i] << ")");
     }
 
   return sinr;
@@ -193,6 +270,24 @@ SatLookUpTable::Load (std::string linkResultPath)
         }
     }
 
+  // Use the binary cache of the file, if it is valid
+  Ptr<SatBinaryDataCache> cache = SatBinaryDataCache::Open (linkResultPath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+
+  if (cache != NULL && cache->GetNParams () == 1 && cache->GetNValues () == 2 * (uint64_t) cache->GetParams ()[0])
+    {
+      m_ifs->close ();
+      delete m_ifs;
+      m_ifs = 0;
+
+      // Values: Es/No values followed by the BLER values, which are used
+      // directly from the mapped cache
+      m_nValues = (uint32_t) cache->GetParams ()[0];
+      m_esNoDbValues = cache->GetValues ();
+      m_blerValues = m_esNoDbValues + m_nValues;
+      m_cache = cache;
+      return;
+    }
+
   double lastEsNoDb = -100.0; // very low value
   double lastBler = 1.0; // maximum value
 
@@ -234,7 +329,48 @@ SatLookUpTable::Load (std::string linkResultPath)
   // SINR and BLER have same size
   NS_ASSERT (m_esNoDb.size () == m_bler.size ());
 
+  m_nValues = m_esNoDb.size ();
+  m_esNoDbValues = &m_esNoDb[0];
+  m_blerValues = &m_bler[0];
+
+  std::vector<double> params (1, m_esNoDb.size ());
+  std::vector<double> values (m_esNoDb.begin (), m_esNoDb.end ());
+  values.insert (values.end (), m_bler.begin (), m_bler.end ());
+
+  SatBinaryDataCache::Store (linkResultPath, SatBinaryDataCache::CACHE_LINK_RESULTS, params, values);
+
 } // end of void Load (std::string linkResultPath)
 
 
+void
+SatLookUpTable::DetectUniformGrid ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t n = m_nValues;
+  m_uniformGrid = false;
+
+  if (n < 3)
+    {
+      return;
+    }
+
+  double step = (m_esNoDbValues[n - 1] - m_esNoDbValues[0]) / (n - 1);
+
+  for (uint32_t i = 1; i < n; ++i)
+    {
+      if (std::abs (m_esNoDbValues[i] - (m_esNoDbValues[0] + i * step)) > 0.01 * step)
+        {
+          NS_LOG_INFO (this << " Es/No step is not constant, binary search is used");
+          return;
+        }
+    }
+
+  m_uniformGrid = true;
+  m_esNoStepDb = step;
+
+  NS_LOG_INFO (this << " Es/No step " << step << " dB is constant");
+}
+
+
 } // end of namespace ns3
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "ns3/object.h"
+#include "ns3/satellite-binary-data-cache.h"
 
 
 namespace ns3 {
@@ -34,6 +35,10 @@ namespace ns3 {
  * \ingroup satellite
  *
  * \brief Loads a link result file and provide query service for BLER.
+ *
+ * If the Es/No values of the link result file have a constant step, the
+ * BLER look-up calculates the table index directly from the Es/No value.
+ * Otherwise, the index is searched with a binary search.
  */
 class SatLookUpTable : public Object
 {
@@ -63,6 +68,13 @@ public:
    */
   double GetBler (double sinrDb) const;
 
+  /**
+   * \brief Get the BLERs corresponding to a set of SINRs
+   * \param sinrDb SINRs in logarithmic scale
+   * \param bler BLERs corresponding to the SINRs
+   */
+  void GetBler (const std::vector<double> &sinrDb, std::vector<double> &bler) const;
+
   /**
    * \brief Get Es/No in dB for a given BLER target
    * \param blerTarget BLER target (0-1)
@@ -79,9 +91,53 @@ private:
    */
   void Load (std::string linkResultPath);
 
+  /**
+   * \brief Detect whether the Es/No values have a constant step
+   */
+  void DetectUniformGrid ();
+
+  /**
+   * \brief Find the index of the first Es/No value (from index 1) which is
+   * equal to or higher than a given Es/No
+   * \param esNoDb Es/No in logarithmic scale
+   * \return Index, number of Es/No values if all the values are lower
+   */
+  uint32_t FindEsNoIndex (double esNoDb) const;
+
   std::vector<double> m_esNoDb;
   std::vector<double> m_bler;
+
+  /**
+   * \brief Es/No values in use, either m_esNoDb or the binary cache
+   */
+  const double *m_esNoDbValues;
+
+  /**
+   * \brief BLER values in use, either m_bler or the binary cache
+   */
+  const double *m_blerValues;
+
+  /**
+   * \brief Number of Es/No and BLER values
+   */
+  uint32_t m_nValues;
+
+  /**
+   * \brief Binary cache of the link results, if it is used
+   */
+  Ptr<SatBinaryDataCache> m_cache;
+
   std::ifstream *m_ifs;
+
+  /**
+   * \brief Is the step of Es/No values constant
+   */
+  bool m_uniformGrid;
+
+  /**
+   * \brief Es/No step of a uniform grid
+   */
+  double m_esNoStepDb;
 };
 
 } // end of namespace ns3
@@ -34,6 +34,7 @@
 #include "satellite-phy.h"
 #include "satellite-node-info.h"
 #include "satellite-queue.h"
+#include "satellite-packet-trace-record.h"
 
 
 namespace ns3 {
@@ -256,15 +257,7 @@ protected:
   /**
    * Trace callback used for packet tracing.
    */
-  TracedCallback< Time,
-                  SatEnums::SatPacketEvent_t,
-                  SatEnums::SatNodeType_t,
-                  uint32_t,
-                  Mac48Address,
-                  SatEnums::SatLogLevel_t,
-                  SatEnums::SatLinkDir_t,
-                  std::string
-                  > m_packetTrace;
+  TracedCallback<const SatPacketTraceRecord &> m_packetTrace;
 
   /**
    * Traced callback for all received packets, including the address of the
@@ -18,7 +18,12 @@
  * Author: Sami Rantanen <sami.rantanen@magister.fi>
  */
 
+#include <algorithm>
 #include <ns3/log.h>
+#include <ns3/uinteger.h>
+#include <ns3/boolean.h>
+#include <ns3/simulator.h>
+#include <ns3/system-thread.h>
 #include <ns3/satellite-control-message.h>
 #include <ns3/satellite-superframe-sequence.h>
 #include <ns3/satellite-lower-layer-service.h>
@@ -38,6 +43,19 @@ SatNcc::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::SatNcc")
     .SetParent<Object> ()
     .AddConstructor<SatNcc> ()
+    .AddAttribute ("BeamSchedulingThreads",
+                   "Number of threads used for the resource allocations of the beams scheduled at the same time. "
+                   "Value one schedules the beams one by one in their own events.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&SatNcc::m_beamSchedulingThreads),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("BeamAllocationStreams",
+                   "Shuffle the UTs, carriers and RCs in the resource allocation of a beam with a random variable stream "
+                   "of the beam instead of the random generator of the standard library. "
+                   "Always used with BeamSchedulingThreads greater than one.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatNcc::m_beamAllocationStreams),
+                   MakeBooleanChecker ())
     //
     // Trace sources
     //
@@ -62,6 +80,8 @@ SatNcc::GetInstanceTypeId (void) const
 }
 
 SatNcc::SatNcc ()
+  : m_beamSchedulingThreads (1),
+    m_beamAllocationStreams (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -77,6 +97,7 @@ SatNcc::DoDispose ()
   NS_LOG_FUNCTION (this);
 
   m_isLowRandomAccessLoad.clear ();
+  m_dueBeamSchedulers.clear ();
 
   Object::DoDispose ();
 }
@@ -257,11 +278,22 @@ SatNcc::AddBeam (uint32_t beamId, SatNcc::SendCallback cb, Ptr<SatSuperframeSeq>
   scheduler = CreateObject<SatBeamScheduler> ();
   scheduler->Initialize (beamId, cb, seq, maxFrameSize );
 
+  // the random generator of the standard library cannot be shared by concurrent allocations
+  if ( m_beamSchedulingThreads > 1 || m_beamAllocationStreams )
+    {
+      scheduler->UseAllocationRandomVariable ();
+    }
+
+  if ( m_beamSchedulingThreads > 1 )
+    {
+      scheduler->SetScheduleCallback (MakeCallback (&SatNcc::BeamSchedulingDue, this));
+    }
+
   m_beamSchedulers.insert (std::make_pair (beamId, scheduler));
 }
 
 uint32_t
-SatNcc::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t beamId)
+SatNcc::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t beamId, uint32_t& assignmentId)
 {
   NS_LOG_FUNCTION (this << utId << beamId);
 
@@ -272,7 +304,7 @@ SatNcc::AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t bea
       NS_FATAL_ERROR ( "Beam where tried to add, not found." );
     }
 
-  return m_beamSchedulers[beamId]->AddUt (utId, llsConf);
+  return m_beamSchedulers[beamId]->AddUt (utId, llsConf, assignmentId);
 }
 
 void
@@ -335,4 +367,98 @@ SatNcc::GetBeamScheduler (uint32_t beamId) const
     }
 }
 
+int64_t
+SatNcc::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+
+  int64_t currentStream = stream;
+
+  for (std::map<uint32_t, Ptr<SatBeamScheduler> >::const_iterator it = m_beamSchedulers.begin (); it != m_beamSchedulers.end (); ++it)
+    {
+      currentStream += it->second->AssignStreams (currentStream);
+    }
+
+  return (currentStream - stream);
+}
+
+void
+SatNcc::BeamSchedulingDue (Ptr<SatBeamScheduler> scheduler)
+{
+  NS_LOG_FUNCTION (this << scheduler);
+
+  // the beams due at the same time are scheduled together after their own events
+  if ( m_dueBeamSchedulers.empty () )
+    {
+      Simulator::ScheduleNow (&SatNcc::ScheduleBeams, this);
+    }
+
+  m_dueBeamSchedulers.push_back (scheduler);
+}
+
+void
+SatNcc::ScheduleBeams ()
+{
+  NS_LOG_FUNCTION (this << m_dueBeamSchedulers.size ());
+
+  std::vector<Ptr<SatBeamScheduler> > schedulers;
+  schedulers.swap (m_dueBeamSchedulers);
+
+  for (std::vector<Ptr<SatBeamScheduler> >::const_iterator it = schedulers.begin (); it != schedulers.end (); ++it)
+    {
+      (*it)->PrepareScheduling ();
+    }
+
+  AllocationJobQueue queue (schedulers);
+
+  std::vector<Ptr<SystemThread> > allocationThreads;
+
+  for (uint32_t i = 1; i < std::min<uint32_t> (m_beamSchedulingThreads, schedulers.size ()); ++i)
+    {
+      allocationThreads.push_back (Create<SystemThread> (MakeCallback (&AllocationJobQueue::Run, &queue)));
+      allocationThreads.back ()->Start ();
+    }
+
+  // The calling thread runs the jobs as well
+  queue.Run ();
+
+  for (uint32_t i = 0; i < allocationThreads.size (); ++i)
+    {
+      allocationThreads[i]->Join ();
+    }
+
+  for (std::vector<Ptr<SatBeamScheduler> >::const_iterator it = schedulers.begin (); it != schedulers.end (); ++it)
+    {
+      (*it)->CompleteScheduling ();
+    }
+}
+
+SatNcc::AllocationJobQueue::AllocationJobQueue (const std::vector<Ptr<SatBeamScheduler> > &schedulers)
+  : m_schedulers (schedulers),
+    m_nextJob (0)
+{
+}
+
+void
+SatNcc::AllocationJobQueue::Run ()
+{
+  while (true)
+    {
+      uint32_t index;
+
+      {
+        CriticalSection cs (m_mutex);
+
+        if (m_nextJob >= m_schedulers.size ())
+          {
+            return;
+          }
+
+        index = m_nextJob++;
+      }
+
+      m_schedulers[index]->AllocateResources ();
+    }
+}
+
 } // namespace ns3
@@ -23,9 +23,11 @@
 
 #include <map>
 #include <utility>
+#include <vector>
 #include <ns3/object.h>
 #include <ns3/ptr.h>
 #include <ns3/traced-callback.h>
+#include <ns3/system-mutex.h>
 #include <ns3/satellite-beam-scheduler.h>
 
 namespace ns3 {
@@ -43,6 +45,15 @@ class SatLowerLayerServiceConf;
  * This SatNcc class implements NCC functionality in Satellite network. It is shared
  * module among GWs. Communication between NCC and GW is handled by callback functions.
  *
+ * With attribute BeamSchedulingThreads greater than one, the beams due to be scheduled
+ * at the same time are scheduled together by the NCC. The DAMA entry updates, TBTP
+ * generation and sending are done one beam at a time in the simulator thread, but the
+ * resource allocations of the beams are run concurrently in the given number of threads.
+ * The UTs, carriers and RCs are then shuffled with a random variable stream per beam
+ * instead of the random generator of the standard library. The random variable streams
+ * can be used also with one thread by attribute BeamAllocationStreams, and the
+ * allocations with the random variable streams don't depend on the number of threads.
+ *
  */
 class SatNcc : public Object
 {
@@ -129,9 +140,10 @@ public:
    * \param utId ID (mac address) of the UT to be added
    * \param llsConf Lower layer service configuration for the UT to be added.
    * \param beamId ID of the beam where UT is connected.
+   * \param assignmentId Variable to store the TBTP assignment ID of the added UT.
    * \return RA channel index assigned to added UT.
    */
-  uint32_t AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t beamId);
+  uint32_t AddUt (Address utId, Ptr<SatLowerLayerServiceConf> llsConf, uint32_t beamId, uint32_t& assignmentId);
 
   /**
    * \brief Function for setting the random access allocation channel specific high load backoff probabilities
@@ -174,6 +186,13 @@ public:
    */
   Ptr<SatBeamScheduler> GetBeamScheduler (uint32_t beamId) const;
 
+  /**
+   * \brief Assign fixed random variable streams to the beam schedulers in beam ID order
+   * \param stream First stream index to use
+   * \return Number of stream indices assigned
+   */
+  int64_t AssignStreams (int64_t stream);
+
 private:
   SatNcc& operator = (const SatNcc &);
   SatNcc (const SatNcc &);
@@ -189,6 +208,56 @@ private:
    */
   void CreateRandomAccessLoadControlMessage (uint16_t backoffProbability, uint16_t backoffTime, uint32_t beamId, uint8_t allocationChannelId);
 
+  /**
+   * \brief Function called by a beam scheduler when its scheduling is due
+   * \param scheduler Beam scheduler
+   */
+  void BeamSchedulingDue (Ptr<SatBeamScheduler> scheduler);
+
+  /**
+   * \brief Function for scheduling the beams due at the current time
+   */
+  void ScheduleBeams ();
+
+  /**
+   * \brief Job queue of the resource allocations run by all the beam scheduling threads
+   */
+  class AllocationJobQueue
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param schedulers Beam schedulers which resources are allocated
+     */
+    AllocationJobQueue (const std::vector<Ptr<SatBeamScheduler> > &schedulers);
+
+    /**
+     * \brief Pick and run the jobs until all of them have been picked
+     */
+    void Run ();
+
+  private:
+    const std::vector<Ptr<SatBeamScheduler> > &m_schedulers;
+    uint32_t m_nextJob;
+    SystemMutex m_mutex;
+  };
+
+  /**
+   * Number of threads used for the resource allocations of the beams
+   */
+  uint32_t m_beamSchedulingThreads;
+
+  /**
+   * Flag telling whether the resource allocations of the beams use random variable
+   * streams of the beams also with one thread
+   */
+  bool m_beamAllocationStreams;
+
+  /**
+   * Beam schedulers due to be scheduled at the current time in the order they became due
+   */
+  std::vector<Ptr<SatBeamScheduler> > m_dueBeamSchedulers;
+
   /**
    * The map containing beams in use (set).
    */
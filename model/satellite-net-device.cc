@@ -128,14 +128,14 @@ SatNetDevice::Receive (Ptr<const Packet> packet)
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_FORWARD : SatEnums::LD_RETURN;
 
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_ND,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_RECV,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_ND,
+                                       ld,
+                                       packet));
 
   /*
    * Invoke the `Rx` and `RxDelay` trace sources. We look at the packet's tags
@@ -376,14 +376,14 @@ SatNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t protocolNu
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_ND,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_SENT,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_ND,
+                                       ld,
+                                       packet));
 
   m_txTrace (packet);
 
@@ -410,14 +410,14 @@ SatNetDevice::SendFrom (Ptr<Packet> packet, const Address& source, const Address
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_ND,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_SENT,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_ND,
+                                       ld,
+                                       packet));
 
   m_txTrace (packet);
 
@@ -447,14 +447,14 @@ SatNetDevice::SendControlMsg (Ptr<SatControlMessage> msg, const Address& dest)
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_ND,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_SENT,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_ND,
+                                       ld,
+                                       packet));
 
   // Add control tag to message and write msg to container in MAC
   SatControlMsgTag tag;
@@ -31,6 +31,7 @@
 #include <ns3/traced-callback.h>
 #include <ns3/satellite-enums.h>
 #include <ns3/satellite-packet-classifier.h>
+#include <ns3/satellite-packet-trace-record.h>
 
 namespace ns3 {
 
@@ -193,15 +194,7 @@ private:
 
   Ptr<SatNodeInfo> m_nodeInfo;
 
-  TracedCallback<Time,
-                 SatEnums::SatPacketEvent_t,
-                 SatEnums::SatNodeType_t,
-                 uint32_t,
-                 Mac48Address,
-                 SatEnums::SatLogLevel_t,
-                 SatEnums::SatLinkDir_t,
-                 std::string
-                 > m_packetTrace;
+  TracedCallback<const SatPacketTraceRecord &> m_packetTrace;
 
   /**
    * Traced callback for all packets received to be transmitted
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+#include "satellite-mac-tag.h"
+#include "satellite-packet-trace-record.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatPacketTraceRecord");
+
+namespace ns3 {
+
+SatPacketTraceRecord::SatPacketTraceRecord (Time now,
+                                            SatEnums::SatPacketEvent_t packetEvent,
+                                            SatEnums::SatNodeType_t nodeType,
+                                            uint32_t nodeId,
+                                            Mac48Address macAddress,
+                                            SatEnums::SatLogLevel_t logLevel,
+                                            SatEnums::SatLinkDir_t linkDir,
+                                            Ptr<const Packet> packet)
+  : m_time (now),
+    m_packetEvent (packetEvent),
+    m_nodeType (nodeType),
+    m_nodeId (nodeId),
+    m_macAddress (macAddress),
+    m_logLevel (logLevel),
+    m_linkDir (linkDir),
+    m_packet (PeekPointer (packet)),
+    m_packets (NULL)
+{
+}
+
+SatPacketTraceRecord::SatPacketTraceRecord (Time now,
+                                            SatEnums::SatPacketEvent_t packetEvent,
+                                            SatEnums::SatNodeType_t nodeType,
+                                            uint32_t nodeId,
+                                            Mac48Address macAddress,
+                                            SatEnums::SatLogLevel_t logLevel,
+                                            SatEnums::SatLinkDir_t linkDir,
+                                            const PacketContainer_t& packets)
+  : m_time (now),
+    m_packetEvent (packetEvent),
+    m_nodeType (nodeType),
+    m_nodeId (nodeId),
+    m_macAddress (macAddress),
+    m_logLevel (logLevel),
+    m_linkDir (linkDir),
+    m_packet (NULL),
+    m_packets (&packets)
+{
+}
+
+uint32_t
+SatPacketTraceRecord::GetNPackets () const
+{
+  if (m_packets)
+    {
+      return m_packets->size ();
+    }
+
+  return (m_packet ? 1 : 0);
+}
+
+const Packet*
+SatPacketTraceRecord::GetPacket (uint32_t index) const
+{
+  if (index >= GetNPackets ())
+    {
+      NS_FATAL_ERROR ("SatPacketTraceRecord::GetPacket - Invalid packet index: " << index);
+    }
+
+  if (m_packets)
+    {
+      return PeekPointer ((*m_packets)[index]);
+    }
+
+  return m_packet;
+}
+
+uint64_t
+SatPacketTraceRecord::GetPacketUid (uint32_t index) const
+{
+  return GetPacket (index)->GetUid ();
+}
+
+bool
+SatPacketTraceRecord::GetPacketAddresses (uint32_t index, Mac48Address& source, Mac48Address& destination) const
+{
+  SatMacTag tag;
+
+  if (GetPacket (index)->PeekPacketTag (tag))
+    {
+      source = tag.GetSourceAddress ();
+      destination = tag.GetDestAddress ();
+      return true;
+    }
+
+  return false;
+}
+
+std::string
+SatPacketTraceRecord::GetPacketInfo () const
+{
+  std::ostringstream oss;
+
+  for (uint32_t i = 0; i < GetNPackets (); i++)
+    {
+      Mac48Address source;
+      Mac48Address destination;
+
+      oss << GetPacketUid (i) << " ";
+
+      if (GetPacketAddresses (i, source, destination))
+        {
+          oss << source << " ";
+          oss << destination << " ";
+        }
+    }
+
+  return oss.str ();
+}
+
+} // namespace ns3
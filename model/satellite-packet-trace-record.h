@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SATELLITE_PACKET_TRACE_RECORD_H_
+#define SATELLITE_PACKET_TRACE_RECORD_H_
+
+#include <string>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "satellite-enums.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Packet event record passed to the `PacketTrace` trace sources.
+ *
+ * The record is created on the stack of the traced protocol layer and it
+ * only refers to the traced packets, thus creating the record is cheap even
+ * when no sink is connected to the trace source. The per packet information
+ * (UID, source and destination MAC address) is read from the packets only
+ * when requested by a sink. The record is valid only during the trace call.
+ */
+class SatPacketTraceRecord
+{
+public:
+  /**
+   * Define type PacketContainer_t
+   */
+  typedef std::vector< Ptr<Packet> > PacketContainer_t;
+
+  /**
+   * \brief Constructor for a packet event of a single packet
+   * \param now Time of the event
+   * \param packetEvent Packet event (SND, RCV, DRP, ENQ)
+   * \param nodeType Node type (UT, SAT, GW, NCC, TER)
+   * \param nodeId Node id
+   * \param macAddress MAC address
+   * \param logLevel Log level (ND, LLC, MAC, PHY, CH)
+   * \param linkDir Link direction (FWD, RTN)
+   * \param packet Traced packet
+   */
+  SatPacketTraceRecord (Time now,
+                        SatEnums::SatPacketEvent_t packetEvent,
+                        SatEnums::SatNodeType_t nodeType,
+                        uint32_t nodeId,
+                        Mac48Address macAddress,
+                        SatEnums::SatLogLevel_t logLevel,
+                        SatEnums::SatLinkDir_t linkDir,
+                        Ptr<const Packet> packet);
+
+  /**
+   * \brief Constructor for a packet event of several packets
+   * \param now Time of the event
+   * \param packetEvent Packet event (SND, RCV, DRP, ENQ)
+   * \param nodeType Node type (UT, SAT, GW, NCC, TER)
+   * \param nodeId Node id
+   * \param macAddress MAC address
+   * \param logLevel Log level (ND, LLC, MAC, PHY, CH)
+   * \param linkDir Link direction (FWD, RTN)
+   * \param packets Traced packets, the container shall exist as long as the record
+   */
+  SatPacketTraceRecord (Time now,
+                        SatEnums::SatPacketEvent_t packetEvent,
+                        SatEnums::SatNodeType_t nodeType,
+                        uint32_t nodeId,
+                        Mac48Address macAddress,
+                        SatEnums::SatLogLevel_t logLevel,
+                        SatEnums::SatLinkDir_t linkDir,
+                        const PacketContainer_t& packets);
+
+  /**
+   * \brief Get the time of the event
+   * \return time of the event
+   */
+  inline Time GetTime () const
+  {
+    return m_time;
+  }
+
+  /**
+   * \brief Get the packet event
+   * \return packet event
+   */
+  inline SatEnums::SatPacketEvent_t GetPacketEvent () const
+  {
+    return m_packetEvent;
+  }
+
+  /**
+   * \brief Get the node type
+   * \return node type
+   */
+  inline SatEnums::SatNodeType_t GetNodeType () const
+  {
+    return m_nodeType;
+  }
+
+  /**
+   * \brief Get the node id
+   * \return node id
+   */
+  inline uint32_t GetNodeId () const
+  {
+    return m_nodeId;
+  }
+
+  /**
+   * \brief Get the MAC address of the node
+   * \return MAC address
+   */
+  inline Mac48Address GetMacAddress () const
+  {
+    return m_macAddress;
+  }
+
+  /**
+   * \brief Get the log level
+   * \return log level
+   */
+  inline SatEnums::SatLogLevel_t GetLogLevel () const
+  {
+    return m_logLevel;
+  }
+
+  /**
+   * \brief Get the link direction
+   * \return link direction
+   */
+  inline SatEnums::SatLinkDir_t GetLinkDir () const
+  {
+    return m_linkDir;
+  }
+
+  /**
+   * \brief Get the number of traced packets
+   * \return number of packets
+   */
+  uint32_t GetNPackets () const;
+
+  /**
+   * \brief Get the UID of a traced packet
+   * \param index Index of the packet
+   * \return UID of the packet
+   */
+  uint64_t GetPacketUid (uint32_t index) const;
+
+  /**
+   * \brief Get the source and destination MAC addresses of a traced packet
+   * \param index Index of the packet
+   * \param source Source MAC address
+   * \param destination Destination MAC address
+   * \return true if the packet has MAC addresses (SatMacTag)
+   */
+  bool GetPacketAddresses (uint32_t index, Mac48Address& source, Mac48Address& destination) const;
+
+  /**
+   * \brief Get the packet info in the same format as SatUtils::GetPacketInfo
+   * \return packet info (List of: Packet id, source MAC address, destination MAC address)
+   */
+  std::string GetPacketInfo () const;
+
+private:
+  /**
+   * \brief Get a traced packet
+   * \param index Index of the packet
+   * \return packet
+   */
+  const Packet* GetPacket (uint32_t index) const;
+
+  Time m_time;
+  SatEnums::SatPacketEvent_t m_packetEvent;
+  SatEnums::SatNodeType_t m_nodeType;
+  uint32_t m_nodeId;
+  Mac48Address m_macAddress;
+  SatEnums::SatLogLevel_t m_logLevel;
+  SatEnums::SatLinkDir_t m_linkDir;
+
+  /**
+   * Traced packet of a single packet event, NULL otherwise
+   */
+  const Packet* m_packet;
+
+  /**
+   * Traced packets of a several packet event, NULL otherwise
+   */
+  const PacketContainer_t* m_packets;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_PACKET_TRACE_RECORD_H_ */
@@ -18,11 +18,15 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
+#include <cstring>
 #include "ns3/object.h"
 #include "ns3/log.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/trace-helper.h"
 #include "ns3/string.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 #include "ns3/mac48-address.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
@@ -34,23 +38,49 @@ namespace ns3 {
 
 NS_OBJECT_ENSURE_REGISTERED (SatPacketTrace);
 
+/**
+ * Identifier and version written to the beginning of a binary packet trace file
+ */
+static const char BINARY_TRACE_MAGIC[8] = { 'S', 'A', 'T', 'P', 'K', 'T', 'T', 'R' };
+static const uint32_t BINARY_TRACE_VERSION = 1;
+
+/**
+ * Time the writer thread waits for new pages before checking the page queue again
+ */
+static const uint64_t WRITER_POLL_INTERVAL_NS = 10000000;
+
 SatPacketTrace::SatPacketTrace ()
+  : m_outputFormat (OUTPUT_TEXT),
+    m_pageSize (1048576),
+    m_currentPage (NULL),
+    m_stopWriter (false)
 {
   ObjectBase::ConstructSelf (AttributeConstructionList ());
 
-  AsciiTraceHelper asciiTraceHelper;
-
   std::stringstream outputPath;
-  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName << ".log";
+  outputPath << Singleton<SatEnvVariables>::Get ()->GetOutputPath () << "/" << m_fileName;
+
+  if (m_outputFormat == OUTPUT_BINARY)
+    {
+      outputPath << ".bin";
+      StartBinaryOutput (outputPath.str ());
+    }
+  else
+    {
+      AsciiTraceHelper asciiTraceHelper;
 
-  m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
+      outputPath << ".log";
+      m_packetTraceStream = asciiTraceHelper.CreateFileStream (outputPath.str ());
 
-  PrintHeader ();
+      PrintHeader (*m_packetTraceStream->GetStream ());
+    }
 }
 
 SatPacketTrace::~SatPacketTrace ()
 {
   NS_LOG_FUNCTION (this);
+
+  StopBinaryOutput ();
 }
 
 TypeId
@@ -70,6 +100,18 @@ SatPacketTrace::GetTypeId ()
                    StringValue ("PacketTrace"),
                    MakeStringAccessor (&SatPacketTrace::m_fileName),
                    MakeStringChecker ())
+    .AddAttribute ("OutputFormat",
+                   "Output format of the packet trace. Binary output has file extension .bin and it is "
+                   "written by a background thread; see SatPacketTrace::ConvertBinaryToText.",
+                   EnumValue (SatPacketTrace::OUTPUT_TEXT),
+                   MakeEnumAccessor (&SatPacketTrace::m_outputFormat),
+                   MakeEnumChecker (SatPacketTrace::OUTPUT_TEXT, "Text",
+                                    SatPacketTrace::OUTPUT_BINARY, "Binary"))
+    .AddAttribute ("PageSize",
+                   "Size of the in-memory pages of binary packet trace records in bytes",
+                   UintegerValue (1048576),
+                   MakeUintegerAccessor (&SatPacketTrace::m_pageSize),
+                   MakeUintegerChecker<uint32_t> (1024))
   ;
   return tid;
 }
@@ -78,38 +120,34 @@ void
 SatPacketTrace::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+
+  StopBinaryOutput ();
+
   Object::DoDispose ();
 }
 
 void
-SatPacketTrace::PrintHeader ()
+SatPacketTrace::PrintHeader (std::ostream &os)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION_NOARGS ();
 
-  *m_packetTraceStream->GetStream () << "COLUMN DESCRIPTIONS" << std::endl;
-  *m_packetTraceStream->GetStream () << "-------------------" << std::endl;
-  *m_packetTraceStream->GetStream () << "Time" << std::endl;
-  *m_packetTraceStream->GetStream () << "Packet event (SND, RCV, DRP, ENQ)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Node type (UT, SAT, GW, NCC, TER)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Node id" << std::endl;
-  *m_packetTraceStream->GetStream () << "MAC address" << std::endl;
-  *m_packetTraceStream->GetStream () << "Log level (ND, LLC, MAC, PHY, CH)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Link direction (FWD, RTN)" << std::endl;
-  *m_packetTraceStream->GetStream () << "Packet info (List of: Packet id, source MAC address, destination MAC address)" << std::endl;
-  *m_packetTraceStream->GetStream () << "-------------------" << std::endl << std::endl;
+  os << "COLUMN DESCRIPTIONS" << std::endl;
+  os << "-------------------" << std::endl;
+  os << "Time" << std::endl;
+  os << "Packet event (SND, RCV, DRP, ENQ)" << std::endl;
+  os << "Node type (UT, SAT, GW, NCC, TER)" << std::endl;
+  os << "Node id" << std::endl;
+  os << "MAC address" << std::endl;
+  os << "Log level (ND, LLC, MAC, PHY, CH)" << std::endl;
+  os << "Link direction (FWD, RTN)" << std::endl;
+  os << "Packet info (List of: Packet id, source MAC address, destination MAC address)" << std::endl;
+  os << "-------------------" << std::endl << std::endl;
 }
 
 void
-SatPacketTrace::AddTraceEntry (Time now,
-                               SatEnums::SatPacketEvent_t packetEvent,
-                               SatEnums::SatNodeType_t nodeType,
-                               uint32_t nodeId,
-                               Mac48Address macAddress,
-                               SatEnums::SatLogLevel_t logLevel,
-                               SatEnums::SatLinkDir_t linkDir,
-                               std::string packetInfo)
+SatPacketTrace::AddTraceEntry (const SatPacketTraceRecord &record)
 {
-  NS_LOG_FUNCTION (this << now.GetSeconds ());
+  NS_LOG_FUNCTION (this << record.GetTime ().GetSeconds ());
 
   /**
    * TODO: Currently the packet trace logs all entries updated by the protocol layers.
@@ -122,17 +160,327 @@ SatPacketTrace::AddTraceEntry (Time now,
    * - Entries from one simulation direction
    */
 
+  if (m_outputFormat == OUTPUT_BINARY)
+    {
+      AppendBinaryEntry (record);
+      return;
+    }
+
   std::ostringstream oss;
-  oss << now.GetSeconds () << " "
-      << SatEnums::GetPacketEventName (packetEvent) << " "
-      << SatEnums::GetNodeTypeName (nodeType) << " "
-      << nodeId << " "
-      << macAddress << " "
-      << SatEnums::GetLogLevelName (logLevel) << " "
-      << SatEnums::GetLinkDirName (linkDir) << " "
-      << packetInfo;
+  oss << record.GetTime ().GetSeconds () << " "
+      << SatEnums::GetPacketEventName (record.GetPacketEvent ()) << " "
+      << SatEnums::GetNodeTypeName (record.GetNodeType ()) << " "
+      << record.GetNodeId () << " "
+      << record.GetMacAddress () << " "
+      << SatEnums::GetLogLevelName (record.GetLogLevel ()) << " "
+      << SatEnums::GetLinkDirName (record.GetLinkDir ()) << " "
+      << record.GetPacketInfo ();
 
   *m_packetTraceStream->GetStream () << oss.str () << std::endl;
 }
 
+void
+SatPacketTrace::StartBinaryOutput (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  m_binaryStream.open (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!m_binaryStream.is_open ())
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::StartBinaryOutput - Unable to open file: " << fileName);
+    }
+
+  uint32_t eventRecordSize = sizeof (EventRecord_t);
+  uint32_t packetRecordSize = sizeof (PacketRecord_t);
+
+  m_binaryStream.write (BINARY_TRACE_MAGIC, sizeof (BINARY_TRACE_MAGIC));
+  m_binaryStream.write (reinterpret_cast<const char*> (&BINARY_TRACE_VERSION), sizeof (BINARY_TRACE_VERSION));
+  m_binaryStream.write (reinterpret_cast<const char*> (&eventRecordSize), sizeof (eventRecordSize));
+  m_binaryStream.write (reinterpret_cast<const char*> (&packetRecordSize), sizeof (packetRecordSize));
+
+  m_currentPage = new Page_t;
+  m_currentPage->m_data.resize (m_pageSize);
+  m_currentPage->m_size = 0;
+  m_stopWriter = false;
+
+  m_writerThread = Create<SystemThread> (MakeCallback (&SatPacketTrace::WriterLoop, this));
+  m_writerThread->Start ();
+
+  // Make sure that the trace file is complete when the simulation is destroyed
+  Simulator::ScheduleDestroy (&SatPacketTrace::StopBinaryOutput, Ptr<SatPacketTrace> (this));
+}
+
+void
+SatPacketTrace::StopBinaryOutput ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_writerThread == 0)
+    {
+      return;
+    }
+
+  {
+    CriticalSection cs (m_pageMutex);
+
+    if (m_currentPage->m_size > 0)
+      {
+        m_fullPages.push_back (m_currentPage);
+      }
+    else
+      {
+        m_freePages.push_back (m_currentPage);
+      }
+
+    m_currentPage = NULL;
+    m_stopWriter = true;
+  }
+
+  m_pagesReady.SetCondition (true);
+  m_pagesReady.Signal ();
+  m_writerThread->Join ();
+  m_writerThread = 0;
+
+  for (std::vector<Page_t*>::iterator it = m_freePages.begin (); it != m_freePages.end (); ++it)
+    {
+      delete *it;
+    }
+  m_freePages.clear ();
+
+  m_binaryStream.close ();
+}
+
+void
+SatPacketTrace::AppendBinaryEntry (const SatPacketTraceRecord &record)
+{
+  // Entries traced after the output is closed cannot be written
+  if (m_currentPage == NULL)
+    {
+      return;
+    }
+
+  uint32_t nPackets = record.GetNPackets ();
+  uint32_t size = sizeof (EventRecord_t) + nPackets * sizeof (PacketRecord_t);
+
+  if (m_currentPage->m_size + size > m_currentPage->m_data.size ())
+    {
+      SwapPage (size);
+    }
+
+  uint8_t* data = &m_currentPage->m_data[m_currentPage->m_size];
+
+  EventRecord_t event;
+  std::memset (&event, 0, sizeof (event));
+  event.m_time = record.GetTime ().GetSeconds ();
+  event.m_nodeId = record.GetNodeId ();
+  event.m_nPackets = nPackets;
+  event.m_packetEvent = record.GetPacketEvent ();
+  event.m_nodeType = record.GetNodeType ();
+  event.m_logLevel = record.GetLogLevel ();
+  event.m_linkDir = record.GetLinkDir ();
+  record.GetMacAddress ().CopyTo (event.m_macAddress);
+
+  std::memcpy (data, &event, sizeof (event));
+  data += sizeof (event);
+
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      PacketRecord_t packet;
+      std::memset (&packet, 0, sizeof (packet));
+
+      Mac48Address source;
+      Mac48Address destination;
+
+      packet.m_uid = record.GetPacketUid (i);
+
+      if (record.GetPacketAddresses (i, source, destination))
+        {
+          source.CopyTo (packet.m_source);
+          destination.CopyTo (packet.m_destination);
+          packet.m_hasAddresses = 1;
+        }
+
+      std::memcpy (data, &packet, sizeof (packet));
+      data += sizeof (packet);
+    }
+
+  m_currentPage->m_size += size;
+}
+
+void
+SatPacketTrace::SwapPage (uint32_t minSize)
+{
+  NS_LOG_FUNCTION (this << minSize);
+
+  if (m_currentPage->m_size == 0)
+    {
+      // The entry does not fit even to an empty page
+      m_currentPage->m_data.resize (minSize);
+      return;
+    }
+
+  Page_t* page = NULL;
+
+  {
+    CriticalSection cs (m_pageMutex);
+
+    m_fullPages.push_back (m_currentPage);
+
+    if (!m_freePages.empty ())
+      {
+        page = m_freePages.back ();
+        m_freePages.pop_back ();
+      }
+  }
+
+  m_pagesReady.SetCondition (true);
+  m_pagesReady.Signal ();
+
+  // The simulation never waits for the writer, a new page is allocated if
+  // all the pages are still waiting to be written.
+  if (page == NULL)
+    {
+      page = new Page_t;
+      page->m_data.resize (m_pageSize);
+    }
+
+  if (page->m_data.size () < minSize)
+    {
+      page->m_data.resize (minSize);
+    }
+
+  page->m_size = 0;
+  m_currentPage = page;
+}
+
+void
+SatPacketTrace::WriterLoop ()
+{
+  NS_LOG_FUNCTION (this);
+
+  bool stop = false;
+
+  while (!stop)
+    {
+      std::deque<Page_t*> pages;
+
+      // Reset before taking the pages, so that pages queued after the
+      // swap wake up the wait below instead of being missed.
+      m_pagesReady.SetCondition (false);
+
+      {
+        CriticalSection cs (m_pageMutex);
+        pages.swap (m_fullPages);
+        stop = m_stopWriter;
+      }
+
+      if (pages.empty ())
+        {
+          if (!stop)
+            {
+              m_pagesReady.TimedWait (WRITER_POLL_INTERVAL_NS);
+            }
+          continue;
+        }
+
+      for (std::deque<Page_t*>::iterator it = pages.begin (); it != pages.end (); ++it)
+        {
+          m_binaryStream.write (reinterpret_cast<const char*> (&(*it)->m_data[0]), (*it)->m_size);
+        }
+
+      {
+        CriticalSection cs (m_pageMutex);
+        m_freePages.insert (m_freePages.end (), pages.begin (), pages.end ());
+      }
+    }
+
+  m_binaryStream.flush ();
+}
+
+uint64_t
+SatPacketTrace::ConvertBinaryToText (std::string binaryFileName, std::string textFileName)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  std::ifstream input (binaryFileName.c_str (), std::ios::in | std::ios::binary);
+
+  if (!input.is_open ())
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::ConvertBinaryToText - Unable to open file: " << binaryFileName);
+    }
+
+  char magic[sizeof (BINARY_TRACE_MAGIC)];
+  uint32_t version = 0;
+  uint32_t eventRecordSize = 0;
+  uint32_t packetRecordSize = 0;
+
+  input.read (magic, sizeof (magic));
+  input.read (reinterpret_cast<char*> (&version), sizeof (version));
+  input.read (reinterpret_cast<char*> (&eventRecordSize), sizeof (eventRecordSize));
+  input.read (reinterpret_cast<char*> (&packetRecordSize), sizeof (packetRecordSize));
+
+  if (!input
+      || std::memcmp (magic, BINARY_TRACE_MAGIC, sizeof (magic)) != 0
+      || version != BINARY_TRACE_VERSION
+      || eventRecordSize != sizeof (EventRecord_t)
+      || packetRecordSize != sizeof (PacketRecord_t))
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::ConvertBinaryToText - Not a compatible binary packet trace file: " << binaryFileName);
+    }
+
+  std::ofstream output (textFileName.c_str (), std::ios::out | std::ios::trunc);
+
+  if (!output.is_open ())
+    {
+      NS_FATAL_ERROR ("SatPacketTrace::ConvertBinaryToText - Unable to open file: " << textFileName);
+    }
+
+  PrintHeader (output);
+
+  uint64_t entries = 0;
+  EventRecord_t event;
+
+  while (input.read (reinterpret_cast<char*> (&event), sizeof (event)))
+    {
+      Mac48Address macAddress;
+      macAddress.CopyFrom (event.m_macAddress);
+
+      output << event.m_time << " "
+             << SatEnums::GetPacketEventName (static_cast<SatEnums::SatPacketEvent_t> (event.m_packetEvent)) << " "
+             << SatEnums::GetNodeTypeName (static_cast<SatEnums::SatNodeType_t> (event.m_nodeType)) << " "
+             << event.m_nodeId << " "
+             << macAddress << " "
+             << SatEnums::GetLogLevelName (static_cast<SatEnums::SatLogLevel_t> (event.m_logLevel)) << " "
+             << SatEnums::GetLinkDirName (static_cast<SatEnums::SatLinkDir_t> (event.m_linkDir)) << " ";
+
+      for (uint32_t i = 0; i < event.m_nPackets; i++)
+        {
+          PacketRecord_t packet;
+
+          if (!input.read (reinterpret_cast<char*> (&packet), sizeof (packet)))
+            {
+              NS_FATAL_ERROR ("SatPacketTrace::ConvertBinaryToText - Truncated binary packet trace file: " << binaryFileName);
+            }
+
+          output << packet.m_uid << " ";
+
+          if (packet.m_hasAddresses)
+            {
+              Mac48Address source;
+              Mac48Address destination;
+              source.CopyFrom (packet.m_source);
+              destination.CopyFrom (packet.m_destination);
+
+              output << source << " " << destination << " ";
+            }
+        }
+
+      output << "\n";
+      entries++;
+    }
+
+  return entries;
+}
+
 }
@@ -21,9 +21,16 @@
 #ifndef SATELLITE_PACKET_TRACE_H_
 #define SATELLITE_PACKET_TRACE_H_
 
+#include <deque>
+#include <fstream>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-condition.h"
 #include "satellite-enums.h"
+#include "satellite-packet-trace-record.h"
 
 
 namespace ns3 {
@@ -33,11 +40,29 @@ namespace ns3 {
  * \brief The SatPacketTrace implements a packet trace functionality.
  * The movement of packet through the satellite stack can be traced
  * in different protocol layers and direction.
+ *
+ * The trace is written either as text (one line per packet event), or in
+ * binary format. In binary format the entries are appended as fixed-width
+ * records to in-memory pages, and the full pages are written to the file by
+ * a background writer thread, so that the simulation does not wait for the
+ * disk. The records are written in the order of the packet events, thus
+ * the binary file is deterministic. The binary file can be rendered to the
+ * text format with ConvertBinaryToText (see sat-packet-trace-converter
+ * example).
  */
 
 class SatPacketTrace : public Object
 {
 public:
+  /**
+   * \brief Output format of the packet trace
+   */
+  typedef enum
+  {
+    OUTPUT_TEXT,  //!< Text log, one line per packet event
+    OUTPUT_BINARY //!< Fixed-width binary records written by a background thread
+  } OutputFormat_t;
+
   /**
    * \brief Constructor
    */
@@ -64,29 +89,103 @@ public:
 
   /**
    * \brief Add a packet trace entry to the log
-   * \param now Time time of a trace event
-   * \param packetEvent Packet event(SND, RCV, DRP, ENQ)
-   * \param nodeType Node type (UT, SAT, GW, NCC, TER)
-   * \param nodeId Node id
-   * \param macAddress MAC address
-   * \param logLevel Log level (ND, LLC, MAC, PHY, CH)
-   * \param linkDir Link direction (FWD, RTN)
-   * \param packetInfo Packet info (List of: Packet id, source MAC address, destination MAC address)
-   */
-  void AddTraceEntry (Time now,
-                      SatEnums::SatPacketEvent_t packetEvent,
-                      SatEnums::SatNodeType_t nodeType,
-                      uint32_t nodeId,
-                      Mac48Address macAddress,
-                      SatEnums::SatLogLevel_t logLevel,
-                      SatEnums::SatLinkDir_t linkDir,
-                      std::string packetInfo);
+   * \param record Packet event record
+   */
+  void AddTraceEntry (const SatPacketTraceRecord &record);
+
+  /**
+   * \brief Render a binary packet trace file to the text format of the
+   * packet trace log.
+   * \param binaryFileName Name of the binary packet trace file
+   * \param textFileName Name of the text file to create
+   * \return number of converted packet trace entries
+   */
+  static uint64_t ConvertBinaryToText (std::string binaryFileName, std::string textFileName);
 
 private:
   /**
-   * \brief Print header to the packet trace log
+   * \brief Binary record of a packet event. A record is followed by
+   * m_nPackets packet records.
    */
-  void PrintHeader ();
+  typedef struct
+  {
+    double m_time;
+    uint32_t m_nodeId;
+    uint32_t m_nPackets;
+    uint8_t m_packetEvent;
+    uint8_t m_nodeType;
+    uint8_t m_logLevel;
+    uint8_t m_linkDir;
+    uint8_t m_macAddress[6];
+    uint8_t m_padding[6];
+  } EventRecord_t;
+
+  /**
+   * \brief Binary record of a traced packet
+   */
+  typedef struct
+  {
+    uint64_t m_uid;
+    uint8_t m_source[6];
+    uint8_t m_destination[6];
+    uint8_t m_hasAddresses;
+    uint8_t m_padding[3];
+  } PacketRecord_t;
+
+  /**
+   * \brief Page of binary records
+   */
+  typedef struct
+  {
+    std::vector<uint8_t> m_data;
+    uint32_t m_size;
+  } Page_t;
+
+  /**
+   * \brief Print header to a packet trace log
+   * \param os Output stream
+   */
+  static void PrintHeader (std::ostream &os);
+
+  /**
+   * \brief Open the binary output file and start the writer thread
+   * \param fileName Name of the binary file
+   */
+  void StartBinaryOutput (std::string fileName);
+
+  /**
+   * \brief Write the pending pages, stop the writer thread and close
+   * the binary output file. Does nothing if the output is already closed.
+   */
+  void StopBinaryOutput ();
+
+  /**
+   * \brief Append a packet trace entry to the current page
+   * \param record Packet event record
+   */
+  void AppendBinaryEntry (const SatPacketTraceRecord &record);
+
+  /**
+   * \brief Hand the current page to the writer thread and take a free page
+   * (or allocate a new one) as the current page
+   * \param minSize Minimum capacity of the new current page in bytes
+   */
+  void SwapPage (uint32_t minSize);
+
+  /**
+   * \brief Main loop of the writer thread
+   */
+  void WriterLoop ();
+
+  /**
+   * Output format
+   */
+  OutputFormat_t m_outputFormat;
+
+  /**
+   * Size of the pages of binary records in bytes
+   */
+  uint32_t m_pageSize;
 
   /**
    * File name of the packet trace log
@@ -98,6 +197,45 @@ private:
    */
   Ptr<OutputStreamWrapper> m_packetTraceStream;
 
+  /**
+   * Binary output file, written only by the writer thread
+   */
+  std::ofstream m_binaryStream;
+
+  /**
+   * Page currently filled by the simulation
+   */
+  Page_t* m_currentPage;
+
+  /**
+   * Full pages waiting for the writer thread, protected by m_pageMutex
+   */
+  std::deque<Page_t*> m_fullPages;
+
+  /**
+   * Written pages available for reuse, protected by m_pageMutex
+   */
+  std::vector<Page_t*> m_freePages;
+
+  /**
+   * Flag to stop the writer thread, protected by m_pageMutex
+   */
+  bool m_stopWriter;
+
+  /**
+   * Mutex protecting the page queues
+   */
+  SystemMutex m_pageMutex;
+
+  /**
+   * Condition signaled when pages are ready or the writer shall stop
+   */
+  SystemCondition m_pagesReady;
+
+  /**
+   * Background writer thread
+   */
+  Ptr<SystemThread> m_writerThread;
 };
 
 }
@@ -0,0 +1,393 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "satellite-per-packet-bucketed-interference.h"
+#include "ns3/singleton.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatPerPacketBucketedInterference");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (SatPerPacketBucketedInterference);
+
+TypeId
+SatPerPacketBucketedInterference::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatPerPacketBucketedInterference")
+    .SetParent<SatInterference> ()
+    .AddConstructor<SatPerPacketBucketedInterference> ()
+    .AddAttribute ("BucketWidth",
+                   "Width of the time buckets of the interference timeline.",
+                   TimeValue (MicroSeconds (250)),
+                   MakeTimeAccessor (&SatPerPacketBucketedInterference::m_bucketWidth),
+                   MakeTimeChecker (NanoSeconds (1)))
+  ;
+
+  return tid;
+}
+
+TypeId
+SatPerPacketBucketedInterference::GetInstanceTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return GetTypeId ();
+}
+
+SatPerPacketBucketedInterference::SatPerPacketBucketedInterference ()
+  : m_buckets (),
+    m_firstBucket (0),
+    m_bucketCount (0),
+    m_validBucket (0),
+    m_bucketWidth (MicroSeconds (250)),
+    m_residualPowerW (0.0),
+    m_rxing (false),
+    m_nextEventId (0),
+    m_enableTraceOutput (false),
+    m_channelType (),
+    m_rxBandwidth_Hz ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatPerPacketBucketedInterference::SatPerPacketBucketedInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz)
+  : m_buckets (),
+    m_firstBucket (0),
+    m_bucketCount (0),
+    m_validBucket (0),
+    m_bucketWidth (MicroSeconds (250)),
+    m_residualPowerW (0.0),
+    m_rxing (false),
+    m_nextEventId (0),
+    m_enableTraceOutput (true),
+    m_channelType (channelType),
+    m_rxBandwidth_Hz (rxBandwidthHz)
+{
+  NS_LOG_FUNCTION (this << channelType << rxBandwidthHz);
+
+  if (m_rxBandwidth_Hz <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatPerPacketBucketedInterference::SatPerPacketBucketedInterference - Invalid value");
+    }
+}
+
+SatPerPacketBucketedInterference::~SatPerPacketBucketedInterference ()
+{
+  NS_LOG_FUNCTION (this);
+
+  Reset ();
+}
+
+SatPerPacketBucketedInterference::Bucket &
+SatPerPacketBucketedInterference::GetBucket (int64_t index)
+{
+  if (m_bucketCount == 0)
+    {
+      m_firstBucket = index;
+      m_validBucket = index - 1;
+    }
+
+  NS_ASSERT (index >= m_firstBucket);
+
+  int64_t requiredCount = index - m_firstBucket + 1;
+
+  if (requiredCount > static_cast<int64_t> (m_buckets.size ()))
+    {
+      // grow the ring buffer to the next power of two and unroll the buckets in use
+      std::size_t capacity = std::max<std::size_t> (m_buckets.size (), 8);
+      while (static_cast<int64_t> (capacity) < requiredCount)
+        {
+          capacity *= 2;
+        }
+
+      std::vector<Bucket> buckets (capacity);
+      for (int64_t i = m_firstBucket; i < m_firstBucket + m_bucketCount; i++)
+        {
+          std::swap (buckets[i & (capacity - 1)], m_buckets[i & (m_buckets.size () - 1)]);
+        }
+      m_buckets.swap (buckets);
+    }
+
+  while (m_bucketCount < requiredCount)
+    {
+      Bucket &bucket = m_buckets[(m_firstBucket + m_bucketCount) & (m_buckets.size () - 1)];
+      bucket.m_changes.clear ();
+      bucket.m_sumPower = 0.0;
+      bucket.m_sumPowerTime = 0.0;
+      bucket.m_powerAtStart = 0.0;
+      m_bucketCount++;
+    }
+
+  return m_buckets[index & (m_buckets.size () - 1)];
+}
+
+void
+SatPerPacketBucketedInterference::AddChange (int64_t time, long double power, uint32_t id)
+{
+  int64_t width = m_bucketWidth.GetTimeStep ();
+  int64_t index = time / width;
+  Bucket &bucket = GetBucket (index);
+
+  InterferenceChange change;
+  change.m_time = time;
+  change.m_power = power;
+  change.m_id = id;
+  bucket.m_changes.push_back (change);
+
+  bucket.m_sumPower += power;
+  bucket.m_sumPowerTime += power * (time - index * width);
+
+  // power at start of the later buckets is no more valid
+  m_validBucket = std::min (m_validBucket, index);
+}
+
+long double
+SatPerPacketBucketedInterference::GetPowerAtStart (int64_t index)
+{
+  NS_ASSERT (index >= m_firstBucket && index < m_firstBucket + m_bucketCount);
+
+  std::size_t mask = m_buckets.size () - 1;
+
+  // power at start of the first bucket is the residual power
+  if (m_validBucket < m_firstBucket)
+    {
+      m_buckets[m_firstBucket & mask].m_powerAtStart = m_residualPowerW;
+      m_validBucket = m_firstBucket;
+    }
+
+  while (m_validBucket < index)
+    {
+      const Bucket &current = m_buckets[m_validBucket & mask];
+      m_buckets[(m_validBucket + 1) & mask].m_powerAtStart = current.m_powerAtStart + current.m_sumPower;
+      m_validBucket++;
+    }
+
+  return m_buckets[index & mask].m_powerAtStart;
+}
+
+void
+SatPerPacketBucketedInterference::RetireBuckets (int64_t time)
+{
+  int64_t width = m_bucketWidth.GetTimeStep ();
+  std::size_t mask = m_buckets.size () - 1;
+
+  while (m_bucketCount > 0 && (m_firstBucket + 1) * width <= time)
+    {
+      Bucket &bucket = m_buckets[m_firstBucket & mask];
+
+      NS_LOG_INFO ( "Bucket to retire: Index= " << m_firstBucket << ", Changes= " << bucket.m_changes.size () << ", PowerValue= " << bucket.m_sumPower);
+
+      m_residualPowerW += bucket.m_sumPower;
+      bucket.m_changes.clear ();
+
+      m_firstBucket++;
+      m_bucketCount--;
+
+      if (m_bucketCount > 0)
+        {
+          m_buckets[m_firstBucket & mask].m_powerAtStart = m_residualPowerW;
+          m_validBucket = std::max (m_validBucket, m_firstBucket);
+        }
+    }
+}
+
+Ptr<SatInterference::InterferenceChangeEvent>
+SatPerPacketBucketedInterference::DoAdd (Time duration, double power, Address rxAddress)
+{
+  NS_LOG_FUNCTION (this << duration << power << rxAddress );
+
+  Ptr<SatInterference::InterferenceChangeEvent> event;
+  event = Create<SatInterference::InterferenceChangeEvent> (m_nextEventId++, duration, power, rxAddress);
+  int64_t now = event->GetStartTime ().GetTimeStep ();
+
+  NS_LOG_INFO ( "Add change: Duration= " << duration << ", Power= " << power << ", Time: " << event->GetStartTime () );
+
+  // the buckets before the earliest ongoing receiving are not needed anymore
+  int64_t retireTime = now;
+  for (std::map<uint32_t, int64_t>::const_iterator it = m_rxEventStartTimes.begin (); it != m_rxEventStartTimes.end (); it++)
+    {
+      retireTime = std::min (retireTime, it->second);
+    }
+  RetireBuckets (retireTime);
+
+  if ( m_bucketCount == 0 || m_residualPowerW < 0 )
+    {
+      if ( ( m_residualPowerW != 0 ) && std::fabs (m_residualPowerW) < std::numeric_limits<long double>::epsilon () )
+        {
+          // if we end up here,
+          // reset first power (this probably due to roundin problem with very small values)
+          m_residualPowerW = 0;
+          m_validBucket = m_firstBucket - 1;
+        }
+    }
+
+  AddChange (now, power, event->GetId ());
+  AddChange (event->GetEndTime ().GetTimeStep (), -power, event->GetId ());
+
+  NS_LOG_INFO ( "Buckets after addition: " << m_bucketCount );
+
+  if ( m_residualPowerW < 0 )
+    {
+      // First power should never leak negative
+      NS_FATAL_ERROR ("First power negative!!!");
+    }
+
+  return event;
+}
+
+double
+SatPerPacketBucketedInterference::DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  if ( m_rxing == false )
+    {
+      NS_FATAL_ERROR ("Receiving is not set on!!!");
+    }
+
+  int64_t width = m_bucketWidth.GetTimeStep ();
+  int64_t rxStartTime = event->GetStartTime ().GetTimeStep ();
+  int64_t rxEndTime = event->GetEndTime ().GetTimeStep ();
+  long double rxDuration = event->GetDuration ().GetDouble ();
+  int64_t startBucket = rxStartTime / width;
+  int64_t endBucket = std::min (rxEndTime / width, m_firstBucket + m_bucketCount - 1);
+
+  NS_LOG_INFO ( "Calculate: Duration= " << event->GetDuration () <<
+                ", StartTime= " << event->GetStartTime () << ", EndTime= " << event->GetEndTime () <<
+                ", Buckets= " << startBucket << "-" << endBucket);
+
+  // interference power at start of the first bucket overlapped by the event
+  long double ifPowerW = GetPowerAtStart (startBucket);
+  std::size_t mask = m_buckets.size () - 1;
+
+  for (int64_t index = startBucket; index <= endBucket; index++)
+    {
+      const Bucket &bucket = m_buckets[index & mask];
+
+      if (index == startBucket || index == endBucket)
+        {
+          for (std::vector<InterferenceChange>::const_iterator it = bucket.m_changes.begin (); it != bucket.m_changes.end (); it++)
+            {
+              if (it->m_id == event->GetId ())
+                {
+                  // own event is not updated to ifPower
+                  continue;
+                }
+
+              if (it->m_time < rxStartTime)
+                {
+                  // increase/decrease interference power with full power change
+                  ifPowerW += it->m_power;
+                }
+              else if (it->m_time < rxEndTime)
+                {
+                  // increase/decrease interference power with relative part of duration of power change
+                  ifPowerW += ((rxEndTime - it->m_time) / rxDuration) * it->m_power;
+                }
+            }
+        }
+      else
+        {
+          // all the changes of the bucket are within the event, sum of relative parts
+          // of the changes is computed from the bucket sums
+          long double offset = rxEndTime - index * width;
+          ifPowerW += (offset * bucket.m_sumPower - bucket.m_sumPowerTime) / rxDuration;
+        }
+    }
+
+  NS_LOG_INFO ( "IfPower after calculation: " << ifPowerW );
+
+  if (m_enableTraceOutput)
+    {
+      std::vector<double> tempVector;
+      tempVector.push_back (Now ().GetSeconds ());
+      tempVector.push_back (ifPowerW / m_rxBandwidth_Hz);
+      Singleton<SatInterferenceOutputTraceContainer>::Get ()->AddToContainer (std::make_pair (event->GetSatEarthStationAddress (), m_channelType), tempVector);
+    }
+
+  return ifPowerW;
+}
+
+void
+SatPerPacketBucketedInterference::DoReset (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_buckets.clear ();
+  m_firstBucket = 0;
+  m_bucketCount = 0;
+  m_validBucket = 0;
+  m_rxEventStartTimes.clear ();
+  m_rxing = false;
+  m_residualPowerW = 0.0;
+}
+
+void
+SatPerPacketBucketedInterference::DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::pair<std::map<uint32_t, int64_t>::iterator, bool> result =
+    m_rxEventStartTimes.insert (std::make_pair (event->GetId (), event->GetStartTime ().GetTimeStep ()));
+
+  NS_ASSERT (result.second);
+  m_rxing = true;
+}
+
+void
+SatPerPacketBucketedInterference::DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_rxEventStartTimes.erase (event->GetId ());
+
+  if (m_rxEventStartTimes.empty ())
+    {
+      m_rxing = false;
+    }
+}
+
+void
+SatPerPacketBucketedInterference::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  SatInterference::DoDispose ();
+}
+
+void
+SatPerPacketBucketedInterference::SetRxBandwidth (double rxBandwidth)
+{
+  NS_LOG_FUNCTION (this << rxBandwidth);
+
+  if (rxBandwidth <= std::numeric_limits<double>::epsilon ())
+    {
+      NS_FATAL_ERROR ("SatPerPacketBucketedInterference::SetRxBandwidth - Invalid value");
+    }
+
+  m_rxBandwidth_Hz = rxBandwidth;
+}
+
+}
+// namespace ns3
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SATELLITE_PER_PACKET_BUCKETED_INTERFERENCE_H
+#define SATELLITE_PER_PACKET_BUCKETED_INTERFERENCE_H
+
+#include <map>
+#include <vector>
+#include "satellite-interference.h"
+#include "satellite-interference-output-trace-container.h"
+#include "satellite-enums.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * \brief Packet by packet interference calculated from a time-bucketed
+ * timeline. The result is the same as with SatPerPacketInterference, but the
+ * power changes are stored into a ring buffer of fixed width time buckets.
+ * Each bucket keeps the sum of its power changes and the running interference
+ * power at its start, thus a calculation touches only the buckets overlapped
+ * by the received packet.
+ */
+class SatPerPacketBucketedInterference : public SatInterference
+{
+public:
+  /**
+   * \brief Get the type ID
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Get the type ID of instance
+   * \return the object TypeId
+   */
+  TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * Default constructor, interference output trace is disabled.
+   */
+  SatPerPacketBucketedInterference ();
+
+  /**
+   * Constructor with interference output trace enabled.
+   * \param channelType Channel type
+   * \param rxBandwidthHz Receiver bandwidth in Hertz
+   */
+  SatPerPacketBucketedInterference (SatEnums::ChannelType_t channelType, double rxBandwidthHz);
+
+  /**
+   * Destructor
+   */
+  ~SatPerPacketBucketedInterference ();
+
+  /**
+   * Dispose of this class instance
+   */
+  void DoDispose ();
+
+  /**
+   * \brief Set the receiver bandwidth
+   * \param rxBandwidth Receiver bandwidth in Hertz
+   */
+  void SetRxBandwidth (double rxBandwidth);
+
+private:
+  /**
+   * Adds interference power to interference object.
+   *
+   * \param rxDuration Duration of the receiving.
+   * \param rxPower Receiving power.
+   *
+   * \return the pointer to interference event as a reference of the addition
+   */
+  virtual Ptr<SatInterference::InterferenceChangeEvent> DoAdd (Time rxDuration, double rxPower, Address rxAddress);
+
+  /**
+   * Calculates interference power for the given reference
+   *
+   * \param event Reference event which for interference is calculated.
+   *
+   * \return Final calculated power value at end of receiving
+   */
+  virtual double DoCalculate (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Resets current interference.
+   */
+  virtual void DoReset (void);
+
+  /**
+   * Notifies that RX is started by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxStart (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * Notifies that RX is ended by a receiver.
+   *
+   * \param event Interference reference event of receiver
+   */
+  virtual void DoNotifyRxEnd (Ptr<SatInterference::InterferenceChangeEvent> event);
+
+  /**
+   * \brief Power change of an event in the timeline
+   */
+  typedef struct
+  {
+    int64_t m_time;
+    long double m_power;
+    uint32_t m_id;
+  } InterferenceChange;
+
+  /**
+   * \brief Time bucket of the timeline
+   */
+  typedef struct
+  {
+    std::vector<InterferenceChange> m_changes;
+    long double m_sumPower;
+    long double m_sumPowerTime;
+    long double m_powerAtStart;
+  } Bucket;
+
+  /**
+   * Copy constructor, not in use
+   * \param o
+   */
+  SatPerPacketBucketedInterference (const SatPerPacketBucketedInterference &o);
+
+  /**
+   * Assignment operator, not in use
+   * \param o
+   * \return
+   */
+  SatPerPacketBucketedInterference &operator = (const SatPerPacketBucketedInterference &o);
+
+  /**
+   * \brief Get the bucket for a bucket index, the bucket is created if needed
+   * \param index Bucket index
+   * \return Bucket
+   */
+  Bucket & GetBucket (int64_t index);
+
+  /**
+   * \brief Add a power change to the timeline
+   * \param time Time of the change in time steps
+   * \param power Power change
+   * \param id Event ID
+   */
+  void AddChange (int64_t time, long double power, uint32_t id);
+
+  /**
+   * \brief Get the interference power at the start of a bucket
+   * \param index Bucket index
+   * \return Interference power
+   */
+  long double GetPowerAtStart (int64_t index);
+
+  /**
+   * \brief Move the buckets ending before given time into residual power
+   * \param time Time in time steps
+   */
+  void RetireBuckets (int64_t time);
+
+  /**
+   * \brief Ring buffer of the time buckets
+   */
+  std::vector<Bucket> m_buckets;
+
+  /**
+   * \brief Index of the first bucket in the ring buffer
+   */
+  int64_t m_firstBucket;
+
+  /**
+   * \brief Number of buckets in use in the ring buffer
+   */
+  int64_t m_bucketCount;
+
+  /**
+   * \brief Last bucket index with valid power at start
+   */
+  int64_t m_validBucket;
+
+  /**
+   * \brief Width of the time bucket
+   */
+  Time m_bucketWidth;
+
+  /**
+   * \brief Start times of the notified interference events
+   */
+  std::map <uint32_t, int64_t> m_rxEventStartTimes;
+
+  /**
+   * \brief Residual power value for interference.
+   * Sum of the power changes in the buckets removed from the ring buffer.
+   */
+  long double m_residualPowerW;
+
+  /**
+   * \brief flag to indicate that at least one receiving is on
+   */
+  bool m_rxing;
+
+  /**
+   * \brief event id for Events
+   */
+  uint32_t m_nextEventId;
+
+  /**
+   * \brief Is interference output trace enabled
+   */
+  bool m_enableTraceOutput;
+
+  /**
+   * \brief Channel type
+   */
+  SatEnums::ChannelType_t m_channelType;
+
+  /**
+   * \brief RX Bandwidth in Hz
+   */
+  double m_rxBandwidth_Hz;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_PER_PACKET_BUCKETED_INTERFERENCE_H */
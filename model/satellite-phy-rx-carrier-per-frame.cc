@@ -28,6 +28,8 @@
 #include <ostream>
 #include <limits>
 #include <utility>
+#include <set>
+#include <cmath>
 
 NS_LOG_COMPONENT_DEFINE ("SatPhyRxCarrierPerFrame");
 
@@ -44,6 +46,9 @@ SatPhyRxCarrierPerFrame::SatPhyRxCarrierPerFrame (uint32_t carrierId,
 	NS_LOG_FUNCTION (this);
 
 	NS_ASSERT(m_randomAccessEnabled == true);
+
+	m_sicEngine.SetDecodeCallback (MakeCallback (&SatPhyRxCarrierPerFrame::DecodeCrdsaPacket, this));
+	m_sicEngine.SetCancelCallback (MakeCallback (&SatPhyRxCarrierPerFrame::EliminateInterference, this));
 }
 
 void
@@ -102,18 +107,13 @@ void
 SatPhyRxCarrierPerFrame::DoDispose ()
 {
 	SatPhyRxCarrierPerSlot::DoDispose ();
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
 
-  for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
+  for (uint32_t i = 0; i < m_crdsaPacketContainer.size (); i++)
     {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-        {
-          iterList->rxParams = NULL;
-        }
-      iter->second.clear ();
+      m_crdsaPacketContainer[i].rxParams = NULL;
     }
   m_crdsaPacketContainer.clear ();
+  m_sicEngine.Clear ();
 }
 
 void
@@ -185,9 +185,9 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
                        << ", error: " << results[i].phyError
                        << ", SINR: " << results[i].cSinr);
 
-          for (uint32_t j = 0; j < results[i].rxParams->m_packetsInBurst.size (); j++)
+          for (uint32_t j = 0; j < results[i].rxParams->GetPackets ().size (); j++)
             {
-              NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Fragment (HL packet) UID: " << results[i].rxParams->m_packetsInBurst.at (j)->GetUid ());
+              NS_LOG_INFO ("SatPhyRxCarrier::DoFrameEnd - Fragment (HL packet) UID: " << results[i].rxParams->GetPackets ().at (j)->GetUid ());
             }
 
           /// uses composite sinr
@@ -197,7 +197,7 @@ SatPhyRxCarrierPerFrame::DoFrameEnd ()
                              results[i].ifPower,
                              results[i].cSinr);
           /// CRDSA trace
-          m_crdsaUniquePayloadRxTrace (results[i].rxParams->m_packetsInBurst.size (),  // number of packets
+          m_crdsaUniquePayloadRxTrace (results[i].rxParams->GetPackets ().size (),  // number of packets
                                        results[i].sourceAddress,  // sender address
                                        results[i].phyError        // error flag
           );
@@ -245,36 +245,23 @@ SatPhyRxCarrierPerFrame::UpdateRandomAccessLoad ()
 {
 	NS_LOG_FUNCTION (this);
 
-  std::vector<uint64_t> uniquePacketIds;
+  std::set<uint64_t> uniquePacketIds;
   uint32_t uniqueCrdsaBytes (0);
 
 	// Go through all the received CRDSA packets
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-	for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
-	  {
-	    // Go through all the packets received in the same slot id
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-        {
-          // It is sufficient to check the first packet Uid
-          uint64_t uid = iterList->rxParams->m_packetsInBurst.front ()->GetUid();
-
-          // Check if we have already counted the bytes of this transmission
-          std::vector<uint64_t>::iterator it = std::find (uniquePacketIds.begin (),
-                                                          uniquePacketIds.end (),
-                                                          uid);
-          // Not found -> is unique
-          if (it == uniquePacketIds.end ())
-            {
-              // Push this to accounted unique transmissions vector
-              uniquePacketIds.push_back (uid);
+  for (uint32_t i = 0; i < m_crdsaPacketContainer.size (); i++)
+    {
+      // It is sufficient to check the first packet Uid
+      uint64_t uid = m_crdsaPacketContainer[i].rxParams->GetPackets ().front ()->GetUid();
 
-              // Update the load with FEC block size!
-              uniqueCrdsaBytes += iterList->rxParams->m_txInfo.fecBlockSizeInBytes;
-            }
-          // else, do nothing, i.e. this is a replica
+      // Check if we have already counted the bytes of this transmission.
+      // Not found -> is unique, else this is a replica
+      if (uniquePacketIds.insert (uid).second)
+        {
+          // Update the load with FEC block size!
+          uniqueCrdsaBytes += m_crdsaPacketContainer[i].rxParams->m_txInfo.fecBlockSizeInBytes;
         }
-	  }
+    }
 
 	// Update with the unique FEC block sum of CRDSA frame
 	m_randomAccessBitsInFrame = uniqueCrdsaBytes * SatConstVariables::BITS_PER_BYTE;
@@ -332,12 +319,12 @@ SatPhyRxCarrierPerFrame::AddCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxP
 
   NS_LOG_INFO ("SatPhyRxCarrierPerFrame::AddCrdsaPacket - Time: " << Now ().GetSeconds ());
 
-  if (crdsaPacketParams.rxParams->m_packetsInBurst.size () > 0)
+  if (crdsaPacketParams.rxParams->GetPackets ().size () > 0)
     {
       SatCrdsaReplicaTag replicaTag;
 
       /// check the first packet for tag
-      bool result = crdsaPacketParams.rxParams->m_packetsInBurst[0]->PeekPacketTag (replicaTag);
+      bool result = crdsaPacketParams.rxParams->GetPackets ()[0]->PeekPacketTag (replicaTag);
 
       if (!result)
         {
@@ -366,9 +353,11 @@ SatPhyRxCarrierPerFrame::AddCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxP
         }
 
       /// tags are not needed after this
-      for (uint32_t i = 0; i < crdsaPacketParams.rxParams->m_packetsInBurst.size (); i++)
+      const SatSignalParameters::PacketsInBurst_t& packets = crdsaPacketParams.rxParams->GetWritablePackets ();
+
+      for (uint32_t i = 0; i < packets.size (); i++)
         {
-      	crdsaPacketParams.rxParams->m_packetsInBurst[i]->RemovePacketTag (replicaTag);
+      	packets[i]->RemovePacketTag (replicaTag);
         }
     }
   else
@@ -376,20 +365,10 @@ SatPhyRxCarrierPerFrame::AddCrdsaPacket (SatPhyRxCarrierPerFrame::crdsaPacketRxP
       NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::AddCrdsaPacket - CRDSA reception with 0 packets");
     }
 
-  std::map<uint32_t, std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator result;
-
-  result = m_crdsaPacketContainer.find (crdsaPacketParams.ownSlotId);
-
-  if (result == m_crdsaPacketContainer.end ())
-    {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> tempList;
-      tempList.push_back (crdsaPacketParams);
-      m_crdsaPacketContainer.insert (std::make_pair (crdsaPacketParams.ownSlotId, tempList));
-    }
-  else
-    {
-      result->second.push_back (crdsaPacketParams);
-    }
+  m_sicEngine.AddPacket (crdsaPacketParams.ownSlotId,
+                         crdsaPacketParams.slotIdsForOtherReplicas,
+                         crdsaPacketParams.sourceAddress);
+  m_crdsaPacketContainer.push_back (crdsaPacketParams);
 
   NS_LOG_INFO ("SatPhyRxCarrierPerFrame::AddCrdsaPacket - Packet in slot " << crdsaPacketParams.ownSlotId << " was added to the CRDSA packet container");
 
@@ -406,142 +385,42 @@ SatPhyRxCarrierPerFrame::ProcessFrame ()
 
   NS_LOG_INFO ("SatPhyRxCarrier::ProcessFrame - Time: " << Now ().GetSeconds ());
 
-  std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> combinedPacketsForFrame;
-  SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket;
-
-  bool nothingToProcess = true;
-
   NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packets to process: " << m_crdsaPacketContainer.size ());
 
-  do
-    {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Searching for the next successfully received packet");
-
-      /// reset the flag
-      nothingToProcess = true;
-
-      /// go through the packets
-      for (iter = m_crdsaPacketContainer.begin (); iter != m_crdsaPacketContainer.end (); iter++)
-        {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Iterating slot: " << iter->first);
-
-          if (iter->second.size () < 1)
-            {
-              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - This should not happen");
-            }
-
-          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-
-          for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Iterating packet in slot: " << iterList->ownSlotId);
-
-              if (!iterList->packetHasBeenProcessed)
-                {
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Found a packet ready for processing");
-
-                  /// process the received packet
-                  *iterList = ProcessReceivedCrdsaPacket (*iterList, iter->second.size ());
-
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet error: " << iterList->phyError);
-
-                  /// packet successfully received
-                  if (!iterList->phyError)
-                    {
-                      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, breaking the slot iteration");
-
-                      nothingToProcess = false;
-
-                      /// save packet for processing outside the loop
-                      processedPacket = *iterList;
-
-                      /// remove the successfully received packet from the container
-                      iter->second.erase (iterList);
+  /// successfully received packets in decoding order followed by the
+  /// unsuccessfully received packets, replicas excluded
+  std::vector<uint32_t> processedPackets = m_sicEngine.ProcessFrame ();
 
-                      /// eliminate the interference caused by this packet to other packets in this slot
-                      EliminateInterference (iter,processedPacket);
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Decoding attempts: " << m_sicEngine.GetNDecodingAttempts ()
+               << ", interference cancellations: " << m_sicEngine.GetNCancellations ());
 
-                      /// break the cycle
-                      break;
-                    }
-                }
-              else
-                {
-                  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - This packet has already been processed");
-                }
-            }
-
-          /// successfully received packet found
-          if (!nothingToProcess)
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, breaking the container iteration");
-              break;
-            }
-        }
-
-      if (!nothingToProcess)
-        {
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Packet successfully received, processing the replicas");
-
-          /// find and remove replicas of the received packet
-          FindAndRemoveReplicas (processedPacket);
-
-          /// save the the received packet
-          combinedPacketsForFrame.push_back (processedPacket);
-        }
-    }
-  while (!nothingToProcess);
-
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets processed, packets left in container: " << m_crdsaPacketContainer.size ());
+  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> combinedPacketsForFrame;
+  combinedPacketsForFrame.reserve (processedPackets.size ());
 
-  do
+  for (uint32_t i = 0; i < processedPackets.size (); i++)
     {
-      /// go through the packets
-      iter = m_crdsaPacketContainer.begin ();
-
-      if (iter != m_crdsaPacketContainer.end ())
-        {
-          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList = iter->second.begin ();
-
-          if (iterList != iter->second.end ())
-            {
-              NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Processing unsuccessfully received packet in slot: " << iterList->ownSlotId
-                           << " packet phy error: " << iterList->phyError
-                           << " packet has been processed: " << iterList->packetHasBeenProcessed);
+      combinedPacketsForFrame.push_back (m_crdsaPacketContainer[processedPackets[i]]);
+    }
 
-              if (!iterList->packetHasBeenProcessed || !iterList->phyError)
-                {
-                  NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::ProcessFrame - All successfully received packets should have been processed by now");
-                }
+  m_crdsaPacketContainer.clear ();
+  m_sicEngine.Clear ();
 
-              /// find and remove replicas of the received packet
-              FindAndRemoveReplicas (*iterList);
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Container processed, unique packets: " << combinedPacketsForFrame.size ());
 
-              /// save the the received packet
-              combinedPacketsForFrame.push_back (*iterList);
+  return combinedPacketsForFrame;
+}
 
-              /// remove the packet from the container
-              iter->second.erase (iterList);
+bool
+SatPhyRxCarrierPerFrame::DecodeCrdsaPacket (uint32_t index, uint32_t numOfPacketsForThisSlot)
+{
+  NS_LOG_FUNCTION (this << index << numOfPacketsForThisSlot);
 
-              /// remove the empty slot container
-              if (iter->second.empty ())
-                {
-                  m_crdsaPacketContainer.erase (iter);
-                }
-            }
-          else
-            {
-              /// remove the empty slot container
-              m_crdsaPacketContainer.erase (iter);
-            }
-        }
-    }
-  while (!m_crdsaPacketContainer.empty ());
+  /// process the received packet
+  m_crdsaPacketContainer[index] = ProcessReceivedCrdsaPacket (m_crdsaPacketContainer[index], numOfPacketsForThisSlot);
 
-  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::ProcessFrame - Container processed, packets left: " << m_crdsaPacketContainer.size ());
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::DecodeCrdsaPacket - Packet error: " << m_crdsaPacketContainer[index].phyError);
 
-  return combinedPacketsForFrame;
+  return !m_crdsaPacketContainer[index].phyError;
 }
 
 SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s
@@ -628,195 +507,44 @@ SatPhyRxCarrierPerFrame::ProcessReceivedCrdsaPacket (SatPhyRxCarrierPerFrame::cr
 }
 
 void
-SatPhyRxCarrierPerFrame::FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet)
+SatPhyRxCarrierPerFrame::EliminateInterference (uint32_t index, uint32_t processedIndex)
 {
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrier::FindAndRemoveReplicas - Time: " << Now ().GetSeconds ());
-
-  for (uint32_t i = 0; i < packet.slotIdsForOtherReplicas.size (); i++)
-    {
-      NS_LOG_INFO ("SatPhyRxCarrier::FindAndRemoveReplicas - Processing replica in slot: " << packet.slotIdsForOtherReplicas[i]);
-
-      /// get the vector of packets for processing
-      std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter;
-      iter = m_crdsaPacketContainer.find (packet.slotIdsForOtherReplicas[i]);
-
-      if (iter == m_crdsaPacketContainer.end ())
-        {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::FindAndRemoveReplicas - This should not happen");
-        }
-
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-      SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s removedPacket;
-
-      bool replicaFound = false;
-
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); )
-        {
-          /// check for the same UT & same slots
-          if (IsReplica (packet, iterList))
-            {
-              /// replica found for removal
-              replicaFound = true;
-              removedPacket = *iterList;
-              iter->second.erase (iterList++);
-            }
-          else
-            {
-              ++iterList;
-            }
-        }
-
-      if (!replicaFound)
-        {
-          NS_FATAL_ERROR ("SatPhyRxCarrier::FindAndRemoveReplicas - Replica not found");
-        }
-
-      if (!packet.phyError)
-        {
-          EliminateInterference (iter, removedPacket);
-        }
-    }
-}
-
-void
-SatPhyRxCarrierPerFrame::EliminateInterference (
-		std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter,
-		SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket)
-{
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << index << processedIndex);
   NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference");
 
-  if (iter->second.empty ())
-    {
-      NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference - No other packets in this slot, erasing the slot container");
-      m_crdsaPacketContainer.erase (iter);
-    }
-  else
-    {
-      std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iterList;
-
-      for (iterList = iter->second.begin (); iterList != iter->second.end (); iterList++)
-        {
-          /// release packets in this slot for re-processing
-          iterList->packetHasBeenProcessed = false;
-
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- BEFORE INTERFERENCE ELIMINATION, RX sat: " << iterList->rxParams->m_rxPowerInSatellite_W <<
-                       " IF sat: " << iterList->rxParams->m_ifPowerInSatellite_W <<
-                       " RX gnd: " << iterList->rxParams->m_rxPower_W <<
-                       " IF gnd: " << iterList->rxParams->m_ifPower_W);
-
-          /// Reduce interference power for the colliding packets. Note, that the interference is
-          /// eliminated only from the user link interference power at the satellite! The intra-beam
-          /// interference is not handled in the return feeder link so that the intra-beam interference
-          /// is not taken into account twice!
-          /// TODO A more novel way to eliminate partially overlapping interference should be considered!
-          /// In addition, as the interference values are extremely small, the use of long double (instead
-          /// of double) should be considered to improve the accuracy.
-
-          iterList->rxParams->m_ifPowerInSatellite_W -= processedPacket.rxParams->m_rxPowerInSatellite_W;
-
-          if (std::abs (iterList->rxParams->m_ifPowerInSatellite_W) < std::numeric_limits<double>::epsilon ())
-            {
-              iterList->rxParams->m_ifPowerInSatellite_W = 0;
-            }
-
-          if (iterList->rxParams->m_ifPower_W < 0 || iterList->rxParams->m_ifPowerInSatellite_W < 0)
-            {
-              NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::EliminateInterference - Negative interference");
-            }
-
-          NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- AFTER INTERFERENCE ELIMINATION, RX sat: " <<
-          							iterList->rxParams->m_rxPowerInSatellite_W <<
-                       " IF sat: " << iterList->rxParams->m_ifPowerInSatellite_W <<
-                       " RX gnd: " << iterList->rxParams->m_rxPower_W <<
-                       " IF gnd: " << iterList->rxParams->m_ifPower_W);
-        }
-    }
-}
-
-bool
-SatPhyRxCarrierPerFrame::IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-																std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
-{
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Time: " << Now ().GetSeconds ());
-
-  NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Checking the source addresses");
-
-  bool isReplica = false;
-
-  if (iter->sourceAddress == packet.sourceAddress)
-    {
-      NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Same source addresses, checking slot IDs");
-
-      if (HaveSameSlotIds (packet, iter))
-        {
-          NS_LOG_INFO ("SatPhyRxCarrier::IsReplica - Same slot IDs, replica found");
-          isReplica = true;
-        }
-    }
-  return isReplica;
-}
-
-bool
-SatPhyRxCarrierPerFrame::HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-                                          std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter)
-{
-  NS_LOG_FUNCTION (this);
-  NS_LOG_INFO ("SatPhyRxCarrierUt::HaveSameSlotIds - Time: " << Now ().GetSeconds ());
-
-  std::set<uint16_t> firstSet;
-  std::set<uint16_t> secondSet;
-  std::set<uint16_t>::iterator firstSetIterator;
-  std::set<uint16_t>::iterator secondSetIterator;
-  bool haveSameSlotIds = true;
-
-  firstSet.insert (packet.ownSlotId);
-  secondSet.insert (iter->ownSlotId);
-
-  /// sanity check
-  if (iter->slotIdsForOtherReplicas.size () != packet.slotIdsForOtherReplicas.size ())
-    {
-      NS_FATAL_ERROR ("SatPhyRxCarrierUt::HaveSameSlotIds - The amount of replicas does not match");
-    }
+  Ptr<SatSignalParameters> rxParams = m_crdsaPacketContainer[index].rxParams;
+  Ptr<SatSignalParameters> processedRxParams = m_crdsaPacketContainer[processedIndex].rxParams;
 
-  NS_LOG_INFO ("SatPhyRxCarrierUt::HaveSameSlotIds - Comparing slot IDs");
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- BEFORE INTERFERENCE ELIMINATION, RX sat: " << rxParams->m_rxPowerInSatellite_W <<
+               " IF sat: " << rxParams->m_ifPowerInSatellite_W <<
+               " RX gnd: " << rxParams->m_rxPower_W <<
+               " IF gnd: " << rxParams->m_ifPower_W);
 
-  /// form sets
-  for (uint32_t i = 0; i < iter->slotIdsForOtherReplicas.size (); i++)
-    {
-      firstSet.insert (packet.slotIdsForOtherReplicas[i]);
-      secondSet.insert (iter->slotIdsForOtherReplicas[i]);
-    }
+  /// Reduce interference power for the colliding packets. Note, that the interference is
+  /// eliminated only from the user link interference power at the satellite! The intra-beam
+  /// interference is not handled in the return feeder link so that the intra-beam interference
+  /// is not taken into account twice!
+  /// TODO A more novel way to eliminate partially overlapping interference should be considered!
+  /// In addition, as the interference values are extremely small, the use of long double (instead
+  /// of double) should be considered to improve the accuracy.
 
-  uint32_t numOfMatchingSlots = 0;
+  rxParams->m_ifPowerInSatellite_W -= processedRxParams->m_rxPowerInSatellite_W;
 
-  /// compare sets
-  for (firstSetIterator = firstSet.begin (); firstSetIterator != firstSet.end (); firstSetIterator++)
+  if (std::abs (rxParams->m_ifPowerInSatellite_W) < std::numeric_limits<double>::epsilon ())
     {
-      secondSetIterator = secondSet.find (*firstSetIterator);
-
-      if (secondSetIterator == secondSet.end ())
-        {
-          haveSameSlotIds = false;
-        }
-      else
-        {
-          numOfMatchingSlots++;
-        }
+      rxParams->m_ifPowerInSatellite_W = 0;
     }
 
-  NS_LOG_INFO ("SatPhyRxCarrier::HaveSameSlotIds - Are slot IDs identical: " << haveSameSlotIds
-               << ", number of matching slots: " << numOfMatchingSlots);
-
-  /// sanity check
-  if (!haveSameSlotIds && numOfMatchingSlots > 0)
+  if (rxParams->m_ifPower_W < 0 || rxParams->m_ifPowerInSatellite_W < 0)
     {
-      NS_FATAL_ERROR ("SatPhyRxCarrier::HaveSameSlotIds - Partially overlapping CRDSA slots");
+      NS_FATAL_ERROR ("SatPhyRxCarrierPerFrame::EliminateInterference - Negative interference");
     }
 
-  return haveSameSlotIds;
+  NS_LOG_INFO ("SatPhyRxCarrierPerFrame::EliminateInterference- AFTER INTERFERENCE ELIMINATION, RX sat: " <<
+               rxParams->m_rxPowerInSatellite_W <<
+               " IF sat: " << rxParams->m_ifPowerInSatellite_W <<
+               " RX gnd: " << rxParams->m_rxPower_W <<
+               " IF gnd: " << rxParams->m_ifPower_W);
 }
 
 bool
@@ -26,6 +26,7 @@
 #include <ns3/satellite-crdsa-replica-tag.h>
 #include <ns3/satellite-phy-rx-carrier.h>
 #include <ns3/satellite-phy-rx-carrier-per-slot.h>
+#include <ns3/satellite-crdsa-sic-engine.h>
 
 namespace ns3 {
 
@@ -119,12 +120,22 @@ protected:
 private:
 
   /**
-   * \brief Function for eliminating the interference to other packets in the slot from the correctly received packet
-   * \param iter Packets in the slot
-   * \param processedPacket Correctly received processed packet
+   * \brief Function for eliminating the interference caused by a correctly
+   * received packet (or its replica) from another packet in the same slot.
+   * Used as the cancel callback of the SIC engine.
+   * \param index Index of the packet from which the interference is eliminated
+   * \param processedIndex Index of the correctly received packet
    */
-  void EliminateInterference (std::map<uint32_t,std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> >::iterator iter,
-  		SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s processedPacket);
+  void EliminateInterference (uint32_t index, uint32_t processedIndex);
+
+  /**
+   * \brief Function for decoding a CRDSA packet. Used as the decode callback
+   * of the SIC engine.
+   * \param index Index of the packet
+   * \param numOfPacketsForThisSlot Number of packets in the slot of the packet
+   * \return Was the packet successfully received
+   */
+  bool DecodeCrdsaPacket (uint32_t index, uint32_t numOfPacketsForThisSlot);
 
   /**
    * \brief Function for storing the received CRDSA packets
@@ -163,30 +174,6 @@ private:
    */
   std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> ProcessFrame ();
 
-  /**
-   * \brief Function for finding and removing the replicas of the CRDSA packet
-   * \param packet CRDSA packet
-   */
-  void FindAndRemoveReplicas (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet);
-
-  /**
-   * \brief Function for identifying whether the packet is a replica of another packet
-   * \param packet Packet
-   * \param iter A packet in certain slot
-   * \return Is the packet a replica
-   */
-  bool IsReplica (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-  		std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
-
-  /**
-   * \brief Function for checking do the packets have identical slots
-   * \param packet Packet
-   * \param iter A packet in certain slot
-   * \return Have the packets identical slots
-   */
-  bool HaveSameSlotIds (SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s packet,
-  		std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s>::iterator iter);
-
   /**
    * \brief Function for calculating the normalized offered random access load
    * \return Normalized offered load
@@ -218,9 +205,14 @@ private:
 
 
   /**
-   * \brief CRDSA packet container
+   * \brief CRDSA packet container, packets are indexed in the order of reception
+   */
+  std::vector<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> m_crdsaPacketContainer;
+
+  /**
+   * \brief Successive interference cancellation engine for the CRDSA frame
    */
-  std::map<uint32_t, std::list<SatPhyRxCarrierPerFrame::crdsaPacketRxParams_s> > m_crdsaPacketContainer;
+  SatCrdsaSicEngine m_sicEngine;
 
   /**
    * \brief Has the frame end scheduling been initialized
@@ -24,6 +24,7 @@
 #include <ns3/satellite-utils.h>
 #include <ns3/satellite-constant-interference.h>
 #include <ns3/satellite-per-packet-interference.h>
+#include <ns3/satellite-per-packet-bucketed-interference.h>
 #include <ns3/satellite-traced-interference.h>
 #include <ns3/satellite-mac-tag.h>
 #include <ns3/singleton.h>
@@ -132,6 +133,19 @@ SatPhyRxCarrier::DoCreateInterferenceModel (Ptr<SatPhyRxCarrierConf> carrierConf
           }
         break;
       }
+    case SatPhyRxCarrierConf::IF_PER_PACKET_BUCKETED:
+      {
+        NS_LOG_INFO (this << " Per packet bucketed interference model created for carrier: " << carrierId);
+        if (carrierConf->IsIntfOutputTraceEnabled ())
+          {
+            m_satInterference = CreateObject<SatPerPacketBucketedInterference> (GetChannelType (), rxBandwidthHz);
+          }
+        else
+          {
+            m_satInterference = CreateObject<SatPerPacketBucketedInterference> ();
+          }
+        break;
+      }
     case SatPhyRxCarrierConf::IF_TRACE:
       {
         NS_LOG_INFO (this << " Traced interference model created for carrier: " << carrierId);
@@ -253,8 +267,8 @@ SatPhyRxCarrier::GetReceiveParams (Ptr<SatSignalParameters> rxParams)
   bool receivePacket = GetDefaultReceiveMode ();
   bool ownAddressFound = false;
 
-  for (SatSignalParameters::PacketsInBurst_t::const_iterator i = rxParams->m_packetsInBurst.begin ();
-       ((i != rxParams->m_packetsInBurst.end ()) && (ownAddressFound == false) ); i++)
+  for (SatSignalParameters::PacketsInBurst_t::const_iterator i = rxParams->GetPackets ().begin ();
+       ((i != rxParams->GetPackets ().end ()) && (ownAddressFound == false) ); i++)
     {
       SatMacTag tag;
       (*i)->PeekPacketTag (tag);
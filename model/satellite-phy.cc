@@ -307,21 +307,21 @@ SatPhy::SendPdu (PacketContainer_t p, uint32_t carrierId, Time duration, SatSign
   SatEnums::SatLinkDir_t ld =
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_SENT,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 ld,
-                 SatUtils::GetPacketInfo (p));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_SENT,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_PHY,
+                                       ld,
+                                       p));
 
 
   // Create a new SatSignalParameters related to this packet transmission
   Ptr<SatSignalParameters> txParams = Create<SatSignalParameters> ();
   txParams->m_duration = duration;
   txParams->m_phyTx = m_phyTx;
-  txParams->m_packetsInBurst = p;
+  txParams->SetPackets (p);
   txParams->m_beamId = m_beamId;
   txParams->m_carrierId = carrierId;
   txParams->m_sinr = 0;
@@ -368,29 +368,32 @@ SatPhy::Receive (Ptr<SatSignalParameters> rxParams, bool phyError)
 
   SatEnums::SatPacketEvent_t event = (phyError) ? SatEnums::PACKET_DROP : SatEnums::PACKET_RECV;
 
-  m_packetTrace (Simulator::Now (),
-                 event,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_PHY,
-                 ld,
-                 SatUtils::GetPacketInfo (rxParams->m_packetsInBurst));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       event,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_PHY,
+                                       ld,
+                                       rxParams->GetPackets ()));
 
   if (phyError)
     {
       // If there was a PHY error, the packet is dropped here.
-      NS_LOG_INFO (this << " dropped " << rxParams->m_packetsInBurst.size ()
+      NS_LOG_INFO (this << " dropped " << rxParams->GetPackets ().size ()
                          << " packets because of PHY error.");
     }
   else
     {
+      // The packets are passed up and their tags removed, so they are not
+      // shared with the other receivers of the burst anymore
+      const SatSignalParameters::PacketsInBurst_t& packets = rxParams->GetWritablePackets ();
+
       // Invoke the `Rx` and `RxDelay` trace sources.
       if (m_isStatisticsTagsEnabled)
         {
-          SatSignalParameters::PacketsInBurst_t::iterator it1;
-          for (it1 = rxParams->m_packetsInBurst.begin ();
-               it1 != rxParams->m_packetsInBurst.end (); ++it1)
+          SatSignalParameters::PacketsInBurst_t::const_iterator it1;
+          for (it1 = packets.begin (); it1 != packets.end (); ++it1)
             {
               Address addr; // invalid address.
               bool isTaggedWithAddress = false;
@@ -422,12 +425,12 @@ SatPhy::Receive (Ptr<SatSignalParameters> rxParams, bool phyError)
                                   addr);
                 }
 
-            } // end of `for (it1 = rxParams->m_packetsInBurst)`
+            } // end of `for (it1 = packets)`
 
         } // end of `if (m_isStatisticsTagsEnabled)`
 
       // Pass the packet to the upper layer.
-      m_rxCallback (rxParams->m_packetsInBurst, rxParams);
+      m_rxCallback (packets, rxParams);
 
     } // end of else of `if (phyError)`
 
@@ -32,6 +32,7 @@
 #include "satellite-signal-parameters.h"
 #include "satellite-node-info.h"
 #include "ns3/satellite-frame-conf.h"
+#include "satellite-packet-trace-record.h"
 
 namespace ns3 {
 
@@ -455,15 +456,7 @@ protected:
   /**
    * Trace callback used for packet tracing:
    */
-  TracedCallback< Time,
-                  SatEnums::SatPacketEvent_t,
-                  SatEnums::SatNodeType_t,
-                  uint32_t,
-                  Mac48Address,
-                  SatEnums::SatLogLevel_t,
-                  SatEnums::SatLinkDir_t,
-                  std::string
-                  > m_packetTrace;
+  TracedCallback<const SatPacketTraceRecord &> m_packetTrace;
 
   /**
    * Traced callback for all received packets, including the address of the
@@ -18,6 +18,7 @@
  * Author: Sami Rantanen <sami.rantanen@magister.fi>
  */
 
+#include <algorithm>
 #include <limits>
 #include "ns3/double.h"
 #include "ns3/string.h"
@@ -26,6 +27,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/enum.h"
 #include "ns3/log.h"
+#include "ns3/system-thread.h"
 #include <cmath>
 #include "satellite-position-allocator.h"
 #include "satellite-antenna-gain-pattern-container.h"
@@ -253,22 +255,57 @@ SatSpotBeamPositionAllocator::SetAltitude (Ptr<RandomVariableStream> altitude)
   m_altitude = altitude;
 }
 
+void
+SatSpotBeamPositionAllocator::SetPrecomputedPositions (const std::vector<GeoCoordinate> &positions)
+{
+  NS_LOG_FUNCTION (this << positions.size ());
+
+  m_precomputedPositions.assign (positions.begin (), positions.end ());
+}
+
 GeoCoordinate
 SatSpotBeamPositionAllocator::GetNextGeoPosition () const
 {
   NS_LOG_FUNCTION (this);
 
+  GeoCoordinate pos;
+
+  if (!m_precomputedPositions.empty ())
+    {
+      pos = m_precomputedPositions.front ();
+      m_precomputedPositions.pop_front ();
+    }
+  else
+    {
+      Ptr<SatConstantPositionMobilityModel> utMob = CreateObject<SatConstantPositionMobilityModel> ();
+      Ptr<SatConstantPositionMobilityModel> geoMob = CreateObject<SatConstantPositionMobilityModel> ();
+      utMob->SetGeoPosition (GeoCoordinate (0.00, 0.00, 0.00));
+      geoMob->SetGeoPosition (m_geoPos);
+      Ptr<SatMobilityObserver> utObserver = CreateObject<SatMobilityObserver> (utMob, geoMob);
+
+      pos = DrawValidPosition (m_targetBeamId, m_antennaGainPatterns, m_minElevationAngleInDeg, utMob, utObserver);
+    }
+
+  // Set a random altitude
+  pos.SetAltitude (m_altitude->GetValue ());
+
+  return pos;
+}
+
+GeoCoordinate
+SatSpotBeamPositionAllocator::DrawValidPosition (uint32_t beamId,
+                                                 const Ptr<SatAntennaGainPatternContainer> &patterns,
+                                                 double minElevationAngleInDeg,
+                                                 const Ptr<SatMobilityModel> &utMobility,
+                                                 const Ptr<SatMobilityObserver> &utObserver)
+{
+  NS_LOG_FUNCTION (beamId << minElevationAngleInDeg);
+
   uint32_t bestBeamId (std::numeric_limits<uint32_t>::max ());
-  Ptr<SatAntennaGainPattern> agp = m_antennaGainPatterns->GetAntennaGainPattern (m_targetBeamId);
+  Ptr<SatAntennaGainPattern> agp = patterns->GetAntennaGainPattern (beamId);
   uint32_t tries (0);
   GeoCoordinate pos;
 
-  Ptr<SatConstantPositionMobilityModel> utMob = CreateObject<SatConstantPositionMobilityModel> ();
-  Ptr<SatConstantPositionMobilityModel> geoMob = CreateObject<SatConstantPositionMobilityModel> ();
-  utMob->SetGeoPosition (GeoCoordinate (0.00, 0.00, 0.00));
-  geoMob->SetGeoPosition (m_geoPos);
-  Ptr<SatMobilityObserver> utObserver = CreateObject<SatMobilityObserver> (utMob, geoMob);
-
   double elevation (std::numeric_limits<double>::max ());
 
   // Try until
@@ -276,13 +313,13 @@ SatSpotBeamPositionAllocator::GetNextGeoPosition () const
   // - the MAX_TRIES have been exceeded
   // - elevation is NOT NaN
   // - elevation is not higher than threshold
-  while ( ( bestBeamId != m_targetBeamId || std::isnan (elevation) || elevation < m_minElevationAngleInDeg ) && tries < MAX_TRIES)
+  while ( ( bestBeamId != beamId || std::isnan (elevation) || elevation < minElevationAngleInDeg ) && tries < MAX_TRIES)
     {
       pos = agp->GetValidRandomPosition ();
-      bestBeamId = m_antennaGainPatterns->GetBestBeamId (pos);
+      bestBeamId = patterns->GetBestBeamId (pos);
 
       // Set the new position to the UT mobility
-      utMob->SetGeoPosition (pos);
+      utMobility->SetGeoPosition (pos);
 
       // Calculate the elevation angle
       elevation = utObserver->GetElevationAngle ();
@@ -293,22 +330,112 @@ SatSpotBeamPositionAllocator::GetNextGeoPosition () const
   // If the positioning fails
   if (tries >= MAX_TRIES)
     {
-      NS_FATAL_ERROR (this << " max number of tries for spot-beam allocation exceeded!");
+      NS_FATAL_ERROR ("SatSpotBeamPositionAllocator::DrawValidPosition - max number of tries for spot-beam " << beamId << " allocation exceeded!");
     }
 
-  // Set a random altitude
-  pos.SetAltitude (m_altitude->GetValue ());
-
   if (pos.GetLatitude () < -90.0 || pos.GetLatitude () > 90.0
       || pos.GetLongitude () < -180.0 || pos.GetLongitude () > 180.0
-      || elevation < m_minElevationAngleInDeg || elevation > 90.0)
+      || elevation < minElevationAngleInDeg || elevation > 90.0)
     {
-      NS_FATAL_ERROR ("SatSpotBeamPositionAllocator::GetNextGeoPosition - unvalid selected position!");
+      NS_FATAL_ERROR ("SatSpotBeamPositionAllocator::DrawValidPosition - unvalid selected position!");
     }
 
   return pos;
 }
 
+std::map<uint32_t, std::vector<GeoCoordinate> >
+SatSpotBeamPositionAllocator::DrawValidPositions (Ptr<SatAntennaGainPatternContainer> patterns,
+                                                  GeoCoordinate geoPos,
+                                                  double minElevationAngleInDeg,
+                                                  const std::map<uint32_t, uint32_t> &positionCounts,
+                                                  uint32_t threads)
+{
+  NS_LOG_FUNCTION (minElevationAngleInDeg << positionCounts.size () << threads);
+
+  std::vector<DrawJob_t> jobs;
+
+  // The objects used by the jobs are created beforehand, thus the threads
+  // only draw the positions.
+  for (std::map<uint32_t, uint32_t>::const_iterator it = positionCounts.begin (); it != positionCounts.end (); ++it)
+    {
+      DrawJob_t job;
+      job.m_beamId = it->first;
+      job.m_count = it->second;
+      job.m_utMobility = CreateObject<SatConstantPositionMobilityModel> ();
+      job.m_geoMobility = CreateObject<SatConstantPositionMobilityModel> ();
+      job.m_utMobility->SetGeoPosition (GeoCoordinate (0.00, 0.00, 0.00));
+      job.m_geoMobility->SetGeoPosition (geoPos);
+      job.m_utObserver = CreateObject<SatMobilityObserver> (job.m_utMobility, job.m_geoMobility);
+      job.m_positions.reserve (job.m_count);
+      jobs.push_back (job);
+    }
+
+  DrawJobQueue queue (patterns, minElevationAngleInDeg, jobs);
+
+  std::vector<Ptr<SystemThread> > drawThreads;
+
+  for (uint32_t i = 1; i < std::min<uint32_t> (threads, jobs.size ()); ++i)
+    {
+      drawThreads.push_back (Create<SystemThread> (MakeCallback (&DrawJobQueue::Run, &queue)));
+      drawThreads.back ()->Start ();
+    }
+
+  // The calling thread runs the jobs as well
+  queue.Run ();
+
+  for (uint32_t i = 0; i < drawThreads.size (); ++i)
+    {
+      drawThreads[i]->Join ();
+    }
+
+  std::map<uint32_t, std::vector<GeoCoordinate> > positions;
+
+  for (uint32_t i = 0; i < jobs.size (); ++i)
+    {
+      positions[jobs[i].m_beamId].swap (jobs[i].m_positions);
+    }
+
+  return positions;
+}
+
+SatSpotBeamPositionAllocator::DrawJobQueue::DrawJobQueue (const Ptr<SatAntennaGainPatternContainer> &patterns,
+                                                          double minElevationAngleInDeg,
+                                                          std::vector<DrawJob_t> &jobs)
+  : m_patterns (patterns),
+    m_minElevationAngleInDeg (minElevationAngleInDeg),
+    m_jobs (jobs),
+    m_nextJob (0)
+{
+}
+
+void
+SatSpotBeamPositionAllocator::DrawJobQueue::Run ()
+{
+  while (true)
+    {
+      uint32_t index;
+
+      {
+        CriticalSection cs (m_mutex);
+
+        if (m_nextJob >= m_jobs.size ())
+          {
+            return;
+          }
+
+        index = m_nextJob++;
+      }
+
+      DrawJob_t &job = m_jobs[index];
+
+      for (uint32_t i = 0; i < job.m_count; ++i)
+        {
+          job.m_positions.push_back (DrawValidPosition (job.m_beamId, m_patterns, m_minElevationAngleInDeg,
+                                                        job.m_utMobility, job.m_utObserver));
+        }
+    }
+}
+
 int64_t
 SatSpotBeamPositionAllocator::AssignStreams (int64_t stream)
 {
@@ -21,11 +21,17 @@
 #ifndef SATELLITE_POSITION_ALLOCATOR_H
 #define SATELLITE_POSITION_ALLOCATOR_H
 
+#include <deque>
+#include <map>
+#include <vector>
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/position-allocator.h"
+#include "ns3/system-mutex.h"
 #include "geo-coordinate.h"
 #include "satellite-antenna-gain-pattern-container.h"
+#include "satellite-mobility-model.h"
+#include "satellite-mobility-observer.h"
 
 namespace ns3 {
 
@@ -168,6 +174,13 @@ private:
 /**
  * \ingroup satellite
  * \brief Allocate random positions within the area of a certain spot-beam.
+ *
+ * The random positions are drawn from the random variable of the antenna
+ * gain pattern of the spot-beam. The valid positions of several spot-beams
+ * may be drawn beforehand in parallel with DrawValidPositions, since the
+ * drawing of a spot-beam does not depend on the other spot-beams. The
+ * precomputed positions are then set to the allocator of the spot-beam and
+ * they are returned in the same order as they would have been drawn.
  */
 class SatSpotBeamPositionAllocator : public SatPositionAllocator
 {
@@ -199,13 +212,96 @@ public:
 
   void SetAltitude (Ptr<RandomVariableStream> altitude);
 
+  /**
+   * \brief Set the precomputed valid positions returned (with a random altitude)
+   * before drawing new positions.
+   * \param positions Valid positions drawn with DrawValidPositions
+   */
+  void SetPrecomputedPositions (const std::vector<GeoCoordinate> &positions);
+
   /**
    * \brief Get next position
    * \return The next chosen position.
    */
   virtual GeoCoordinate GetNextGeoPosition (void) const;
   virtual int64_t AssignStreams (int64_t stream);
+
+  /**
+   * \brief Draw the valid positions of several spot-beams in parallel. The
+   * positions of a spot-beam are identical to the ones drawn by its allocator,
+   * as long as the random variable of the antenna gain pattern of the
+   * spot-beam is not used in between.
+   * \param patterns Container holding the antenna patterns
+   * \param geoPos GEO coordinate of the satellite for elevation angle calculations
+   * \param minElevationAngleInDeg Minimum accepted elevation angle in degrees
+   * \param positionCounts Number of positions to draw per beam id
+   * \param threads Number of threads used for drawing
+   * \return Valid positions (without altitude) per beam id
+   */
+  static std::map<uint32_t, std::vector<GeoCoordinate> > DrawValidPositions (Ptr<SatAntennaGainPatternContainer> patterns,
+                                                                             GeoCoordinate geoPos,
+                                                                             double minElevationAngleInDeg,
+                                                                             const std::map<uint32_t, uint32_t> &positionCounts,
+                                                                             uint32_t threads);
+
 private:
+  /**
+   * \brief Draw a valid position (without altitude) within the area of a spot-beam.
+   * \param beamId Target beam id
+   * \param patterns Container holding the antenna patterns
+   * \param minElevationAngleInDeg Minimum accepted elevation angle in degrees
+   * \param utMobility Mobility model used for the elevation angle calculation
+   * \param utObserver Mobility observer of utMobility and the GEO satellite
+   * \return The chosen position
+   */
+  static GeoCoordinate DrawValidPosition (uint32_t beamId,
+                                          const Ptr<SatAntennaGainPatternContainer> &patterns,
+                                          double minElevationAngleInDeg,
+                                          const Ptr<SatMobilityModel> &utMobility,
+                                          const Ptr<SatMobilityObserver> &utObserver);
+
+  /**
+   * \brief Job of drawing the valid positions of a spot-beam in DrawValidPositions
+   */
+  typedef struct
+  {
+    uint32_t m_beamId;
+    uint32_t m_count;
+    Ptr<SatMobilityModel> m_utMobility;
+    Ptr<SatMobilityModel> m_geoMobility;
+    Ptr<SatMobilityObserver> m_utObserver;
+    std::vector<GeoCoordinate> m_positions;
+  } DrawJob_t;
+
+  /**
+   * \brief Job queue of DrawValidPositions run by all the drawing threads
+   */
+  class DrawJobQueue
+  {
+  public:
+    /**
+     * \brief Constructor
+     * \param patterns Container holding the antenna patterns
+     * \param minElevationAngleInDeg Minimum accepted elevation angle in degrees
+     * \param jobs Jobs to run
+     */
+    DrawJobQueue (const Ptr<SatAntennaGainPatternContainer> &patterns,
+                double minElevationAngleInDeg,
+                std::vector<DrawJob_t> &jobs);
+
+    /**
+     * \brief Pick and run the jobs until all of them have been picked
+     */
+    void Run ();
+
+  private:
+    const Ptr<SatAntennaGainPatternContainer> &m_patterns;
+    double m_minElevationAngleInDeg;
+    std::vector<DrawJob_t> &m_jobs;
+    uint32_t m_nextJob;
+    SystemMutex m_mutex;
+  };
+
   /**
    * Max number of tries to pick a random position for a UT.
    */
@@ -245,6 +341,11 @@ private:
    * A random variable stream for altitude.
    */
   Ptr<RandomVariableStream> m_altitude;
+
+  /**
+   * Precomputed valid positions returned before drawing new positions.
+   */
+  mutable std::deque<GeoCoordinate> m_precomputedPositions;
 };
 
 
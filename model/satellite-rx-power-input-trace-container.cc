@@ -142,7 +142,22 @@ SatRxPowerInputTraceContainer::GetRxPowerDensity (key_t key)
 {
   NS_LOG_FUNCTION (this);
 
-  return FindNode (key)->ProceedToNextClosestTimeSample ().at (SatBaseTraceContainer::RX_POWER_TRACE_DEFAULT_RX_POWER_DENSITY_INDEX);
+  return FindNode (key)->ProceedToNextClosestTimeSample (SatBaseTraceContainer::RX_POWER_TRACE_DEFAULT_RX_POWER_DENSITY_INDEX);
+}
+
+Ptr<SatInputFileStreamTimeDoubleContainer>
+SatRxPowerInputTraceContainer::GetRxPowerTrace (key_t key)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<SatInputFileStreamTimeDoubleContainer> trace = FindNode (key);
+
+  if (trace == NULL)
+    {
+      NS_FATAL_ERROR ("SatRxPowerInputTraceContainer::GetRxPowerTrace - No trace for MAC " << key.first);
+    }
+
+  return trace;
 }
 
 } // namespace ns3
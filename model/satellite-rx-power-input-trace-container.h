@@ -80,6 +80,16 @@ public:
    */
   double GetRxPowerDensity (key_t key);
 
+  /**
+   * \brief Function for getting the Rx power trace matching the key.
+   * The trace keeps the position of the last returned time sample, thus it
+   * may be stored and used as a cursor instead of looking up the key on
+   * each reception.
+   * \param key key
+   * \return Rx power trace
+   */
+  Ptr<SatInputFileStreamTimeDoubleContainer> GetRxPowerTrace (key_t key);
+
   /**
    * \brief Function for resetting the variables
    */
@@ -119,6 +119,18 @@ SatRxPowerOutputTraceContainer::AddNode (key_t key)
           NS_FATAL_ERROR ("SatRxPowerOutputTraceContainer::AddNode failed");
         }
 
+      // The figure output is enabled before any rows are added, so that the
+      // figure is created from the rows before they are flushed to the file
+      if (m_enableFigureOutput)
+        {
+          result.first->second->EnableFigureOutput ("Rx power density",
+                                                    "Time (s)",
+                                                    "Rx power (dBW / Hz)",
+                                                    "set key top right",
+                                                    SatOutputFileStreamDoubleContainer::DECIBEL,
+                                                    Gnuplot2dDataset::LINES);
+        }
+
       NS_LOG_INFO ("SatRxPowerOutputTraceContainer::AddNode: Added node with MAC " << key.first << " channel type " << key.second);
 
       return result.first->second;
@@ -149,21 +161,16 @@ SatRxPowerOutputTraceContainer::WriteToFile ()
 
   for (iter = m_container.begin (); iter != m_container.end (); iter++)
     {
-      if (m_enableFigureOutput)
+      if (!m_enableFigureOutput)
         {
-          iter->second->EnableFigureOutput ("Rx power density",
-                                            "Time (s)",
-                                            "Rx power (dBW / Hz)",
-                                            "set key top right",
-                                            SatOutputFileStreamDoubleContainer::DECIBEL,
-                                            Gnuplot2dDataset::LINES);
+          iter->second->DisableFigureOutput ();
         }
       iter->second->WriteContainerToFile ();
     }
 }
 
 void
-SatRxPowerOutputTraceContainer::AddToContainer (key_t key, std::vector<double> newItem)
+SatRxPowerOutputTraceContainer::AddToContainer (key_t key, const std::vector<double>& newItem)
 {
   NS_LOG_FUNCTION (this);
 
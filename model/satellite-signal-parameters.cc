@@ -18,8 +18,10 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
+#include <vector>
 #include "ns3/log.h"
 #include "ns3/ptr.h"
+#include "ns3/system-thread.h"
 
 #include "satellite-signal-parameters.h"
 #include "satellite-phy-tx.h"
@@ -28,6 +30,29 @@ NS_LOG_COMPONENT_DEFINE ("SatSignalParameters");
 
 namespace ns3 {
 
+/**
+ * Get the free list of the memory blocks of the released signal parameters.
+ * The list is never destroyed, so that signal parameters may be released
+ * also during the destruction of static objects. Its size is bounded by the
+ * peak number of the signal parameters existing at the same time.
+ *
+ * The list is not protected by a lock, thus the signal parameters shall be
+ * created and released only in the simulator thread, e.g. not in the beam
+ * scheduling threads of the NCC.
+ */
+static std::vector<void*>&
+GetFreeSignalParameters ()
+{
+  static std::vector<void*> *freeBlocks = new std::vector<void*> ();
+  static SystemThread::ThreadId simulatorThread = SystemThread::Self ();
+
+  NS_ASSERT_MSG (SystemThread::Equals (simulatorThread), "Signal parameters allocated or released outside the simulator thread");
+
+  return *freeBlocks;
+}
+
+static const SatSignalParameters::PacketsInBurst_t g_emptyPacketsInBurst;
+
 SatSignalParameters::SatSignalParameters ()
   : m_beamId (),
     m_carrierId (),
@@ -44,17 +69,22 @@ SatSignalParameters::SatSignalParameters ()
     m_rxNoisePowerInSatellite_W (),
     m_rxAciIfPowerInSatellite_W (),
     m_rxExtNoisePowerInSatellite_W (),
-    m_sinrCalculate ()
+    m_sinrCalculate (),
+    m_packetsInBurst ()
 {
   NS_LOG_FUNCTION (this);
 }
 
 SatSignalParameters::SatSignalParameters ( const SatSignalParameters& p )
 {
-  for ( PacketsInBurst_t::const_iterator i = p.m_packetsInBurst.begin (); i != p.m_packetsInBurst.end (); i++  )
-    {
-      m_packetsInBurst.push_back ((*i)->Copy ());
-    }
+  CopyFrom (p);
+}
+
+void
+SatSignalParameters::CopyFrom (const SatSignalParameters& p)
+{
+  // packets are copied only when a receiver needs to modify them
+  m_packetsInBurst = p.m_packetsInBurst;
 
   m_beamId = p.m_beamId;
   m_carrierId = p.m_carrierId;
@@ -89,6 +119,86 @@ SatSignalParameters::Copy ()
   return p;
 }
 
+void*
+SatSignalParameters::operator new (size_t size)
+{
+  std::vector<void*>& freeBlocks = GetFreeSignalParameters ();
+
+  if ( size == sizeof (SatSignalParameters) && !freeBlocks.empty () )
+    {
+      void* block = freeBlocks.back ();
+      freeBlocks.pop_back ();
+      return block;
+    }
+
+  return ::operator new (size);
+}
+
+void
+SatSignalParameters::operator delete (void* block, size_t size)
+{
+  if ( block == NULL )
+    {
+      return;
+    }
+
+  if ( size == sizeof (SatSignalParameters) )
+    {
+      GetFreeSignalParameters ().push_back (block);
+    }
+  else
+    {
+      ::operator delete (block);
+    }
+}
+
+const SatSignalParameters::PacketsInBurst_t&
+SatSignalParameters::GetPackets () const
+{
+  if ( m_packetsInBurst == NULL )
+    {
+      return g_emptyPacketsInBurst;
+    }
+
+  return m_packetsInBurst->m_packets;
+}
+
+const SatSignalParameters::PacketsInBurst_t&
+SatSignalParameters::GetWritablePackets ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if ( m_packetsInBurst == NULL )
+    {
+      return g_emptyPacketsInBurst;
+    }
+
+  // copy the packets, if they are shared with the other signal parameters
+  // or with the transmitter
+  if ( !m_packetsInBurst->m_owned || m_packetsInBurst->GetReferenceCount () > 1 )
+    {
+      PacketsInBurst_t packets;
+      packets.reserve (m_packetsInBurst->m_packets.size ());
+
+      for ( PacketsInBurst_t::const_iterator i = m_packetsInBurst->m_packets.begin (); i != m_packetsInBurst->m_packets.end (); i++  )
+        {
+          packets.push_back ((*i)->Copy ());
+        }
+
+      m_packetsInBurst = Create<SharedPackets> (packets, true);
+    }
+
+  return m_packetsInBurst->m_packets;
+}
+
+void
+SatSignalParameters::SetPackets (const PacketsInBurst_t& packets)
+{
+  NS_LOG_FUNCTION (this << packets.size ());
+
+  m_packetsInBurst = Create<SharedPackets> (packets, false);
+}
+
 TypeId
 SatSignalParameters::GetTypeId (void)
 {
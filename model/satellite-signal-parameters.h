@@ -25,6 +25,7 @@
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/simple-ref-count.h"
 #include "satellite-enums.h"
 
 namespace ns3 {
@@ -66,24 +67,69 @@ public:
   SatSignalParameters ();
 
   /**
-   * copy constructor
+   * copy constructor. The copy shares the packets with the original.
    */
   SatSignalParameters (const SatSignalParameters& p);
 
   Ptr<SatSignalParameters> Copy ();
 
   /**
-   * \brief Get the type ID
-   * \return the object TypeId
+   * \brief Overwrite the transmission information of these signal parameters
+   * with the one of the given signal parameters. The packets are shared with
+   * the given signal parameters as in the copy constructor.
+   * \param p The signal parameters to copy from
    */
-  static TypeId GetTypeId (void);
+  void CopyFrom (const SatSignalParameters& p);
+
+  /**
+   * \brief Allocate memory for signal parameters. The memory of the released
+   * signal parameters is recycled through a free list, since signal parameters
+   * are copied for every receiver of every transmission. The free list is
+   * not thread-safe, thus signal parameters shall be created and released
+   * only in the simulator thread.
+   * \param size Size of the memory to allocate
+   * \return Pointer to the allocated memory
+   */
+  static void* operator new (size_t size);
+
+  /**
+   * \brief Release memory of signal parameters to the free list.
+   * \param block Pointer to the memory to release
+   * \param size Size of the memory to release
+   */
+  static void operator delete (void* block, size_t size);
+
+  /**
+   * \brief Get the packets being transmitted with this signal for reading,
+   * e.g. to peek tags or to trace them. The packets may be shared with the
+   * other copies of the signal parameters and with the transmitter, thus
+   * they shall neither be modified nor passed to the upper layers. Use
+   * GetWritablePackets for those.
+   * \return The packets
+   */
+  const PacketsInBurst_t& GetPackets () const;
+
+  /**
+   * \brief Get the packets being transmitted with this signal for modification,
+   * e.g. to remove tags or to pass them to the upper layer. The packets are
+   * copied before they are returned, unless they are already owned by this
+   * signal parameters only.
+   * \return The packets
+   */
+  const PacketsInBurst_t& GetWritablePackets ();
 
   /**
-   * The packets being transmitted with this signal i.e.
-   * this is transmit buffer including packet pointers.
+   * \brief Set the packets being transmitted with this signal i.e.
+   * the transmit buffer including packet pointers.
+   * \param packets The packets
    */
+  void SetPackets (const PacketsInBurst_t& packets);
 
-  PacketsInBurst_t m_packetsInBurst;
+  /**
+   * \brief Get the type ID
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
 
   /**
    * The beam for the packet transmission
@@ -173,6 +219,34 @@ public:
    * Callback for SINR calculation
    */
   Callback<double, double> m_sinrCalculate;
+
+private:
+  /**
+   * Packets of a transmission shared by the copies of the signal parameters.
+   */
+  class SharedPackets : public SimpleRefCount<SharedPackets>
+  {
+public:
+    /**
+     * Construct shared packets.
+     *
+     * \param packets The packets
+     * \param owned true if the packets are copies owned by the signal parameters
+     */
+    SharedPackets (const PacketsInBurst_t& packets, bool owned)
+      : m_packets (packets),
+        m_owned (owned)
+    {
+    }
+
+    PacketsInBurst_t  m_packets;
+    bool              m_owned;
+  };
+
+  /**
+   * The packets being transmitted with this signal, NULL if there are no packets.
+   */
+  Ptr<SharedPackets> m_packetsInBurst;
 };
 
 
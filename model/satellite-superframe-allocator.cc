@@ -134,9 +134,58 @@ SatSuperframeAllocator::GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t
       NS_FATAL_ERROR ("TBTP container must contain at least one message.");
     }
 
+  ComputeTimeSlots ();
+  WriteTimeSlots (tbtpContainer, maxSizeInBytes, utAllocContainer, waveformTrace, utLoadTrace, loadTrace);
+}
+
+void
+SatSuperframeAllocator::ComputeTimeSlots ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (FrameAllocatorContainer_t::iterator it = m_frameAllocators.begin (); it != m_frameAllocators.end (); it++  )
+    {
+      (*it)->ComputeTimeSlots (m_rcBasedAllocationEnabled);
+    }
+}
+
+void
+SatSuperframeAllocator::WriteTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer,
+                                        const TracedCallback<uint32_t>& waveformTrace, const TracedCallback<uint32_t, uint32_t>& utLoadTrace,
+                                        const TracedCallback<uint32_t, double>& loadTrace)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (tbtpContainer.empty ())
+    {
+      NS_FATAL_ERROR ("TBTP container must contain at least one message.");
+    }
+
+  for (FrameAllocatorContainer_t::iterator it = m_frameAllocators.begin (); it != m_frameAllocators.end (); it++  )
+    {
+      (*it)->WriteTimeSlots (tbtpContainer, maxSizeInBytes, utAllocContainer, waveformTrace, utLoadTrace, loadTrace);
+    }
+}
+
+void
+SatSuperframeAllocator::SetRandomVariable (Ptr<UniformRandomVariable> random)
+{
+  NS_LOG_FUNCTION (this << random);
+
+  for (FrameAllocatorContainer_t::iterator it = m_frameAllocators.begin (); it != m_frameAllocators.end (); it++  )
+    {
+      (*it)->SetRandomVariable (random);
+    }
+}
+
+void
+SatSuperframeAllocator::PrepareWaveformSelection ()
+{
+  NS_LOG_FUNCTION (this);
+
   for (FrameAllocatorContainer_t::iterator it = m_frameAllocators.begin (); it != m_frameAllocators.end (); it++  )
     {
-      (*it)->GenerateTimeSlots (tbtpContainer, maxSizeInBytes, utAllocContainer, m_rcBasedAllocationEnabled, waveformTrace, utLoadTrace, loadTrace);
+      (*it)->PrepareWaveformSelection ();
     }
 }
 
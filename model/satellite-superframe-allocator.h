@@ -104,6 +104,44 @@ public:
   void GenerateTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer,
                           TracedCallback<uint32_t> waveformTrace, TracedCallback<uint32_t, uint32_t> utLoadTrace, TracedCallback<uint32_t, double> loadTrace);
 
+  /**
+   * \brief Compute time slots of the frames for the UT/RCs based on preallocation.
+   * The computed time slots are added to TBTP(s) by calling WriteTimeSlots.
+   *
+   * The method neither creates objects nor calls the simulator, so it can be called
+   * concurrently for allocators of different beams, when they have random variables
+   * of their own set by SetRandomVariable.
+   */
+  void ComputeTimeSlots ();
+
+  /**
+   * \brief Add time slots computed by ComputeTimeSlots to TBTP(s).
+   *
+   * \param tbtpContainer TBTP message container to add/fill TBTPs.
+   * \param maxSizeInBytes Maximum size for a TBTP message.
+   * \param utAllocContainer Reference to UT allocation container to fill in info of the allocation
+   * \param waveformTrace Wave form trace callback
+   * \param utLoadTrace UT load per the frame trace callback
+   * \param loadTrace Load per the frame trace callback
+   */
+  void WriteTimeSlots (SatFrameAllocator::TbtpMsgContainer_t& tbtpContainer, uint32_t maxSizeInBytes, SatFrameAllocator::UtAllocInfoContainer_t& utAllocContainer,
+                       const TracedCallback<uint32_t>& waveformTrace, const TracedCallback<uint32_t, uint32_t>& utLoadTrace,
+                       const TracedCallback<uint32_t, double>& loadTrace);
+
+  /**
+   * \brief Set random variable used by the frame allocators to shuffle UTs, carriers and RCs
+   * in time slot generation instead of the random generator of the standard library.
+   *
+   * \param random Random variable to use for shuffling
+   */
+  void SetRandomVariable (Ptr<UniformRandomVariable> random);
+
+  /**
+   * \brief Prepare the waveform selection of the frame allocators, see
+   * SatFrameAllocator::PrepareWaveformSelection.
+   */
+  void PrepareWaveformSelection ();
+
 private:
   /**
    * Container for SatFrameInfo items.
@@ -18,9 +18,7 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
-#include <algorithm>
 #include <iostream>
-#include "ns3/mac48-address.h"
 #include "ns3/uinteger.h"
 #include "ns3/nstime.h"
 #include "ns3/simulator.h"
@@ -53,7 +51,7 @@ SatTbtpContainer::GetTypeId (void)
 }
 
 SatTbtpContainer::SatTbtpContainer ()
-  : m_address (),
+  : m_assignmentId (0),
     m_maxStoredTbtps (100),
     m_rcvdTbtps (0),
     m_superFrameDuration (0)
@@ -62,7 +60,7 @@ SatTbtpContainer::SatTbtpContainer ()
 }
 
 SatTbtpContainer::SatTbtpContainer (Ptr<SatSuperframeSeq> seq)
-  : m_address (),
+  : m_assignmentId (0),
     m_superframeSeq (seq),
     m_maxStoredTbtps (100),
     m_rcvdTbtps (0),
@@ -84,10 +82,10 @@ void SatTbtpContainer::DoDispose ()
 
 
 void
-SatTbtpContainer::SetMacAddress (Mac48Address address)
+SatTbtpContainer::SetAssignmentId (uint32_t assignmentId)
 {
-  NS_LOG_FUNCTION (this);
-  m_address = address;
+  NS_LOG_FUNCTION (this << assignmentId);
+  m_assignmentId = assignmentId;
 }
 
 void
@@ -136,15 +134,14 @@ SatTbtpContainer::HasScheduledTimeSlots ()
     {
       RemovePastTbtps ();
 
-      SatTbtpMessage::DaTimeSlotInfoItem_t info;
       for (TbtpMap_t::const_reverse_iterator it = m_tbtps.rbegin ();
            it != m_tbtps.rend ();
            ++it)
         {
-          info = it->second->GetDaTimeslots (m_address);
+          SatTbtpMessage::DaTimeSlotInfo info = it->second->GetDaTimeslots (m_assignmentId);
 
           // This TBTP has time slots for this UT
-          if (!info.second.empty ())
+          if (!info.IsEmpty ())
             {
               Time superframeStartTime = it->first;
 
@@ -162,23 +159,28 @@ SatTbtpContainer::HasScheduledTimeSlots ()
                 {
                   /**
                    * The time slots are not necessarily in increasing order in the TBTP.
-                   * Sort the time slots into increasing order based on time.
+                   * Find the time slot with the latest start time.
                    */
-                  std::sort (info.second.begin (), info.second.end (), SortTimeSlots ());
+                  uint32_t lastSlot = 0;
+
+                  for (uint32_t i = 1; i < info.GetSize (); ++i)
+                    {
+                      if (info[i].m_startTime > info[lastSlot].m_startTime)
+                        {
+                          lastSlot = i;
+                        }
+                    }
 
                   // Start time offset for the last time slot for this UT
-                  Time startTimeOffsetForLastSlot = (*(info.second.rbegin ()))->GetStartTime ();
+                  Time startTimeOffsetForLastSlot = info[lastSlot].m_startTime;
 
                   /**
-                   * Calculate the duration of the last slot. To be able to do that we need the
-                   * superframe conf, frame conf, time slot conf and symbol rate.
+                   * Get the duration of the last slot from the frame conf, which
+                   * holds the burst durations of the waveforms for its symbol rate.
                    */
                   Ptr<SatSuperframeConf> superframeConf = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
-                  uint8_t frameId = info.first;
-                  Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
-                  uint32_t wfId = (*(info.second.rbegin ()))->GetWaveFormId ();
-                  Ptr<SatWaveform> wf = m_superframeSeq->GetWaveformConf ()->GetWaveform (wfId);
-                  Time lastSlotDuration = wf->GetBurstDuration (frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
+                  Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (info.GetFrameId ());
+                  Time lastSlotDuration = frameConf->GetBurstDuration (info[lastSlot].m_waveformId);
 
                   NS_LOG_INFO ("Superframe counter: " << it->second->GetSuperframeCounter () <<
                                ", start time: " << superframeStartTime.GetSeconds () <<
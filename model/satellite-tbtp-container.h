@@ -23,7 +23,6 @@
 
 #include <map>
 #include "ns3/object.h"
-#include "ns3/mac48-address.h"
 #include "satellite-control-message.h"
 #include "satellite-frame-conf.h"
 #include "satellite-superframe-sequence.h"
@@ -31,30 +30,6 @@
 namespace ns3 {
 
 
-/**
- * \ingroup satellite
- * This class sorts time slots within TBTP into increasing order based
- * on start time.
- */
-class SortTimeSlots
-{
-public:
-  SortTimeSlots ()
-  {
-  }
-
-  /**
-   * Operator overload for sorting function
-   * \param p1 Time slot configuration
-   * \param p2 Time slot configuration
-   * \return Start time of p1 < Start time of p2
-   */
-  bool operator() (Ptr<SatTimeSlotConf> p1, Ptr<SatTimeSlotConf> p2)
-  {
-    return p1->GetStartTime () < p2->GetStartTime ();
-  }
-};
-
 /**
  * \ingroup satellite
  * \brief A container of received TBTPs. All the received TBTPs with
@@ -94,10 +69,10 @@ public:
   virtual void DoDispose ();
 
   /**
-   * \brief Set the MAC address of this node
-   * \param address MAC address of this node
+   * \brief Set the TBTP assignment ID of this node
+   * \param assignmentId Assignment ID of this node
    */
-  void SetMacAddress (Mac48Address address);
+  void SetAssignmentId (uint32_t assignmentId);
 
   /**
    * \brief Add a TBTP message to the container
@@ -124,9 +99,9 @@ private:
   TbtpMap_t m_tbtps;
 
   /**
-   * Address of this UT
+   * Assignment ID of this UT
    */
-  Mac48Address m_address;
+  uint32_t m_assignmentId;
 
   /**
    * Superframe sequence
@@ -93,7 +93,16 @@ SatTracedInterference::DoCalculate (Ptr<SatInterference::InterferenceChangeEvent
 {
   NS_LOG_FUNCTION (this);
 
-  m_power = m_rxBandwidth_Hz * Singleton<SatInterferenceInputTraceContainer>::Get ()->GetInterferenceDensity (std::make_pair (event->GetSatEarthStationAddress (),m_channelType));
+  Address address = event->GetSatEarthStationAddress ();
+
+  // The earth station seldom changes (forward link), thus the trace is looked up only when it does
+  if (m_trace == NULL || address != m_traceAddress)
+    {
+      m_trace = Singleton<SatInterferenceInputTraceContainer>::Get ()->GetInterferenceTrace (std::make_pair (address, m_channelType));
+      m_traceAddress = address;
+    }
+
+  m_power = m_rxBandwidth_Hz * m_trace->ProceedToNextClosestTimeSample (SatBaseTraceContainer::INTF_TRACE_DEFAULT_INTF_DENSITY_INDEX);
 
   return m_power;
 }
@@ -125,6 +134,8 @@ SatTracedInterference::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  m_trace = NULL;
+
   SatInterference::DoDispose ();
 }
 
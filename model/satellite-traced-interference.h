@@ -150,6 +150,17 @@ private:
    * \brief RX Bandwidth in Hz
    */
   double m_rxBandwidth_Hz;
+
+  /**
+   * \brief Earth station address of the interference trace in use
+   */
+  Address m_traceAddress;
+
+  /**
+   * \brief Interference trace of the latest earth station, used as a cursor
+   * to the trace samples
+   */
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_trace;
 };
 
 } // namespace ns3
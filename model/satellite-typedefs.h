@@ -30,6 +30,7 @@ namespace ns3 {
 class Packet;
 class Address;
 class Time;
+class SatPacketTraceRecord;
 
 /**
  * \ingroup satellite
@@ -75,29 +76,13 @@ public:
 
   /**
    * \brief Common callback signature for `PacketTrace` trace sources.
-   * \param now the current simulation time
-   * \param eventType the type of this trace e.g., PACKET_SENT, PACKET_RECV,
-   *                  PACKET_ENQUE, or PACKET_DROP
-   * \param nodeType the type of the node where the event occured, e.g., NT_UT,
-   *                 NT_SAT, NT_GW, NT_NCC, or NT_TER
-   * \param nodeId the identifier of the node where the event occured
-   * \param nodeMacAddress the MAC address of the node where the event occured
-   * \param logLevel the log level used
-   * \param linkDirection link direction, e.g., LD_FORWARD or LD_RETURN
-   * \param packetInfo packet information in std::string for printing purpose,
-   *                   typically contains the packet's Uid, source address,
-   *                   and destination address
-   * \todo Use const-reference for Time argument.
+   * \param record the packet event record holding the time, the type of
+   *               the event, the type, identifier and MAC address of the
+   *               node where the event occured, the log level, the link
+   *               direction and the traced packets
    */
   typedef void (*PacketTraceCallback)
-    (Time                        now,
-    SatEnums::SatPacketEvent_t  eventType,
-    SatEnums::SatNodeType_t     nodeType,
-    uint32_t                    nodeId,
-    Mac48Address                nodeMacAddress,
-    SatEnums::SatLogLevel_t     logLevel,
-    SatEnums::SatLinkDir_t      linkDirection,
-    std::string                 packetInfo);
+    (const SatPacketTraceRecord &record);
 
   /**
    * \brief Common callback signature for scenario creation trace sources by
@@ -126,14 +126,14 @@ SatUtLlc::Enque (Ptr<Packet> packet, Address dest, uint8_t flowId)
     (m_nodeInfo->GetNodeType () == SatEnums::NT_UT) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD;
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_ENQUE,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_LLC,
-                 ld,
-                 SatUtils::GetPacketInfo (packet));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_ENQUE,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_LLC,
+                                       ld,
+                                       packet));
 
   return true;
 }
@@ -157,14 +157,14 @@ SatUtLlc::NotifyTxOpportunity (uint32_t bytes, Mac48Address utAddr, uint8_t rcIn
           SatEnums::SatLinkDir_t ld = SatEnums::LD_RETURN;
 
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_LLC,
-                         ld,
-                         SatUtils::GetPacketInfo (packet));
+          m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                               SatEnums::PACKET_SENT,
+                                               m_nodeInfo->GetNodeType (),
+                                               m_nodeInfo->GetNodeId (),
+                                               m_nodeInfo->GetMacAddress (),
+                                               SatEnums::LL_LLC,
+                                               ld,
+                                               packet));
         }
     }
   /*
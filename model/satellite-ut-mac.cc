@@ -62,6 +62,15 @@ SatUtMac::GetTypeId (void)
                    TimeValue (MicroSeconds (1)),
                    MakeTimeAccessor (&SatUtMac::m_guardTime),
                    MakeTimeChecker ())
+    .AddAttribute ("DaTxTimeline",
+                   "Schedule the DA Tx opportunities of the UT through a timeline, which keeps only the next "
+                   "opportunity of the UT in the simulator event queue. If disabled, one simulator event is "
+                   "scheduled for every time slot when TBTP is received. The timeline keeps the order of the "
+                   "transmissions of the UT, but they may run in a different order relative to other events "
+                   "scheduled to the same time instant.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatUtMac::m_daTxTimelineEnabled),
+                   MakeBooleanChecker ())
     .AddAttribute ("Scheduler",
                    "UT scheduler used by this Sat UT MAC.",
                    PointerValue (),
@@ -89,7 +98,9 @@ SatUtMac::SatUtMac ()
     m_timingAdvanceCb (0),
     m_randomAccess (NULL),
     m_guardTime (MicroSeconds (1)),
+    m_daTxTimelineEnabled (false),
     m_raChannel (0),
+    m_assignmentId (0),
     m_crdsaUniquePacketId (1),
     m_crdsaOnlyForControl (false)
 {
@@ -104,7 +115,9 @@ SatUtMac::SatUtMac (Ptr<SatSuperframeSeq> seq, uint32_t beamId, bool crdsaOnlyFo
     m_superframeSeq (seq),
     m_timingAdvanceCb (0),
     m_guardTime (MicroSeconds (1)),
+    m_daTxTimelineEnabled (false),
     m_raChannel (0),
+    m_assignmentId (0),
     m_crdsaUniquePacketId (1),
     m_crdsaOnlyForControl (crdsaOnlyForControl)
 {
@@ -128,6 +141,8 @@ SatUtMac::DoDispose (void)
   NS_LOG_FUNCTION (this);
 
   m_timingAdvanceCb.Nullify ();
+  m_daTxEvent.Cancel ();
+  m_daTxOpportunities.clear ();
   m_tbtpContainer->DoDispose ();
   m_utScheduler->DoDispose ();
   m_utScheduler = NULL;
@@ -140,7 +155,6 @@ SatUtMac::SetNodeInfo (Ptr<SatNodeInfo> nodeInfo)
 {
   NS_LOG_FUNCTION (this << nodeInfo);
 
-  m_tbtpContainer->SetMacAddress (nodeInfo->GetMacAddress ());
   m_utScheduler->SetNodeInfo (nodeInfo);
   SatMac::SetNodeInfo (nodeInfo);
 }
@@ -161,6 +175,15 @@ SatUtMac::GetRaChannel () const
   return m_raChannel;
 }
 
+void
+SatUtMac::SetAssignmentId (uint32_t assignmentId)
+{
+  NS_LOG_FUNCTION (this << assignmentId);
+
+  m_assignmentId = assignmentId;
+  m_tbtpContainer->SetAssignmentId (assignmentId);
+}
+
 void
 SatUtMac::SetRandomAccess (Ptr<SatRandomAccess> randomAccess)
 {
@@ -260,41 +283,43 @@ SatUtMac::ScheduleTimeSlots (Ptr<SatTbtpMessage> tbtp)
   NS_LOG_INFO ("Time to start sending the superframe for this UT: " << txTime.GetSeconds ());
   NS_LOG_INFO ("Waiting delay before the superframe start: " << startDelay.GetSeconds ());
 
-  SatTbtpMessage::DaTimeSlotInfoItem_t info = tbtp->GetDaTimeslots (m_nodeInfo->GetMacAddress ());
+  SatTbtpMessage::DaTimeSlotInfo info = tbtp->GetDaTimeslots (m_assignmentId);
 
   // Counters for allocated TBTP resources
   uint32_t payloadSumInSuperFrame = 0;
   uint32_t payloadSumPerRcIndex [SatEnums::NUM_FIDS] = { };
 
-  if (!info.second.empty ())
+  if (!info.IsEmpty ())
     {
-      NS_LOG_INFO ("TBTP contains " << info.second.size () << " timeslots for UT: " << m_nodeInfo->GetMacAddress ());
+      NS_LOG_INFO ("TBTP contains " << info.GetSize () << " timeslots for UT: " << m_nodeInfo->GetMacAddress ());
+
+      uint8_t frameId = info.GetFrameId ();
 
-      uint8_t frameId = info.first;
+      // The waveforms and burst durations are resolved once per frame configuration
+      Ptr<SatSuperframeConf> superframeConf = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
+      Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
 
       // schedule time slots
-      for ( SatTbtpMessage::DaTimeSlotConfContainer_t::iterator it = info.second.begin (); it != info.second.end (); it++ )
+      for ( uint32_t i = 0; i < info.GetSize (); i++ )
         {
-          Ptr<SatSuperframeConf> superframeConf = m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE);
-          Ptr<SatFrameConf> frameConf = superframeConf->GetFrameConf (frameId);
-          Ptr<SatTimeSlotConf> timeSlotConf = *it;
+          const SatTbtpMessage::DaTimeSlot_t& timeSlot = info[i];
 
           // Start time
-          Time slotDelay = startDelay + timeSlotConf->GetStartTime ();
+          Time slotDelay = startDelay + timeSlot.m_startTime;
           NS_LOG_INFO ("Slot start delay: " << slotDelay.GetSeconds ());
 
           // Duration
-          Ptr<SatWaveform> wf = m_superframeSeq->GetWaveformConf ()->GetWaveform (timeSlotConf->GetWaveFormId ());
-          Time duration = wf->GetBurstDuration (frameConf->GetBtuConf ()->GetSymbolRateInBauds ());
+          const Ptr<SatWaveform>& wf = frameConf->GetWaveform (timeSlot.m_waveformId);
+          Time duration = frameConf->GetBurstDuration (timeSlot.m_waveformId);
 
           // Carrier
-          uint32_t carrierId = m_superframeSeq->GetCarrierId (0, frameId, timeSlotConf->GetCarrierId () );
+          uint32_t carrierId = superframeConf->GetCarrierId (frameId, timeSlot.m_carrierId);
 
           // Schedule individual time slot
-          ScheduleDaTxOpportunity (slotDelay, duration, wf, timeSlotConf, carrierId);
+          ScheduleDaTxOpportunity (slotDelay, duration, wf, timeSlot.m_slotType, timeSlot.m_rcIndex, carrierId);
 
           payloadSumInSuperFrame += wf->GetPayloadInBytes ();
-          payloadSumPerRcIndex [timeSlotConf->GetRcIndex ()] += wf->GetPayloadInBytes ();
+          payloadSumPerRcIndex [timeSlot.m_rcIndex] += wf->GetPayloadInBytes ();
         }
     }
 
@@ -309,20 +334,62 @@ SatUtMac::ScheduleTimeSlots (Ptr<SatTbtpMessage> tbtp)
 }
 
 void
-SatUtMac::ScheduleDaTxOpportunity (Time transmitDelay, Time duration, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, uint32_t carrierId)
+SatUtMac::ScheduleDaTxOpportunity (Time transmitDelay, Time duration, Ptr<SatWaveform> wf, SatTimeSlotConf::SatTimeSlotType_t slotType, uint8_t rcIndex, uint32_t carrierId)
+{
+  NS_LOG_FUNCTION (this << transmitDelay.GetSeconds () << duration.GetSeconds () << wf->GetPayloadInBytes () << (uint32_t) slotType << (uint32_t) rcIndex << carrierId);
+  NS_LOG_INFO ("SatUtMac::ScheduleDaTxOpportunity - after delay: " << transmitDelay.GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", rcIndex: " << (uint32_t) rcIndex << ", carrier: " << carrierId);
+
+  if (!m_daTxTimelineEnabled)
+    {
+      Simulator::Schedule (transmitDelay, &SatUtMac::DoTransmit, this, duration, carrierId, wf, slotType, rcIndex, SatUtScheduler::LOOSE);
+      return;
+    }
+
+  DaTxOpportunity_t opportunity;
+  opportunity.m_duration = duration;
+  opportunity.m_carrierId = carrierId;
+  opportunity.m_waveform = wf;
+  opportunity.m_slotType = slotType;
+  opportunity.m_rcIndex = rcIndex;
+
+  Time txTime = Simulator::Now () + transmitDelay;
+
+  // the opportunity is inserted after the ones with the same transmit time
+  m_daTxOpportunities.insert (std::make_pair (txTime, opportunity));
+
+  // the timeline event is kept scheduled to the earliest opportunity
+  if (m_daTxEvent.IsExpired () || txTime < TimeStep (m_daTxEvent.GetTs ()))
+    {
+      m_daTxEvent.Cancel ();
+      m_daTxEvent = Simulator::Schedule (transmitDelay, &SatUtMac::DoDaTxTimeline, this);
+    }
+}
+
+void
+SatUtMac::DoDaTxTimeline ()
 {
-  NS_LOG_FUNCTION (this << transmitDelay.GetSeconds () << duration.GetSeconds () << wf->GetPayloadInBytes () << (uint32_t)(tsConf->GetRcIndex ()) << carrierId);
-  NS_LOG_INFO ("SatUtMac::ScheduleDaTxOpportunity - after delay: " << transmitDelay.GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", rcIndex: " << (uint32_t)(tsConf->GetRcIndex ()) << ", carrier: " << carrierId);
+  NS_LOG_FUNCTION (this);
+
+  while (!m_daTxOpportunities.empty () && m_daTxOpportunities.begin ()->first <= Simulator::Now ())
+    {
+      DaTxOpportunity_t opportunity = m_daTxOpportunities.begin ()->second;
+      m_daTxOpportunities.erase (m_daTxOpportunities.begin ());
 
-  Simulator::Schedule (transmitDelay, &SatUtMac::DoTransmit, this, duration, carrierId, wf, tsConf, SatUtScheduler::LOOSE);
+      DoTransmit (opportunity.m_duration, opportunity.m_carrierId, opportunity.m_waveform, opportunity.m_slotType, opportunity.m_rcIndex, SatUtScheduler::LOOSE);
+    }
+
+  if (!m_daTxOpportunities.empty ())
+    {
+      m_daTxEvent = Simulator::Schedule (m_daTxOpportunities.begin ()->first - Simulator::Now (), &SatUtMac::DoDaTxTimeline, this);
+    }
 }
 
 
 void
-SatUtMac::DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, SatUtScheduler::SatCompliancePolicy_t policy)
+SatUtMac::DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, SatTimeSlotConf::SatTimeSlotType_t slotType, uint8_t rcIndex, SatUtScheduler::SatCompliancePolicy_t policy)
 {
-  NS_LOG_FUNCTION (this << duration.GetSeconds () << wf->GetPayloadInBytes () << carrierId << (uint32_t)(tsConf->GetRcIndex ()));
-  NS_LOG_INFO ("DA Tx opportunity for UT: " << m_nodeInfo->GetMacAddress () << " at time: " << Simulator::Now ().GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", carrier: " << carrierId << ", RC index: " << (uint32_t)(tsConf->GetRcIndex ()));
+  NS_LOG_FUNCTION (this << duration.GetSeconds () << wf->GetPayloadInBytes () << carrierId << (uint32_t) slotType << (uint32_t) rcIndex);
+  NS_LOG_INFO ("DA Tx opportunity for UT: " << m_nodeInfo->GetMacAddress () << " at time: " << Simulator::Now ().GetSeconds () << " duration: " << duration.GetSeconds () << ", payload: " << wf->GetPayloadInBytes () << ", carrier: " << carrierId << ", RC index: " << (uint32_t) rcIndex);
 
   SatSignalParameters::txInfo_s txInfo;
   txInfo.packetType = SatEnums::PACKET_TYPE_DEDICATED_ACCESS;
@@ -331,7 +398,7 @@ SatUtMac::DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, Pt
   txInfo.frameType = SatEnums::UNDEFINED_FRAME;
   txInfo.waveformId = wf->GetWaveformId ();
 
-  TransmitPackets (FetchPackets (wf->GetPayloadInBytes (), tsConf->GetSlotType (), tsConf->GetRcIndex (), policy), duration, carrierId, txInfo);
+  TransmitPackets (FetchPackets (wf->GetPayloadInBytes (), slotType, rcIndex, policy), duration, carrierId, txInfo);
 }
 
 void
@@ -364,14 +431,14 @@ SatUtMac::DoSlottedAlohaTransmit (Time duration, Ptr<SatWaveform> waveform, uint
            ++it)
         {
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_MAC,
-                         SatEnums::LD_RETURN,
-                         SatUtils::GetPacketInfo (*it));
+          m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                               SatEnums::PACKET_SENT,
+                                               m_nodeInfo->GetNodeType (),
+                                               m_nodeInfo->GetNodeId (),
+                                               m_nodeInfo->GetMacAddress (),
+                                               SatEnums::LL_MAC,
+                                               SatEnums::LD_RETURN,
+                                               *it));
         }
 
       SatSignalParameters::txInfo_s txInfo;
@@ -413,14 +480,14 @@ SatUtMac::FetchPackets (uint32_t payloadBytes, SatTimeSlotConf::SatTimeSlotType_
            ++it)
         {
           // Add packet trace entry:
-          m_packetTrace (Simulator::Now (),
-                         SatEnums::PACKET_SENT,
-                         m_nodeInfo->GetNodeType (),
-                         m_nodeInfo->GetNodeId (),
-                         m_nodeInfo->GetMacAddress (),
-                         SatEnums::LL_MAC,
-                         SatEnums::LD_RETURN,
-                         SatUtils::GetPacketInfo (*it));
+          m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                               SatEnums::PACKET_SENT,
+                                               m_nodeInfo->GetNodeType (),
+                                               m_nodeInfo->GetNodeId (),
+                                               m_nodeInfo->GetMacAddress (),
+                                               SatEnums::LL_MAC,
+                                               SatEnums::LD_RETURN,
+                                               *it));
         }
     }
 
@@ -478,14 +545,14 @@ SatUtMac::Receive (SatPhy::PacketContainer_t packets, Ptr<SatSignalParameters> /
   NS_LOG_FUNCTION (this << packets.size ());
 
   // Add packet trace entry:
-  m_packetTrace (Simulator::Now (),
-                 SatEnums::PACKET_RECV,
-                 m_nodeInfo->GetNodeType (),
-                 m_nodeInfo->GetNodeId (),
-                 m_nodeInfo->GetMacAddress (),
-                 SatEnums::LL_MAC,
-                 SatEnums::LD_FORWARD,
-                 SatUtils::GetPacketInfo (packets));
+  m_packetTrace (SatPacketTraceRecord (Simulator::Now (),
+                                       SatEnums::PACKET_RECV,
+                                       m_nodeInfo->GetNodeType (),
+                                       m_nodeInfo->GetNodeId (),
+                                       m_nodeInfo->GetMacAddress (),
+                                       SatEnums::LL_MAC,
+                                       SatEnums::LD_FORWARD,
+                                       packets));
 
   // Invoke the `Rx` and `RxDelay` trace sources.
   RxTraces (packets);
@@ -26,6 +26,7 @@
 #include <ns3/traced-callback.h>
 #include <ns3/traced-value.h>
 #include <ns3/nstime.h>
+#include <ns3/event-id.h>
 #include <ns3/satellite-mac.h>
 #include <ns3/satellite-phy.h>
 #include <ns3/satellite-queue.h>
@@ -35,6 +36,8 @@
 #include <ns3/satellite-enums.h>
 #include <utility>
 
+class SatUtMacDaTxTimelineTestCase;
+
 namespace ns3 {
 
 class Packet;
@@ -171,6 +174,14 @@ public:
    */
   uint32_t GetRaChannel () const;
 
+  /**
+   * Set assignment ID of this UT, which identifies the DA time slots of
+   * the UT in the received TBTPs.
+   *
+   * \param assignmentId Assignment ID given by NCC to this UT.
+   */
+  void SetAssignmentId (uint32_t assignmentId);
+
   /**
    * \brief Set the random access module
    * \param randomAccess
@@ -201,6 +212,11 @@ protected:
   void DoDispose (void);
 
 private:
+  /**
+   * The test case feeds TBTPs directly to the UT MAC to check the DA Tx timeline.
+   */
+  friend class ::SatUtMacDaTxTimelineTestCase;
+
   /**
    * \brief Get start time for the current superframe.
    * \param superFrameSeqId Superframe sequence id
@@ -304,15 +320,34 @@ private:
    */
   void ScheduleTimeSlots (Ptr<SatTbtpMessage> tbtp);
 
+  /**
+   * Dedicated access Tx opportunity waiting in the DA Tx timeline of the UT.
+   */
+  typedef struct
+  {
+    Time                                m_duration;
+    uint32_t                            m_carrierId;
+    Ptr<SatWaveform>                    m_waveform;
+    SatTimeSlotConf::SatTimeSlotType_t  m_slotType;
+    uint8_t                             m_rcIndex;
+  } DaTxOpportunity_t;
+
+  /**
+   * DA Tx opportunities by transmit time. Opportunities with the same
+   * transmit time are kept in the order they are scheduled.
+   */
+  typedef std::multimap<Time, DaTxOpportunity_t> DaTxOpportunityContainer_t;
+
   /**
    * Schdules one Tx opportunity, i.e. time slot.
    * \param transmitDelay time when transmit possibility starts
    * \param duration duration of the burst
    * \param wf waveform
-   * \param tsConf Time slot conf
+   * \param slotType Type of the time slot
+   * \param rcIndex RC index of the time slot
    * \param carrierId Carrier id used for the transmission
    */
-  void ScheduleDaTxOpportunity (Time transmitDelay, Time duration, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, uint32_t carrierId);
+  void ScheduleDaTxOpportunity (Time transmitDelay, Time duration, Ptr<SatWaveform> wf, SatTimeSlotConf::SatTimeSlotType_t slotType, uint8_t rcIndex, uint32_t carrierId);
 
   /**
    * Notify the upper layer about the Tx opportunity. If upper layer
@@ -321,10 +356,17 @@ private:
    * \param duration duration of the burst
    * \param carrierId Carrier id used for the transmission
    * \param wf waveform
-   * \param tsConf Time slot conf
+   * \param slotType Type of the time slot
+   * \param rcIndex RC index of the time slot
    * \param policy UT scheduler policy
    */
-  void DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, Ptr<SatTimeSlotConf> tsConf, SatUtScheduler::SatCompliancePolicy_t policy = SatUtScheduler::LOOSE);
+  void DoTransmit (Time duration, uint32_t carrierId, Ptr<SatWaveform> wf, SatTimeSlotConf::SatTimeSlotType_t slotType, uint8_t rcIndex, SatUtScheduler::SatCompliancePolicy_t policy = SatUtScheduler::LOOSE);
+
+  /**
+   * Transmit the DA Tx opportunities of the timeline, which are due at the
+   * current time, and schedule the timeline event to the next opportunity.
+   */
+  void DoDaTxTimeline ();
 
   /**
    * Notify the upper layer about the Slotted ALOHA Tx opportunity. If upper layer
@@ -397,6 +439,23 @@ private:
    */
   Time m_guardTime;
 
+  /**
+   * Flag to tell if the DA Tx opportunities are scheduled through the DA Tx
+   * timeline, i.e. with one pending simulator event per UT, instead of one
+   * simulator event per time slot.
+   */
+  bool m_daTxTimelineEnabled;
+
+  /**
+   * DA Tx opportunities waiting for transmission.
+   */
+  DaTxOpportunityContainer_t m_daTxOpportunities;
+
+  /**
+   * Event of the next due DA Tx opportunity in the timeline.
+   */
+  EventId m_daTxEvent;
+
   /**
    * Container for storing all the TBTP information related to this UT.
    */
@@ -417,6 +476,11 @@ private:
    */
   uint32_t m_raChannel;
 
+  /**
+   * Assignment ID of the UT in TBTPs.
+   */
+  uint32_t m_assignmentId;
+
   /**
    * UT scheduler
    */
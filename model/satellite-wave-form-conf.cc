@@ -25,6 +25,7 @@
 #include <limits>
 #include <utility>
 #include <map>
+#include <functional>
 #include <ns3/log.h>
 #include <ns3/double.h>
 #include <ns3/boolean.h>
@@ -162,7 +163,8 @@ SatWaveformConf::SatWaveformConf ()
     m_acmEnabled (false),
     m_defaultWfId (3),
     m_minWfId (0),
-    m_maxWfId (23)
+    m_maxWfId (23),
+    m_cnoThresholdTables ()
 {
   // default constructor should not be used
   NS_ASSERT (false);
@@ -175,7 +177,8 @@ SatWaveformConf::SatWaveformConf (std::string filePathName)
     m_acmEnabled (false),
     m_defaultWfId (3),
     m_minWfId (0),
-    m_maxWfId (23)
+    m_maxWfId (23),
+    m_cnoThresholdTables ()
 {
   NS_LOG_FUNCTION (this);
   ReadFromFile (filePathName);
@@ -197,7 +200,8 @@ SatWaveformConf::GetTypeId (void)
     .AddAttribute ( "AcmEnabled",
                     "Enable ACM",
                     BooleanValue (false),
-                    MakeBooleanAccessor (&SatWaveformConf::m_acmEnabled),
+                    MakeBooleanAccessor (&SatWaveformConf::SetAcmEnabled,
+                                         &SatWaveformConf::IsAcmEnabled),
                     MakeBooleanChecker ())
     .AddAttribute ( "DefaultWfId",
                     "Default waveform id",
@@ -309,9 +313,61 @@ void SatWaveformConf::InitializeEbNoRequirements ( Ptr<SatLinkResultsDvbRcs2> li
       double ebnoRequirementDb = linkResults->GetEbNoDb (it->first, m_targetBLER);
       it->second->SetEbNoRequirement (SatUtils::DbToLinear (ebnoRequirementDb));
     }
+
+  m_cnoThresholdTables.clear ();
 }
 
-Ptr<SatWaveform>
+void
+SatWaveformConf::SetAcmEnabled (bool enabled)
+{
+  NS_LOG_FUNCTION (this << enabled);
+
+  m_acmEnabled = enabled;
+  m_cnoThresholdTables.clear ();
+}
+
+void
+SatWaveformConf::PrepareCNoThresholdTable (double symbolRateInBaud, uint32_t burstLength)
+{
+  NS_LOG_FUNCTION (this << symbolRateInBaud << burstLength);
+
+  std::pair<CNoThresholdTableMap_t::iterator, bool> result =
+    m_cnoThresholdTables.insert (std::make_pair (std::make_pair (symbolRateInBaud, burstLength), CNoThresholdTable_t ()));
+
+  if (result.second)
+    {
+      CreateCNoThresholdTable (symbolRateInBaud, burstLength, result.first->second);
+    }
+}
+
+void
+SatWaveformConf::CreateCNoThresholdTable (double symbolRateInBaud, uint32_t burstLength, CNoThresholdTable_t& table) const
+{
+  NS_LOG_FUNCTION (this << symbolRateInBaud << burstLength);
+
+  // Walk the waveforms in the same order as the linear search and keep
+  // only the waveforms with threshold lower than any higher waveform id
+  double lowestThr = std::numeric_limits<double>::infinity ();
+
+  for ( std::map< uint32_t, Ptr<SatWaveform> >::const_reverse_iterator rit = m_waveforms.rbegin ();
+        rit != m_waveforms.rend ();
+        ++rit )
+    {
+      if (rit->second->GetBurstLengthInSymbols () == burstLength)
+        {
+          double cnoThr = rit->second->GetCNoThreshold (symbolRateInBaud);
+
+          if (cnoThr < lowestThr)
+            {
+              lowestThr = cnoThr;
+              table.m_cnoThresholds.push_back (cnoThr);
+              table.m_wfIds.push_back (rit->first);
+            }
+        }
+    }
+}
+
+const Ptr<SatWaveform>&
 SatWaveformConf::GetWaveform (uint32_t wfId) const
 {
   NS_LOG_FUNCTION (this << wfId);
@@ -352,22 +408,30 @@ SatWaveformConf::GetBestWaveformId (double cno, double symbolRateInBaud, uint32_
       return success;
     }
 
-  // Return the waveform with best spectral efficiency
-  for ( std::map< uint32_t, Ptr<SatWaveform> >::const_reverse_iterator rit = m_waveforms.rbegin ();
-        rit != m_waveforms.rend ();
-        ++rit )
+  // The lookup does not modify the configuration, since it may be done by several
+  // beam scheduling threads at once. A table not prepared beforehand is created
+  // for this lookup only.
+  CNoThresholdTableMap_t::const_iterator tableIt = m_cnoThresholdTables.find (std::make_pair (symbolRateInBaud, burstLength));
+  CNoThresholdTable_t createdTable;
+
+  if (tableIt == m_cnoThresholdTables.end ())
     {
-      if (rit->second->GetBurstLengthInSymbols () == burstLength)
-        {
-          double cnoThr = rit->second->GetCNoThreshold (symbolRateInBaud);
-          // The first waveform over the threshold
-          if (cnoThr <= cno)
-            {
-              wfId = rit->first;
-              success = true;
-              break;
-            }
-        }
+      CreateCNoThresholdTable (symbolRateInBaud, burstLength, createdTable);
+    }
+
+  const CNoThresholdTable_t& table = (tableIt != m_cnoThresholdTables.end ()) ? tableIt->second : createdTable;
+
+  // Return the waveform with best spectral efficiency, i.e. the first
+  // waveform in the table with threshold not exceeding the C/No
+  std::vector<double>::const_iterator it = std::lower_bound (table.m_cnoThresholds.begin (),
+                                                             table.m_cnoThresholds.end (),
+                                                             cno,
+                                                             std::greater<double> ());
+
+  if (it != table.m_cnoThresholds.end () && *it <= cno)
+    {
+      wfId = table.m_wfIds[it - table.m_cnoThresholds.begin ()];
+      success = true;
     }
 
   NS_LOG_INFO ("Get best waveform in RTN link (ACM)! CNo: " << SatUtils::LinearToDb(cno) << ", Symbol rate: " << symbolRateInBaud << ", burst length: " << burstLength << ", WF: " << wfId);
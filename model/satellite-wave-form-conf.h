@@ -22,6 +22,8 @@
 #define SATELLITE_WAVE_FORM_CONF_H
 
 #include <vector>
+#include <map>
+#include <utility>
 #include <ns3/nstime.h>
 #include <ns3/ptr.h>
 #include <ns3/simple-ref-count.h>
@@ -216,6 +218,13 @@ public:
     return m_acmEnabled;
   }
 
+  /**
+   * Enable or disable ACM. The precomputed C/No threshold tables are
+   * invalidated.
+   * \param enabled Is ACM enabled
+   */
+  void SetAcmEnabled (bool enabled);
+
   /**
    * \brief Initialize the Eb/No requirements of the waveforms based on
    * the used DVB-RCS2 link results.
@@ -228,7 +237,7 @@ public:
    * \param wfId Waveform id
    * \return SatWaveform holding all the details of a certain waveform
    */
-  Ptr<SatWaveform> GetWaveform (uint32_t wfId) const;
+  const Ptr<SatWaveform>& GetWaveform (uint32_t wfId) const;
 
   /**
    * \brief Get MODCOD enum corresponding to a waveform id
@@ -271,6 +280,17 @@ public:
    */
   bool GetBestWaveformId (double cno, double symbolRateInBaud, uint32_t& wfId, uint32_t burstLength = SHORT_BURST_LENGTH) const;
 
+  /**
+   * \brief Prepare the C/No threshold table used by GetBestWaveformId for a symbol
+   * rate and a burst length, if it is not prepared yet. GetBestWaveformId does not
+   * modify the configuration, thus it can be called concurrently, when the tables
+   * are prepared beforehand. Without a prepared table GetBestWaveformId creates a
+   * temporary table for every call.
+   * \param symbolRateInBaud Frame's symbol rate used for waveform C/No requirement calculation
+   * \param burstLength Burst length in symbols
+   */
+  void PrepareCNoThresholdTable (double symbolRateInBaud, uint32_t burstLength);
+
   /**
    * \brief Get the most robust waveform id based payload of the waveform in bytes
    * \param wfId Waveform id variable used for passing the best waveform id to the client
@@ -316,6 +336,32 @@ public:
   static const uint32_t LONG_BURST_LENGTH = 1616;
 
 private:
+  /**
+   * \brief C/No threshold table of one (symbol rate, burst length) pair. Only
+   * the waveforms which can be selected as the best waveform are included, in
+   * descending waveform id order. A waveform can be selected only if its
+   * threshold is lower than the thresholds of all the waveforms with higher
+   * ids, thus the thresholds are strictly descending.
+   */
+  typedef struct
+  {
+    std::vector<double> m_cnoThresholds;
+    std::vector<uint32_t> m_wfIds;
+  } CNoThresholdTable_t;
+
+  /**
+   * Define type for the threshold tables indexed by (symbol rate, burst length)
+   */
+  typedef std::map<std::pair<double, uint32_t>, CNoThresholdTable_t> CNoThresholdTableMap_t;
+
+  /**
+   * \brief Create the C/No threshold table for a symbol rate and a burst length.
+   * \param symbolRateInBaud Symbol rate
+   * \param burstLength Burst length in symbols
+   * \param table Created C/No threshold table
+   */
+  void CreateCNoThresholdTable (double symbolRateInBaud, uint32_t burstLength, CNoThresholdTable_t& table) const;
+
   /**
    * \brief Read the waveform table from a file
    * \param filePathName path and file name
@@ -364,6 +410,12 @@ private:
    * Container to store supported burst lengths.
    */
   BurstLengthContainer_t  m_supportedBurstLengthsInSymbols;
+
+  /**
+   * Precomputed C/No threshold tables used in the waveform selection. The
+   * tables are cleared when the Eb/No requirements or the ACM flag change.
+   */
+  CNoThresholdTableMap_t m_cnoThresholdTables;
 };
 
 } // namespace ns3
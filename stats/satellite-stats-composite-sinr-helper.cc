@@ -249,6 +249,30 @@ SatStatsCompositeSinrHelper::DoInstall ()
       break;
     }
 
+  // Resolve the collectors for the samples passed by callbacks.
+  switch (GetOutputType ())
+    {
+    case SatStatsHelper::OUTPUT_SCALAR_FILE:
+    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
+      CreateCollectorSinks (m_terminalCollectors,
+                            &ScalarCollector::TraceSinkDouble,
+                            m_terminalCollectorSinks);
+      break;
+
+    case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
+      CreateCollectorSinks (m_terminalCollectors,
+                            &UnitConversionCollector::TraceSinkDouble,
+                            m_terminalCollectorSinks);
+      break;
+
+    default:
+      CreateCollectorSinks (m_terminalCollectors,
+                            &DistributionCollector::TraceSinkDouble,
+                            m_terminalCollectorSinks);
+      break;
+    }
+
   // Setup probes and connect them to the collectors.
   InstallProbes ();
 
@@ -512,49 +536,11 @@ SatStatsRtnCompositeSinrHelper::SinrCallback (double sinrDb, const Address &from
         }
       else
         {
-          // Find the collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (it->second);
-          NS_ASSERT_MSG (collector != 0,
+          // Pass the sample to the collector with the right identifier.
+          NS_ASSERT_MSG (it->second < m_terminalCollectorSinks.size ()
+                         && !m_terminalCollectorSinks[it->second].IsNull (),
                          "Unable to find collector with identifier " << it->second);
-
-          switch (GetOutputType ())
-            {
-            case SatStatsHelper::OUTPUT_SCALAR_FILE:
-            case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-              {
-                Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
-                NS_ASSERT (c != 0);
-                c->TraceSinkDouble (0.0, sinrDb);
-                break;
-              }
-
-            case SatStatsHelper::OUTPUT_SCATTER_FILE:
-            case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-              {
-                Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-                NS_ASSERT (c != 0);
-                c->TraceSinkDouble (0.0, sinrDb);
-                break;
-              }
-
-            case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
-            case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-            case SatStatsHelper::OUTPUT_PDF_FILE:
-            case SatStatsHelper::OUTPUT_PDF_PLOT:
-            case SatStatsHelper::OUTPUT_CDF_FILE:
-            case SatStatsHelper::OUTPUT_CDF_PLOT:
-              {
-                Ptr<DistributionCollector> c = collector->GetObject<DistributionCollector> ();
-                NS_ASSERT (c != 0);
-                c->TraceSinkDouble (0.0, sinrDb);
-                break;
-              }
-
-            default:
-              NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-              break;
-
-            } // end of `switch (GetOutputType ())`
+          m_terminalCollectorSinks[it->second] (0.0, sinrDb);
 
         } // end of `if (it == m_identifierMap.end ())`
 
@@ -28,6 +28,7 @@
 #include <ns3/collector-map.h>
 #include <list>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -79,6 +80,9 @@ protected:
   /// Maintains a list of collectors created by this helper.
   CollectorMap m_terminalCollectors;
 
+  /// Trace sinks of the collectors, indexed by identifier.
+  std::vector<Callback<void, double, double> > m_terminalCollectorSinks;
+
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
@@ -197,7 +201,12 @@ private:
    */
   void SaveAddressAndIdentifier (Ptr<Node> utNode);
 
-  /// Map of address and the identifier associated with it (for return link).
+  /**
+   * \brief Map of address and the identifier associated with it (for return link).
+   *
+   * The RX carriers of the GW are shared by all the UTs of the beam, so the
+   * identifier is looked up by the sender address of each sample.
+   */
   std::map<const Address, uint32_t> m_identifierMap;
 
 }; // end of class SatStatsRtnCompositeSinrHelper
@@ -387,6 +387,39 @@ SatStatsDelayHelper::DoInstall ()
       break;
     }
 
+  // Resolve the collectors for the samples passed by callbacks.
+  switch (GetOutputType ())
+    {
+    case SatStatsHelper::OUTPUT_SCALAR_FILE:
+    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
+      CreateCollectorSinks (m_terminalCollectors,
+                            &ScalarCollector::TraceSinkDouble,
+                            m_terminalCollectorSinks);
+      break;
+
+    case SatStatsHelper::OUTPUT_SCATTER_FILE:
+    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
+      CreateCollectorSinks (m_terminalCollectors,
+                            &UnitConversionCollector::TraceSinkDouble,
+                            m_terminalCollectorSinks);
+      break;
+
+    default:
+      if (m_averagingMode)
+        {
+          CreateCollectorSinks (m_terminalCollectors,
+                                &ScalarCollector::TraceSinkDouble,
+                                m_terminalCollectorSinks);
+        }
+      else
+        {
+          CreateCollectorSinks (m_terminalCollectors,
+                                &DistributionCollector::TraceSinkDouble,
+                                m_terminalCollectorSinks);
+        }
+      break;
+    }
+
   // Setup probes and connect them to the collectors.
   InstallProbes ();
 
@@ -527,55 +560,11 @@ SatStatsDelayHelper::PassSampleToCollector (const Time &delay, uint32_t identifi
 {
   //NS_LOG_FUNCTION (this << delay.GetSeconds () << identifier);
 
-  Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (identifier);
-  NS_ASSERT_MSG (collector != 0,
+  NS_ASSERT_MSG (identifier < m_terminalCollectorSinks.size ()
+                 && !m_terminalCollectorSinks[identifier].IsNull (),
                  "Unable to find collector with identifier " << identifier);
 
-  switch (GetOutputType ())
-    {
-    case SatStatsHelper::OUTPUT_SCALAR_FILE:
-    case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-      {
-        Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
-        NS_ASSERT (c != 0);
-        c->TraceSinkDouble (0.0, delay.GetSeconds ());
-        break;
-      }
-
-    case SatStatsHelper::OUTPUT_SCATTER_FILE:
-    case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-      {
-        Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-        NS_ASSERT (c != 0);
-        c->TraceSinkDouble (0.0, delay.GetSeconds ());
-        break;
-      }
-
-    case SatStatsHelper::OUTPUT_HISTOGRAM_FILE:
-    case SatStatsHelper::OUTPUT_HISTOGRAM_PLOT:
-    case SatStatsHelper::OUTPUT_PDF_FILE:
-    case SatStatsHelper::OUTPUT_PDF_PLOT:
-    case SatStatsHelper::OUTPUT_CDF_FILE:
-    case SatStatsHelper::OUTPUT_CDF_PLOT:
-      if (m_averagingMode)
-        {
-          Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
-          NS_ASSERT (c != 0);
-          c->TraceSinkDouble (0.0, delay.GetSeconds ());
-        }
-      else
-        {
-          Ptr<DistributionCollector> c = collector->GetObject<DistributionCollector> ();
-          NS_ASSERT (c != 0);
-          c->TraceSinkDouble (0.0, delay.GetSeconds ());
-        }
-      break;
-
-    default:
-      NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-      break;
-
-    } // end of `switch (GetOutputType ())`
+  m_terminalCollectorSinks[identifier] (0.0, delay.GetSeconds ());
 
 } // end of `void PassSampleToCollector (Time, uint32_t)`
 
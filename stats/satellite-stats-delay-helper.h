@@ -28,6 +28,7 @@
 #include <ns3/collector-map.h>
 #include <list>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -129,13 +130,21 @@ protected:
   /// Maintains a list of collectors created by this helper.
   CollectorMap m_terminalCollectors;
 
+  /// Trace sinks of the collectors, indexed by identifier.
+  std::vector<Callback<void, double, double> > m_terminalCollectorSinks;
+
   /// The final collector utilized in averaged output (histogram, PDF, and CDF).
   Ptr<DistributionCollector> m_averagingCollector;
 
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
-  /// Map of address and the identifier associated with it (for return link).
+  /**
+   * \brief Map of address and the identifier associated with it (for return link).
+   *
+   * The delay samples of the return link are traced at the GW and carry the
+   * address of the sending UT, so the identifier is looked up per sample.
+   */
   std::map<const Address, uint32_t> m_identifierMap;
 
 private:
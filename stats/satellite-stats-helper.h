@@ -26,7 +26,11 @@
 #include <ns3/object.h>
 #include <ns3/attribute.h>
 #include <ns3/net-device-container.h>
+#include <ns3/assert.h>
+#include <ns3/callback.h>
+#include <ns3/collector-map.h>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -298,6 +302,41 @@ protected:
    */
   uint32_t CreateCollectorPerIdentifier (CollectorMap &collectorMap) const;
 
+  /**
+   * \brief Resolve the trace sinks of the collectors in a CollectorMap into
+   *        an array indexed by identifier.
+   * \param collectorMap the CollectorMap with collectors of type C.
+   * \param sink the trace sink method of C which receives the samples.
+   * \param sinks the array of sinks, where identifiers without a collector
+   *        have a null callback.
+   *
+   * The method is intended to be called once at install time, after
+   * CreateCollectorPerIdentifier(). Passing a sample to a collector is then
+   * a plain array access, instead of looking up the CollectorMap and the
+   * collector type for every sample.
+   */
+  template <typename C, typename T>
+  static void CreateCollectorSinks (CollectorMap &collectorMap,
+                                    void (C::*sink)(T, T),
+                                    std::vector<Callback<void, T, T> > &sinks)
+  {
+    sinks.clear ();
+
+    for (CollectorMap::Iterator it = collectorMap.Begin ();
+         it != collectorMap.End (); ++it)
+      {
+        Ptr<C> c = it->second->GetObject<C> ();
+        NS_ASSERT (c != 0);
+
+        if (it->first >= sinks.size ())
+          {
+            sinks.resize (it->first + 1);
+          }
+
+        sinks[it->first] = MakeCallback (sink, c);
+      }
+  }
+
   // IDENTIFIER RELATED METHODS ///////////////////////////////////////////////
 
   /**
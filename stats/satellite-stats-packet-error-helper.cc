@@ -223,6 +223,20 @@ SatStatsPacketErrorHelper::DoInstall ()
       break;
     }
 
+  // Resolve the collectors for the samples passed by callbacks.
+  if (GetOutputType () == SatStatsHelper::OUTPUT_SCALAR_FILE)
+    {
+      CreateCollectorSinks (m_terminalCollectors,
+                            &ScalarCollector::TraceSinkBoolean,
+                            m_terminalCollectorSinks);
+    }
+  else
+    {
+      CreateCollectorSinks (m_terminalCollectors,
+                            &IntervalRateCollector::TraceSinkBoolean,
+                            m_terminalCollectorSinks);
+    }
+
   switch (m_linkDirection)
     {
     case SatEnums::LD_FORWARD:
@@ -290,36 +304,11 @@ SatStatsPacketErrorHelper::ErrorRxCallback (uint32_t nPackets,
         }
       else
         {
-          // Find the first-level collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_terminalCollectors.Get (it->second);
-          NS_ASSERT_MSG (collector != 0,
+          // Pass the sample to the collector with the right identifier.
+          NS_ASSERT_MSG (it->second < m_terminalCollectorSinks.size ()
+                         && !m_terminalCollectorSinks[it->second].IsNull (),
                          "Unable to find collector with identifier " << it->second);
-
-          switch (GetOutputType ())
-            {
-            case SatStatsHelper::OUTPUT_SCALAR_FILE:
-            case SatStatsHelper::OUTPUT_SCALAR_PLOT:
-              {
-                Ptr<ScalarCollector> c = collector->GetObject<ScalarCollector> ();
-                NS_ASSERT (c != 0);
-                c->TraceSinkBoolean (false, isError);
-                break;
-              }
-
-            case SatStatsHelper::OUTPUT_SCATTER_FILE:
-            case SatStatsHelper::OUTPUT_SCATTER_PLOT:
-              {
-                Ptr<IntervalRateCollector> c = collector->GetObject<IntervalRateCollector> ();
-                NS_ASSERT (c != 0);
-                c->TraceSinkBoolean (false, isError);
-                break;
-              }
-
-            default:
-              NS_FATAL_ERROR (GetOutputTypeName (GetOutputType ()) << " is not a valid output type for this statistics.");
-              break;
-
-            } // end of `switch (GetOutputType ())`
+          m_terminalCollectorSinks[it->second] (false, isError);
 
         } // end of else of `if (it == m_identifierMap.end ())`
 
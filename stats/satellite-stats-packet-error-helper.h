@@ -29,6 +29,7 @@
 #include <ns3/address.h>
 #include <ns3/collector-map.h>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -140,10 +141,19 @@ private:
   /// Maintains a list of collectors created by this helper.
   CollectorMap m_terminalCollectors;
 
+  /// Trace sinks of the collectors, indexed by identifier (for return link).
+  std::vector<Callback<void, bool, bool> > m_terminalCollectorSinks;
+
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
-  /// Map of address and the identifier associated with it (for return link).
+  /**
+   * \brief Map of address and the identifier associated with it (for return link).
+   *
+   * Used by ErrorRxCallback, which is connected to the GW RX carriers
+   * receiving from all the UTs of the beam. The identifier depends on the
+   * sender address of each sample and cannot be bound at connect time.
+   */
   std::map<const Address, uint32_t> m_identifierMap;
 
   /// Name of trace source of PHY RX carrier to listen to.
@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "satellite-stats-replication-merger.h"
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+#include <dirent.h>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("SatStatsReplicationMerger");
+
+
+namespace ns3 {
+
+/**
+ * Two-sided 95% quantiles of Student's t-distribution for 1 to 30 degrees
+ * of freedom, the normal distribution quantile is used above them.
+ */
+static const double T_QUANTILES_95[30] = { 12.706, 4.303, 3.182, 2.776, 2.571,
+                                           2.447, 2.365, 2.306, 2.262, 2.228,
+                                           2.201, 2.179, 2.160, 2.145, 2.131,
+                                           2.120, 2.110, 2.101, 2.093, 2.086,
+                                           2.080, 2.074, 2.069, 2.064, 2.060,
+                                           2.056, 2.052, 2.048, 2.045, 2.042};
+
+
+SatStatsReplicationMerger::SatStatsReplicationMerger (std::string outputPath)
+  : m_outputPath (outputPath),
+    m_replicationPaths ()
+{
+  NS_LOG_FUNCTION (this << outputPath);
+}
+
+
+void
+SatStatsReplicationMerger::AddReplication (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+
+  m_replicationPaths.push_back (path);
+}
+
+
+uint32_t
+SatStatsReplicationMerger::Merge () const
+{
+  NS_LOG_FUNCTION (this);
+
+  // The replications may have written different sets of files
+  std::set<std::string> fileNames;
+
+  for (std::vector<std::string>::const_iterator it = m_replicationPaths.begin ();
+       it != m_replicationPaths.end (); ++it)
+    {
+      std::vector<std::string> files = GetStatFiles (*it);
+      fileNames.insert (files.begin (), files.end ());
+    }
+
+  for (std::set<std::string>::const_iterator it = fileNames.begin ();
+       it != fileNames.end (); ++it)
+    {
+      MergeStatFile (*it);
+    }
+
+  NS_LOG_INFO ("Merged " << fileNames.size () << " files of "
+                         << m_replicationPaths.size () << " replications");
+
+  return fileNames.size ();
+}
+
+
+double
+SatStatsReplicationMerger::GetConfidenceInterval (double stdDev, uint32_t n)
+{
+  if (n < 2)
+    {
+      return 0.0;
+    }
+
+  uint32_t degrees = n - 1;
+  double quantile = (degrees <= 30 ? T_QUANTILES_95[degrees - 1] : 1.96);
+
+  return quantile * stdDev / std::sqrt (static_cast<double> (n));
+}
+
+
+std::vector<std::string>
+SatStatsReplicationMerger::GetStatFiles (std::string path)
+{
+  std::vector<std::string> files;
+  DIR *dir = opendir (path.c_str ());
+
+  if (dir == NULL)
+    {
+      NS_LOG_WARN ("Unable to open replication directory " << path);
+      return files;
+    }
+
+  struct dirent *entry;
+
+  while ((entry = readdir (dir)) != NULL)
+    {
+      std::string name (entry->d_name);
+      std::string::size_type extension = name.rfind (".txt");
+
+      if (extension != std::string::npos && extension + 4 == name.size ()
+          && (name.find ("-scalar") != std::string::npos || name.find ("-cdf") != std::string::npos))
+        {
+          files.push_back (name);
+        }
+    }
+
+  closedir (dir);
+
+  return files;
+}
+
+
+bool
+SatStatsReplicationMerger::ReadStatFile (std::string fileName,
+                                         std::vector<std::string> &headings,
+                                         std::vector<Row_t> &rows)
+{
+  std::ifstream input (fileName.c_str ());
+
+  if (!input.is_open ())
+    {
+      return false;
+    }
+
+  std::string line;
+
+  while (std::getline (input, line))
+    {
+      if (line.empty ())
+        {
+          continue;
+        }
+
+      if (line[0] == '%')
+        {
+          headings.push_back (line);
+          continue;
+        }
+
+      std::istringstream iss (line);
+      Row_t row;
+
+      if (iss >> row.first >> row.second)
+        {
+          rows.push_back (row);
+        }
+    }
+
+  return true;
+}
+
+
+void
+SatStatsReplicationMerger::MergeStatFile (std::string fileName) const
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  /**
+   * Running mean and sum of squared deviations (Welford) of a row
+   */
+  typedef struct
+  {
+    uint32_t m_n;
+    double m_mean;
+    double m_m2;
+  } Accumulator_t;
+
+  std::vector<std::string> headings;
+  std::set<std::string> headingSet;
+  std::vector<std::string> keys;
+  std::map<std::string, Accumulator_t> accumulators;
+
+  for (std::vector<std::string>::const_iterator path = m_replicationPaths.begin ();
+       path != m_replicationPaths.end (); ++path)
+    {
+      std::vector<std::string> fileHeadings;
+      std::vector<Row_t> rows;
+
+      if (!ReadStatFile (*path + "/" + fileName, fileHeadings, rows))
+        {
+          continue;
+        }
+
+      // The heading lines of all the replications are kept in the order of
+      // their first appearance, without duplicates
+      for (std::vector<std::string>::const_iterator heading = fileHeadings.begin ();
+           heading != fileHeadings.end (); ++heading)
+        {
+          if (headingSet.insert (*heading).second)
+            {
+              headings.push_back (*heading);
+            }
+        }
+
+      for (std::vector<Row_t>::const_iterator row = rows.begin (); row != rows.end (); ++row)
+        {
+          std::map<std::string, Accumulator_t>::iterator it = accumulators.find (row->first);
+
+          if (it == accumulators.end ())
+            {
+              // Keep the rows in the order of their first appearance
+              Accumulator_t accumulator = { 0, 0.0, 0.0 };
+              it = accumulators.insert (std::make_pair (row->first, accumulator)).first;
+              keys.push_back (row->first);
+            }
+
+          Accumulator_t &accumulator = it->second;
+          double delta = row->second - accumulator.m_mean;
+          accumulator.m_n++;
+          accumulator.m_mean += delta / accumulator.m_n;
+          accumulator.m_m2 += delta * (row->second - accumulator.m_mean);
+        }
+    }
+
+  std::string outputFileName = m_outputPath + "/" + fileName;
+  std::ofstream output (outputFileName.c_str (), std::ios::out | std::ios::trunc);
+
+  if (!output.is_open ())
+    {
+      NS_FATAL_ERROR ("SatStatsReplicationMerger::MergeStatFile - Unable to open file: " << outputFileName);
+    }
+
+  for (std::vector<std::string>::const_iterator it = headings.begin (); it != headings.end (); ++it)
+    {
+      output << *it << std::endl;
+    }
+
+  output << "% merged over " << m_replicationPaths.size ()
+         << " replications: mean ci95_half_width replications" << std::endl;
+  output << std::setprecision (10);
+
+  for (std::vector<std::string>::const_iterator key = keys.begin (); key != keys.end (); ++key)
+    {
+      const Accumulator_t &accumulator = accumulators[*key];
+      double stdDev = (accumulator.m_n > 1 ? std::sqrt (accumulator.m_m2 / (accumulator.m_n - 1)) : 0.0);
+
+      output << *key << " "
+             << accumulator.m_mean << " "
+             << GetConfidenceInterval (stdDev, accumulator.m_n) << " "
+             << accumulator.m_n << std::endl;
+    }
+}
+
+} // namespace ns3
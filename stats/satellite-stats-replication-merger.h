@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SATELLITE_STATS_REPLICATION_MERGER_H
+#define SATELLITE_STATS_REPLICATION_MERGER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup satstats
+ * \brief Merges the statistics files of independent simulation replications.
+ *
+ * The scalar and CDF files (file names with `-scalar` or `-cdf` and `.txt`
+ * extension) written by SatStatsHelperContainer in the output directories of
+ * the replications are merged into files with the same names in the output
+ * directory of the merger. Each data row of the files is identified by its
+ * first column, i.e., the identifier of a scalar file and the value of a CDF
+ * file. A merged row contains the identifier, the mean of the second column
+ * over the replications, the half width of its 95% confidence interval and
+ * the number of replications having the row. The heading lines (starting
+ * with `%`) of all the replications are copied to the merged file once.
+ */
+class SatStatsReplicationMerger
+{
+public:
+  /**
+   * \brief Constructor
+   * \param outputPath Directory, where the merged files are written
+   */
+  SatStatsReplicationMerger (std::string outputPath);
+
+  /**
+   * \brief Add the output directory of a replication to be merged
+   * \param path Output directory of the replication
+   */
+  void AddReplication (std::string path);
+
+  /**
+   * \brief Merge the statistics files of the added replications
+   * \return number of merged files
+   */
+  uint32_t Merge () const;
+
+  /**
+   * \brief Get the half width of the 95% confidence interval of a mean
+   * \param stdDev Sample standard deviation
+   * \param n Number of samples
+   * \return half width of the confidence interval, zero for less than two samples
+   */
+  static double GetConfidenceInterval (double stdDev, uint32_t n);
+
+private:
+  /**
+   * \brief Data row of a statistics file, identifier and value
+   */
+  typedef std::pair<std::string, double> Row_t;
+
+  /**
+   * \brief Get the names of the mergeable statistics files in a directory
+   * \param path Directory
+   * \return file names without the directory
+   */
+  static std::vector<std::string> GetStatFiles (std::string path);
+
+  /**
+   * \brief Read a statistics file
+   * \param fileName Name of the file with the path
+   * \param headings Heading lines of the file
+   * \param rows Data rows of the file
+   * \return false if the file cannot be opened
+   */
+  static bool ReadStatFile (std::string fileName, std::vector<std::string> &headings, std::vector<Row_t> &rows);
+
+  /**
+   * \brief Merge a statistics file of the replications
+   * \param fileName Name of the file without the directory
+   */
+  void MergeStatFile (std::string fileName) const;
+
+  /**
+   * \brief Directory of the merged files
+   */
+  std::string m_outputPath;
+
+  /**
+   * \brief Output directories of the replications
+   */
+  std::vector<std::string> m_replicationPaths;
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_STATS_REPLICATION_MERGER_H */
@@ -368,6 +368,11 @@ SatStatsThroughputHelper::DoInstall ()
       break;
     }
 
+  // Resolve the first-level collectors for the samples passed by callbacks.
+  CreateCollectorSinks (m_conversionCollectors,
+                        &UnitConversionCollector::TraceSinkUinteger32,
+                        m_conversionCollectorSinks);
+
   // Setup probes and connect them to conversion collectors.
   InstallProbes ();
 
@@ -411,21 +416,25 @@ SatStatsThroughputHelper::RxCallback (Ptr<const Packet> packet,
         }
       else
         {
-          // Find the first-level collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it->second);
-          NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it->second);
-          Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-          NS_ASSERT (c != 0);
-
-          // Pass the sample to the collector.
-          c->TraceSinkUinteger32 (0, packet->GetSize ());
+          // Pass the sample to the first-level collector with the right identifier.
+          PassSampleToCollector (packet->GetSize (), it->second);
         }
     }
 
 } // end of `void RxCallback (Ptr<const Packet>, const Address);`
 
 
+void
+SatStatsThroughputHelper::PassSampleToCollector (uint32_t bytes, uint32_t identifier)
+{
+  NS_ASSERT_MSG (identifier < m_conversionCollectorSinks.size ()
+                 && !m_conversionCollectorSinks[identifier].IsNull (),
+                 "Unable to find collector with identifier " << identifier);
+
+  m_conversionCollectorSinks[identifier] (0, bytes);
+}
+
+
 void
 SatStatsThroughputHelper::SaveAddressAndIdentifier (Ptr<Node> utNode)
 {
@@ -939,15 +948,8 @@ SatStatsRtnAppThroughputHelper::Ipv4Callback (Ptr<const Packet> packet,
         }
       else
         {
-          // Find the collector with the right identifier.
-          Ptr<DataCollectionObject> collector = m_conversionCollectors.Get (it1->second);
-          NS_ASSERT_MSG (collector != 0,
-                         "Unable to find collector with identifier " << it1->second);
-          Ptr<UnitConversionCollector> c = collector->GetObject<UnitConversionCollector> ();
-          NS_ASSERT (c != 0);
-
-          // Pass the sample to the collector.
-          c->TraceSinkUinteger32 (0, packet->GetSize ());
+          // Pass the sample to the collector with the right identifier.
+          PassSampleToCollector (packet->GetSize (), it1->second);
         }
     }
   else
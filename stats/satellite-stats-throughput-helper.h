@@ -28,6 +28,7 @@
 #include <ns3/collector-map.h>
 #include <list>
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -111,9 +112,19 @@ protected:
    */
   void SaveAddressAndIdentifier (Ptr<Node> utNode);
 
+  /**
+   * \brief Pass a sample to the first-level collector of an identifier.
+   * \param bytes size of the received packet.
+   * \param identifier the identifier of the collector.
+   */
+  void PassSampleToCollector (uint32_t bytes, uint32_t identifier);
+
   /// Maintains a list of first-level collectors created by this helper.
   CollectorMap m_conversionCollectors;
 
+  /// Trace sinks of the first-level collectors, indexed by identifier.
+  std::vector<Callback<void, uint32_t, uint32_t> > m_conversionCollectorSinks;
+
   /// Maintains a list of second-level collectors created by this helper.
   CollectorMap m_terminalCollectors;
 
@@ -123,7 +134,14 @@ protected:
   /// The aggregator created by this helper.
   Ptr<DataCollectionObject> m_aggregator;
 
-  /// Map of address and the identifier associated with it (for return link).
+  /**
+   * \brief Map of address and the identifier associated with it (for return link).
+   *
+   * The return link trace sources are at the GW, where one trace source
+   * receives the packets of all the UTs of the beam. The sender is known
+   * only from the address of each packet, hence the identifier is looked up
+   * per sample instead of being bound to the callback at connect time.
+   */
   std::map<const Address, uint32_t> m_identifierMap;
 
 private:
@@ -15,11 +15,14 @@ cpp_examples = [
 	("sat-cbr-full-example", "True", "True"),
 	("sat-cbr-stats-example", "True", "True"),
 	("sat-cbr-user-defined-example", "True", "True"),
+	("sat-crdsa-sic-benchmark --maxBursts=4000", "True", "False"),
 	("sat-dama-http-sim-tn9", "True", "True"),
 	("sat-dama-onoff-sim-tn9", "True", "True"),
 	("sat-dama-sim-tn9", "True", "True"),
 	("sat-dama-verification-sim", "True", "True"),
 	("sat-environmental-variables-example", "True", "True"),
+	("sat-fading-oscillator-benchmark", "True", "False"),
+	("sat-frame-allocator-benchmark", "True", "False"),
 	("sat-fwd-system-test-example", "True", "True"),
 	("sat-http-example", "True", "True"),
 	("sat-link-budget-example", "True", "True"),
@@ -27,6 +30,7 @@ cpp_examples = [
 	("sat-list-position-ext-fading-example", "True", "True"),
 	("sat-log-example", "True", "True"),
 	("sat-loo-example", "True", "True"),
+	("sat-look-up-table-benchmark", "True", "False"),
 	("sat-markov-fading-trace-example", "True", "True"),
 	("sat-markov-logic-example", "True", "True"),
 	("sat-multi-application-fwd-example", "True", "True"),
@@ -46,6 +50,7 @@ cpp_examples = [
 	("sat-ra-sim-tn9-comparison", "True", "True"),
 	("sat-rayleigh-example", "True", "True"),
 	("sat-rtn-system-test-example", "True", "True"),
+	("sat-scenario-creation-benchmark", "True", "False"),
 	("sat-trace-input-external-fading-example", "True", "True"),
 	("sat-trace-input-fading-example", "True", "True"),
 	("sat-trace-input-interference-example", "True", "True"),
@@ -53,6 +58,7 @@ cpp_examples = [
 	("sat-trace-output-example", "True", "True"),
 	("sat-training-example", "True", "True"),
 	("sat-tutorial-example", "True", "True"),
+	("sat-ut-da-tx-benchmark", "True", "False"),
 ]
 
 # A list of Python examples to run in order to ensure that they remain
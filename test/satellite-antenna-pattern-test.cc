@@ -18,6 +18,9 @@
  * Author: Jani Puttonen <jani.puttonen@magister.fi>
  */
 
+#include <cmath>
+#include <limits>
+#include <vector>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
@@ -120,6 +123,193 @@ SatAntennaPatternTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case comparing the antenna gains of all the beams calculated by
+ * SatAntennaGainPatternContainer in one pass to the gains calculated by the
+ * antenna gain patterns of the beams one by one. The best beam id is checked
+ * against the best gain of the beams in the positions, where all the beams
+ * have a valid gain. The test positions are random positions within the
+ * coverage of every beam.
+ */
+class SatAntennaPatternBeamGainsTestCase : public TestCase
+{
+public:
+  SatAntennaPatternBeamGainsTestCase ();
+  virtual ~SatAntennaPatternBeamGainsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatAntennaPatternBeamGainsTestCase::SatAntennaPatternBeamGainsTestCase ()
+  : TestCase ("Test antenna gains of all the beams against the antenna gain patterns.")
+{
+}
+
+SatAntennaPatternBeamGainsTestCase::~SatAntennaPatternBeamGainsTestCase ()
+{
+}
+
+void
+SatAntennaPatternBeamGainsTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-antenna-gain-pattern-beam-gains", "", true);
+
+  const uint32_t beams = 72;
+  const uint32_t positionsPerBeam = 10;
+
+  SatAntennaGainPatternContainer gpContainer;
+  std::vector<double> gains;
+  uint32_t checkedBestBeams (0);
+
+  for (uint32_t beamId = 1; beamId <= beams; ++beamId)
+    {
+      for (uint32_t i = 0; i < positionsPerBeam; ++i)
+        {
+          GeoCoordinate coord = gpContainer.GetAntennaGainPattern (beamId)->GetValidRandomPosition ();
+          gpContainer.GetAntennaGains_lin (coord, gains);
+
+          NS_TEST_ASSERT_MSG_EQ (gains.size (), beams, "Unexpected number of antenna gains");
+
+          bool allValid (true);
+          double bestGain (-100.0);
+          uint32_t bestBeamId (0);
+
+          for (uint32_t b = 1; b <= beams; ++b)
+            {
+              Ptr<SatAntennaGainPattern> pattern = gpContainer.GetAntennaGainPattern (b);
+              double gain = pattern->GetAntennaGain_lin (pattern->GetGridPosition (coord));
+
+              if (std::isnan (gain))
+                {
+                  NS_TEST_ASSERT_MSG_EQ (std::isnan (gains[b - 1]), true, "Antenna gain of beam " << b << " not NaN");
+                  allValid = false;
+                  continue;
+                }
+
+              NS_TEST_ASSERT_MSG_EQ (gains[b - 1], gain, "Antenna gain of beam " << b << " differs");
+
+              if (gain > bestGain)
+                {
+                  bestGain = gain;
+                  bestBeamId = b;
+                }
+            }
+
+          // The own beam has always a valid gain in its valid positions
+          NS_TEST_ASSERT_MSG_EQ (std::isnan (gains[beamId - 1]), false, "Antenna gain of the own beam is NaN");
+
+          if (allValid)
+            {
+              NS_TEST_ASSERT_MSG_EQ (gpContainer.GetBestBeamId (coord), bestBeamId, "Not expected best spot-beam id");
+              checkedBestBeams++;
+            }
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_GT (checkedBestBeams, 0, "No positions with valid gains of all the beams");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case checking the beam couplings of SatAntennaGainPatternContainer
+ * against the antenna gains in the grid points of the antenna patterns. In every
+ * grid point, the gain of a beam relative to the gain of the best beam shall not
+ * exceed the coupling of the best beam and the beam. The coupling of a beam with
+ * itself shall be one.
+ */
+class SatAntennaPatternBeamCouplingTestCase : public TestCase
+{
+public:
+  SatAntennaPatternBeamCouplingTestCase ();
+  virtual ~SatAntennaPatternBeamCouplingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatAntennaPatternBeamCouplingTestCase::SatAntennaPatternBeamCouplingTestCase ()
+  : TestCase ("Test beam couplings against the antenna gains of the grid points.")
+{
+}
+
+SatAntennaPatternBeamCouplingTestCase::~SatAntennaPatternBeamCouplingTestCase ()
+{
+}
+
+void
+SatAntennaPatternBeamCouplingTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-antenna-gain-pattern-beam-coupling", "", true);
+
+  const uint32_t beams = 72;
+
+  SatAntennaGainPatternContainer gpContainer;
+  std::vector<uint32_t> coverageBeams;
+
+  for (uint32_t beamId = 1; beamId <= beams; ++beamId)
+    {
+      NS_TEST_ASSERT_MSG_EQ (gpContainer.GetBeamCoupling_lin (beamId, beamId), 1.0, "Coupling of beam " << beamId << " with itself is not one");
+    }
+
+  Ptr<SatAntennaGainPattern> firstPattern = gpContainer.GetAntennaGainPattern (1);
+  uint32_t nLat = firstPattern->GetNLatitudes ();
+  uint32_t nLon = firstPattern->GetNLongitudes ();
+  uint32_t checkedPoints (0);
+  std::vector<double> gains (beams);
+
+  for (uint32_t lat = 0; lat < nLat; ++lat)
+    {
+      for (uint32_t lon = 0; lon < nLon; ++lon)
+        {
+          double bestGain (-std::numeric_limits<double>::infinity ());
+          uint32_t bestBeamId (0);
+
+          for (uint32_t b = 1; b <= beams; ++b)
+            {
+              gains[b - 1] = gpContainer.GetAntennaGainPattern (b)->GetGridAntennaGain_db (lat, lon);
+
+              if (!std::isnan (gains[b - 1]) && gains[b - 1] > bestGain)
+                {
+                  bestGain = gains[b - 1];
+                  bestBeamId = b;
+                }
+            }
+
+          if (bestBeamId == 0)
+            {
+              continue;
+            }
+
+          for (uint32_t b = 1; b <= beams; ++b)
+            {
+              if (std::isnan (gains[b - 1]))
+                {
+                  continue;
+                }
+
+              // The gains of the grid are stored with float precision
+              double coupling_db = 10.0 * log10 (gpContainer.GetBeamCoupling_lin (bestBeamId, b));
+              NS_TEST_ASSERT_MSG_LT_OR_EQ (gains[b - 1] - bestGain, coupling_db + 0.001,
+                                           "Gain of beam " << b << " exceeds its coupling to beam " << bestBeamId);
+            }
+
+          checkedPoints++;
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_GT (checkedPoints, 0, "No grid points with valid gains");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 /**
  * \ingroup satellite
  * \brief Satellite antenna pattern test suite
@@ -134,6 +324,8 @@ SatAntennaPatternTestSuite::SatAntennaPatternTestSuite ()
   : TestSuite ("sat-antenna-gain-pattern-test", UNIT)
 {
   AddTestCase (new SatAntennaPatternTestCase, TestCase::QUICK);
+  AddTestCase (new SatAntennaPatternBeamGainsTestCase, TestCase::QUICK);
+  AddTestCase (new SatAntennaPatternBeamCouplingTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
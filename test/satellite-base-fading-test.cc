@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-base-fading-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the coherence cache of the fading models.
+ */
+
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "../model/satellite-base-fading.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Fading model returning a new value on every evaluation, 1, 2, 3 and so on.
+ */
+class SatCountingFading : public SatBaseFading
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::SatCountingFading")
+      .SetParent<SatBaseFading> ()
+      .AddConstructor<SatCountingFading> ();
+    return tid;
+  }
+
+  SatCountingFading ()
+    : m_evaluations (0)
+  {
+  }
+
+  virtual double DoGetFading (Address macAddress, SatEnums::ChannelType_t channelType)
+  {
+    return ++m_evaluations;
+  }
+
+private:
+  uint32_t m_evaluations;
+};
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the coherence cache of the fading values.
+ *
+ * The fading values of a fading model returning a new value on every
+ * evaluation are requested at different times with a 10 ms coherence interval.
+ *
+ *   1.  Get the fading of a MAC address three times within a coherence interval.
+ *   2.  Get the fading of another MAC address and another channel type within the interval.
+ *   3.  Get the fading of the first MAC address at the start of the next interval.
+ *   4.  Get the fading of the first MAC address with the cache disabled.
+ *
+ *   Expected result:
+ *     The values within the coherence interval are identical per MAC address
+ *     and channel type. A fresh value is evaluated in the next interval and
+ *     on every request with the cache disabled. The cache hits and misses
+ *     match the requests.
+ *
+ */
+class SatBaseFadingCoherenceCacheTestCase : public TestCase
+{
+public:
+  SatBaseFadingCoherenceCacheTestCase ();
+  virtual ~SatBaseFadingCoherenceCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Get and store a fading value
+   * \param fading Fading model
+   * \param macAddress MAC address
+   * \param channelType Channel type
+   */
+  void GetFading (Ptr<SatBaseFading> fading, Mac48Address macAddress, SatEnums::ChannelType_t channelType);
+
+  std::vector<double> m_fadingValues;
+};
+
+SatBaseFadingCoherenceCacheTestCase::SatBaseFadingCoherenceCacheTestCase ()
+  : TestCase ("Test the coherence cache of the fading values.")
+{
+}
+
+SatBaseFadingCoherenceCacheTestCase::~SatBaseFadingCoherenceCacheTestCase ()
+{
+}
+
+void
+SatBaseFadingCoherenceCacheTestCase::GetFading (Ptr<SatBaseFading> fading, Mac48Address macAddress, SatEnums::ChannelType_t channelType)
+{
+  m_fadingValues.push_back (fading->GetFading (macAddress, channelType));
+}
+
+void
+SatBaseFadingCoherenceCacheTestCase::DoRun (void)
+{
+  Ptr<SatBaseFading> fading = CreateObject<SatCountingFading> ();
+  fading->SetAttribute ("EnableCoherenceCache", BooleanValue (true));
+  fading->SetAttribute ("CoherenceInterval", TimeValue (MilliSeconds (10)));
+
+  Ptr<SatBaseFading> uncachedFading = CreateObject<SatCountingFading> ();
+
+  Mac48Address first ("00:00:00:00:00:01");
+  Mac48Address second ("00:00:00:00:00:02");
+
+  // within the interval [10 ms, 20 ms)
+  Simulator::Schedule (MicroSeconds (10000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, first, SatEnums::FORWARD_USER_CH);
+  Simulator::Schedule (MicroSeconds (15000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, first, SatEnums::FORWARD_USER_CH);
+  Simulator::Schedule (MicroSeconds (15000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, second, SatEnums::FORWARD_USER_CH);
+  Simulator::Schedule (MicroSeconds (15000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, first, SatEnums::RETURN_USER_CH);
+  Simulator::Schedule (MicroSeconds (19999), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, first, SatEnums::FORWARD_USER_CH);
+
+  // next interval [20 ms, 30 ms)
+  Simulator::Schedule (MicroSeconds (20000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, first, SatEnums::FORWARD_USER_CH);
+  Simulator::Schedule (MicroSeconds (25000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, fading, first, SatEnums::FORWARD_USER_CH);
+
+  // cache disabled
+  Simulator::Schedule (MicroSeconds (26000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, uncachedFading, first, SatEnums::FORWARD_USER_CH);
+  Simulator::Schedule (MicroSeconds (26000), &SatBaseFadingCoherenceCacheTestCase::GetFading, this, uncachedFading, first, SatEnums::FORWARD_USER_CH);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues.size (), 9, "Fading value count incorrect");
+
+  // the values are evaluated in the order 1, 2, 3 for the first interval and 4 for the second
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[0], 1.0, "First fading value incorrect");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[1], 1.0, "Fading value changed within the coherence interval");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[2], 2.0, "Fading value of another MAC address not evaluated");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[3], 3.0, "Fading value of another channel type not evaluated");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[4], 1.0, "Fading value changed at the end of the coherence interval");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[5], 4.0, "Fading value not evaluated in the next coherence interval");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[6], 4.0, "Fading value changed within the next coherence interval");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[7], 1.0, "Fading value with the cache disabled incorrect");
+  NS_TEST_ASSERT_MSG_EQ (m_fadingValues[8], 2.0, "Fading value reused with the cache disabled");
+
+  NS_TEST_ASSERT_MSG_EQ (fading->GetNCoherenceCacheHits (), 3, "Coherence cache hits incorrect");
+  NS_TEST_ASSERT_MSG_EQ (fading->GetNCoherenceCacheMisses (), 4, "Coherence cache misses incorrect");
+  NS_TEST_ASSERT_MSG_EQ (uncachedFading->GetNCoherenceCacheHits (), 0, "Coherence cache hits with the cache disabled");
+  NS_TEST_ASSERT_MSG_EQ (uncachedFading->GetNCoherenceCacheMisses (), 0, "Coherence cache misses with the cache disabled");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the fading base class.
+ */
+class SatBaseFadingTestSuite : public TestSuite
+{
+public:
+  SatBaseFadingTestSuite ();
+};
+
+SatBaseFadingTestSuite::SatBaseFadingTestSuite ()
+  : TestSuite ("sat-base-fading", UNIT)
+{
+  AddTestCase (new SatBaseFadingCoherenceCacheTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatBaseFadingTestSuite satBaseFadingTestSuite;
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-beam-scheduler-test.cc
+ * \ingroup satellite
+ * \brief Test cases for the beam scheduling of the NCC.
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/singleton.h"
+#include "ns3/applications-module.h"
+#include "ns3/satellite-module.h"
+#include "ns3/traffic-module.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the resource allocations of the beams do not
+ * depend on the number of beam scheduling threads.
+ *
+ *  1.  Return link CBR traffic is simulated in three beams with the allocation
+ *      random variable streams of the beams and one beam scheduling thread.
+ *  2.  Same simulation is run again with four beam scheduling threads.
+ *
+ *  Expected result:
+ *    • Same return link bursts (time, beam, carrier and waveform) received by the GW
+ *      in the same order in both runs.
+ *    • Same bytes received by the GW user.
+ */
+class SatBeamSchedulerThreadsTestCase : public TestCase
+{
+public:
+  SatBeamSchedulerThreadsTestCase ();
+  virtual ~SatBeamSchedulerThreadsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Run the simulation
+   * \param threads Number of the beam scheduling threads
+   * \param rxBytes Variable to store the bytes received by the GW user
+   * \return Time, beam, carrier and waveform of the bursts received by the GW
+   */
+  std::vector<double> RunSimulation (uint32_t threads, uint64_t& rxBytes);
+
+  /**
+   * \brief Store a burst received by the GW
+   */
+  void LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                          Mac48Address ownAdd, Mac48Address destAdd,
+                          double ifPower, double cSinr);
+
+  std::vector<double> m_bursts;
+};
+
+SatBeamSchedulerThreadsTestCase::SatBeamSchedulerThreadsTestCase ()
+  : TestCase ("Test identical allocations with one and several beam scheduling threads")
+{
+}
+
+SatBeamSchedulerThreadsTestCase::~SatBeamSchedulerThreadsTestCase ()
+{
+}
+
+void
+SatBeamSchedulerThreadsTestCase::LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                                                    Mac48Address ownAdd, Mac48Address destAdd,
+                                                    double ifPower, double cSinr)
+{
+  if (params->m_channelType == SatEnums::RETURN_FEEDER_CH)
+    {
+      m_bursts.push_back (Simulator::Now ().GetSeconds ());
+      m_bursts.push_back (params->m_beamId);
+      m_bursts.push_back (params->m_carrierId);
+      m_bursts.push_back (params->m_txInfo.waveformId);
+    }
+}
+
+std::vector<double>
+SatBeamSchedulerThreadsTestCase::RunSimulation (uint32_t threads, uint64_t& rxBytes)
+{
+  // Reset singletons and the random variable streams, so that both
+  // simulations use the same streams
+  Singleton<SatIdMapper>::Get ()->Reset ();
+  RngSeedManager::ResetNextStreamIndex ();
+  m_bursts.clear ();
+
+  Config::SetDefault ("ns3::SatNcc::BeamSchedulingThreads", UintegerValue (threads));
+  Config::SetDefault ("ns3::SatNcc::BeamAllocationStreams", BooleanValue (true));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  SatBeamUserInfo beamInfo = SatBeamUserInfo (5,1);
+  std::map<uint32_t, SatBeamUserInfo > beamMap;
+  beamMap[1] = beamInfo;
+  beamMap[2] = beamInfo;
+  beamMap[3] = beamInfo;
+
+  helper->CreateUserDefinedScenario (beamMap);
+
+  Config::Connect ("/NodeList/*/DeviceList/*/SatPhy/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatBeamSchedulerThreadsTestCase::LinkBudgetTraceCb, this));
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  uint16_t port = 9;
+
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (3.0));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("10ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (256));
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+  cbrs.Start (Seconds (0.5));
+  cbrs.Stop (Seconds (2.5));
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+
+  rxBytes = DynamicCast<PacketSink> (sinks.Get (0))->GetTotalRx ();
+
+  helper = NULL;
+  Simulator::Destroy ();
+
+  return m_bursts;
+}
+
+void
+SatBeamSchedulerThreadsTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-beam-scheduler", "threads", true);
+
+  uint64_t rxBytes (0);
+  uint64_t threadedRxBytes (0);
+
+  std::vector<double> bursts = RunSimulation (1, rxBytes);
+  std::vector<double> threadedBursts = RunSimulation (4, threadedRxBytes);
+
+  NS_TEST_ASSERT_MSG_GT (rxBytes, 0, "Nothing received!");
+  NS_TEST_ASSERT_MSG_GT (bursts.size (), 0, "No bursts received!");
+  NS_TEST_ASSERT_MSG_EQ (threadedRxBytes, rxBytes, "Received bytes are not what expected!");
+  NS_TEST_ASSERT_MSG_EQ (threadedBursts.size (), bursts.size (), "Received burst count is not what expected!");
+
+  for (uint32_t i = 0; i < bursts.size () && i < threadedBursts.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (threadedBursts[i], bursts[i], "Received burst value " << i << " is not what expected!");
+    }
+
+  Config::SetDefault ("ns3::SatNcc::BeamSchedulingThreads", UintegerValue (1));
+  Config::SetDefault ("ns3::SatNcc::BeamAllocationStreams", BooleanValue (false));
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the beam scheduling.
+ */
+class SatBeamSchedulerTestSuite : public TestSuite
+{
+public:
+  SatBeamSchedulerTestSuite ();
+};
+
+SatBeamSchedulerTestSuite::SatBeamSchedulerTestSuite ()
+  : TestSuite ("sat-beam-scheduler", SYSTEM)
+{
+  AddTestCase (new SatBeamSchedulerThreadsTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatBeamSchedulerTestSuite satBeamSchedulerTestSuite;
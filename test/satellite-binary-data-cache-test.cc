@@ -0,0 +1,372 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-binary-data-cache-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the binary data cache.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <utime.h>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/singleton.h"
+#include "../model/satellite-look-up-table.h"
+#include "../model/satellite-antenna-gain-pattern.h"
+#include "../model/geo-coordinate.h"
+#include "../utils/satellite-binary-data-cache.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the data stored to the binary cache of a
+ * source file is read back as such and that the cache is rejected, when the
+ * source file or the type of the data changes or the cache is disabled.
+ *
+ * 1. Write a source file and store its binary cache in a cache directory.
+ * 2. Open the cache and compare the parameters and the values to the stored ones.
+ * 3. Open the cache with another data type, which shall fail.
+ * 4. Change the modification time of the source file, which shall invalidate the cache.
+ * 5. Store the cache again, rewrite the source file in place with the same size
+ *    and restore its modification time, which shall invalidate the cache.
+ * 6. Disable the cache, after which the cache is neither stored nor opened.
+ */
+class SatBinaryDataCacheRoundTripTestCase : public TestCase
+{
+public:
+  SatBinaryDataCacheRoundTripTestCase ();
+  virtual ~SatBinaryDataCacheRoundTripTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBinaryDataCacheRoundTripTestCase::SatBinaryDataCacheRoundTripTestCase ()
+  : TestCase ("Test binary data cache round trip.")
+{
+}
+
+SatBinaryDataCacheRoundTripTestCase::~SatBinaryDataCacheRoundTripTestCase ()
+{
+}
+
+void
+SatBinaryDataCacheRoundTripTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("EnableBinaryDataCache", BooleanValue (true));
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("BinaryDataCacheDirectory", StringValue (CreateTempDirFilename ("cache")));
+
+  std::string sourcePath = CreateTempDirFilename ("sat-binary-data-cache-source.txt");
+  std::ofstream source (sourcePath.c_str ());
+  source << "1.0 2.0 3.0" << std::endl;
+  source.close ();
+
+  std::vector<double> params;
+  params.push_back (3.0);
+  params.push_back (-0.5);
+
+  std::vector<double> values;
+
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      values.push_back (i * 0.001 - 0.25);
+    }
+
+  bool stored = SatBinaryDataCache::Store (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS, params, values);
+  NS_TEST_ASSERT_MSG_EQ (stored, true, "Binary cache not stored");
+
+  Ptr<SatBinaryDataCache> cache = SatBinaryDataCache::Open (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+  NS_TEST_ASSERT_MSG_EQ ((cache != NULL), true, "Binary cache not opened");
+  NS_TEST_ASSERT_MSG_EQ (cache->GetNParams (), params.size (), "Unexpected number of parameters");
+  NS_TEST_ASSERT_MSG_EQ (cache->GetNValues (), values.size (), "Unexpected number of values");
+
+  for (uint32_t i = 0; i < params.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cache->GetParams ()[i], params[i], "Parameter " << i << " differs");
+    }
+
+  for (uint32_t i = 0; i < values.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cache->GetValues ()[i], values[i], "Value " << i << " differs");
+    }
+
+  cache = 0;
+
+  cache = SatBinaryDataCache::Open (sourcePath, SatBinaryDataCache::CACHE_ANTENNA_PATTERN);
+  NS_TEST_ASSERT_MSG_EQ ((cache == NULL), true, "Binary cache opened with another data type");
+
+  // Same size, but a different modification time
+  struct stat st;
+  NS_TEST_ASSERT_MSG_EQ (stat (sourcePath.c_str (), &st), 0, "Source file not found");
+
+  struct utimbuf times;
+  times.actime = st.st_atime;
+  times.modtime = st.st_mtime + 10;
+  utime (sourcePath.c_str (), &times);
+
+  cache = SatBinaryDataCache::Open (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+  NS_TEST_ASSERT_MSG_EQ ((cache == NULL), true, "Binary cache of a modified source file opened");
+
+  // Same size and modification time, but different contents
+  stored = SatBinaryDataCache::Store (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS, params, values);
+  NS_TEST_ASSERT_MSG_EQ (stored, true, "Binary cache not stored again");
+
+  cache = SatBinaryDataCache::Open (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+  NS_TEST_ASSERT_MSG_EQ ((cache != NULL), true, "Binary cache not opened again");
+  cache = 0;
+
+  NS_TEST_ASSERT_MSG_EQ (stat (sourcePath.c_str (), &st), 0, "Source file not found");
+
+  source.open (sourcePath.c_str ());
+  source << "4.0 5.0 6.0" << std::endl;
+  source.close ();
+
+  struct timespec restoredTimes[2] = { st.st_atim, st.st_mtim };
+  NS_TEST_ASSERT_MSG_EQ (utimensat (AT_FDCWD, sourcePath.c_str (), restoredTimes, 0), 0, "Modification time not restored");
+
+  cache = SatBinaryDataCache::Open (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+  NS_TEST_ASSERT_MSG_EQ ((cache == NULL), true, "Binary cache of a rewritten source file opened");
+
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("EnableBinaryDataCache", BooleanValue (false));
+
+  stored = SatBinaryDataCache::Store (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS, params, values);
+  NS_TEST_ASSERT_MSG_EQ (stored, false, "Binary cache stored while disabled");
+
+  cache = SatBinaryDataCache::Open (sourcePath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+  NS_TEST_ASSERT_MSG_EQ ((cache == NULL), true, "Binary cache opened while disabled");
+
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("BinaryDataCacheDirectory", StringValue (""));
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that a look-up table using the binary cache of a
+ * link result file gives the same BLER and Es/No values as a look-up table
+ * reading the link result file.
+ */
+class SatBinaryDataCacheLookUpTableTestCase : public TestCase
+{
+public:
+  SatBinaryDataCacheLookUpTableTestCase ();
+  virtual ~SatBinaryDataCacheLookUpTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBinaryDataCacheLookUpTableTestCase::SatBinaryDataCacheLookUpTableTestCase ()
+  : TestCase ("Test look-up table from binary data cache.")
+{
+}
+
+SatBinaryDataCacheLookUpTableTestCase::~SatBinaryDataCacheLookUpTableTestCase ()
+{
+}
+
+void
+SatBinaryDataCacheLookUpTableTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("EnableBinaryDataCache", BooleanValue (true));
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("BinaryDataCacheDirectory", StringValue (CreateTempDirFilename ("cache")));
+
+  std::string linkResultPath = CreateTempDirFilename ("sat-binary-data-cache-link-results.txt");
+  std::ofstream linkResults (linkResultPath.c_str ());
+
+  // Es/No values with a non-constant step
+  double bler = 1.0;
+
+  for (uint32_t i = 0; i < 40; ++i)
+    {
+      linkResults << (-3.0 + i * 0.1 + (i % 3) * 0.01) << " " << bler << std::endl;
+      bler *= 0.8;
+    }
+
+  linkResults.close ();
+
+  // The first table reads the file and stores the cache, the second one uses the cache
+  Ptr<SatLookUpTable> fileTable = CreateObject<SatLookUpTable> (linkResultPath);
+
+  Ptr<SatBinaryDataCache> cache = SatBinaryDataCache::Open (linkResultPath, SatBinaryDataCache::CACHE_LINK_RESULTS);
+  NS_TEST_ASSERT_MSG_EQ ((cache != NULL), true, "Binary cache of link results not stored");
+  cache = 0;
+
+  Ptr<SatLookUpTable> cacheTable = CreateObject<SatLookUpTable> (linkResultPath);
+
+  for (double esNoDb = -4.0; esNoDb < 2.0; esNoDb += 0.037)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cacheTable->GetBler (esNoDb), fileTable->GetBler (esNoDb), "BLER differs at Es/No " << esNoDb);
+    }
+
+  for (double blerTarget = 0.5; blerTarget > 1e-3; blerTarget *= 0.7)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cacheTable->GetEsNoDb (blerTarget), fileTable->GetEsNoDb (blerTarget), "Es/No differs at BLER " << blerTarget);
+    }
+
+  fileTable->Dispose ();
+  cacheTable->Dispose ();
+
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("EnableBinaryDataCache", BooleanValue (false));
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("BinaryDataCacheDirectory", StringValue (""));
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that an antenna pattern read from the binary cache
+ * of an antenna pattern file has the same grid and gains as the antenna pattern
+ * read from the file.
+ *
+ * 1. Write an antenna pattern file with a row of NaN gains.
+ * 2. Load the antenna pattern, which reads the file and stores the cache.
+ * 3. Load the antenna pattern again, which reads the cache.
+ *
+ * Expected result:
+ *   • Same grid and same dB and linear gains at the grid points, NaN included.
+ *   • Same interpolated gains between the grid points.
+ */
+class SatBinaryDataCacheAntennaPatternTestCase : public TestCase
+{
+public:
+  SatBinaryDataCacheAntennaPatternTestCase ();
+  virtual ~SatBinaryDataCacheAntennaPatternTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatBinaryDataCacheAntennaPatternTestCase::SatBinaryDataCacheAntennaPatternTestCase ()
+  : TestCase ("Test antenna pattern from binary data cache.")
+{
+}
+
+SatBinaryDataCacheAntennaPatternTestCase::~SatBinaryDataCacheAntennaPatternTestCase ()
+{
+}
+
+void
+SatBinaryDataCacheAntennaPatternTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("EnableBinaryDataCache", BooleanValue (true));
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("BinaryDataCacheDirectory", StringValue (CreateTempDirFilename ("cache")));
+
+  std::string patternPath = CreateTempDirFilename ("sat-binary-data-cache-antenna-pattern.txt");
+  std::ofstream pattern (patternPath.c_str ());
+
+  // Latitudes 40...45 and longitudes 0...5 with a step of 0.5 degrees, the
+  // gains of the last latitude are NaN
+  for (uint32_t i = 0; i <= 10; ++i)
+    {
+      for (uint32_t j = 0; j <= 10; ++j)
+        {
+          double lat = 40.0 + i * 0.5;
+          double lon = j * 0.5;
+
+          pattern << lat << " " << lon << " ";
+
+          if (i == 10)
+            {
+              pattern << "NaN" << std::endl;
+            }
+          else
+            {
+              pattern << (40.0 - 0.3 * (lat - 42.5) * (lat - 42.5) - 0.2 * (lon - 2.5) * (lon - 2.5) + 0.001 * ((i * 7 + j * 3) % 11)) << std::endl;
+            }
+        }
+    }
+
+  pattern.close ();
+
+  // The first antenna pattern reads the file and stores the cache, the second one uses the cache
+  Ptr<SatAntennaGainPattern> filePattern = CreateObject<SatAntennaGainPattern> (patternPath);
+
+  Ptr<SatBinaryDataCache> cache = SatBinaryDataCache::Open (patternPath, SatBinaryDataCache::CACHE_ANTENNA_PATTERN);
+  NS_TEST_ASSERT_MSG_EQ ((cache != NULL), true, "Binary cache of antenna pattern not stored");
+  cache = 0;
+
+  Ptr<SatAntennaGainPattern> cachePattern = CreateObject<SatAntennaGainPattern> (patternPath);
+
+  NS_TEST_ASSERT_MSG_EQ (filePattern->GetNLatitudes (), 11, "Unexpected number of latitudes");
+  NS_TEST_ASSERT_MSG_EQ (filePattern->GetNLongitudes (), 11, "Unexpected number of longitudes");
+  NS_TEST_ASSERT_MSG_EQ (cachePattern->GetNLatitudes (), filePattern->GetNLatitudes (), "Number of latitudes differs");
+  NS_TEST_ASSERT_MSG_EQ (cachePattern->GetNLongitudes (), filePattern->GetNLongitudes (), "Number of longitudes differs");
+  NS_TEST_ASSERT_MSG_EQ (cachePattern->HasSameGrid (filePattern), true, "Grid differs");
+
+  for (uint32_t i = 0; i < filePattern->GetNLatitudes (); ++i)
+    {
+      for (uint32_t j = 0; j < filePattern->GetNLongitudes (); ++j)
+        {
+          double fileGainDb = filePattern->GetGridAntennaGain_db (i, j);
+          double cacheGainDb = cachePattern->GetGridAntennaGain_db (i, j);
+          double fileGainLin = filePattern->GetGridAntennaGain_lin (i, j);
+          double cacheGainLin = cachePattern->GetGridAntennaGain_lin (i, j);
+
+          NS_TEST_ASSERT_MSG_EQ (std::isnan (fileGainDb), (i == 10), "NaN gain not read at " << i << ", " << j);
+          NS_TEST_ASSERT_MSG_EQ (std::isnan (cacheGainDb), std::isnan (fileGainDb), "NaN gain differs at " << i << ", " << j);
+          NS_TEST_ASSERT_MSG_EQ (std::isnan (cacheGainLin), std::isnan (fileGainLin), "NaN linear gain differs at " << i << ", " << j);
+
+          if (!std::isnan (fileGainDb))
+            {
+              NS_TEST_ASSERT_MSG_EQ (cacheGainDb, fileGainDb, "Gain differs at " << i << ", " << j);
+              NS_TEST_ASSERT_MSG_EQ (cacheGainLin, fileGainLin, "Linear gain differs at " << i << ", " << j);
+            }
+        }
+    }
+
+  // Interpolated gains below the NaN row
+  for (double lat = 40.05; lat < 44.5; lat += 0.13)
+    {
+      for (double lon = 0.05; lon < 5.0; lon += 0.17)
+        {
+          GeoCoordinate coord (lat, lon, 0.0);
+          NS_TEST_ASSERT_MSG_EQ (cachePattern->GetAntennaGain_lin (coord), filePattern->GetAntennaGain_lin (coord),
+                                 "Interpolated gain differs at " << lat << ", " << lon);
+        }
+    }
+
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("EnableBinaryDataCache", BooleanValue (false));
+  Singleton<SatEnvVariables>::Get ()->SetAttribute ("BinaryDataCacheDirectory", StringValue (""));
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the binary data cache.
+ */
+class SatBinaryDataCacheTestSuite : public TestSuite
+{
+public:
+  SatBinaryDataCacheTestSuite ();
+};
+
+SatBinaryDataCacheTestSuite::SatBinaryDataCacheTestSuite ()
+  : TestSuite ("sat-binary-data-cache-test", UNIT)
+{
+  AddTestCase (new SatBinaryDataCacheRoundTripTestCase, TestCase::QUICK);
+  AddTestCase (new SatBinaryDataCacheLookUpTableTestCase, TestCase::QUICK);
+  AddTestCase (new SatBinaryDataCacheAntennaPatternTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatBinaryDataCacheTestSuite satBinaryDataCacheTestSuite;
@@ -0,0 +1,659 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-channel-test.cc
+ * \ingroup satellite
+ * \brief Test cases for the reception optimizations of the satellite channel.
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/channel-list.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/singleton.h"
+#include "ns3/applications-module.h"
+#include "ns3/satellite-module.h"
+#include "ns3/traffic-module.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the batched receptions give identical results
+ * with the receptions scheduled one event per receiver.
+ *
+ *  1.  Return and forward link CBR traffic is simulated in co-channel beams 1 and 5
+ *      with one event per receiver.
+ *  2.  Same simulation is run again with the batched receptions enabled.
+ *
+ *  Expected result:
+ *    • Same received powers, interference powers and SINRs in the same order in both runs.
+ *    • Same bytes received by the users and same number of scheduled receptions.
+ *    • Less signal parameter copies with the batched receptions.
+ */
+class SatChannelBatchedRxTestCase : public TestCase
+{
+public:
+  SatChannelBatchedRxTestCase ();
+  virtual ~SatChannelBatchedRxTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Result of a simulation run
+   */
+  typedef struct
+  {
+    std::vector<double> m_linkBudgets;
+    uint64_t m_rxBytes;
+    uint64_t m_scheduledRx;
+    uint64_t m_rxParamsCopies;
+  } RunResult_t;
+
+  /**
+   * \brief Run the simulation
+   * \param batchedRx Defines whether the receptions are batched
+   * \return Result of the run
+   */
+  RunResult_t RunSimulation (bool batchedRx);
+
+  /**
+   * \brief Store the link budget of a reception
+   */
+  void LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                          Mac48Address ownAdd, Mac48Address destAdd,
+                          double ifPower, double cSinr);
+
+  std::vector<double> m_linkBudgets;
+};
+
+SatChannelBatchedRxTestCase::SatChannelBatchedRxTestCase ()
+  : TestCase ("Test identical results of batched and unbatched receptions")
+{
+}
+
+SatChannelBatchedRxTestCase::~SatChannelBatchedRxTestCase ()
+{
+}
+
+void
+SatChannelBatchedRxTestCase::LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                                                Mac48Address ownAdd, Mac48Address destAdd,
+                                                double ifPower, double cSinr)
+{
+  m_linkBudgets.push_back (params->m_rxPower_W);
+  m_linkBudgets.push_back (ifPower);
+  m_linkBudgets.push_back (cSinr);
+}
+
+SatChannelBatchedRxTestCase::RunResult_t
+SatChannelBatchedRxTestCase::RunSimulation (bool batchedRx)
+{
+  // Reset singletons and the random variable streams, so that both
+  // simulations use the same streams
+  Singleton<SatIdMapper>::Get ()->Reset ();
+  RngSeedManager::ResetNextStreamIndex ();
+  m_linkBudgets.clear ();
+
+  Config::SetDefault ("ns3::SatChannel::EnableBatchedRx", BooleanValue (batchedRx));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  // beams 1 and 5 use the same frequency, thus the return link bursts of
+  // a beam are received also by the satellite receiver of the other beam
+  SatBeamUserInfo beamInfo = SatBeamUserInfo (2,1);
+  std::map<uint32_t, SatBeamUserInfo > beamMap;
+  beamMap[1] = beamInfo;
+  beamMap[5] = beamInfo;
+
+  helper->CreateUserDefinedScenario (beamMap);
+
+  Config::Connect ("/NodeList/*/DeviceList/*/SatPhy/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatChannelBatchedRxTestCase::LinkBudgetTraceCb, this));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/UserPhy/*/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatChannelBatchedRxTestCase::LinkBudgetTraceCb, this));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/FeederPhy/*/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatChannelBatchedRxTestCase::LinkBudgetTraceCb, this));
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  uint16_t port = 9;
+
+  // return link traffic from all the UT users to the GW user
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("20ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (128));
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+
+  // forward link traffic from the GW user to all the UT users
+  for (uint32_t i = 0; i < utUsers.GetN (); ++i)
+    {
+      sinkHelper.SetAttribute ("Local", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (i)), port))));
+      sinks.Add (sinkHelper.Install (utUsers.Get (i)));
+
+      cbrHelper.SetAttribute ("Remote", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (i)), port))));
+      cbrs.Add (cbrHelper.Install (gwUsers.Get (0)));
+    }
+
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (2.5));
+  cbrs.Start (Seconds (0.5));
+  cbrs.Stop (Seconds (2.0));
+
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+
+  RunResult_t result;
+  result.m_linkBudgets = m_linkBudgets;
+  result.m_rxBytes = 0;
+  result.m_scheduledRx = 0;
+  result.m_rxParamsCopies = 0;
+
+  for (uint32_t i = 0; i < sinks.GetN (); ++i)
+    {
+      result.m_rxBytes += DynamicCast<PacketSink> (sinks.Get (i))->GetTotalRx ();
+    }
+
+  for (uint32_t i = 0; i < ChannelList::GetNChannels (); ++i)
+    {
+      Ptr<SatChannel> channel = DynamicCast<SatChannel> (ChannelList::GetChannel (i));
+
+      if (channel != NULL)
+        {
+          result.m_scheduledRx += channel->GetNScheduledRx ();
+          result.m_rxParamsCopies += channel->GetNRxParamsCopies ();
+        }
+    }
+
+  helper = NULL;
+  Simulator::Destroy ();
+
+  return result;
+}
+
+void
+SatChannelBatchedRxTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", "batched-rx", true);
+
+  RunResult_t unbatched = RunSimulation (false);
+  RunResult_t batched = RunSimulation (true);
+
+  NS_TEST_ASSERT_MSG_GT (unbatched.m_rxBytes, 0, "Nothing received!");
+  NS_TEST_ASSERT_MSG_GT (unbatched.m_linkBudgets.size (), 0, "No link budgets traced!");
+  NS_TEST_ASSERT_MSG_EQ (batched.m_rxBytes, unbatched.m_rxBytes, "Received bytes are not what expected!");
+  NS_TEST_ASSERT_MSG_EQ (batched.m_scheduledRx, unbatched.m_scheduledRx, "Scheduled receptions are not what expected!");
+  NS_TEST_ASSERT_MSG_LT (batched.m_rxParamsCopies, unbatched.m_rxParamsCopies, "Batched receptions do not save signal parameter copies!");
+  NS_TEST_ASSERT_MSG_EQ (batched.m_linkBudgets.size (), unbatched.m_linkBudgets.size (), "Traced link budget count is not what expected!");
+
+  for (uint32_t i = 0; i < unbatched.m_linkBudgets.size () && i < batched.m_linkBudgets.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (batched.m_linkBudgets[i], unbatched.m_linkBudgets[i], "Link budget value " << i << " is not what expected!");
+    }
+
+  Config::SetDefault ("ns3::SatChannel::EnableBatchedRx", BooleanValue (false));
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check which receivers are culled by the spatial culling.
+ *
+ *  1.  Return and forward link CBR traffic is simulated in beams around beam 1
+ *      with the spatial culling and the culled Rx powers enabled.
+ *  2.  The culled receptions are traced per user link channel.
+ *
+ *  Expected result:
+ *    • Receptions are culled.
+ *    • The coupling of the beams of every culled reception is below the threshold.
+ *    • Traced culled receptions and their Rx powers match the channel counters.
+ */
+class SatChannelSpatialCullingTestCase : public TestCase
+{
+public:
+  SatChannelSpatialCullingTestCase ();
+  virtual ~SatChannelSpatialCullingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Check the coupling of a culled reception
+   */
+  void CulledRxCb (std::string context, uint32_t txBeamId, uint32_t rxBeamId, double rxPower_W);
+
+  Ptr<SatAntennaGainPatternContainer> m_antennaPatterns;
+  double m_threshold;
+  uint64_t m_culledRx;
+  double m_culledRxPower_W;
+};
+
+SatChannelSpatialCullingTestCase::SatChannelSpatialCullingTestCase ()
+  : TestCase ("Test receivers culled by the spatial culling"),
+    m_antennaPatterns (),
+    m_threshold (SatUtils::DbToLinear (-20.0)),
+    m_culledRx (0),
+    m_culledRxPower_W (0.0)
+{
+}
+
+SatChannelSpatialCullingTestCase::~SatChannelSpatialCullingTestCase ()
+{
+}
+
+void
+SatChannelSpatialCullingTestCase::CulledRxCb (std::string context, uint32_t txBeamId, uint32_t rxBeamId, double rxPower_W)
+{
+  // The coverage beam of the coupling is the beam of the UT
+  double coupling = (context == SatEnums::GetChannelTypeName (SatEnums::RETURN_USER_CH))
+    ? m_antennaPatterns->GetBeamCoupling_lin (txBeamId, rxBeamId)
+    : m_antennaPatterns->GetBeamCoupling_lin (rxBeamId, txBeamId);
+
+  NS_TEST_ASSERT_MSG_EQ ((context == SatEnums::GetChannelTypeName (SatEnums::RETURN_USER_CH)
+                          || context == SatEnums::GetChannelTypeName (SatEnums::FORWARD_USER_CH)), true,
+                         "Reception culled in " << context);
+  NS_TEST_ASSERT_MSG_LT (coupling, m_threshold, "Reception from beam " << txBeamId << " to beam " << rxBeamId << " culled in " << context);
+  NS_TEST_ASSERT_MSG_GT (rxPower_W, 0.0, "Rx power of the culled reception is not what expected!");
+
+  m_culledRx++;
+  m_culledRxPower_W += rxPower_W;
+}
+
+void
+SatChannelSpatialCullingTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", "spatial-culling", true);
+
+  Singleton<SatIdMapper>::Get ()->Reset ();
+
+  Config::SetDefault ("ns3::SatChannel::EnableBatchedRx", BooleanValue (false));
+  Config::SetDefault ("ns3::SatChannel::EnableSpatialCulling", BooleanValue (true));
+  Config::SetDefault ("ns3::SatChannel::SpatialCullingThresholdDb", DoubleValue (-20.0));
+  Config::SetDefault ("ns3::SatChannel::EnableCulledRxPower", BooleanValue (true));
+
+  m_antennaPatterns = CreateObject<SatAntennaGainPatternContainer> ();
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  SatBeamUserInfo beamInfo = SatBeamUserInfo (1,1);
+  std::map<uint32_t, SatBeamUserInfo > beamMap;
+  uint32_t beams[] = { 1, 2, 5, 8, 12, 15, 20, 27 };
+
+  for (uint32_t i = 0; i < sizeof (beams) / sizeof (beams[0]); ++i)
+    {
+      beamMap[beams[i]] = beamInfo;
+    }
+
+  helper->CreateUserDefinedScenario (beamMap);
+
+  std::vector<Ptr<SatChannel> > channels;
+
+  for (uint32_t i = 0; i < ChannelList::GetNChannels (); ++i)
+    {
+      Ptr<SatChannel> channel = DynamicCast<SatChannel> (ChannelList::GetChannel (i));
+
+      if (channel != NULL)
+        {
+          channel->TraceConnect ("CulledRx", SatEnums::GetChannelTypeName (channel->GetChannelType ()),
+                                 MakeCallback (&SatChannelSpatialCullingTestCase::CulledRxCb, this));
+          channels.push_back (channel);
+        }
+    }
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  uint16_t port = 9;
+
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("20ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (128));
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+
+  for (uint32_t i = 0; i < utUsers.GetN (); ++i)
+    {
+      sinkHelper.SetAttribute ("Local", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (i)), port))));
+      sinks.Add (sinkHelper.Install (utUsers.Get (i)));
+
+      cbrHelper.SetAttribute ("Remote", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (i)), port))));
+      cbrs.Add (cbrHelper.Install (gwUsers.Get (0)));
+    }
+
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (2.5));
+  cbrs.Start (Seconds (0.5));
+  cbrs.Stop (Seconds (2.0));
+
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+
+  uint64_t culledRx (0);
+  double culledRxPower_W (0.0);
+
+  for (uint32_t i = 0; i < channels.size (); ++i)
+    {
+      culledRx += channels[i]->GetNCulledRx ();
+      culledRxPower_W += channels[i]->GetCulledRxPower ();
+    }
+
+  NS_TEST_ASSERT_MSG_GT (m_culledRx, 0, "No receptions culled!");
+  NS_TEST_ASSERT_MSG_EQ (culledRx, m_culledRx, "Culled receptions are not what expected!");
+  NS_TEST_ASSERT_MSG_EQ_TOL (culledRxPower_W, m_culledRxPower_W, m_culledRxPower_W * 1e-9, "Culled Rx power is not what expected!");
+
+  channels.clear ();
+  helper = NULL;
+  Simulator::Destroy ();
+
+  Config::SetDefault ("ns3::SatChannel::EnableSpatialCulling", BooleanValue (false));
+  Config::SetDefault ("ns3::SatChannel::EnableCulledRxPower", BooleanValue (false));
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the cached link budgets give identical results
+ * with the link budgets calculated per reception, also when a UT moves.
+ *
+ *  1.  Return and forward link CBR traffic is simulated in co-channel beams 1 and 5
+ *      with the link budget cache disabled. A UT is moved in the middle of the
+ *      simulation.
+ *  2.  Same simulation is run again with the link budget cache enabled.
+ *
+ *  Expected result:
+ *    • Same received powers, interference powers and SINRs in the same order in both runs.
+ *    • Same bytes received by the users.
+ *    • The course change of the UT removes cached link budgets.
+ *    • Every reception of the first run calculates the link budget, and every
+ *      reception of the second run either uses a cached link budget or
+ *      calculates and caches it.
+ */
+class SatChannelLinkBudgetCacheTestCase : public TestCase
+{
+public:
+  SatChannelLinkBudgetCacheTestCase ();
+  virtual ~SatChannelLinkBudgetCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Result of a simulation run
+   */
+  typedef struct
+  {
+    std::vector<double> m_linkBudgets;
+    uint64_t m_rxBytes;
+    uint64_t m_cacheHits;
+    uint64_t m_cacheMisses;
+    uint64_t m_cacheSize;
+    uint64_t m_invalidated;
+  } RunResult_t;
+
+  /**
+   * \brief Run the simulation
+   * \param linkBudgetCache Defines whether the link budgets are cached
+   * \return Result of the run
+   */
+  RunResult_t RunSimulation (bool linkBudgetCache);
+
+  /**
+   * \brief Move a UT and store the number of the cached link budgets removed by the move
+   * \param mobility Mobility model of the UT
+   */
+  void MoveUt (Ptr<SatMobilityModel> mobility);
+
+  /**
+   * \brief Get the number of the cached link budgets of all the channels
+   * \return Number of the cached link budgets
+   */
+  uint64_t GetLinkBudgetCacheSize () const;
+
+  /**
+   * \brief Store the link budget of a reception
+   */
+  void LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                          Mac48Address ownAdd, Mac48Address destAdd,
+                          double ifPower, double cSinr);
+
+  std::vector<double> m_linkBudgets;
+  uint64_t m_invalidated;
+};
+
+SatChannelLinkBudgetCacheTestCase::SatChannelLinkBudgetCacheTestCase ()
+  : TestCase ("Test identical results with and without the link budget cache"),
+    m_invalidated (0)
+{
+}
+
+SatChannelLinkBudgetCacheTestCase::~SatChannelLinkBudgetCacheTestCase ()
+{
+}
+
+void
+SatChannelLinkBudgetCacheTestCase::LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                                                      Mac48Address ownAdd, Mac48Address destAdd,
+                                                      double ifPower, double cSinr)
+{
+  m_linkBudgets.push_back (params->m_rxPower_W);
+  m_linkBudgets.push_back (ifPower);
+  m_linkBudgets.push_back (cSinr);
+}
+
+uint64_t
+SatChannelLinkBudgetCacheTestCase::GetLinkBudgetCacheSize () const
+{
+  uint64_t size = 0;
+
+  for (uint32_t i = 0; i < ChannelList::GetNChannels (); ++i)
+    {
+      Ptr<SatChannel> channel = DynamicCast<SatChannel> (ChannelList::GetChannel (i));
+
+      if (channel != NULL)
+        {
+          size += channel->GetLinkBudgetCacheSize ();
+        }
+    }
+
+  return size;
+}
+
+void
+SatChannelLinkBudgetCacheTestCase::MoveUt (Ptr<SatMobilityModel> mobility)
+{
+  uint64_t sizeBefore = GetLinkBudgetCacheSize ();
+
+  GeoCoordinate position = mobility->GetGeoPosition ();
+  mobility->SetGeoPosition (GeoCoordinate (position.GetLatitude () + 0.5,
+                                           position.GetLongitude () + 0.5,
+                                           position.GetAltitude ()));
+
+  m_invalidated = sizeBefore - GetLinkBudgetCacheSize ();
+}
+
+SatChannelLinkBudgetCacheTestCase::RunResult_t
+SatChannelLinkBudgetCacheTestCase::RunSimulation (bool linkBudgetCache)
+{
+  // Reset singletons and the random variable streams, so that both
+  // simulations use the same streams
+  Singleton<SatIdMapper>::Get ()->Reset ();
+  RngSeedManager::ResetNextStreamIndex ();
+  m_linkBudgets.clear ();
+  m_invalidated = 0;
+
+  Config::SetDefault ("ns3::SatChannel::EnableLinkBudgetCache", BooleanValue (linkBudgetCache));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  SatBeamUserInfo beamInfo = SatBeamUserInfo (2,1);
+  std::map<uint32_t, SatBeamUserInfo > beamMap;
+  beamMap[1] = beamInfo;
+  beamMap[5] = beamInfo;
+
+  helper->CreateUserDefinedScenario (beamMap);
+
+  Config::Connect ("/NodeList/*/DeviceList/*/SatPhy/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatChannelLinkBudgetCacheTestCase::LinkBudgetTraceCb, this));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/UserPhy/*/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatChannelLinkBudgetCacheTestCase::LinkBudgetTraceCb, this));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/FeederPhy/*/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatChannelLinkBudgetCacheTestCase::LinkBudgetTraceCb, this));
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  uint16_t port = 9;
+
+  // return link traffic from all the UT users to the GW user
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("20ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (128));
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+
+  // forward link traffic from the GW user to all the UT users
+  for (uint32_t i = 0; i < utUsers.GetN (); ++i)
+    {
+      sinkHelper.SetAttribute ("Local", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (i)), port))));
+      sinks.Add (sinkHelper.Install (utUsers.Get (i)));
+
+      cbrHelper.SetAttribute ("Remote", AddressValue (Address (InetSocketAddress (helper->GetUserAddress (utUsers.Get (i)), port))));
+      cbrs.Add (cbrHelper.Install (gwUsers.Get (0)));
+    }
+
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (2.5));
+  cbrs.Start (Seconds (0.5));
+  cbrs.Stop (Seconds (2.0));
+
+  // move the first UT in the middle of the traffic
+  Ptr<SatMobilityModel> utMobility = helper->UtNodes ().Get (0)->GetObject<SatMobilityModel> ();
+  Simulator::Schedule (Seconds (1.25), &SatChannelLinkBudgetCacheTestCase::MoveUt, this, utMobility);
+
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+
+  RunResult_t result;
+  result.m_linkBudgets = m_linkBudgets;
+  result.m_rxBytes = 0;
+  result.m_cacheHits = 0;
+  result.m_cacheMisses = 0;
+  result.m_cacheSize = GetLinkBudgetCacheSize ();
+  result.m_invalidated = m_invalidated;
+
+  for (uint32_t i = 0; i < sinks.GetN (); ++i)
+    {
+      result.m_rxBytes += DynamicCast<PacketSink> (sinks.Get (i))->GetTotalRx ();
+    }
+
+  for (uint32_t i = 0; i < ChannelList::GetNChannels (); ++i)
+    {
+      Ptr<SatChannel> channel = DynamicCast<SatChannel> (ChannelList::GetChannel (i));
+
+      if (channel != NULL)
+        {
+          result.m_cacheHits += channel->GetNLinkBudgetCacheHits ();
+          result.m_cacheMisses += channel->GetNLinkBudgetCacheMisses ();
+        }
+    }
+
+  helper = NULL;
+  Simulator::Destroy ();
+
+  return result;
+}
+
+void
+SatChannelLinkBudgetCacheTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-channel", "link-budget-cache", true);
+
+  RunResult_t uncached = RunSimulation (false);
+  RunResult_t cached = RunSimulation (true);
+
+  NS_TEST_ASSERT_MSG_GT (uncached.m_rxBytes, 0, "Nothing received!");
+  NS_TEST_ASSERT_MSG_GT (uncached.m_linkBudgets.size (), 0, "No link budgets traced!");
+  NS_TEST_ASSERT_MSG_EQ (cached.m_rxBytes, uncached.m_rxBytes, "Received bytes are not what expected!");
+  NS_TEST_ASSERT_MSG_EQ (cached.m_linkBudgets.size (), uncached.m_linkBudgets.size (), "Traced link budget count is not what expected!");
+
+  for (uint32_t i = 0; i < uncached.m_linkBudgets.size () && i < cached.m_linkBudgets.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cached.m_linkBudgets[i], uncached.m_linkBudgets[i], "Link budget value " << i << " is not what expected!");
+    }
+
+  // without the cache every reception calculates the link budget
+  NS_TEST_ASSERT_MSG_EQ (uncached.m_cacheHits, 0, "Cache hits without the cache!");
+  NS_TEST_ASSERT_MSG_EQ (uncached.m_cacheSize, 0, "Link budgets cached without the cache!");
+  NS_TEST_ASSERT_MSG_EQ (uncached.m_invalidated, 0, "Link budgets invalidated without the cache!");
+
+  // with the cache every reception either hits the cache or calculates and caches the link budget
+  NS_TEST_ASSERT_MSG_EQ (cached.m_cacheHits + cached.m_cacheMisses, uncached.m_cacheMisses, "Link budget lookups are not what expected!");
+  NS_TEST_ASSERT_MSG_GT (cached.m_invalidated, 0, "Course change of the UT does not invalidate cached link budgets!");
+  NS_TEST_ASSERT_MSG_EQ (cached.m_cacheMisses, cached.m_cacheSize + cached.m_invalidated, "Link budget cache misses are not what expected!");
+  NS_TEST_ASSERT_MSG_GT (cached.m_cacheHits, cached.m_cacheMisses, "Link budget cache is not used!");
+
+  Config::SetDefault ("ns3::SatChannel::EnableLinkBudgetCache", BooleanValue (false));
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the satellite channel.
+ */
+class SatChannelTestSuite : public TestSuite
+{
+public:
+  SatChannelTestSuite ();
+};
+
+SatChannelTestSuite::SatChannelTestSuite ()
+  : TestSuite ("sat-channel", SYSTEM)
+{
+  AddTestCase (new SatChannelBatchedRxTestCase, TestCase::QUICK);
+  AddTestCase (new SatChannelSpatialCullingTestCase, TestCase::QUICK);
+  AddTestCase (new SatChannelLinkBudgetCacheTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatChannelTestSuite satChannelTestSuite;
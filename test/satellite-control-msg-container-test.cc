@@ -33,6 +33,7 @@
 #include "ns3/boolean.h"
 #include "ns3/string.h"
 #include "../model/satellite-control-message.h"
+#include "../model/satellite-frame-conf.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -227,6 +228,104 @@ SatCtrlMsgContDelOffTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the DA time slots of the TBTP message.
+ *
+ *  1.  Set DA time slots of two UTs in different frames, using the same time slot
+ *      configuration with different RC indices like the frame configuration type 0.
+ *  2.  Get the time slots of the UTs and of unknown assignment IDs.
+ *
+ *  Expected result:
+ *   The views of the UTs contain the set time slots in the set order with the set RC indices.
+ *   The views of the unknown and unassigned assignment IDs are empty.
+ *   The size of the message is the sum of the time slots of the UTs.
+ */
+class SatTbtpDaTimeSlotTestCase : public TestCase
+{
+public:
+  SatTbtpDaTimeSlotTestCase () : TestCase ("Test DA time slots of the TBTP message.")
+  {
+  }
+  virtual ~SatTbtpDaTimeSlotTestCase ()
+  {
+  }
+
+protected:
+  virtual void DoRun (void);
+};
+
+void
+SatTbtpDaTimeSlotTestCase::DoRun (void)
+{
+  Ptr<SatTbtpMessage> tbtp = CreateObject<SatTbtpMessage> ();
+
+  Ptr<SatTimeSlotConf> firstConf = Create<SatTimeSlotConf> (Seconds (0.001), 3, 0, SatTimeSlotConf::SLOT_TYPE_TR);
+  Ptr<SatTimeSlotConf> secondConf = Create<SatTimeSlotConf> (Seconds (0.002), 4, 1, SatTimeSlotConf::SLOT_TYPE_TRC);
+  Ptr<SatTimeSlotConf> sharedConf = Create<SatTimeSlotConf> (Seconds (0.003), 5, 2, SatTimeSlotConf::SLOT_TYPE_TR);
+
+  // assignment ID 1, frame 0
+  tbtp->SetDaTimeslot (1, 0, firstConf, 0);
+  tbtp->SetDaTimeslot (1, 0, secondConf, 1);
+  tbtp->SetDaTimeslot (1, 0, sharedConf, 1);
+
+  // the shared configuration is reused with another RC index, the frame
+  // allocator used to write the RC index to the configuration
+  sharedConf->SetRcIndex (3);
+
+  // assignment ID 4, frame 1
+  tbtp->SetDaTimeslot (4, 1, sharedConf, 2);
+  tbtp->SetDaTimeslot (4, 1, firstConf, 0);
+
+  tbtp->SetRaChannel (0, 0, 4);
+
+  SatTbtpMessage::DaTimeSlotInfo firstSlots = tbtp->GetDaTimeslots (1);
+
+  NS_TEST_ASSERT_MSG_EQ (firstSlots.IsEmpty (), false, "Time slots of assignment ID 1 missing");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots.GetSize (), 3, "Time slot count of assignment ID 1 incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) firstSlots.GetFrameId (), 0, "Frame ID of assignment ID 1 incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[0].m_startTime, Seconds (0.001), "Start time of the first time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[0].m_waveformId, 3, "Waveform of the first time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[0].m_carrierId, 0, "Carrier of the first time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) firstSlots[0].m_rcIndex, 0, "RC index of the first time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[0].m_slotType, SatTimeSlotConf::SLOT_TYPE_TR, "Type of the first time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[1].m_startTime, Seconds (0.002), "Start time of the second time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[1].m_waveformId, 4, "Waveform of the second time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[1].m_carrierId, 1, "Carrier of the second time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) firstSlots[1].m_rcIndex, 1, "RC index of the second time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[1].m_slotType, SatTimeSlotConf::SLOT_TYPE_TRC, "Type of the second time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (firstSlots[2].m_startTime, Seconds (0.003), "Start time of the third time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) firstSlots[2].m_rcIndex, 1, "RC index changed by reusing the time slot configuration");
+
+  SatTbtpMessage::DaTimeSlotInfo secondSlots = tbtp->GetDaTimeslots (4);
+
+  NS_TEST_ASSERT_MSG_EQ (secondSlots.GetSize (), 2, "Time slot count of assignment ID 4 incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) secondSlots.GetFrameId (), 1, "Frame ID of assignment ID 4 incorrect");
+  NS_TEST_ASSERT_MSG_EQ (secondSlots[0].m_startTime, Seconds (0.003), "Start time of the reused time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) secondSlots[0].m_rcIndex, 2, "RC index of the reused time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ (secondSlots[1].m_startTime, Seconds (0.001), "Start time of the last time slot incorrect");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) secondSlots[1].m_rcIndex, 0, "RC index of the last time slot incorrect");
+
+  // assignment IDs 0 and 2 are below the highest assignment ID, but not assigned
+  NS_TEST_ASSERT_MSG_EQ (tbtp->GetDaTimeslots (0).IsEmpty (), true, "Time slots for unassigned assignment ID 0");
+  NS_TEST_ASSERT_MSG_EQ (tbtp->GetDaTimeslots (2).IsEmpty (), true, "Time slots for unassigned assignment ID 2");
+  NS_TEST_ASSERT_MSG_EQ (tbtp->GetDaTimeslots (2).GetSize (), 0, "Time slot count for unassigned assignment ID 2");
+  NS_TEST_ASSERT_MSG_EQ (tbtp->GetDaTimeslots (100).IsEmpty (), true, "Time slots for unknown assignment ID 100");
+
+  // size as the sum of the time slots of the UTs and the RA time slots
+  uint32_t utSlots[] = { 3, 2 };
+  uint32_t expectedSize = SatTbtpMessage::m_tbtpBodySizeInBytes + 2 * tbtp->GetFrameInfoSize ();
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      expectedSize += utSlots[i] * tbtp->GetTimeSlotInfoSizeInBytes ();
+    }
+
+  expectedSize += 4 * tbtp->GetTimeSlotInfoSizeInBytes ();
+
+  NS_TEST_ASSERT_MSG_EQ (tbtp->GetSizeInBytes (), expectedSize, "Size of the TBTP message incorrect");
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for Satellite control message container unit test cases.
@@ -242,6 +341,7 @@ SatCtrlMsgContainerTestSuite::SatCtrlMsgContainerTestSuite ()
 {
   AddTestCase (new SatCtrlMsgContDelOnTestCase, TestCase::QUICK);
   AddTestCase (new SatCtrlMsgContDelOffTestCase, TestCase::QUICK);
+  AddTestCase (new SatTbtpDaTimeSlotTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -24,6 +24,9 @@
  * \brief Test cases to unit test external fading traces
  */
 
+#include <cmath>
+#include <fstream>
+#include <limits>
 #include <vector>
 #include "ns3/log.h"
 #include "ns3/test.h"
@@ -31,6 +34,7 @@
 #include "ns3/simulator.h"
 #include "../model/satellite-fading-external-input-trace-container.h"
 #include "../model/satellite-channel.h"
+#include "../model/satellite-utils.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -108,6 +112,178 @@ SatFadingExternalInputTraceTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the half precision float conversions of the
+ * fading traces.
+ *
+ * 1. Convert all the half precision values to single precision and back, which
+ *    shall give the same values.
+ * 2. Check the conversion of the subnormal values, the overflow to infinity and NaN.
+ * 3. Check the relative accuracy of the values between MIN_HALF_FADING and MAX_HALF_FADING.
+ */
+class SatFadingHalfFloatTestCase : public TestCase
+{
+public:
+  SatFadingHalfFloatTestCase ();
+  virtual ~SatFadingHalfFloatTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatFadingHalfFloatTestCase::SatFadingHalfFloatTestCase ()
+  : TestCase ("Test half precision float conversions of the fading traces.")
+{
+}
+
+SatFadingHalfFloatTestCase::~SatFadingHalfFloatTestCase ()
+{
+}
+
+void
+SatFadingHalfFloatTestCase::DoRun (void)
+{
+  // Round trip of all the values but NaNs
+  for (uint32_t half = 0; half <= 0xffff; ++half)
+    {
+      float value = SatFadingExternalInputTrace::HalfToFloat (half);
+
+      if (std::isnan (value))
+        {
+          NS_TEST_ASSERT_MSG_EQ ((half & 0x7c00), 0x7c00, "Half " << half << " converted to NaN");
+          NS_TEST_ASSERT_MSG_NE ((half & 0x3ff), 0, "Half " << half << " converted to NaN");
+          continue;
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (value), half, "Round trip of half " << half << " failed");
+    }
+
+  // Subnormal values
+  float smallest = std::ldexp (1.0f, -24);
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (smallest), 0x0001, "Smallest subnormal not what expected");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::HalfToFloat (0x0001), smallest, "Smallest subnormal not what expected");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::HalfToFloat (0x03ff), std::ldexp (1023.0f, -24), "Largest subnormal not what expected");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (smallest * 0.25f), 0x0000, "Underflow not rounded to zero");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (smallest * 0.75f), 0x0001, "Subnormal not rounded to nearest");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::HalfToFloat (0x0400), SatFadingExternalInputTrace::MIN_HALF_FADING, "Smallest normal not what expected");
+
+  // Overflow to infinity
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (SatFadingExternalInputTrace::MAX_HALF_FADING), 0x7bff, "Largest value not what expected");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (65520.0f), 0x7c00, "Overflow not rounded to infinity");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (1.0e10f), 0x7c00, "Overflow not rounded to infinity");
+  NS_TEST_ASSERT_MSG_EQ (SatFadingExternalInputTrace::FloatToHalf (-1.0e10f), 0xfc00, "Negative overflow not rounded to minus infinity");
+  NS_TEST_ASSERT_MSG_EQ (std::isinf (SatFadingExternalInputTrace::HalfToFloat (0x7c00)), true, "Infinity not what expected");
+
+  // NaN
+  uint16_t nan = SatFadingExternalInputTrace::FloatToHalf (std::numeric_limits<float>::quiet_NaN ());
+  NS_TEST_ASSERT_MSG_EQ ((nan & 0x7c00), 0x7c00, "NaN exponent not what expected");
+  NS_TEST_ASSERT_MSG_NE ((nan & 0x3ff), 0, "NaN mantissa not what expected");
+  NS_TEST_ASSERT_MSG_EQ (std::isnan (SatFadingExternalInputTrace::HalfToFloat (nan)), true, "NaN not what expected");
+
+  // Relative accuracy in the range of the fading values
+  for (double db = -42.0; db <= 48.0; db += 0.01)
+    {
+      float value = SatUtils::DbToLinear (db);
+      float converted = SatFadingExternalInputTrace::HalfToFloat (SatFadingExternalInputTrace::FloatToHalf (value));
+
+      NS_TEST_ASSERT_MSG_EQ_TOL (converted, value, value * 4.9e-4, "Relative accuracy of " << db << " dB not within tolerance");
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the fading values of a trace stored as half
+ * precision floats match the values stored as single precision floats.
+ *
+ * 1. Write a two column trace file with fading values between -40 and 10 dB
+ *    followed by fades deeper than -42.1 dB.
+ * 2. Load the trace with both storage types.
+ * 3. Compare the interpolated fading values of the traces in the middle of the samples.
+ *
+ * Expected result:
+ *    • Relative difference of the fading values below 4.9e-4.
+ *    • Fading values of the deep fades clamped to MIN_HALF_FADING.
+ */
+class SatFadingHalfFloatTraceTestCase : public TestCase
+{
+public:
+  SatFadingHalfFloatTraceTestCase ();
+  virtual ~SatFadingHalfFloatTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void CompareFading (Ptr<SatFadingExternalInputTrace> floatTrace, Ptr<SatFadingExternalInputTrace> halfTrace, bool deepFade);
+};
+
+SatFadingHalfFloatTraceTestCase::SatFadingHalfFloatTraceTestCase ()
+  : TestCase ("Test fading trace stored as half precision floats against single precision floats.")
+{
+}
+
+SatFadingHalfFloatTraceTestCase::~SatFadingHalfFloatTraceTestCase ()
+{
+}
+
+void
+SatFadingHalfFloatTraceTestCase::CompareFading (Ptr<SatFadingExternalInputTrace> floatTrace, Ptr<SatFadingExternalInputTrace> halfTrace, bool deepFade)
+{
+  double floatFading = floatTrace->GetFading ();
+  double halfFading = halfTrace->GetFading ();
+
+  if (deepFade)
+    {
+      NS_TEST_ASSERT_MSG_LT (floatFading, SatFadingExternalInputTrace::MIN_HALF_FADING, "Deep fade not what expected");
+      NS_TEST_ASSERT_MSG_EQ (halfFading, SatFadingExternalInputTrace::MIN_HALF_FADING, "Deep fade not clamped");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (halfFading, floatFading, floatFading * 4.9e-4, "Fading at " << Simulator::Now ().GetSeconds () << " s not within tolerance");
+    }
+}
+
+void
+SatFadingHalfFloatTraceTestCase::DoRun (void)
+{
+  std::string tracePath = CreateTempDirFilename ("sat-fading-half-float-trace.bin");
+  std::ofstream trace (tracePath.c_str (), std::ios::out | std::ios::binary);
+
+  const uint32_t samples = 1000;
+  const uint32_t deepFadeSamples = 10;
+  const float interval = 0.01f;
+
+  for (uint32_t i = 0; i < samples + deepFadeSamples; ++i)
+    {
+      float time = i * interval;
+      float fading = (i < samples) ? -40.0f + 50.0f * (i % 97) / 96.0f : -50.0f - i % 3;
+
+      trace.write ((const char*)&time, sizeof (float));
+      trace.write ((const char*)&fading, sizeof (float));
+    }
+
+  trace.close ();
+
+  Ptr<SatFadingExternalInputTrace> floatTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_TWO_COLUMN, tracePath, SatFadingExternalInputTrace::ST_FLOAT);
+  Ptr<SatFadingExternalInputTrace> halfTrace = Create<SatFadingExternalInputTrace> (SatFadingExternalInputTrace::FT_TWO_COLUMN, tracePath, SatFadingExternalInputTrace::ST_HALF_FLOAT);
+
+  for (uint32_t i = 0; i + 1 < samples + deepFadeSamples; ++i)
+    {
+      // The interpolation from a normal sample to a clamped deep fade is not compared
+      if (i + 1 == samples)
+        {
+          continue;
+        }
+
+      // Interpolated between the samples i and i + 1
+      bool deepFade = (i >= samples);
+      Simulator::Schedule (Seconds ((i + 0.5) * interval), &SatFadingHalfFloatTraceTestCase::CompareFading, this, floatTrace, halfTrace, deepFade);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for satellite fading external input trace
@@ -122,6 +298,8 @@ SatFadingExternalInputTraceTestSuite::SatFadingExternalInputTraceTestSuite ()
   : TestSuite ("sat-fading-external-input-trace-test", UNIT)
 {
   AddTestCase (new SatFadingExternalInputTraceTestCase, TestCase::QUICK);
+  AddTestCase (new SatFadingHalfFloatTestCase, TestCase::QUICK);
+  AddTestCase (new SatFadingHalfFloatTraceTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-fading-oscillator-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the fading oscillator bank.
+ */
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+#include "../model/satellite-fading-oscillator.h"
+#include "../model/satellite-fading-oscillator-bank.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the evaluation modes of the fading
+ * oscillator bank.
+ *
+ * This case fills oscillator banks of 4 to 64 oscillators the same way as
+ * the Loo and Rayleigh models do and evaluates the complex and cosine wave
+ * sums at random time instants.
+ *
+ *   1.  Evaluate the sums of SatFadingOscillator objects in order.
+ *   2.  Evaluate the sums of the bank with the deterministic mode.
+ *   3.  Evaluate the sums of the bank with the vectorized mode.
+ *
+ *   Expected result:
+ *     The deterministic sums are bit-exactly equal to the sums of the
+ *     SatFadingOscillator objects. The relative deviation of the vectorized
+ *     sums from the deterministic sums is below 1e-10 (relative to the
+ *     magnitude of the sum, or to 1e-3 if the sum is closer to zero).
+ *
+ */
+class SatFadingOscillatorBankTestCase : public TestCase
+{
+public:
+  SatFadingOscillatorBankTestCase ();
+  virtual ~SatFadingOscillatorBankTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatFadingOscillatorBankTestCase::SatFadingOscillatorBankTestCase ()
+  : TestCase ("Test accuracy of the fading oscillator bank evaluation modes.")
+{
+}
+
+SatFadingOscillatorBankTestCase::~SatFadingOscillatorBankTestCase ()
+{
+}
+
+void
+SatFadingOscillatorBankTestCase::DoRun (void)
+{
+  const uint32_t samples = 2000;
+  const double maxDopplerHz = 100.0;
+  const double maxRelativeDeviation = 1e-10;
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  for (uint32_t n = 4; n <= 64; n *= 2)
+    {
+      for (uint32_t cosineWave = 0; cosineWave <= 1; cosineWave++)
+        {
+          std::vector< Ptr<SatFadingOscillator> > oscillators;
+          SatFadingOscillatorBank bank;
+
+          double phi = rng->GetValue (-M_PI, M_PI);
+
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              double omega = 2.0 * M_PI * maxDopplerHz * std::cos (rng->GetValue (0, M_PI));
+
+              if (cosineWave)
+                {
+                  double amplitude = rng->GetValue (0.5, 1.5) / n;
+                  oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+                  bank.AddOscillator (amplitude, phi, omega);
+                }
+              else
+                {
+                  double psi = rng->GetValue (-M_PI, M_PI);
+                  std::complex<double> amplitude = std::complex<double> (std::cos (psi), std::sin (psi)) * 2.0 / std::sqrt (n);
+                  oscillators.push_back (CreateObject<SatFadingOscillator> (amplitude, phi, omega));
+                  bank.AddOscillator (amplitude, phi, omega);
+                }
+            }
+
+          NS_TEST_ASSERT_MSG_EQ (bank.GetNOscillators (), n, "Wrong number of oscillators in the bank");
+
+          bool exact = true;
+          double maxDeviation = 0.0;
+
+          for (uint32_t s = 0; s < samples; ++s)
+            {
+              double t = rng->GetValue (0.0, 1000.0);
+
+              std::complex<double> reference = std::complex<double> (0, 0);
+              for (uint32_t i = 0; i < oscillators.size (); i++)
+                {
+                  reference += cosineWave ? oscillators[i]->GetCosineWaveValueAt (t)
+                    : oscillators[i]->GetComplexValueAt (t);
+                }
+
+              std::complex<double> deterministic = cosineWave ? bank.GetCosineWaveSum (t, SatFadingOscillatorBank::EVALUATION_DETERMINISTIC)
+                : bank.GetComplexSum (t, SatFadingOscillatorBank::EVALUATION_DETERMINISTIC);
+              std::complex<double> vectorized = cosineWave ? bank.GetCosineWaveSum (t, SatFadingOscillatorBank::EVALUATION_VECTORIZED)
+                : bank.GetComplexSum (t, SatFadingOscillatorBank::EVALUATION_VECTORIZED);
+
+              exact = exact && (deterministic == reference);
+
+              double deviation = std::abs (vectorized - deterministic) / std::max (std::abs (deterministic), 1e-3);
+              maxDeviation = std::max (maxDeviation, deviation);
+            }
+
+          NS_TEST_ASSERT_MSG_EQ (exact, true, "Deterministic sums of " << n << " oscillators differ from the reference");
+          NS_TEST_ASSERT_MSG_LT (maxDeviation, maxRelativeDeviation, "Vectorized sums of " << n << " oscillators deviate too much, cosine wave = " << cosineWave);
+        }
+    }
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the fading oscillator bank.
+ */
+class SatFadingOscillatorTestSuite : public TestSuite
+{
+public:
+  SatFadingOscillatorTestSuite ();
+};
+
+SatFadingOscillatorTestSuite::SatFadingOscillatorTestSuite ()
+  : TestSuite ("sat-fading-oscillator-test", UNIT)
+{
+  AddTestCase (new SatFadingOscillatorBankTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatFadingOscillatorTestSuite satFadingOscillatorTestSuite;
@@ -76,6 +76,7 @@ private:
   SatFrameAllocator::CcLevel_t m_ccLevels[m_ccLevelCount];
   double m_cnoValues[m_cnoValueCount];
   uint32_t m_cnoIndex;
+  uint32_t m_utIndex;
   Ptr<SatWaveformConf> m_waveFormConf;
   Ptr<SatFrameConf> m_frameConf;
   Ptr<SatFrameAllocator> m_frameAllocator;
@@ -106,6 +107,7 @@ SatFrameAllocatorTestCase::SatFrameAllocatorTestCase ()
   m_ccLevels[3] = SatFrameAllocator::CC_LEVEL_CRA_RBDC_VBDC;
 
   m_cnoIndex = 0;
+  m_utIndex = 0;
 
   m_cnoValues[0] = SatUtils::DbToLinear (125.0);
   m_cnoValues[1] = SatUtils::DbToLinear (35.0);
@@ -277,14 +279,14 @@ SatFrameAllocatorTestCase::CheckSingleUtTestResults (uint32_t bytesReq, SatFrame
 
   for ( SatFrameAllocator::TbtpMsgContainer_t::const_iterator it = tbtpContainer.begin (); it != tbtpContainer.end (); it++)
     {
-      SatTbtpMessage::DaTimeSlotInfoItem_t info = (*it)->GetDaTimeslots (req.m_address);
+      SatTbtpMessage::DaTimeSlotInfo info = (*it)->GetDaTimeslots (req.m_utIndex);
 
-      for (SatTbtpMessage::DaTimeSlotConfContainer_t::const_iterator it2 = info.second.begin (); it2 != info.second.end (); it2++ )
+      for (uint32_t i = 0; i < info.GetSize (); i++ )
         {
-          tbtpAllocatedBytes += m_frameConf->GetWaveformConf ()->GetWaveform ((*it2)->GetWaveFormId ())->GetPayloadInBytes ();
+          tbtpAllocatedBytes += m_frameConf->GetWaveformConf ()->GetWaveform (info[i].m_waveformId)->GetPayloadInBytes ();
         }
 
-      slotsAllocated += info.second.size ();
+      slotsAllocated += info.GetSize ();
     }
 
   // check that information is identical in TBTP container and UT allocation container
@@ -510,6 +512,7 @@ SatFrameAllocatorTestCase::ContructRequestForUt ( uint32_t& totalBytes, uint32_t
   SatFrameAllocator::SatFrameAllocReq req;
   req = SatFrameAllocator::SatFrameAllocReq (rcReqs);
   req.m_address = Mac48Address::Allocate ();
+  req.m_utIndex = m_utIndex++;
   req.m_generateCtrlSlot = controlSlot;
 
   m_cnoIndex++;
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-input-fstream-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the input file stream containers.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "../utils/satellite-input-fstream-time-double-container.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the single column lookup of the time double
+ * container returns the same values as the row lookup and the closest time
+ * samples of the file.
+ *
+ * 1. Write a trace file with unevenly spaced time samples and two value columns.
+ * 2. Read the file with two containers and look up the values at increasing
+ *    times, with one container by rows and with the other by single columns.
+ *    The times are before, at and between the samples, and after the last
+ *    sample, from which the samples are looped.
+ * 3. Find the closest time samples from the rows written to the file.
+ *
+ * Expected result:
+ *   • Identical values from the row and the single column lookups at all times.
+ *   • The values of the closest time samples of the file up to the last sample.
+ */
+class SatInputFileStreamTimeDoubleColumnTestCase : public TestCase
+{
+public:
+  SatInputFileStreamTimeDoubleColumnTestCase ();
+  virtual ~SatInputFileStreamTimeDoubleColumnTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Look up the values of the current time with both containers
+   */
+  void LookUp ();
+
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_rowContainer;
+  Ptr<SatInputFileStreamTimeDoubleContainer> m_columnContainer;
+  std::vector<std::vector<double> > m_rowValues;
+  std::vector<std::vector<double> > m_columnValues;
+};
+
+SatInputFileStreamTimeDoubleColumnTestCase::SatInputFileStreamTimeDoubleColumnTestCase ()
+  : TestCase ("Test identical values of the row and single column lookups of the time double container.")
+{
+}
+
+SatInputFileStreamTimeDoubleColumnTestCase::~SatInputFileStreamTimeDoubleColumnTestCase ()
+{
+}
+
+void
+SatInputFileStreamTimeDoubleColumnTestCase::LookUp ()
+{
+  m_rowValues.push_back (m_rowContainer->ProceedToNextClosestTimeSample ());
+
+  std::vector<double> columnValues;
+  columnValues.push_back (m_columnContainer->ProceedToNextClosestTimeSample (1));
+  columnValues.push_back (m_columnContainer->ProceedToNextClosestTimeSample (2));
+  m_columnValues.push_back (columnValues);
+}
+
+void
+SatInputFileStreamTimeDoubleColumnTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("sat-input-fstream-time-double-test");
+
+  // time, value 1 and value 2 of the rows written to the file
+  std::vector<std::vector<double> > rows;
+  std::vector<uint64_t> sampleTimes;
+  uint64_t sampleTime = 0;
+
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      // time samples in microseconds
+      sampleTime += 5000 + 1000 * (i % 4);
+      sampleTimes.push_back (sampleTime);
+
+      std::vector<double> row;
+      row.push_back (sampleTime / 1000000.0);
+      row.push_back (1.0e-20 * (i + 1));
+      row.push_back (100.0 - i);
+      rows.push_back (row);
+    }
+
+  std::ofstream ofs (fileName.c_str ());
+  ofs << std::setprecision (17);
+
+  for (uint32_t i = 0; i < rows.size (); i++)
+    {
+      ofs << rows[i][0] << " " << rows[i][1] << " " << rows[i][2] << std::endl;
+    }
+
+  ofs.close ();
+
+  m_rowContainer = CreateObject<SatInputFileStreamTimeDoubleContainer> (fileName, std::ios::in, 3);
+  m_columnContainer = CreateObject<SatInputFileStreamTimeDoubleContainer> (fileName, std::ios::in, 3);
+
+  // look up times in microseconds: before the first sample, at and between the
+  // samples and after the last sample
+  std::vector<uint64_t> lookUpTimes;
+
+  for (uint64_t t = 1000; t < 2 * sampleTimes.back (); t += 1700)
+    {
+      lookUpTimes.push_back (t);
+    }
+
+  lookUpTimes.push_back (sampleTimes[10]);
+  lookUpTimes.push_back (sampleTimes[11]);
+  std::sort (lookUpTimes.begin (), lookUpTimes.end ());
+
+  for (uint32_t i = 0; i < lookUpTimes.size (); i++)
+    {
+      Simulator::Schedule (MicroSeconds (lookUpTimes[i]), &SatInputFileStreamTimeDoubleColumnTestCase::LookUp, this);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rowValues.size (), lookUpTimes.size (), "Row lookup count incorrect");
+  NS_TEST_ASSERT_MSG_EQ (m_columnValues.size (), lookUpTimes.size (), "Column lookup count incorrect");
+
+  for (uint32_t i = 0; i < m_rowValues.size () && i < m_columnValues.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_columnValues[i][0], m_rowValues[i][1], "Column lookup " << i << " of value 1 differs from the row lookup");
+      NS_TEST_ASSERT_MSG_EQ (m_columnValues[i][1], m_rowValues[i][2], "Column lookup " << i << " of value 2 differs from the row lookup");
+    }
+
+  // the lookups up to the last sample return the closest time sample, the
+  // lookups in the middle of two samples are skipped, since the rounding of
+  // the simulation time may select either one of them
+  for (uint32_t i = 0; i < m_rowValues.size () && lookUpTimes[i] <= sampleTimes.back (); i++)
+    {
+      uint32_t closest = 0;
+      bool tie = false;
+
+      for (uint32_t j = 1; j < sampleTimes.size (); j++)
+        {
+          uint64_t difference = sampleTimes[j] > lookUpTimes[i] ? sampleTimes[j] - lookUpTimes[i] : lookUpTimes[i] - sampleTimes[j];
+          uint64_t closestDifference = sampleTimes[closest] > lookUpTimes[i] ? sampleTimes[closest] - lookUpTimes[i] : lookUpTimes[i] - sampleTimes[closest];
+
+          if (difference < closestDifference)
+            {
+              closest = j;
+              tie = false;
+            }
+          else if (difference == closestDifference)
+            {
+              tie = true;
+            }
+        }
+
+      if (!tie)
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_rowValues[i][0], rows[closest][0], "Time of lookup " << i << " is not the closest time sample");
+          NS_TEST_ASSERT_MSG_EQ (m_rowValues[i][1], rows[closest][1], "Value 1 of lookup " << i << " is not the closest time sample");
+          NS_TEST_ASSERT_MSG_EQ (m_rowValues[i][2], rows[closest][2], "Value 2 of lookup " << i << " is not the closest time sample");
+        }
+    }
+
+  m_rowContainer = NULL;
+  m_columnContainer = NULL;
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the input file stream containers.
+ */
+class SatInputFileStreamTestSuite : public TestSuite
+{
+public:
+  SatInputFileStreamTestSuite ();
+};
+
+SatInputFileStreamTestSuite::SatInputFileStreamTestSuite ()
+  : TestSuite ("sat-input-fstream", UNIT)
+{
+  AddTestCase (new SatInputFileStreamTimeDoubleColumnTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatInputFileStreamTestSuite satInputFileStreamTestSuite;
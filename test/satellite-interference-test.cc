@@ -36,6 +36,9 @@
 #include "../model/satellite-constant-interference.h"
 #include "../model/satellite-traced-interference.h"
 #include "../model/satellite-per-packet-interference.h"
+#include "../model/satellite-per-packet-bucketed-interference.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/singleton.h"
 #include "../utils/satellite-env-variables.h"
 
@@ -239,6 +242,165 @@ SatPerPacketInterferenceTestCase::DoRun (void)
   Singleton<SatEnvVariables>::Get ()->DoDispose ();
 }
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test satellite per packet bucketed interference model.
+ *
+ * This case tests that SatPerPacketBucketedInterference calculates the same interference
+ * as SatPerPacketInterference.
+ *  1.  Create SatPerPacketInterference and SatPerPacketBucketedInterference objects.
+ *  2.  Add the interfering events of SatPerPacketInterferenceTestCase to both and check
+ *      the calculated values against the expected ones.
+ *  3.  Add a random set of interfering and received events to both and calculate
+ *      interference for the received events with both.
+ *
+ *  Expected result:
+ *   Values calculated by the models should be equal within floating point tolerance.
+ *
+ */
+class SatPerPacketBucketedInterferenceTestCase : public TestCase
+{
+public:
+  SatPerPacketBucketedInterferenceTestCase ();
+  virtual ~SatPerPacketBucketedInterferenceTestCase ();
+
+  // adds interference to model objects
+  void AddInterference (Time duration, double power, Address rxAddress);
+
+  // adds receivers own interference to model objects and schedules receiving
+  void StartReceiver (Time duration, double power, Address rxAddress);
+
+  // receives packets i.e. calculates interference and stops receiving.
+  void Receive (uint32_t rxIndex);
+
+private:
+  virtual void DoRun (void);
+  Ptr<SatPerPacketInterference> m_interference;
+  Ptr<SatPerPacketBucketedInterference> m_bucketedInterference;
+  std::vector<Ptr<SatInterference::InterferenceChangeEvent> > m_rxEvents;
+  std::vector<Ptr<SatInterference::InterferenceChangeEvent> > m_bucketedRxEvents;
+  std::vector<double> m_finalPower;
+  std::vector<double> m_bucketedFinalPower;
+};
+
+SatPerPacketBucketedInterferenceTestCase::SatPerPacketBucketedInterferenceTestCase ()
+  : TestCase ("Test satellite per packet bucketed interference model.")
+{
+}
+
+SatPerPacketBucketedInterferenceTestCase::~SatPerPacketBucketedInterferenceTestCase ()
+{
+}
+
+void
+SatPerPacketBucketedInterferenceTestCase::AddInterference (Time duration, double power, Address rxAddress)
+{
+  m_interference->Add (duration, power, rxAddress);
+  m_bucketedInterference->Add (duration, power, rxAddress);
+}
+
+void
+SatPerPacketBucketedInterferenceTestCase::StartReceiver (Time duration, double power, Address rxAddress)
+{
+  m_rxEvents.push_back (m_interference->Add (duration, power, rxAddress));
+  m_bucketedRxEvents.push_back (m_bucketedInterference->Add (duration, power, rxAddress));
+  m_finalPower.push_back (0.0);
+  m_bucketedFinalPower.push_back (0.0);
+
+  m_interference->NotifyRxStart (m_rxEvents.back ());
+  m_bucketedInterference->NotifyRxStart (m_bucketedRxEvents.back ());
+
+  Simulator::Schedule (duration, &SatPerPacketBucketedInterferenceTestCase::Receive, this, m_rxEvents.size () - 1);
+}
+
+void
+SatPerPacketBucketedInterferenceTestCase::Receive (uint32_t rxIndex)
+{
+  m_finalPower[rxIndex] = m_interference->Calculate (m_rxEvents[rxIndex]);
+  m_interference->NotifyRxEnd (m_rxEvents[rxIndex]);
+
+  m_bucketedFinalPower[rxIndex] = m_bucketedInterference->Calculate (m_bucketedRxEvents[rxIndex]);
+  m_bucketedInterference->NotifyRxEnd (m_bucketedRxEvents[rxIndex]);
+}
+
+void
+SatPerPacketBucketedInterferenceTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-if-unit", "perpacketbucketed", true);
+
+  m_interference = CreateObject<SatPerPacketInterference> ();
+  m_bucketedInterference = CreateObject<SatPerPacketBucketedInterference> ();
+  m_bucketedInterference->SetAttribute ("BucketWidth", TimeValue (Time (16)));
+
+  // same interferences and receiving as in the per packet interference test case
+  Simulator::Schedule (Time (0), &SatPerPacketBucketedInterferenceTestCase::AddInterference, this, Time (60), 60, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (10), &SatPerPacketBucketedInterferenceTestCase::AddInterference, this, Time (40), 70, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (30), &SatPerPacketBucketedInterferenceTestCase::AddInterference, this, Time (50), 10, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (50), &SatPerPacketBucketedInterferenceTestCase::AddInterference, this, Time (40), 20, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (10), &SatPerPacketBucketedInterferenceTestCase::StartReceiver, this, Time (90), 50, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (20), &SatPerPacketBucketedInterferenceTestCase::StartReceiver, this, Time (50), 5, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (30), &SatPerPacketBucketedInterferenceTestCase::StartReceiver, this, Time (60), 30, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  Simulator::Schedule (Time (50), &SatPerPacketBucketedInterferenceTestCase::StartReceiver, this, Time (20), 40, Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_bucketedFinalPower[0], (double)995 / (double)9, 0.0000000000001, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_bucketedFinalPower[1], (double)196, 0.0000000000001, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_bucketedFinalPower[2], (double)850 / (double)6, 0.0000000000001, "Final power incorrect");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_bucketedFinalPower[3], (double)145, 0.00000000000001, "Final power incorrect");
+
+  Simulator::Destroy ();
+
+  // random interferences and receiving, calculated with both models
+  m_interference = CreateObject<SatPerPacketInterference> ();
+  m_bucketedInterference = CreateObject<SatPerPacketBucketedInterference> ();
+  m_bucketedInterference->SetAttribute ("BucketWidth", TimeValue (MicroSeconds (50)));
+  m_rxEvents.clear ();
+  m_bucketedRxEvents.clear ();
+  m_finalPower.clear ();
+  m_bucketedFinalPower.clear ();
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Time startTime = NanoSeconds (random->GetInteger (0, 10000000));
+      Time duration = NanoSeconds (random->GetInteger (1000, 500000));
+      double power = 1e-12 * random->GetValue (0.1, 10.0);
+      Address address = Mac48Address::ConvertFrom (Mac48Address::Allocate ());
+
+      if (i % 4 == 0)
+        {
+          Simulator::Schedule (startTime, &SatPerPacketBucketedInterferenceTestCase::StartReceiver, this, duration, power, address);
+        }
+      else
+        {
+          Simulator::Schedule (startTime, &SatPerPacketBucketedInterferenceTestCase::AddInterference, this, duration, power, address);
+        }
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_bucketedFinalPower.size (), 500, "Calculations missing");
+
+  for (uint32_t i = 0; i < m_finalPower.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_bucketedFinalPower[i], m_finalPower[i], 1e-9 * m_finalPower[i] + 1e-24, "Final power differs from per packet interference model");
+    }
+
+  Simulator::Destroy ();
+
+  m_interference = NULL;
+  m_bucketedInterference = NULL;
+  m_rxEvents.clear ();
+  m_bucketedRxEvents.clear ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 /**
  * \ingroup satellite
  * \brief Test suite for Satellite interference unit test cases.
@@ -254,6 +416,7 @@ SatInterferenceTestSuite::SatInterferenceTestSuite ()
 {
   AddTestCase (new SatConstantInterferenceTestCase, TestCase::QUICK);
   AddTestCase (new SatPerPacketInterferenceTestCase, TestCase::QUICK);
+  AddTestCase (new SatPerPacketBucketedInterferenceTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-output-fstream-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the output file stream containers.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "../utils/satellite-output-fstream-double-container.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that flushing the rows of the double container
+ * to the file during the simulation does not change the file or the figure.
+ *
+ * 1. Write rows with the flush threshold of zero, which keeps the rows in memory.
+ * 2. Write the same rows to the same file with the flush threshold of one.
+ * 3. Write rows after stale rows of a file opened in the append mode, with
+ *    the flush threshold of zero and the figure output enabled before the rows.
+ * 4. Write the same rows after the same stale rows with the flush threshold
+ *    of one and the figure output enabled after the rows.
+ *
+ * Expected result:
+ *   • Identical file and figure contents in the steps 1 and 2.
+ *   • Identical file and figure contents in the steps 3 and 4, i.e. the stale
+ *     rows are not in the figure.
+ */
+class SatOutputFileStreamDoubleFlushTestCase : public TestCase
+{
+public:
+  SatOutputFileStreamDoubleFlushTestCase ();
+  virtual ~SatOutputFileStreamDoubleFlushTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Write rows to a file with a double container
+   * \param fileName file name
+   * \param fileMode file mode
+   * \param flushThreshold flush threshold of the container
+   * \param figureAfterRows enable the figure output after adding the rows
+   * \param rows rows to write
+   */
+  void WriteRows (std::string fileName, std::ios::openmode fileMode, uint32_t flushThreshold,
+                  bool figureAfterRows, const std::vector<std::vector<double> >& rows);
+
+  /**
+   * \brief Read the contents of a file
+   * \param fileName file name
+   * \return file contents
+   */
+  std::string ReadFile (std::string fileName);
+
+  /**
+   * \brief Write stale rows to a file
+   * \param fileName file name
+   */
+  void WriteStaleRows (std::string fileName);
+};
+
+SatOutputFileStreamDoubleFlushTestCase::SatOutputFileStreamDoubleFlushTestCase ()
+  : TestCase ("Test identical output of the double container with and without flushing.")
+{
+}
+
+SatOutputFileStreamDoubleFlushTestCase::~SatOutputFileStreamDoubleFlushTestCase ()
+{
+}
+
+void
+SatOutputFileStreamDoubleFlushTestCase::WriteRows (std::string fileName, std::ios::openmode fileMode, uint32_t flushThreshold,
+                                                   bool figureAfterRows, const std::vector<std::vector<double> >& rows)
+{
+  Ptr<SatOutputFileStreamDoubleContainer> container = CreateObject<SatOutputFileStreamDoubleContainer> (fileName, fileMode, 2);
+  container->SetAttribute ("FlushThreshold", UintegerValue (flushThreshold));
+
+  if (!figureAfterRows)
+    {
+      container->EnableFigureOutput ("Test", "Time (s)", "Value", "set key top right",
+                                     SatOutputFileStreamDoubleContainer::RAW, Gnuplot2dDataset::LINES);
+    }
+
+  for (uint32_t i = 0; i < rows.size (); i++)
+    {
+      container->AddToContainer (rows[i]);
+    }
+
+  if (figureAfterRows)
+    {
+      container->EnableFigureOutput ("Test", "Time (s)", "Value", "set key top right",
+                                     SatOutputFileStreamDoubleContainer::RAW, Gnuplot2dDataset::LINES);
+    }
+
+  container->WriteContainerToFile ();
+}
+
+std::string
+SatOutputFileStreamDoubleFlushTestCase::ReadFile (std::string fileName)
+{
+  std::ifstream ifs (fileName.c_str ());
+  std::stringstream contents;
+  contents << ifs.rdbuf ();
+  return contents.str ();
+}
+
+void
+SatOutputFileStreamDoubleFlushTestCase::WriteStaleRows (std::string fileName)
+{
+  std::ofstream ofs (fileName.c_str ());
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      ofs << 100.0 + i << "\t" << -1.0 << "\n";
+    }
+}
+
+void
+SatOutputFileStreamDoubleFlushTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("sat-output-fstream-double-test");
+  std::string plotFileName = fileName + ".plt";
+
+  // Values with more significant digits than written to the file
+  std::vector<std::vector<double> > rows;
+
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      std::vector<double> row;
+      row.push_back (i / 3.0);
+      row.push_back (1.0e-13 / (i + 7.0));
+      rows.push_back (row);
+    }
+
+  WriteRows (fileName, std::ios::out, 0, false, rows);
+  std::string file = ReadFile (fileName);
+  std::string plot = ReadFile (plotFileName);
+
+  WriteRows (fileName, std::ios::out, 1, false, rows);
+  std::string flushedFile = ReadFile (fileName);
+  std::string flushedPlot = ReadFile (plotFileName);
+
+  NS_TEST_ASSERT_MSG_NE (file, "", "No rows written to the file");
+  NS_TEST_ASSERT_MSG_EQ (flushedFile, file, "Flushed file not what expected");
+  NS_TEST_ASSERT_MSG_EQ (flushedPlot, plot, "Figure of the flushed file not what expected");
+
+  // Values exactly represented in the file, since the rows flushed before
+  // enabling the figure output are read back from the file
+  std::vector<std::vector<double> > exactRows;
+
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      std::vector<double> row;
+      row.push_back (i * 0.5);
+      row.push_back (i + 0.25);
+      exactRows.push_back (row);
+    }
+
+  WriteStaleRows (fileName);
+  WriteRows (fileName, std::ios::out | std::ios::app, 0, false, exactRows);
+  std::string appendedFile = ReadFile (fileName);
+  std::string appendedPlot = ReadFile (plotFileName);
+
+  WriteStaleRows (fileName);
+  WriteRows (fileName, std::ios::out | std::ios::app, 1, true, exactRows);
+  std::string flushedAppendedFile = ReadFile (fileName);
+  std::string flushedAppendedPlot = ReadFile (plotFileName);
+
+  NS_TEST_ASSERT_MSG_EQ (flushedAppendedFile, appendedFile, "Flushed appended file not what expected");
+  NS_TEST_ASSERT_MSG_EQ (flushedAppendedPlot, appendedPlot, "Figure of the flushed appended file not what expected");
+  NS_TEST_ASSERT_MSG_EQ (appendedPlot.find ("100\t-1"), std::string::npos, "Stale row in the figure");
+  NS_TEST_ASSERT_MSG_EQ (appendedPlot.find ("100 -1"), std::string::npos, "Stale row in the figure");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the output file stream containers.
+ */
+class SatOutputFileStreamTestSuite : public TestSuite
+{
+public:
+  SatOutputFileStreamTestSuite ();
+};
+
+SatOutputFileStreamTestSuite::SatOutputFileStreamTestSuite ()
+  : TestSuite ("sat-output-fstream", UNIT)
+{
+  AddTestCase (new SatOutputFileStreamDoubleFlushTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatOutputFileStreamTestSuite satOutputFileStreamTestSuite;
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-packet-trace-test.cc
+ * \ingroup satellite
+ * \brief Test cases to verify the binary output of the packet trace.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/config.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/singleton.h"
+#include "../model/satellite-mac-tag.h"
+#include "../model/satellite-packet-trace.h"
+#include "../model/satellite-packet-trace-record.h"
+#include "../utils/satellite-env-variables.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to verify that a binary packet trace rendered to text is
+ * identical to the text packet trace of the same packet events.
+ *
+ *  Expected result:
+ *    Text trace and the converted binary trace have the same contents.
+ */
+class SatBinaryPacketTraceTestCase : public TestCase
+{
+public:
+  SatBinaryPacketTraceTestCase ();
+  virtual ~SatBinaryPacketTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Read the lines of a file
+   * \param fileName File name
+   * \return lines of the file
+   */
+  std::vector<std::string> ReadLines (std::string fileName);
+};
+
+SatBinaryPacketTraceTestCase::SatBinaryPacketTraceTestCase ()
+  : TestCase ("Test that binary packet trace converts to the text packet trace.")
+{
+}
+
+SatBinaryPacketTraceTestCase::~SatBinaryPacketTraceTestCase ()
+{
+}
+
+std::vector<std::string>
+SatBinaryPacketTraceTestCase::ReadLines (std::string fileName)
+{
+  std::vector<std::string> lines;
+  std::ifstream ifs (fileName.c_str ());
+  std::string line;
+
+  while (std::getline (ifs, line))
+    {
+      lines.push_back (line);
+    }
+
+  return lines;
+}
+
+void
+SatBinaryPacketTraceTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-packet-trace", "", true);
+
+  std::string outputPath = Singleton<SatEnvVariables>::Get ()->GetOutputPath ();
+
+  Config::SetDefault ("ns3::SatPacketTrace::FileName", StringValue ("PacketTraceText"));
+  Ptr<SatPacketTrace> textTrace = CreateObject<SatPacketTrace> ();
+
+  // Use small pages to exercise the page handover to the writer thread
+  Config::SetDefault ("ns3::SatPacketTrace::FileName", StringValue ("PacketTraceBinary"));
+  Config::SetDefault ("ns3::SatPacketTrace::OutputFormat", EnumValue (SatPacketTrace::OUTPUT_BINARY));
+  Config::SetDefault ("ns3::SatPacketTrace::PageSize", UintegerValue (1024));
+  Ptr<SatPacketTrace> binaryTrace = CreateObject<SatPacketTrace> ();
+
+  Config::SetDefault ("ns3::SatPacketTrace::FileName", StringValue ("PacketTrace"));
+  Config::SetDefault ("ns3::SatPacketTrace::OutputFormat", EnumValue (SatPacketTrace::OUTPUT_TEXT));
+  Config::SetDefault ("ns3::SatPacketTrace::PageSize", UintegerValue (1048576));
+
+  Mac48Address utAddress = Mac48Address::Allocate ();
+  Mac48Address gwAddress = Mac48Address::Allocate ();
+  uint32_t entries (1000);
+
+  for (uint32_t i = 0; i < entries; ++i)
+    {
+      // Vary the number of packets, including large containers not fitting to one page
+      uint32_t nPackets = (i % 100 == 0) ? 60 : (i % 5);
+      SatPacketTraceRecord::PacketContainer_t packets;
+
+      for (uint32_t j = 0; j < nPackets; ++j)
+        {
+          Ptr<Packet> packet = Create<Packet> (100);
+
+          if (j % 2 == 0)
+            {
+              SatMacTag tag;
+              tag.SetSourceAddress (utAddress);
+              tag.SetDestAddress (gwAddress);
+              packet->AddPacketTag (tag);
+            }
+
+          packets.push_back (packet);
+        }
+
+      SatPacketTraceRecord record (Seconds (i * 0.0013),
+                                   (i % 2) ? SatEnums::PACKET_SENT : SatEnums::PACKET_RECV,
+                                   SatEnums::NT_UT,
+                                   i % 7,
+                                   (i % 3) ? utAddress : gwAddress,
+                                   SatEnums::LL_MAC,
+                                   (i % 2) ? SatEnums::LD_RETURN : SatEnums::LD_FORWARD,
+                                   packets);
+
+      textTrace->AddTraceEntry (record);
+      binaryTrace->AddTraceEntry (record);
+    }
+
+  textTrace->Dispose ();
+  binaryTrace->Dispose ();
+
+  uint64_t converted = SatPacketTrace::ConvertBinaryToText (outputPath + "/PacketTraceBinary.bin",
+                                                            outputPath + "/PacketTraceConverted.log");
+
+  NS_TEST_ASSERT_MSG_EQ (converted, entries, "Unexpected number of converted entries");
+
+  std::vector<std::string> textLines = ReadLines (outputPath + "/PacketTraceText.log");
+  std::vector<std::string> convertedLines = ReadLines (outputPath + "/PacketTraceConverted.log");
+
+  NS_TEST_ASSERT_MSG_EQ (convertedLines.size (), textLines.size (), "Unexpected number of lines");
+
+  for (uint32_t i = 0; i < textLines.size () && i < convertedLines.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (convertedLines[i], textLines[i], "Line " << i << " differs");
+    }
+
+  Simulator::Destroy ();
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the packet trace.
+ */
+class SatPacketTraceTestSuite : public TestSuite
+{
+public:
+  SatPacketTraceTestSuite ();
+};
+
+SatPacketTraceTestSuite::SatPacketTraceTestSuite ()
+  : TestSuite ("sat-packet-trace-test", UNIT)
+{
+  AddTestCase (new SatBinaryPacketTraceTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatPacketTraceTestSuite satPacketTraceTestSuite;
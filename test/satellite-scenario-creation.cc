@@ -28,11 +28,15 @@
  *
  */
 
+#include <vector>
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/test.h"
 #include "ns3/simulator.h"
 #include "ns3/core-module.h"
 #include "../helper/satellite-helper.h"
+#include "../model/satellite-mobility-model.h"
 #include "ns3/singleton.h"
 #include "ns3/satellite-id-mapper.h"
 #include "../utils/satellite-env-variables.h"
@@ -319,6 +323,122 @@ ScenarioCreationUser::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief 'Scenario Creation, Threads' test case implementation.
+ *
+ * This case tests that the scenario created with several scenario creation
+ * threads is identical to the scenario created with one thread.
+ *  1.  User defined test scenario created with helper using one thread.
+ *  2.  Same scenario created with a new helper using four threads.
+ *
+ *  Expected result:
+ *    • Same UTs in the same beams and same UT positions in both scenarios.
+ *
+ */
+class ScenarioCreationThreads : public TestCase
+{
+public:
+  ScenarioCreationThreads ();
+  virtual ~ScenarioCreationThreads ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Create the user defined scenario and get the UT positions of it
+   * \param threads Number of scenario creation threads
+   * \return UT positions per beam id, in the creation order of the UTs
+   */
+  std::map<uint32_t, std::vector<GeoCoordinate> > CreateScenario (uint32_t threads);
+};
+
+// Add some help text to this case to describe what it is intended to test
+ScenarioCreationThreads::ScenarioCreationThreads ()
+  : TestCase ("'Scenario Creation, Threads' case tests identical scenario creation with several threads")
+{
+}
+
+// This destructor does nothing but we include it as a reminder that
+// the test case should clean up after itself
+ScenarioCreationThreads::~ScenarioCreationThreads ()
+{
+}
+
+std::map<uint32_t, std::vector<GeoCoordinate> >
+ScenarioCreationThreads::CreateScenario (uint32_t threads)
+{
+  // Reset singletons and the random variable streams, so that both
+  // scenarios use the same streams
+  Singleton<SatIdMapper>::Get ()->Reset ();
+  RngSeedManager::ResetNextStreamIndex ();
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+  helper->SetAttribute ("ScenarioCreationThreads", UintegerValue (threads));
+
+  SatBeamUserInfo beamInfo = SatBeamUserInfo (3,1);
+  std::map<uint32_t, SatBeamUserInfo > beamMap;
+  uint32_t beams[] = { 1, 8, 15, 27, 40, 53, 60, 72 };
+
+  for (uint32_t i = 0; i < sizeof (beams) / sizeof (beams[0]); ++i)
+    {
+      beamMap[beams[i]] = beamInfo;
+    }
+
+  helper->CreateUserDefinedScenario (beamMap);
+
+  std::map<uint32_t, std::vector<GeoCoordinate> > positions;
+  std::list<uint32_t> beamIds = helper->GetBeamHelper ()->GetBeams ();
+
+  for (std::list<uint32_t>::iterator it = beamIds.begin (); it != beamIds.end (); ++it)
+    {
+      NodeContainer uts = helper->GetBeamHelper ()->GetUtNodes (*it);
+
+      for (NodeContainer::Iterator ut = uts.Begin (); ut != uts.End (); ++ut)
+        {
+          positions[*it].push_back ((*ut)->GetObject<SatMobilityModel> ()->GetGeoPosition ());
+        }
+    }
+
+  helper = NULL;
+  Simulator::Destroy ();
+
+  return positions;
+}
+
+//
+// ScenarioCreationThreads TestCase implementation
+//
+void
+ScenarioCreationThreads::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-scenario-creation", "threads-scenario", true);
+
+  std::map<uint32_t, std::vector<GeoCoordinate> > positions = CreateScenario (1);
+  std::map<uint32_t, std::vector<GeoCoordinate> > threadedPositions = CreateScenario (4);
+
+  NS_TEST_ASSERT_MSG_EQ (positions.size (), 8, "Beam count is not what expected!");
+  NS_TEST_ASSERT_MSG_EQ (threadedPositions.size (), positions.size (), "Beam count is not what expected!");
+
+  for (std::map<uint32_t, std::vector<GeoCoordinate> >::iterator it = positions.begin (); it != positions.end (); ++it)
+    {
+      std::map<uint32_t, std::vector<GeoCoordinate> >::iterator threaded = threadedPositions.find (it->first);
+
+      NS_TEST_ASSERT_MSG_EQ ((threaded != threadedPositions.end ()), true, "Beam " << it->first << " is missing!");
+      NS_TEST_ASSERT_MSG_EQ (threaded->second.size (), it->second.size (), "UT count of beam " << it->first << " is not what expected!");
+
+      for (uint32_t i = 0; i < it->second.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (threaded->second[i].GetLatitude (), it->second[i].GetLatitude (), "UT latitude is not what expected!");
+          NS_TEST_ASSERT_MSG_EQ (threaded->second[i].GetLongitude (), it->second[i].GetLongitude (), "UT longitude is not what expected!");
+          NS_TEST_ASSERT_MSG_EQ (threaded->second[i].GetAltitude (), it->second[i].GetAltitude (), "UT altitude is not what expected!");
+        }
+    }
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
 // The TestSuite class names the TestSuite as sat-scenario-creation, identifies what type of TestSuite (SYSTEM),
 // and enables the TestCases to be run. Typically, only the constructor for
 // this class must be defined
@@ -344,6 +464,9 @@ ScenarioCreationTestSuite::ScenarioCreationTestSuite ()
   // add ScenarioCreationUser case to suite sat-scenario-creation
   AddTestCase (new ScenarioCreationUser, TestCase::QUICK);
 
+  // add ScenarioCreationThreads case to suite sat-scenario-creation
+  AddTestCase (new ScenarioCreationThreads, TestCase::QUICK);
+
 }
 
 // Allocate an instance of this TestSuite
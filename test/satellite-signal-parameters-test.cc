@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-signal-parameters-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the signal parameters.
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "../model/satellite-signal-parameters.h"
+#include "../model/satellite-mac-tag.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the copy-on-write packets of the signal parameters.
+ *
+ *  1.  Set tagged packets of a transmitter to signal parameters and copy them
+ *      for two receivers.
+ *  2.  Get the packets of the first receiver for modification and remove the tags.
+ *  3.  Get the packets of the transmitter signal parameters for modification.
+ *
+ *  Expected result:
+ *   The copies share the packets of the transmitter until they are get for
+ *   modification. The packets for modification are copies, which are returned
+ *   again without copying. Removing their tags does not change the packets of
+ *   the transmitter or the other receiver.
+ */
+class SatSignalParametersCopyOnWriteTestCase : public TestCase
+{
+public:
+  SatSignalParametersCopyOnWriteTestCase ();
+  virtual ~SatSignalParametersCopyOnWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatSignalParametersCopyOnWriteTestCase::SatSignalParametersCopyOnWriteTestCase ()
+  : TestCase ("Test copy-on-write packets of the signal parameters.")
+{
+}
+
+SatSignalParametersCopyOnWriteTestCase::~SatSignalParametersCopyOnWriteTestCase ()
+{
+}
+
+void
+SatSignalParametersCopyOnWriteTestCase::DoRun (void)
+{
+  SatSignalParameters::PacketsInBurst_t packets;
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<Packet> packet = Create<Packet> (100 + i);
+      SatMacTag tag;
+      tag.SetDestAddress (Mac48Address ("00:00:00:00:00:01"));
+      packet->AddPacketTag (tag);
+      packets.push_back (packet);
+    }
+
+  Ptr<SatSignalParameters> txParams = CreateObject<SatSignalParameters> ();
+  txParams->SetPackets (packets);
+
+  Ptr<SatSignalParameters> firstRxParams = txParams->Copy ();
+  Ptr<SatSignalParameters> secondRxParams = txParams->Copy ();
+
+  NS_TEST_ASSERT_MSG_EQ (firstRxParams->GetPackets ().size (), packets.size (), "Packet count of the copy incorrect");
+
+  for (uint32_t i = 0; i < packets.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((firstRxParams->GetPackets ()[i] == packets[i]), true, "Packet " << i << " not shared by the copy");
+      NS_TEST_ASSERT_MSG_EQ ((secondRxParams->GetPackets ()[i] == packets[i]), true, "Packet " << i << " not shared by the copy");
+    }
+
+  const SatSignalParameters::PacketsInBurst_t& writablePackets = firstRxParams->GetWritablePackets ();
+
+  NS_TEST_ASSERT_MSG_EQ (writablePackets.size (), packets.size (), "Writable packet count incorrect");
+
+  for (uint32_t i = 0; i < writablePackets.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((writablePackets[i] == packets[i]), false, "Writable packet " << i << " shared with the transmitter");
+      NS_TEST_ASSERT_MSG_EQ (writablePackets[i]->GetUid (), packets[i]->GetUid (), "Writable packet " << i << " UID incorrect");
+      NS_TEST_ASSERT_MSG_EQ (writablePackets[i]->GetSize (), packets[i]->GetSize (), "Writable packet " << i << " size incorrect");
+
+      SatMacTag tag;
+      NS_TEST_ASSERT_MSG_EQ (writablePackets[i]->RemovePacketTag (tag), true, "Tag of writable packet " << i << " missing");
+    }
+
+  // the packets owned by the copy are not copied again
+  NS_TEST_ASSERT_MSG_EQ ((firstRxParams->GetWritablePackets ()[0] == writablePackets[0]), true, "Owned packets copied again");
+  NS_TEST_ASSERT_MSG_EQ ((firstRxParams->GetPackets ()[0] == writablePackets[0]), true, "Owned packets not returned for reading");
+
+  for (uint32_t i = 0; i < packets.size (); i++)
+    {
+      SatMacTag tag;
+      NS_TEST_ASSERT_MSG_EQ (packets[i]->PeekPacketTag (tag), true, "Tag of transmitter packet " << i << " removed");
+      NS_TEST_ASSERT_MSG_EQ ((txParams->GetPackets ()[i] == packets[i]), true, "Packet " << i << " of the transmitter changed");
+      NS_TEST_ASSERT_MSG_EQ ((secondRxParams->GetPackets ()[i] == packets[i]), true, "Packet " << i << " of the other copy changed");
+      NS_TEST_ASSERT_MSG_EQ (secondRxParams->GetPackets ()[i]->PeekPacketTag (tag), true, "Tag of the other copy packet " << i << " removed");
+    }
+
+  // the packets set by the transmitter are copied for modification, even if
+  // the signal parameters are not shared anymore
+  firstRxParams = NULL;
+  secondRxParams = NULL;
+
+  NS_TEST_ASSERT_MSG_EQ ((txParams->GetWritablePackets ()[0] == packets[0]), false, "Transmitter packets returned for modification");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the memory reuse of the signal parameters.
+ *
+ *  1.  Create signal parameters and a copy of them and release them.
+ *  2.  Create signal parameters and a copy of them again.
+ *
+ *  Expected result:
+ *   The memory of the released signal parameters is reused in the reverse
+ *   order of releasing them. The reused signal parameters are initialized.
+ */
+class SatSignalParametersPoolTestCase : public TestCase
+{
+public:
+  SatSignalParametersPoolTestCase ();
+  virtual ~SatSignalParametersPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SatSignalParametersPoolTestCase::SatSignalParametersPoolTestCase ()
+  : TestCase ("Test memory reuse of the signal parameters.")
+{
+}
+
+SatSignalParametersPoolTestCase::~SatSignalParametersPoolTestCase ()
+{
+}
+
+void
+SatSignalParametersPoolTestCase::DoRun (void)
+{
+  Ptr<SatSignalParameters> params = CreateObject<SatSignalParameters> ();
+  params->m_beamId = 5;
+  params->SetPackets (SatSignalParameters::PacketsInBurst_t (1, Create<Packet> (100)));
+
+  Ptr<SatSignalParameters> copy = params->Copy ();
+
+  const SatSignalParameters* paramsMemory = PeekPointer (params);
+  const SatSignalParameters* copyMemory = PeekPointer (copy);
+
+  NS_TEST_ASSERT_MSG_EQ (copy->m_beamId, 5, "Beam ID of the copy incorrect");
+
+  // the copy is released first, thus its memory is reused last
+  copy = NULL;
+  params = NULL;
+
+  Ptr<SatSignalParameters> reusedParams = CreateObject<SatSignalParameters> ();
+  Ptr<SatSignalParameters> reusedCopy = reusedParams->Copy ();
+
+  NS_TEST_ASSERT_MSG_EQ ((PeekPointer (reusedParams) == paramsMemory), true, "Memory of the released signal parameters not reused");
+  NS_TEST_ASSERT_MSG_EQ ((PeekPointer (reusedCopy) == copyMemory), true, "Memory of the released copy not reused");
+  NS_TEST_ASSERT_MSG_EQ (reusedParams->m_beamId, 0, "Reused signal parameters not initialized");
+  NS_TEST_ASSERT_MSG_EQ (reusedParams->GetPackets ().size (), 0, "Reused signal parameters have packets");
+  NS_TEST_ASSERT_MSG_EQ (reusedCopy->GetPackets ().size (), 0, "Copy of the reused signal parameters has packets");
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the signal parameters.
+ */
+class SatSignalParametersTestSuite : public TestSuite
+{
+public:
+  SatSignalParametersTestSuite ();
+};
+
+SatSignalParametersTestSuite::SatSignalParametersTestSuite ()
+  : TestSuite ("sat-signal-parameters", UNIT)
+{
+  AddTestCase (new SatSignalParametersCopyOnWriteTestCase, TestCase::QUICK);
+  AddTestCase (new SatSignalParametersPoolTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatSignalParametersTestSuite satSignalParametersTestSuite;
@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-stats-replication-merger-test.cc
+ * \ingroup satellite
+ * \brief Test cases to unit test the merging of replication statistics files.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/singleton.h"
+#include "../utils/satellite-env-variables.h"
+#include "../stats/satellite-stats-replication-merger.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the merging of scalar and CDF files of
+ * replications with SatStatsReplicationMerger.
+ *
+ * This case writes hand-made scalar and CDF files of three replications to
+ * temporary directories and merges them.
+ *
+ *   1.  Row "1" of the scalar file has values 100, 110 and 120, row "2" has
+ *       values 200 and 220 in the first and third replication and row "3"
+ *       has value 5 in the second replication only.
+ *   2.  The CDF file has values 0.2, 0.4 and 0.6 for the row "0.5".
+ *   3.  The second replication has an additional heading line.
+ *
+ *   Expected result:
+ *     The merged rows have the mean, the half width of the 95% confidence
+ *     interval (Student's t-distribution) and the number of replications of
+ *     the row. The heading lines of all the replications are in the merged
+ *     files.
+ *
+ */
+class SatStatsReplicationMergerTestCase : public TestCase
+{
+public:
+  SatStatsReplicationMergerTestCase ();
+  virtual ~SatStatsReplicationMergerTestCase ();
+
+private:
+  /**
+   * \brief Merged row of a statistics file
+   */
+  typedef struct
+  {
+    double m_mean;
+    double m_ci;
+    uint32_t m_n;
+  } MergedRow_t;
+
+  void WriteFile (std::string fileName, std::string content);
+  void ReadMergedFile (std::string fileName, std::vector<std::string> &headings,
+                       std::map<std::string, MergedRow_t> &rows);
+  virtual void DoRun (void);
+};
+
+SatStatsReplicationMergerTestCase::SatStatsReplicationMergerTestCase ()
+  : TestCase ("Test merging of replication statistics files.")
+{
+}
+
+SatStatsReplicationMergerTestCase::~SatStatsReplicationMergerTestCase ()
+{
+}
+
+void
+SatStatsReplicationMergerTestCase::WriteFile (std::string fileName, std::string content)
+{
+  std::ofstream output (fileName.c_str (), std::ios::out | std::ios::trunc);
+  NS_TEST_ASSERT_MSG_EQ (output.is_open (), true, "Unable to open file " << fileName);
+  output << content;
+}
+
+void
+SatStatsReplicationMergerTestCase::ReadMergedFile (std::string fileName,
+                                                   std::vector<std::string> &headings,
+                                                   std::map<std::string, MergedRow_t> &rows)
+{
+  std::ifstream input (fileName.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (input.is_open (), true, "Unable to open merged file " << fileName);
+
+  std::string line;
+
+  while (std::getline (input, line))
+    {
+      if (line.empty ())
+        {
+          continue;
+        }
+
+      if (line[0] == '%')
+        {
+          headings.push_back (line);
+          continue;
+        }
+
+      std::istringstream iss (line);
+      std::string key;
+      MergedRow_t row;
+
+      NS_TEST_ASSERT_MSG_EQ ((bool)(iss >> key >> row.m_mean >> row.m_ci >> row.m_n), true,
+                             "Invalid merged row: " << line);
+      rows[key] = row;
+    }
+}
+
+void
+SatStatsReplicationMergerTestCase::DoRun (void)
+{
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-stats-replication-merger", "", true);
+
+  std::string outputPath = CreateTempDirFilename ("merged");
+  Singleton<SatEnvVariables>::Get ()->CreateDirectory (outputPath);
+
+  std::vector<std::string> runPaths;
+  runPaths.push_back (CreateTempDirFilename ("run-1"));
+  runPaths.push_back (CreateTempDirFilename ("run-2"));
+  runPaths.push_back (CreateTempDirFilename ("run-3"));
+
+  for (std::vector<std::string>::const_iterator it = runPaths.begin (); it != runPaths.end (); ++it)
+    {
+      Singleton<SatEnvVariables>::Get ()->CreateDirectory (*it);
+    }
+
+  WriteFile (runPaths[0] + "/stat-throughput-scalar.txt",
+             "% beam_id throughput_kbps\n1 100\n2 200\n");
+  WriteFile (runPaths[1] + "/stat-throughput-scalar.txt",
+             "% beam_id throughput_kbps\n% replication 2\n1 110\n3 5\n");
+  WriteFile (runPaths[2] + "/stat-throughput-scalar.txt",
+             "% beam_id throughput_kbps\n1 120\n2 220\n");
+
+  WriteFile (runPaths[0] + "/stat-delay-cdf.txt", "% delay_sec cdf\n0.5 0.2\n");
+  WriteFile (runPaths[1] + "/stat-delay-cdf.txt", "% delay_sec cdf\n0.5 0.4\n");
+  WriteFile (runPaths[2] + "/stat-delay-cdf.txt", "% delay_sec cdf\n0.5 0.6\n");
+
+  // Not a statistics file, ignored by the merger
+  WriteFile (runPaths[0] + "/notes.txt", "1 1\n");
+
+  SatStatsReplicationMerger merger (outputPath);
+
+  for (std::vector<std::string>::const_iterator it = runPaths.begin (); it != runPaths.end (); ++it)
+    {
+      merger.AddReplication (*it);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (merger.Merge (), 2, "Unexpected number of merged files");
+
+  std::vector<std::string> headings;
+  std::map<std::string, MergedRow_t> rows;
+  ReadMergedFile (outputPath + "/stat-throughput-scalar.txt", headings, rows);
+
+  NS_TEST_ASSERT_MSG_EQ (headings.size (), 3, "Unexpected number of heading lines");
+  NS_TEST_ASSERT_MSG_EQ (headings[0], "% beam_id throughput_kbps", "Unexpected first heading line");
+  NS_TEST_ASSERT_MSG_EQ (headings[1], "% replication 2", "Heading line of the second replication missing");
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 3, "Unexpected number of merged scalar rows");
+
+  // Values 100, 110 and 120: standard deviation 10 and t-quantile of 2 degrees of freedom
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["1"].m_mean, 110.0, 1e-6, "Unexpected mean of row 1");
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["1"].m_ci, 4.303 * 10.0 / std::sqrt (3.0), 1e-6, "Unexpected confidence interval of row 1");
+  NS_TEST_ASSERT_MSG_EQ (rows["1"].m_n, 3, "Unexpected number of replications of row 1");
+
+  // Values 200 and 220: standard deviation 10 * sqrt (2) and t-quantile of 1 degree of freedom
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["2"].m_mean, 210.0, 1e-6, "Unexpected mean of row 2");
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["2"].m_ci, 12.706 * 10.0 * std::sqrt (2.0) / std::sqrt (2.0), 1e-6, "Unexpected confidence interval of row 2");
+  NS_TEST_ASSERT_MSG_EQ (rows["2"].m_n, 2, "Unexpected number of replications of row 2");
+
+  // A single value has no confidence interval
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["3"].m_mean, 5.0, 1e-6, "Unexpected mean of row 3");
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["3"].m_ci, 0.0, 1e-6, "Unexpected confidence interval of row 3");
+  NS_TEST_ASSERT_MSG_EQ (rows["3"].m_n, 1, "Unexpected number of replications of row 3");
+
+  headings.clear ();
+  rows.clear ();
+  ReadMergedFile (outputPath + "/stat-delay-cdf.txt", headings, rows);
+
+  NS_TEST_ASSERT_MSG_EQ (headings.size (), 2, "Unexpected number of CDF heading lines");
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 1, "Unexpected number of merged CDF rows");
+
+  // Values 0.2, 0.4 and 0.6: standard deviation 0.2
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["0.5"].m_mean, 0.4, 1e-9, "Unexpected mean of CDF row");
+  NS_TEST_ASSERT_MSG_EQ_TOL (rows["0.5"].m_ci, 4.303 * 0.2 / std::sqrt (3.0), 1e-9, "Unexpected confidence interval of CDF row");
+  NS_TEST_ASSERT_MSG_EQ (rows["0.5"].m_n, 3, "Unexpected number of replications of CDF row");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \brief Test suite for the replication statistics merger.
+ */
+class SatStatsReplicationMergerTestSuite : public TestSuite
+{
+public:
+  SatStatsReplicationMergerTestSuite ();
+};
+
+SatStatsReplicationMergerTestSuite::SatStatsReplicationMergerTestSuite ()
+  : TestSuite ("sat-stats-replication-merger-test", UNIT)
+{
+  AddTestCase (new SatStatsReplicationMergerTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatStatsReplicationMergerTestSuite satStatsReplicationMergerTestSuite;
+
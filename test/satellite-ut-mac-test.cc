@@ -0,0 +1,360 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file satellite-ut-mac-test.cc
+ * \ingroup satellite
+ * \brief Test cases for the DA transmissions of the UT MAC.
+ */
+
+#include <map>
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/singleton.h"
+#include "ns3/applications-module.h"
+#include "ns3/satellite-module.h"
+#include "ns3/traffic-module.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup satellite
+ * \brief Test case to check that the DA Tx timeline of the UT transmits the
+ * time slots at the same times and in the same order as the simulator events
+ * scheduled per time slot.
+ *
+ *  1.  Return link CBR traffic is simulated for two UTs without constant
+ *      assignment, RBDC and random access, thus the UTs transmit only in the
+ *      time slots of the TBTPs fed to their MACs by the test. The TBTPs are
+ *      fed three times during the simulation. Each time a UT gets:
+ *       • TBTP with two time slots in the middle of a superframe.
+ *       • A later TBTP with two time slots before the pending ones in the
+ *         same superframe, and one time slot in the following superframe.
+ *      The DA Tx timeline is disabled.
+ *  2.  Same simulation is run again with the DA Tx timeline enabled.
+ *
+ *  Expected result:
+ *    • All the time slots are used for transmission.
+ *    • The timeline event is moved to the time slots of the later TBTP.
+ *    • Same bursts (time, carrier and waveform) transmitted by each UT in the
+ *      same order in both runs, and the bursts of a UT are in time order.
+ *    • Same bytes received by the GW user.
+ */
+class SatUtMacDaTxTimelineTestCase : public TestCase
+{
+public:
+  SatUtMacDaTxTimelineTestCase ();
+  virtual ~SatUtMacDaTxTimelineTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Time, carrier and waveform of the bursts received by the GW per UT
+   */
+  typedef std::map<Mac48Address, std::vector<double> > BurstMap_t;
+
+  /**
+   * \brief Run the simulation
+   * \param daTxTimeline Enable the DA Tx timeline of the UTs
+   * \param rxBytes Variable to store the bytes received by the GW user
+   * \return Bursts received by the GW per UT
+   */
+  BurstMap_t RunSimulation (bool daTxTimeline, uint64_t& rxBytes);
+
+  /**
+   * \brief Feed the TBTPs of one round to a UT MAC
+   * \param mac UT MAC
+   * \param firstCarrierId First of the two frame carriers used by the UT
+   */
+  void SendTbtps (Ptr<SatUtMac> mac, uint16_t firstCarrierId);
+
+  /**
+   * \brief Feed a TBTP to a UT MAC
+   * \param mac UT MAC
+   * \param tbtp TBTP
+   */
+  void ScheduleTimeSlots (Ptr<SatUtMac> mac, Ptr<SatTbtpMessage> tbtp);
+
+  /**
+   * \brief Add a DA time slot of the frame 0 to a TBTP
+   * \param tbtp TBTP
+   * \param assignmentId Assignment ID of the UT
+   * \param startTime Start time of the slot within the superframe
+   * \param waveformId Waveform ID
+   * \param carrierId Frame carrier ID
+   */
+  void AddTimeSlot (Ptr<SatTbtpMessage> tbtp, uint32_t assignmentId, Time startTime, uint32_t waveformId, uint16_t carrierId);
+
+  /**
+   * \brief Get the MAC of a UT node
+   * \param node UT node
+   * \return UT MAC
+   */
+  Ptr<SatUtMac> GetUtMac (Ptr<Node> node);
+
+  /**
+   * \brief Store a burst received by the GW
+   */
+  void LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                          Mac48Address ownAdd, Mac48Address destAdd,
+                          double ifPower, double cSinr);
+
+  BurstMap_t m_bursts;
+};
+
+SatUtMacDaTxTimelineTestCase::SatUtMacDaTxTimelineTestCase ()
+  : TestCase ("Test identical DA transmissions of the UT with and without the DA Tx timeline")
+{
+}
+
+SatUtMacDaTxTimelineTestCase::~SatUtMacDaTxTimelineTestCase ()
+{
+}
+
+void
+SatUtMacDaTxTimelineTestCase::LinkBudgetTraceCb (std::string context, Ptr<SatSignalParameters> params,
+                                                 Mac48Address ownAdd, Mac48Address destAdd,
+                                                 double ifPower, double cSinr)
+{
+  SatMacTag macTag;
+
+  if (params->m_channelType == SatEnums::RETURN_FEEDER_CH
+      && !params->GetPackets ().empty ()
+      && params->GetPackets ().front ()->PeekPacketTag (macTag))
+    {
+      std::vector<double>& bursts = m_bursts[macTag.GetSourceAddress ()];
+      bursts.push_back (Simulator::Now ().GetSeconds ());
+      bursts.push_back (params->m_carrierId);
+      bursts.push_back (params->m_txInfo.waveformId);
+    }
+}
+
+Ptr<SatUtMac>
+SatUtMacDaTxTimelineTestCase::GetUtMac (Ptr<Node> node)
+{
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<SatNetDevice> device = DynamicCast<SatNetDevice> (node->GetDevice (i));
+
+      if (device != NULL)
+        {
+          return DynamicCast<SatUtMac> (device->GetMac ());
+        }
+    }
+
+  return NULL;
+}
+
+void
+SatUtMacDaTxTimelineTestCase::AddTimeSlot (Ptr<SatTbtpMessage> tbtp, uint32_t assignmentId, Time startTime, uint32_t waveformId, uint16_t carrierId)
+{
+  Ptr<SatTimeSlotConf> conf = Create<SatTimeSlotConf> (startTime, waveformId, carrierId, SatTimeSlotConf::SLOT_TYPE_TRC);
+  tbtp->SetDaTimeslot (assignmentId, 0, conf, 0);
+}
+
+void
+SatUtMacDaTxTimelineTestCase::ScheduleTimeSlots (Ptr<SatUtMac> mac, Ptr<SatTbtpMessage> tbtp)
+{
+  mac->ScheduleTimeSlots (tbtp);
+
+  // the timeline event is kept at the earliest pending time slot
+  if (mac->m_daTxTimelineEnabled)
+    {
+      NS_TEST_EXPECT_MSG_EQ (mac->m_daTxOpportunities.empty (), false, "No pending DA Tx opportunities");
+      NS_TEST_EXPECT_MSG_EQ (mac->m_daTxEvent.IsRunning (), true, "DA Tx timeline event not running");
+
+      if (!mac->m_daTxOpportunities.empty ())
+        {
+          NS_TEST_EXPECT_MSG_EQ (TimeStep (mac->m_daTxEvent.GetTs ()), mac->m_daTxOpportunities.begin ()->first,
+                                 "DA Tx timeline event not at the earliest time slot");
+        }
+    }
+}
+
+void
+SatUtMacDaTxTimelineTestCase::SendTbtps (Ptr<SatUtMac> mac, uint16_t firstCarrierId)
+{
+  Ptr<SatFrameConf> frameConf = mac->m_superframeSeq->GetSuperframeConf (SatConstVariables::SUPERFRAME_SEQUENCE)->GetFrameConf (0);
+  uint32_t waveformId = frameConf->GetWaveformConf ()->GetDefaultWaveformId ();
+  Time burstDuration = frameConf->GetBurstDuration (waveformId);
+
+  NS_TEST_EXPECT_MSG_GT (frameConf->GetCarrierCount (), firstCarrierId + 1, "Not enough carriers in the frame");
+  NS_TEST_EXPECT_MSG_EQ ((TimeStep (7 * burstDuration.GetTimeStep ()) <= frameConf->GetDuration ()), true, "Not enough time slots in the frame");
+
+  // the superframe after the next one, so that its time slots are in the
+  // future also when the later TBTP is fed
+  uint32_t superframeCount = Singleton<SatRtnLinkTime>::Get ()->GetNextSuperFrameCount (SatConstVariables::SUPERFRAME_SEQUENCE,
+                                                                                        mac->m_timingAdvanceCb ()) + 1;
+
+  Ptr<SatTbtpMessage> tbtp = CreateObject<SatTbtpMessage> (SatConstVariables::SUPERFRAME_SEQUENCE);
+  tbtp->SetSuperframeCounter (superframeCount);
+  AddTimeSlot (tbtp, mac->m_assignmentId, TimeStep (4 * burstDuration.GetTimeStep ()), waveformId, firstCarrierId);
+  AddTimeSlot (tbtp, mac->m_assignmentId, TimeStep (6 * burstDuration.GetTimeStep ()), waveformId, firstCarrierId);
+
+  ScheduleTimeSlots (mac, tbtp);
+
+  // the later TBTPs have time slots before the pending time slots, thus the
+  // timeline event has to be moved to an earlier time
+  Ptr<SatTbtpMessage> laterTbtp = CreateObject<SatTbtpMessage> (SatConstVariables::SUPERFRAME_SEQUENCE);
+  laterTbtp->SetSuperframeCounter (superframeCount);
+  AddTimeSlot (laterTbtp, mac->m_assignmentId, Seconds (0), waveformId, firstCarrierId + 1);
+  AddTimeSlot (laterTbtp, mac->m_assignmentId, TimeStep (2 * burstDuration.GetTimeStep ()), waveformId, firstCarrierId + 1);
+
+  Ptr<SatTbtpMessage> nextTbtp = CreateObject<SatTbtpMessage> (SatConstVariables::SUPERFRAME_SEQUENCE);
+  nextTbtp->SetSuperframeCounter (superframeCount + 1);
+  AddTimeSlot (nextTbtp, mac->m_assignmentId, burstDuration, waveformId, firstCarrierId);
+
+  Simulator::Schedule (MicroSeconds (100), &SatUtMacDaTxTimelineTestCase::ScheduleTimeSlots, this, mac, laterTbtp);
+  Simulator::Schedule (MicroSeconds (100), &SatUtMacDaTxTimelineTestCase::ScheduleTimeSlots, this, mac, nextTbtp);
+}
+
+SatUtMacDaTxTimelineTestCase::BurstMap_t
+SatUtMacDaTxTimelineTestCase::RunSimulation (bool daTxTimeline, uint64_t& rxBytes)
+{
+  // Reset singletons and the random variable streams, so that both
+  // simulations use the same streams
+  Singleton<SatIdMapper>::Get ()->Reset ();
+  RngSeedManager::ResetNextStreamIndex ();
+  m_bursts.clear ();
+
+  Config::SetDefault ("ns3::SatUtMac::DaTxTimeline", BooleanValue (daTxTimeline));
+
+  // The UTs get time slots only from the TBTPs fed by the test
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService0_ConstantAssignmentProvided", BooleanValue (false));
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService3_RbdcAllowed", BooleanValue (false));
+
+  Ptr<SatHelper> helper = CreateObject<SatHelper> ();
+
+  std::map<uint32_t, SatBeamUserInfo > beamMap;
+  beamMap[1] = SatBeamUserInfo (2,1);
+
+  helper->CreateUserDefinedScenario (beamMap);
+
+  Config::Connect ("/NodeList/*/DeviceList/*/SatPhy/PhyRx/RxCarrierList/*/LinkBudgetTrace",
+                   MakeCallback (&SatUtMacDaTxTimelineTestCase::LinkBudgetTraceCb, this));
+
+  NodeContainer utUsers = helper->GetUtUsers ();
+  NodeContainer gwUsers = helper->GetGwUsers ();
+  uint16_t port = 9;
+
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  ApplicationContainer sinks = sinkHelper.Install (gwUsers.Get (0));
+  sinks.Start (Seconds (0.1));
+  sinks.Stop (Seconds (3.0));
+
+  CbrHelper cbrHelper ("ns3::UdpSocketFactory", InetSocketAddress (helper->GetUserAddress (gwUsers.Get (0)), port));
+  cbrHelper.SetAttribute ("Interval", StringValue ("10ms"));
+  cbrHelper.SetAttribute ("PacketSize", UintegerValue (256));
+  ApplicationContainer cbrs = cbrHelper.Install (utUsers);
+  cbrs.Start (Seconds (0.5));
+  cbrs.Stop (Seconds (2.5));
+
+  // Each UT uses its own carriers, so that the bursts of the UTs do not overlap
+  NodeContainer uts = helper->UtNodes ();
+
+  for (uint32_t i = 0; i < uts.GetN (); i++)
+    {
+      Ptr<SatUtMac> mac = GetUtMac (uts.Get (i));
+
+      for (uint32_t round = 0; round < 3; round++)
+        {
+          Simulator::Schedule (Seconds (1.0 + 0.5 * round), &SatUtMacDaTxTimelineTestCase::SendTbtps, this, mac, (uint16_t) (2 * i));
+        }
+    }
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+
+  rxBytes = DynamicCast<PacketSink> (sinks.Get (0))->GetTotalRx ();
+
+  helper = NULL;
+  Simulator::Destroy ();
+
+  return m_bursts;
+}
+
+void
+SatUtMacDaTxTimelineTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-ut-mac", "da-tx-timeline", true);
+
+  uint64_t rxBytes (0);
+  uint64_t timelineRxBytes (0);
+
+  BurstMap_t bursts = RunSimulation (false, rxBytes);
+  BurstMap_t timelineBursts = RunSimulation (true, timelineRxBytes);
+
+  NS_TEST_ASSERT_MSG_GT (rxBytes, 0, "Nothing received!");
+  NS_TEST_ASSERT_MSG_EQ (bursts.size (), 2, "Bursts not received from both UTs!");
+  NS_TEST_ASSERT_MSG_EQ (timelineRxBytes, rxBytes, "Received bytes are not what expected!");
+  NS_TEST_ASSERT_MSG_EQ (timelineBursts.size (), bursts.size (), "UT count of the received bursts is not what expected!");
+
+  for (BurstMap_t::const_iterator it = bursts.begin (); it != bursts.end (); it++)
+    {
+      const std::vector<double>& utBursts = it->second;
+      const std::vector<double>& timelineUtBursts = timelineBursts[it->first];
+
+      // three rounds of five time slots, three values per burst
+      NS_TEST_ASSERT_MSG_EQ (utBursts.size (), 3 * 5 * 3, "Burst count of UT " << it->first << " is not what expected!");
+      NS_TEST_ASSERT_MSG_EQ (timelineUtBursts.size (), utBursts.size (), "Burst count of UT " << it->first << " with the timeline is not what expected!");
+
+      for (uint32_t i = 0; i < utBursts.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (timelineUtBursts[i], utBursts[i], "Burst value " << i << " of UT " << it->first << " is not what expected!");
+        }
+
+      for (uint32_t i = 3; i < timelineUtBursts.size (); i += 3)
+        {
+          NS_TEST_ASSERT_MSG_GT (timelineUtBursts[i], timelineUtBursts[i - 3], "Bursts of UT " << it->first << " not in time order!");
+        }
+    }
+
+  Config::SetDefault ("ns3::SatUtMac::DaTxTimeline", BooleanValue (false));
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService0_ConstantAssignmentProvided", BooleanValue (true));
+  Config::SetDefault ("ns3::SatLowerLayerServiceConf::DaService3_RbdcAllowed", BooleanValue (true));
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+/**
+ * \ingroup satellite
+ * \brief Test suite for the UT MAC.
+ */
+class SatUtMacTestSuite : public TestSuite
+{
+public:
+  SatUtMacTestSuite ();
+};
+
+SatUtMacTestSuite::SatUtMacTestSuite ()
+  : TestSuite ("sat-ut-mac", SYSTEM)
+{
+  AddTestCase (new SatUtMacDaTxTimelineTestCase, TestCase::QUICK);
+}
+
+// Do allocate an instance of this TestSuite
+static SatUtMacTestSuite satUtMacTestSuite;
@@ -203,6 +203,129 @@ SatDvbS2BbFrameConfTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup satellite
+ * \brief Test case to unit test the precomputed C/No threshold tables used
+ * in the ACM waveform and MODCOD selection.
+ *
+ * Expected result:
+ * - The best waveform ids for a range of C/Nos, symbol rates and burst lengths
+ *   are the same as with a linear search over the waveforms
+ * - The default waveform and MODCOD are selected after ACM has been disabled
+ *   at runtime, and the ACM selection is restored after ACM is enabled again
+ */
+class SatAcmThresholdTableTestCase : public TestCase
+{
+public:
+  SatAcmThresholdTableTestCase ();
+  virtual ~SatAcmThresholdTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+SatAcmThresholdTableTestCase::SatAcmThresholdTableTestCase ()
+  : TestCase ("Test precomputed ACM threshold tables.")
+{
+}
+
+SatAcmThresholdTableTestCase::~SatAcmThresholdTableTestCase ()
+{
+}
+
+
+void
+SatAcmThresholdTableTestCase::DoRun (void)
+{
+  // Set simulation output details
+  Singleton<SatEnvVariables>::Get ()->DoInitialize ();
+  Singleton<SatEnvVariables>::Get ()->SetOutputVariables ("test-sat-waveform-conf", "acm-tables", true);
+
+  std::string path = Singleton<SatEnvVariables>::Get ()->GetDataPath () + "/";
+  std::string fileName = "dvbRcs2Waveforms.txt";
+
+  Config::SetDefault ("ns3::SatWaveformConf::AcmEnabled", BooleanValue (true));
+  Config::SetDefault ("ns3::SatBbFrameConf::AcmEnabled", BooleanValue (true));
+
+  Ptr<SatLinkResultsDvbRcs2> lrRcs2 = CreateObject<SatLinkResultsDvbRcs2> ();
+  lrRcs2->Initialize ();
+
+  Ptr<SatWaveformConf> wf = CreateObject<SatWaveformConf> (path + fileName);
+  wf->InitializeEbNoRequirements (lrRcs2);
+
+  double symbolRates[3] = { 125000, 250000, 1000000 };
+  uint32_t burstLengths[2] = { SatWaveformConf::SHORT_BURST_LENGTH, SatWaveformConf::LONG_BURST_LENGTH };
+
+  for (uint32_t s = 0; s < 3; ++s)
+    {
+      for (uint32_t b = 0; b < 2; ++b)
+        {
+          for (double d = 40.0; d <= 80.0; d += 0.1)
+            {
+              double cno = SatUtils::DbToLinear (d);
+
+              // Reference: linear search in descending waveform id order
+              bool refSuccess (false);
+              uint32_t refWfId (0);
+              for (uint32_t id = wf->GetMaxWfId (); id >= wf->GetMinWfId () && id <= wf->GetMaxWfId (); --id)
+                {
+                  Ptr<SatWaveform> waveform = wf->GetWaveform (id);
+                  if (waveform->GetBurstLengthInSymbols () == burstLengths[b]
+                      && waveform->GetCNoThreshold (symbolRates[s]) <= cno)
+                    {
+                      refSuccess = true;
+                      refWfId = id;
+                      break;
+                    }
+                }
+
+              uint32_t wfId (0);
+              bool success = wf->GetBestWaveformId (cno, symbolRates[s], wfId, burstLengths[b]);
+
+              NS_TEST_ASSERT_MSG_EQ (success, refSuccess, "Unexpected waveform search result");
+              if (refSuccess)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (wfId, refWfId, "Not expected waveform id");
+                }
+            }
+        }
+    }
+
+  // Disable and re-enable ACM at runtime
+  uint32_t acmWfId (0);
+  wf->GetBestWaveformId (SatUtils::DbToLinear (70.0), symbolRates[1], acmWfId);
+
+  wf->SetAttribute ("AcmEnabled", BooleanValue (false));
+  uint32_t wfId (0);
+  wf->GetBestWaveformId (SatUtils::DbToLinear (70.0), symbolRates[1], wfId);
+  NS_TEST_ASSERT_MSG_EQ (wfId, wf->GetDefaultWaveformId (), "Default waveform expected with ACM disabled");
+
+  wf->SetAttribute ("AcmEnabled", BooleanValue (true));
+  wf->GetBestWaveformId (SatUtils::DbToLinear (70.0), symbolRates[1], wfId);
+  NS_TEST_ASSERT_MSG_EQ (wfId, acmWfId, "ACM waveform expected with ACM enabled");
+
+  Ptr<SatLinkResultsDvbS2> lrS2 = CreateObject<SatLinkResultsDvbS2> ();
+  lrS2->Initialize ();
+
+  Ptr<SatBbFrameConf> bbFrameConf = CreateObject<SatBbFrameConf> (93750000.0);
+  bbFrameConf->InitializeCNoRequirements (lrS2);
+
+  SatEnums::SatModcod_t acmModcod = bbFrameConf->GetBestModcod (SatUtils::DbToLinear (100.0), SatEnums::NORMAL_FRAME);
+  NS_TEST_ASSERT_MSG_NE (acmModcod, bbFrameConf->GetDefaultModCod (), "Higher MODCOD expected with high C/No");
+
+  bbFrameConf->SetAttribute ("AcmEnabled", BooleanValue (false));
+  NS_TEST_ASSERT_MSG_EQ (bbFrameConf->GetBestModcod (SatUtils::DbToLinear (100.0), SatEnums::NORMAL_FRAME),
+                         bbFrameConf->GetDefaultModCod (), "Default MODCOD expected with ACM disabled");
+
+  bbFrameConf->SetAttribute ("AcmEnabled", BooleanValue (true));
+  NS_TEST_ASSERT_MSG_EQ (bbFrameConf->GetBestModcod (SatUtils::DbToLinear (100.0), SatEnums::NORMAL_FRAME),
+                         acmModcod, "ACM MODCOD expected with ACM enabled");
+
+  Singleton<SatEnvVariables>::Get ()->DoDispose ();
+}
+
+
 /**
  * \ingroup satellite
  * \brief Test suite for Satellite free space loss unit test cases.
@@ -218,6 +341,7 @@ SatWaveformConfTestSuite::SatWaveformConfTestSuite ()
 {
   AddTestCase (new SatDvbRcs2WaveformTableTestCase, TestCase::QUICK);
   AddTestCase (new SatDvbS2BbFrameConfTestCase, TestCase::QUICK);
+  AddTestCase (new SatAcmThresholdTableTestCase, TestCase::QUICK);
 }
 
 // Do allocate an instance of this TestSuite
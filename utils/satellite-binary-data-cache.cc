@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ns3/log.h"
+#include "ns3/singleton.h"
+#include "satellite-env-variables.h"
+#include "satellite-binary-data-cache.h"
+
+NS_LOG_COMPONENT_DEFINE ("SatBinaryDataCache");
+
+namespace ns3 {
+
+static const char SAT_BINARY_DATA_CACHE_MAGIC[8] = {'S', 'A', 'T', 'C', 'A', 'C', 'H', 'E'};
+
+SatBinaryDataCache::SatBinaryDataCache (void *data, uint64_t size)
+  : m_data (data),
+    m_size (size)
+{
+  NS_LOG_FUNCTION (this << data << size);
+
+  const Header_t *header = static_cast<const Header_t *> (m_data);
+  m_nParams = header->m_nParams;
+  m_nValues = header->m_nValues;
+  m_params = reinterpret_cast<const double *> (static_cast<const char *> (m_data) + sizeof (Header_t));
+  m_values = m_params + m_nParams;
+}
+
+SatBinaryDataCache::~SatBinaryDataCache ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_data != 0)
+    {
+      munmap (m_data, m_size);
+      m_data = 0;
+    }
+}
+
+bool
+SatBinaryDataCache::IsEnabled ()
+{
+  return Singleton<SatEnvVariables>::Get ()->IsBinaryDataCacheEnabled ();
+}
+
+std::string
+SatBinaryDataCache::GetCachePath (std::string sourcePath)
+{
+  std::string cacheDirectory = Singleton<SatEnvVariables>::Get ()->GetBinaryDataCacheDirectory ();
+
+  if (cacheDirectory.empty ())
+    {
+      return sourcePath + ".bin";
+    }
+
+  char resolved[PATH_MAX];
+  std::string canonicalPath = (realpath (sourcePath.c_str (), resolved) != NULL) ? std::string (resolved) : sourcePath;
+
+  // 64-bit FNV-1a hash of the canonical path of the source file
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (std::string::const_iterator it = canonicalPath.begin (); it != canonicalPath.end (); ++it)
+    {
+      hash ^= static_cast<uint8_t> (*it);
+      hash *= 1099511628211ULL;
+    }
+
+  std::string::size_type separator = canonicalPath.find_last_of ('/');
+  std::string fileName = (separator == std::string::npos) ? canonicalPath : canonicalPath.substr (separator + 1);
+
+  std::ostringstream cachePath;
+  cachePath << cacheDirectory << "/" << fileName << "." << std::hex << std::setw (16) << std::setfill ('0') << hash << ".bin";
+
+  return cachePath.str ();
+}
+
+bool
+SatBinaryDataCache::CalculateHeader (std::string sourcePath, DataType_t dataType, Header_t &header)
+{
+  NS_LOG_FUNCTION (sourcePath << dataType);
+
+  struct stat st;
+
+  if (stat (sourcePath.c_str (), &st) != 0)
+    {
+      return false;
+    }
+
+  std::memset (&header, 0, sizeof (Header_t));
+  std::memcpy (header.m_magic, SAT_BINARY_DATA_CACHE_MAGIC, sizeof (header.m_magic));
+  header.m_schemaVersion = SCHEMA_VERSION;
+  header.m_dataType = dataType;
+  header.m_sourceSize = st.st_size;
+  header.m_sourceModifiedSec = st.st_mtim.tv_sec;
+  header.m_sourceModifiedNsec = st.st_mtim.tv_nsec;
+
+  return CalculateChecksum (sourcePath, header.m_sourceChecksum);
+}
+
+bool
+SatBinaryDataCache::CalculateChecksum (std::string path, uint64_t &checksum)
+{
+  NS_LOG_FUNCTION (path);
+
+  FILE *file = std::fopen (path.c_str (), "rb");
+
+  if (file == 0)
+    {
+      return false;
+    }
+
+  // 64-bit FNV-1a hash of the contents of the file
+  uint64_t hash = 14695981039346656037ULL;
+  unsigned char buffer[65536];
+  size_t count;
+
+  while ((count = std::fread (buffer, 1, sizeof (buffer), file)) > 0)
+    {
+      for (size_t i = 0; i < count; ++i)
+        {
+          hash ^= buffer[i];
+          hash *= 1099511628211ULL;
+        }
+    }
+
+  bool read = (std::ferror (file) == 0);
+  std::fclose (file);
+
+  checksum = hash;
+
+  return read;
+}
+
+Ptr<SatBinaryDataCache>
+SatBinaryDataCache::Open (std::string sourcePath, DataType_t dataType)
+{
+  NS_LOG_FUNCTION (sourcePath << dataType);
+
+  if (!IsEnabled ())
+    {
+      return NULL;
+    }
+
+  Header_t expected;
+
+  if (!CalculateHeader (sourcePath, dataType, expected))
+    {
+      return NULL;
+    }
+
+  std::string cachePath = GetCachePath (sourcePath);
+  int fd = open (cachePath.c_str (), O_RDONLY);
+
+  if (fd < 0)
+    {
+      NS_LOG_INFO ("No binary cache " << cachePath);
+      return NULL;
+    }
+
+  struct stat st;
+
+  if (fstat (fd, &st) != 0 || static_cast<uint64_t> (st.st_size) < sizeof (Header_t))
+    {
+      close (fd);
+      return NULL;
+    }
+
+  uint64_t size = st.st_size;
+  void *data = mmap (0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (data == MAP_FAILED)
+    {
+      NS_LOG_WARN ("Unable to map binary cache " << cachePath);
+      return NULL;
+    }
+
+  const Header_t *header = static_cast<const Header_t *> (data);
+
+  // The counts are read from the file, so they are compared against the
+  // number of doubles in the file before they are used in any arithmetic.
+  uint64_t maxCount = (size - sizeof (Header_t)) / sizeof (double);
+
+  if (std::memcmp (header->m_magic, expected.m_magic, sizeof (expected.m_magic)) != 0
+      || header->m_schemaVersion != expected.m_schemaVersion
+      || header->m_dataType != expected.m_dataType
+      || header->m_sourceSize != expected.m_sourceSize
+      || header->m_sourceModifiedSec != expected.m_sourceModifiedSec
+      || header->m_sourceModifiedNsec != expected.m_sourceModifiedNsec
+      || header->m_sourceChecksum != expected.m_sourceChecksum
+      || header->m_nParams > maxCount
+      || header->m_nValues > maxCount - header->m_nParams
+      || size != sizeof (Header_t) + (header->m_nParams + header->m_nValues) * sizeof (double))
+    {
+      NS_LOG_INFO ("Binary cache " << cachePath << " is not valid for " << sourcePath);
+      munmap (data, size);
+      return NULL;
+    }
+
+  NS_LOG_INFO ("Using binary cache " << cachePath);
+
+  return Ptr<SatBinaryDataCache> (new SatBinaryDataCache (data, size), false);
+}
+
+bool
+SatBinaryDataCache::Store (std::string sourcePath,
+                           DataType_t dataType,
+                           const std::vector<double> &params,
+                           const std::vector<double> &values)
+{
+  NS_LOG_FUNCTION (sourcePath << dataType << params.size () << values.size ());
+
+  return Store (sourcePath, dataType, params, values.data (), values.size () * sizeof (double));
+}
+
+bool
+SatBinaryDataCache::Store (std::string sourcePath,
+                           DataType_t dataType,
+                           const std::vector<double> &params,
+                           const void *data,
+                           uint64_t dataSize)
+{
+  NS_LOG_FUNCTION (sourcePath << dataType << params.size () << dataSize);
+
+  if (!IsEnabled ())
+    {
+      return false;
+    }
+
+  Header_t header;
+
+  if (!CalculateHeader (sourcePath, dataType, header))
+    {
+      return false;
+    }
+
+  header.m_nParams = params.size ();
+  header.m_nValues = (dataSize + sizeof (double) - 1) / sizeof (double);
+
+  std::string cacheDirectory = Singleton<SatEnvVariables>::Get ()->GetBinaryDataCacheDirectory ();
+
+  if (!cacheDirectory.empty () && !Singleton<SatEnvVariables>::Get ()->IsValidDirectory (cacheDirectory))
+    {
+      Singleton<SatEnvVariables>::Get ()->CreateDirectory (cacheDirectory);
+    }
+
+  std::string cachePath = GetCachePath (sourcePath);
+  std::ostringstream tempPath;
+  tempPath << cachePath << "." << getpid () << ".tmp";
+
+  FILE *file = std::fopen (tempPath.str ().c_str (), "wb");
+
+  if (file == 0)
+    {
+      NS_LOG_WARN ("Unable to create binary cache " << cachePath);
+      return false;
+    }
+
+  // Padding of the data to a multiple of double size
+  const char padding[sizeof (double)] = { 0 };
+  uint64_t paddingSize = header.m_nValues * sizeof (double) - dataSize;
+
+  bool written = std::fwrite (&header, sizeof (Header_t), 1, file) == 1
+    && std::fwrite (params.data (), sizeof (double), params.size (), file) == params.size ()
+    && std::fwrite (data, 1, dataSize, file) == dataSize
+    && std::fwrite (padding, 1, paddingSize, file) == paddingSize;
+
+  written = (std::fclose (file) == 0) && written;
+
+  if (!written || std::rename (tempPath.str ().c_str (), cachePath.c_str ()) != 0)
+    {
+      NS_LOG_WARN ("Unable to write binary cache " << cachePath);
+      std::remove (tempPath.str ().c_str ());
+      return false;
+    }
+
+  NS_LOG_INFO ("Binary cache " << cachePath << " created");
+
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Magister Solutions Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SAT_BINARY_DATA_CACHE_H
+#define SAT_BINARY_DATA_CACHE_H
+
+#include <string>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief Binary cache of a text data file (e.g. antenna pattern or link results).
+ *
+ * The cache is disabled by default and it is enabled with the
+ * SatEnvVariables::EnableBinaryDataCache attribute. The cache is stored into
+ * the directory given by the SatEnvVariables::BinaryDataCacheDirectory
+ * attribute or, if the directory is not set, next to the source file with
+ * ".bin" suffix. The cache is memory-mapped read-only, thus the operating
+ * system shares the cached data between the processes using the same source
+ * file. The cache file starts with a header containing the schema version,
+ * the data type and the size, modification time and checksum of the source
+ * file, followed by the parameters and the values of the data, both as arrays
+ * of doubles. A cache is valid only if the header matches the current source
+ * file. The checksum is calculated over the whole source file, so a source
+ * file rewritten in place with the same size and modification time does not
+ * reuse stale data. Reading the source for the checksum is still much cheaper
+ * than parsing it.
+ *
+ * This class uses a basic ns-3 reference counting base class but is not
+ * an ns3::Object with attributes, TypeId, or aggregation.
+ */
+class SatBinaryDataCache : public SimpleRefCount<SatBinaryDataCache>
+{
+public:
+  /**
+   * \brief Types of the cached data
+   */
+  typedef enum
+  {
+    CACHE_ANTENNA_PATTERN = 1,
+    CACHE_LINK_RESULTS = 2,
+    CACHE_FADING_TRACE = 3
+  } DataType_t;
+
+  /**
+   * \brief Version of the cache file format
+   */
+  static const uint32_t SCHEMA_VERSION = 3;
+
+  /**
+   * \brief Destructor
+   */
+  ~SatBinaryDataCache ();
+
+  /**
+   * \brief Open the cache of a source file
+   * \param sourcePath Path to the source file
+   * \param dataType Type of the data
+   * \return Memory-mapped cache, NULL if the cache is disabled or there is no
+   * valid cache for the source file
+   */
+  static Ptr<SatBinaryDataCache> Open (std::string sourcePath, DataType_t dataType);
+
+  /**
+   * \brief Store the cache of a source file. The cache file is written into a
+   * temporary file and renamed, so that the processes opening the cache at the
+   * same time see either a complete cache file or no cache file.
+   * \param sourcePath Path to the source file
+   * \param dataType Type of the data
+   * \param params Parameters of the data
+   * \param values Values of the data
+   * \return true if the cache was stored
+   */
+  static bool Store (std::string sourcePath,
+                     DataType_t dataType,
+                     const std::vector<double> &params,
+                     const std::vector<double> &values);
+
+  /**
+   * \brief Store the cache of a source file with the values as raw data,
+   * e.g. packed arrays of floats. The data is padded to a multiple of
+   * double size.
+   * \param sourcePath Path to the source file
+   * \param dataType Type of the data
+   * \param params Parameters of the data
+   * \param data Values of the data
+   * \param dataSize Size of the values in bytes
+   * \return true if the cache was stored
+   */
+  static bool Store (std::string sourcePath,
+                     DataType_t dataType,
+                     const std::vector<double> &params,
+                     const void *data,
+                     uint64_t dataSize);
+
+  /**
+   * \brief Get the number of parameters
+   * \return Number of parameters
+   */
+  inline uint64_t GetNParams () const
+  {
+    return m_nParams;
+  }
+
+  /**
+   * \brief Get the parameters
+   * \return Pointer to the first parameter
+   */
+  inline const double * GetParams () const
+  {
+    return m_params;
+  }
+
+  /**
+   * \brief Get the number of values
+   * \return Number of values
+   */
+  inline uint64_t GetNValues () const
+  {
+    return m_nValues;
+  }
+
+  /**
+   * \brief Get the values
+   * \return Pointer to the first value
+   */
+  inline const double * GetValues () const
+  {
+    return m_values;
+  }
+
+  /**
+   * \brief Get the values as raw data
+   * \return Pointer to the first byte of the values
+   */
+  inline const void * GetData () const
+  {
+    return m_values;
+  }
+
+  /**
+   * \brief Get the size of the values in bytes
+   * \return Size of the values in bytes
+   */
+  inline uint64_t GetDataSize () const
+  {
+    return m_nValues * sizeof (double);
+  }
+
+private:
+  /**
+   * \brief Header of the cache file
+   */
+  typedef struct
+  {
+    char m_magic[8];
+    uint32_t m_schemaVersion;
+    uint32_t m_dataType;
+    uint64_t m_sourceSize;
+    int64_t m_sourceModifiedSec;
+    int64_t m_sourceModifiedNsec;
+    uint64_t m_sourceChecksum;
+    uint64_t m_nParams;
+    uint64_t m_nValues;
+  } Header_t;
+
+  /**
+   * \brief Constructor
+   * \param data Memory-mapped cache file
+   * \param size Size of the cache file
+   */
+  SatBinaryDataCache (void *data, uint64_t size);
+
+  /**
+   * \brief Calculate the header for a source file
+   * \param sourcePath Path to the source file
+   * \param dataType Type of the data
+   * \param header Calculated header
+   * \return true if the status and the contents of the source file were read
+   */
+  static bool CalculateHeader (std::string sourcePath, DataType_t dataType, Header_t &header);
+
+  /**
+   * \brief Calculate the 64-bit FNV-1a checksum of the contents of a file
+   * \param path Path to the file
+   * \param checksum Calculated checksum
+   * \return true if the file was read
+   */
+  static bool CalculateChecksum (std::string path, uint64_t &checksum);
+
+  /**
+   * \brief Get the path of the cache file of a source file. In a cache
+   * directory, the name of the cache file consists of the name of the source
+   * file and the hash of its canonical path.
+   * \param sourcePath Path to the source file
+   * \return Path to the cache file
+   */
+  static std::string GetCachePath (std::string sourcePath);
+
+  /**
+   * \brief Check whether the cache is enabled
+   * \return true if the cache is enabled
+   */
+  static bool IsEnabled ();
+
+  /**
+   * \brief Memory-mapped cache file
+   */
+  void *m_data;
+
+  /**
+   * \brief Size of the cache file
+   */
+  uint64_t m_size;
+
+  uint64_t m_nParams;
+  const double *m_params;
+  uint64_t m_nValues;
+  const double *m_values;
+};
+
+} // namespace ns3
+
+#endif /* SAT_BINARY_DATA_CACHE_H */
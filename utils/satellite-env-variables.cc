@@ -87,7 +87,17 @@ SatEnvVariables::GetTypeId (void)
                    "Exclude satellite data folder from the revision diff.",
                    BooleanValue (true),
                    MakeBooleanAccessor (&SatEnvVariables::m_excludeDataFolderFromDiff),
-                   MakeBooleanChecker ());
+                   MakeBooleanChecker ())
+    .AddAttribute ("EnableBinaryDataCache",
+                   "Enable memory-mapped binary cache of the antenna pattern, link result and external fading files.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SatEnvVariables::m_enableBinaryDataCache),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BinaryDataCacheDirectory",
+                   "Directory of the binary cache files. If empty, the cache files are stored next to the data files.",
+                   StringValue (""),
+                   MakeStringAccessor (&SatEnvVariables::m_binaryDataCacheDirectory),
+                   MakeStringChecker ());
   return tid;
 }
 
@@ -113,6 +123,8 @@ SatEnvVariables::SatEnvVariables ()
     m_enableSimInfoOutput (true),
     m_enableSimInfoDiffOutput (true),
     m_excludeDataFolderFromDiff (true),
+    m_enableBinaryDataCache (false),
+    m_binaryDataCacheDirectory (""),
     m_isInitialized (false)
 {
   NS_LOG_FUNCTION (this);
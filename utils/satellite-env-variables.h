@@ -100,6 +100,25 @@ public:
     return m_dataPath;
   }
 
+  /**
+   * \brief Is the binary cache of the data files enabled
+   * \return true if the binary data cache is enabled
+   */
+  bool IsBinaryDataCacheEnabled ()
+  {
+    return m_enableBinaryDataCache;
+  }
+
+  /**
+   * \brief Get the directory of the binary cache files of the data files
+   * \return path to the cache directory, empty if the cache files are stored
+   * next to the data files
+   */
+  std::string GetBinaryDataCacheDirectory ()
+  {
+    return m_binaryDataCacheDirectory;
+  }
+
   /**
    * \brief Function for getting the simulation folder
    * \return path to the simulation folder
@@ -293,6 +312,16 @@ private:
    */
   bool m_excludeDataFolderFromDiff;
 
+  /**
+   * \brief Is binary cache of the data files enabled
+   */
+  bool m_enableBinaryDataCache;
+
+  /**
+   * \brief Directory of the binary cache files of the data files
+   */
+  std::string m_binaryDataCacheDirectory;
+
   /**
    * \brief Flag for disposing and initializing
    */
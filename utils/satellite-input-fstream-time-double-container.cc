@@ -39,7 +39,7 @@ SatInputFileStreamTimeDoubleContainer::GetTypeId (void)
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
   : m_inputFileStreamWrapper (),
     m_inputFileStream (),
-    m_container (),
+    m_columns (),
     m_fileName (filename),
     m_fileMode (filemode),
     m_valuesInRow (valuesInRow),
@@ -56,7 +56,7 @@ SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer (st
 SatInputFileStreamTimeDoubleContainer::SatInputFileStreamTimeDoubleContainer ()
   : m_inputFileStreamWrapper (),
     m_inputFileStream (),
-    m_container (),
+    m_columns (),
     m_fileName (),
     m_fileMode (),
     m_valuesInRow (),
@@ -101,12 +101,18 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
 
   if (m_inputFileStream->is_open ())
     {
-      std::vector<double> tempVector = ReadRow ();
+      std::vector<double> tempVector (m_valuesInRow);
+      m_columns.resize (m_valuesInRow);
+
+      ReadRow (tempVector);
 
       while (!m_inputFileStream->eof ())
         {
-          m_container.push_back (tempVector);
-          tempVector = ReadRow ();
+          for (uint32_t i = 0; i < m_valuesInRow; i++)
+            {
+              m_columns[i].push_back (tempVector[i]);
+            }
+          ReadRow (tempVector);
         }
       m_inputFileStream->close ();
     }
@@ -120,20 +126,15 @@ SatInputFileStreamTimeDoubleContainer::UpdateContainer (std::string filename, st
   ResetStream ();
 }
 
-std::vector<double>
-SatInputFileStreamTimeDoubleContainer::ReadRow ()
+void
+SatInputFileStreamTimeDoubleContainer::ReadRow (std::vector<double>& row)
 {
   NS_LOG_FUNCTION (this);
 
-  double tempValue;
-  std::vector<double> tempVector;
-
   for ( uint32_t i = 0; i < m_valuesInRow; i++ )
     {
-      *m_inputFileStream >> tempValue;
-      tempVector.push_back (tempValue);
+      *m_inputFileStream >> row[i];
     }
-  return tempVector;
 }
 
 void
@@ -141,29 +142,31 @@ SatInputFileStreamTimeDoubleContainer::CheckContainerSanity ()
 {
   NS_LOG_FUNCTION (this);
 
+  uint32_t samples = GetNSamples ();
+
   /// check time sample sanity
-  if (m_container.size () < 1)
+  if (samples < 1)
     {
       NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Empty file");
     }
-  else if (m_container.size () == 1)
+  else if (samples == 1)
     {
-      if (m_container[m_container.size () - 1].at (m_timeColumn) == 0)
+      if (GetTime (samples - 1) == 0)
         {
           NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
         }
     }
   else
     {
-      double tempValue1 = m_container[0].at (m_timeColumn);
+      double tempValue1 = GetTime (0);
 
-      for (uint32_t i = 1; i < m_container.size (); i++)
+      for (uint32_t i = 1; i < samples; i++)
         {
-          if (tempValue1 > m_container[i].at (m_timeColumn))
+          if (tempValue1 > GetTime (i))
             {
               NS_FATAL_ERROR ("SatInputFileStreamDoubleContainer::UpdateContainer - Invalid input file format (time sample error)");
             }
-          tempValue1 = m_container[i].at (m_timeColumn);
+          tempValue1 = GetTime (i);
         }
     }
 }
@@ -173,11 +176,40 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
 {
   NS_LOG_FUNCTION (this);
 
+  uint32_t index = ProceedToNextClosestTimeIndex ();
+  std::vector<double> row (m_valuesInRow);
+
+  for (uint32_t i = 0; i < m_valuesInRow; i++)
+    {
+      row[i] = m_columns[i][index];
+    }
+
+  return row;
+}
+
+double
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample (uint32_t column)
+{
+  NS_LOG_FUNCTION (this << column);
+
+  if (column >= m_valuesInRow)
+    {
+      NS_FATAL_ERROR ("SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample - Invalid column: " << column);
+    }
+
+  return m_columns[column][ProceedToNextClosestTimeIndex ()];
+}
+
+uint32_t
+SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeIndex ()
+{
+  NS_LOG_FUNCTION (this);
+
   while (!FindNextClosest (m_lastValidPosition,m_timeShiftValue, Now ().GetSeconds ()))
     {
       m_lastValidPosition = 0;
       m_numOfPasses++;
-      m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+      m_timeShiftValue = m_numOfPasses * GetTime (GetNSamples () - 1);
 
       NS_LOG_INFO ("Looping samples again with shift value: " << m_timeShiftValue);
     }
@@ -188,7 +220,7 @@ SatInputFileStreamTimeDoubleContainer::ProceedToNextClosestTimeSample ()
       std::cout << "The container will loop samples from the beginning." << std::endl;
     }
 
-  return m_container[m_lastValidPosition];
+  return m_lastValidPosition;
 }
 
 bool
@@ -197,19 +229,22 @@ SatInputFileStreamTimeDoubleContainer::FindNextClosest (uint32_t lastValidPositi
   NS_LOG_FUNCTION (this);
 
   NS_ASSERT (m_timeColumn < m_valuesInRow);
-  NS_ASSERT (m_container.size () > 0);
-  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < m_container.size ());
+  NS_ASSERT (GetNSamples () > 0);
+  NS_ASSERT (lastValidPosition >= 0 && lastValidPosition < GetNSamples ());
 
   NS_LOG_INFO ("SatInputFileStreamDoubleContainer::FindNextClosest: lastValidPosition " << lastValidPosition << " column " << m_timeColumn << " timeShiftValue " << timeShiftValue << " comparisonTimeValue " << comparisonTimeValue);
 
   bool valueFound = false;
 
-  for (uint32_t i = lastValidPosition; i < m_container.size (); i++)
+  const std::vector<double>& times = m_columns[m_timeColumn];
+  uint32_t samples = times.size ();
+
+  for (uint32_t i = lastValidPosition; i < samples; i++)
     {
-      if (m_container[i].at (m_timeColumn) + timeShiftValue >= comparisonTimeValue)
+      if (times[i] + timeShiftValue >= comparisonTimeValue)
         {
-          double difference1 = std::abs (m_container[lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-          double difference2 = std::abs (m_container[i].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
+          double difference1 = std::abs (times[lastValidPosition] + timeShiftValue - comparisonTimeValue);
+          double difference2 = std::abs (times[i] + timeShiftValue - comparisonTimeValue);
 
           if (difference1 < difference2)
             {
@@ -227,18 +262,18 @@ SatInputFileStreamTimeDoubleContainer::FindNextClosest (uint32_t lastValidPositi
 
   if (valueFound && m_numOfPasses > 0 && m_lastValidPosition == 0)
     {
-      double difference1 = std::abs (m_container[m_lastValidPosition].at (m_timeColumn) + timeShiftValue - comparisonTimeValue);
-      double difference2 = std::abs (m_container[m_container.size () - 1].at (m_timeColumn) + ((m_numOfPasses - 1) * m_container[m_container.size () - 1].at (m_timeColumn)) - comparisonTimeValue);
+      double difference1 = std::abs (times[m_lastValidPosition] + timeShiftValue - comparisonTimeValue);
+      double difference2 = std::abs (times[samples - 1] + ((m_numOfPasses - 1) * times[samples - 1]) - comparisonTimeValue);
 
       if (difference1 > difference2)
         {
-          m_lastValidPosition = m_container.size () - 1;
+          m_lastValidPosition = samples - 1;
           m_numOfPasses--;
-          m_timeShiftValue = m_numOfPasses * m_container[m_container.size () - 1].at (m_timeColumn);
+          m_timeShiftValue = m_numOfPasses * times[samples - 1];
         }
     }
 
-  NS_LOG_INFO ("Done: " << valueFound << " value: " << m_container[m_lastValidPosition].at (m_timeColumn) << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
+  NS_LOG_INFO ("Done: " << valueFound << " value: " << times[m_lastValidPosition] << " @ line: " << m_lastValidPosition + 1 << " comparison time value: " << comparisonTimeValue << " passes: " << m_numOfPasses);
 
   return valueFound;
 }
@@ -270,17 +305,7 @@ SatInputFileStreamTimeDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
+  m_columns.clear ();
 
   m_valuesInRow = 0;
   m_lastValidPosition = 0;
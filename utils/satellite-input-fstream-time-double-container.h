@@ -34,7 +34,10 @@ namespace ns3 {
  * The class implements reading the values from a file, storing the values
  * and iterating the stored values.
  *
- * Row format is [time, value1, ..., value n].
+ * Row format is [time, value1, ..., value n]. The values are stored column
+ * wise, i.e. each column of the file is stored in one contiguous vector.
+ * The container keeps the position of the last returned time sample, from
+ * which the next lookup proceeds.
  */
 class SatInputFileStreamTimeDoubleContainer : public Object
 {
@@ -77,6 +80,13 @@ public:
    */
   std::vector<double> ProceedToNextClosestTimeSample ();
 
+  /**
+   * \brief Function for locating the next closest time sample and returning one value related to it
+   * \param column index of the value column in the row
+   * \return matching value
+   */
+  double ProceedToNextClosestTimeSample (uint32_t column);
+
   /**
    * \brief Do needed dispose actions
    */
@@ -100,9 +110,34 @@ private:
 
   /**
    * \brief Function for reading a row from file
-   * \return the row
+   * \param row vector to store the row to
+   */
+  void ReadRow (std::vector<double>& row);
+
+  /**
+   * \brief Function for locating the next closest time sample
+   * \return index of the time sample
+   */
+  uint32_t ProceedToNextClosestTimeIndex ();
+
+  /**
+   * \brief Get the time of a time sample
+   * \param index index of the time sample
+   * \return time of the sample
+   */
+  inline double GetTime (uint32_t index) const
+  {
+    return m_columns[m_timeColumn][index];
+  }
+
+  /**
+   * \brief Get the number of time samples
+   * \return number of time samples
    */
-  std::vector<double> ReadRow ();
+  inline uint32_t GetNSamples () const
+  {
+    return m_columns.empty () ? 0 : m_columns[m_timeColumn].size ();
+  }
 
   /**
    * \brief Function for locating the next closest value index. This locator loops the samples if the container does not have enough samples. Next closest index value is saved to a separate member variable.
@@ -129,9 +164,9 @@ private:
   std::ifstream* m_inputFileStream;
 
   /**
-   * \brief Container for value rows
+   * \brief Container for value columns
    */
-  std::vector<std::vector<double> > m_container;
+  std::vector<std::vector<double> > m_columns;
 
   /**
    * \brief File name
@@ -18,10 +18,13 @@
  * Author: Frans Laakso <frans.laakso@magister.fi>
  */
 
+#include <cstdlib>
+#include <sstream>
 #include "satellite-output-fstream-double-container.h"
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 NS_LOG_COMPONENT_DEFINE ("SatOutputFileStreamDoubleContainer");
 
@@ -32,14 +35,26 @@ SatOutputFileStreamDoubleContainer::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::SatOutputFileStreamDoubleContainer")
     .SetParent<Object> ()
-    .AddConstructor<SatOutputFileStreamDoubleContainer> ();
+    .AddConstructor<SatOutputFileStreamDoubleContainer> ()
+    .AddAttribute ("FlushThreshold",
+                   "Number of buffered value rows, which are appended to the file at once. "
+                   "Zero keeps all the rows in memory until the end of the simulation.",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&SatOutputFileStreamDoubleContainer::m_flushThreshold),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
   return tid;
 }
 
 SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer (std::string filename, std::ios::openmode filemode, uint32_t valuesInRow)
   : m_outputFileStreamWrapper (),
     m_outputFileStream (),
-    m_container (),
+    m_buffer (),
+    m_flushThreshold (1024),
+    m_fileCreated (false),
+    m_writtenRows (0),
+    m_figurePoints (),
+    m_rowsWithoutFigure (0),
     m_fileName (filename),
     m_fileMode (filemode),
     m_valuesInRow (valuesInRow),
@@ -58,7 +73,12 @@ SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer (std::str
 SatOutputFileStreamDoubleContainer::SatOutputFileStreamDoubleContainer ()
   : m_outputFileStreamWrapper (),
     m_outputFileStream (),
-    m_container (),
+    m_buffer (),
+    m_flushThreshold (),
+    m_fileCreated (),
+    m_writtenRows (),
+    m_figurePoints (),
+    m_rowsWithoutFigure (),
     m_fileName (),
     m_fileMode (),
     m_valuesInRow (),
@@ -91,38 +111,75 @@ SatOutputFileStreamDoubleContainer::WriteContainerToFile ()
 {
   NS_LOG_FUNCTION (this);
 
+  FlushBuffer ();
+
+  if (m_printFigure)
+    {
+      PrintFigure ();
+    }
+
+  Reset ();
+}
+
+void
+SatOutputFileStreamDoubleContainer::FlushBuffer ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // The file is created also when there are no rows
+  if (m_buffer.empty () && m_fileCreated)
+    {
+      return;
+    }
+
   OpenStream ();
 
   if (m_outputFileStream->is_open ())
     {
-      for (uint32_t i = 0; i < m_container.size (); i++)
+      uint32_t rows = m_buffer.size () / m_valuesInRow;
+
+      // The figure points are taken from the rows before they are dropped
+      // from the memory, so that the figure is not created from the rounded
+      // values of the file
+      if (m_printFigure && m_valuesInRow == 2)
         {
+          for (uint32_t i = 0; i < rows; i++)
+            {
+              m_figurePoints.push_back (std::make_pair (m_buffer[i * 2], m_buffer[i * 2 + 1]));
+            }
+        }
+      else
+        {
+          m_rowsWithoutFigure += rows;
+        }
+
+      for (uint32_t i = 0; i < rows; i++)
+        {
+          const double* row = &m_buffer[i * m_valuesInRow];
+
           for (uint32_t j = 0; j < m_valuesInRow; j++ )
             {
               if (j + 1 == m_valuesInRow)
                 {
-                  *m_outputFileStream << m_container[i].at (j);
+                  *m_outputFileStream << row[j];
                 }
               else
                 {
-                  *m_outputFileStream << m_container[i].at (j) << "\t";
+                  *m_outputFileStream << row[j] << "\t";
                 }
             }
-          *m_outputFileStream << std::endl;
+          *m_outputFileStream << "\n";
         }
-      m_outputFileStream->close ();
+
+      m_writtenRows += rows;
+      m_buffer.clear ();
     }
   else
     {
       NS_ABORT_MSG ("Output stream is not valid for writing.");
     }
 
-  if (m_printFigure)
-    {
-      PrintFigure ();
-    }
-
-  Reset ();
+  CloseStream ();
 }
 
 void
@@ -150,7 +207,7 @@ SatOutputFileStreamDoubleContainer::PrintFigure ()
 }
 
 void
-SatOutputFileStreamDoubleContainer::AddToContainer (std::vector<double> newItem)
+SatOutputFileStreamDoubleContainer::AddToContainer (const std::vector<double>& newItem)
 {
   NS_LOG_FUNCTION (this);
 
@@ -159,7 +216,12 @@ SatOutputFileStreamDoubleContainer::AddToContainer (std::vector<double> newItem)
       NS_FATAL_ERROR ("SatOutputFileStreamDoubleContainer::AddToContainer - Invalid vector size");
     }
 
-  m_container.push_back (newItem);
+  m_buffer.insert (m_buffer.end (), newItem.begin (), newItem.end ());
+
+  if (m_flushThreshold > 0 && m_buffer.size () >= static_cast<std::size_t> (m_flushThreshold) * m_valuesInRow)
+    {
+      FlushBuffer ();
+    }
 }
 
 void
@@ -167,8 +229,26 @@ SatOutputFileStreamDoubleContainer::OpenStream ()
 {
   NS_LOG_FUNCTION (this);
 
-  m_outputFileStreamWrapper = new SatOutputFileStreamWrapper (m_fileName,m_fileMode);
+  // The stream is kept open only while writing, since a simulation may have
+  // a container for each terminal
+  std::ios::openmode fileMode = m_fileCreated ? (std::ios::out | std::ios::app) : m_fileMode;
+
+  m_outputFileStreamWrapper = new SatOutputFileStreamWrapper (m_fileName, fileMode);
   m_outputFileStream = m_outputFileStreamWrapper->GetStream ();
+  m_fileCreated = true;
+}
+
+void
+SatOutputFileStreamDoubleContainer::CloseStream ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_outputFileStreamWrapper != NULL)
+    {
+      delete m_outputFileStreamWrapper;
+      m_outputFileStreamWrapper = 0;
+    }
+  m_outputFileStream = 0;
 }
 
 void
@@ -185,13 +265,12 @@ SatOutputFileStreamDoubleContainer::ResetStream ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (m_outputFileStreamWrapper != NULL)
-    {
-      delete m_outputFileStreamWrapper;
-      m_outputFileStreamWrapper = 0;
-    }
-  m_outputFileStream = 0;
+  CloseStream ();
 
+  m_fileCreated = false;
+  m_writtenRows = 0;
+  m_figurePoints.clear ();
+  m_rowsWithoutFigure = 0;
   m_fileName = "";
   m_fileMode = std::ofstream::out;
 }
@@ -201,17 +280,7 @@ SatOutputFileStreamDoubleContainer::ClearContainer ()
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_container.empty ())
-    {
-      for (uint32_t i = 0; i < m_container.size (); i++)
-        {
-          if (!m_container[i].empty ())
-            {
-              m_container[i].clear ();
-            }
-        }
-      m_container.clear ();
-    }
+  m_buffer.clear ();
 
   m_valuesInRow = 0;
 }
@@ -225,15 +294,21 @@ SatOutputFileStreamDoubleContainer::GetGnuplotDataset ()
   ret.SetTitle (m_title);
   ret.SetStyle (m_style);
 
-  if (!m_container.empty ())
+  if (m_writtenRows > 0)
     {
       switch (m_valuesInRow)
         {
         case 2:
           {
-            for (uint32_t i = 0; i < m_container.size (); i++)
+            if (m_rowsWithoutFigure > 0)
               {
-                ret.Add (m_container[i].at (0), ConvertValue (m_container[i].at (1)));
+                AddRowsFromFile (ret);
+              }
+
+            for (std::vector<std::pair<double, double> >::const_iterator it = m_figurePoints.begin ();
+                 it != m_figurePoints.end (); ++it)
+              {
+                ret.Add (it->first, ConvertValue (it->second));
               }
             break;
           }
@@ -246,6 +321,42 @@ SatOutputFileStreamDoubleContainer::GetGnuplotDataset ()
   return ret;
 }
 
+void
+SatOutputFileStreamDoubleContainer::AddRowsFromFile (Gnuplot2dDataset& dataset)
+{
+  NS_LOG_FUNCTION (this);
+
+  // The rows flushed before the figure output was enabled are read back
+  // from the file. The rows, which were in the file before it was opened
+  // by this container in the append mode, are skipped.
+  std::ifstream ifs (m_fileName.c_str ());
+  std::string line;
+  uint64_t lines = 0;
+
+  while (std::getline (ifs, line))
+    {
+      lines++;
+    }
+
+  uint64_t staleRows = lines > m_writtenRows ? lines - m_writtenRows : 0;
+
+  ifs.clear ();
+  ifs.seekg (0, std::ios::beg);
+
+  for (uint64_t i = 0; i < staleRows + m_rowsWithoutFigure && std::getline (ifs, line); i++)
+    {
+      if (i >= staleRows)
+        {
+          const char* begin = line.c_str ();
+          char* end;
+          double x = std::strtod (begin, &end);
+          double y = std::strtod (end, NULL);
+
+          dataset.Add (x, ConvertValue (y));
+        }
+    }
+}
+
 double
 SatOutputFileStreamDoubleContainer::ConvertValue (double value)
 {
@@ -315,4 +426,12 @@ SatOutputFileStreamDoubleContainer::EnableFigureOutput (std::string title,
   m_style = style;
 }
 
+void
+SatOutputFileStreamDoubleContainer::DisableFigureOutput ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_printFigure = false;
+}
+
 } // namespace ns3
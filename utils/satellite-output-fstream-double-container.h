@@ -34,6 +34,13 @@ namespace ns3 {
  * \brief Class for output file stream container for double values.
  * The class implements storing the values and writing the stored
  * values into a file. A figure output in two dimensions is also supported.
+ *
+ * The value rows are stored in a flat buffer, which is appended to the file
+ * when the number of buffered rows reaches the flush threshold. Thus the
+ * memory usage does not grow with the simulation length. When the figure
+ * output is enabled, the figure points are taken from the rows before they
+ * are flushed. The rows flushed before enabling the figure output are read
+ * back from the file.
  */
 class SatOutputFileStreamDoubleContainer : public Object
 {
@@ -77,7 +84,7 @@ public:
   /**
    * \brief Function for adding the values to container
    */
-  void AddToContainer (std::vector<double> newItem);
+  void AddToContainer (const std::vector<double>& newItem);
 
   /**
    * \brief Do needed dispose actions
@@ -100,6 +107,11 @@ public:
                            FigureUnitConversion_t figureUnitConversionType,
                            Gnuplot2dDataset::Style style);
 
+  /**
+   * \brief Function for disabling the figure output
+   */
+  void DisableFigureOutput ();
+
 private:
   /**
    * \brief Function for resetting the variables
@@ -117,10 +129,22 @@ private:
   void ClearContainer ();
 
   /**
-   * \brief Function for opening the output file stream
+   * \brief Function for opening the output file stream. The file is
+   * created with the given file mode when opened for the first time, and
+   * appended to otherwise.
    */
   void OpenStream ();
 
+  /**
+   * \brief Function for closing the output file stream
+   */
+  void CloseStream ();
+
+  /**
+   * \brief Function for appending the buffered rows to the file
+   */
+  void FlushBuffer ();
+
   /**
    * \brief Function for printing the container contents into a figure
    */
@@ -139,6 +163,13 @@ private:
    */
   Gnuplot2dDataset GetGnuplotDataset ();
 
+  /**
+   * \brief Function for adding the rows flushed before enabling the figure
+   * output from the file to the dataset
+   * \param dataset dataset
+   */
+  void AddRowsFromFile (Gnuplot2dDataset& dataset);
+
   /**
    * \brief Function for creating Gnuplots
    * \return Gnuplot
@@ -156,9 +187,36 @@ private:
   std::ofstream* m_outputFileStream;
 
   /**
-   * \brief Container for value rows
+   * \brief Buffer for value rows, m_valuesInRow values per row
+   */
+  std::vector<double> m_buffer;
+
+  /**
+   * \brief Number of buffered rows, which triggers writing the buffer to
+   * the file. Zero keeps all the rows in the buffer until the container is
+   * written to the file.
+   */
+  uint32_t m_flushThreshold;
+
+  /**
+   * \brief Has the file been created
+   */
+  bool m_fileCreated;
+
+  /**
+   * \brief Number of rows written to the file
+   */
+  uint64_t m_writtenRows;
+
+  /**
+   * \brief Figure points of the flushed rows
+   */
+  std::vector<std::pair<double, double> > m_figurePoints;
+
+  /**
+   * \brief Number of rows flushed before enabling the figure output
    */
-  std::vector<std::vector<double> > m_container;
+  uint64_t m_rowsWithoutFigure;
 
   /**
    * \brief File name